@@ -8,12 +8,14 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Game/Definition/FactionDefinition.hpp"
 #include "Game/Framework/AnimationGroup.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "Game/Gameplay/Sound.hpp"
 
 //----------------------------------------------------------------------------------------------------
 STATIC std::vector<ActorDefinition*> ActorDefinition::s_actorDefinitions;
+STATIC std::vector<int>              ActorDefinition::s_defIndexByNameID;
 
 //----------------------------------------------------------------------------------------------------
 ActorDefinition::~ActorDefinition()
@@ -24,6 +26,7 @@ ActorDefinition::~ActorDefinition()
     }
 
     s_actorDefinitions.clear();
+    s_defIndexByNameID.clear();
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -36,6 +39,14 @@ bool ActorDefinition::LoadFromXmlElement(XmlElement const* element)
     m_corpseLifetime = ParseXmlAttribute(*element, "corpseLifetime", -1.f);
     m_isVisible      = ParseXmlAttribute(*element, "visible", false);
     m_dieOnSpawn     = ParseXmlAttribute(*element, "dieOnSpawn", false);
+    m_nameID         = NameTable::Intern(m_name);
+    m_factionID      = NameTable::Intern(m_faction);
+    m_factionIndex   = FactionDefinition::GetFactionIndexByNameID(m_factionID);
+
+    if (m_factionIndex < 0)
+    {
+        ERROR_AND_DIE("Actor definition faction is not in the faction definitions")
+    }
 
     XmlElement const* collisionElement = element->FirstChildElement("Collision");
 
@@ -62,6 +73,14 @@ bool ActorDefinition::LoadFromXmlElement(XmlElement const* element)
         m_drag      = ParseXmlAttribute(*physicsElement, "drag", -1.f);
     }
 
+    XmlElement const* projectileElement = element->FirstChildElement("Projectile");
+
+    if (projectileElement != nullptr)
+    {
+        m_isPooledProjectile = true;
+        m_projectileLifetime = ParseXmlAttribute(*projectileElement, "lifetime", m_projectileLifetime);
+    }
+
     XmlElement const* cameraElement = element->FirstChildElement("Camera");
 
     if (cameraElement != nullptr)
@@ -93,21 +112,26 @@ bool ActorDefinition::LoadFromXmlElement(XmlElement const* element)
         m_renderLit                       = ParseXmlAttribute(*visualElement, "renderLit", false);
         m_renderRounded                   = ParseXmlAttribute(*visualElement, "renderRounded", false);
         m_cellCount                       = ParseXmlAttribute(*visualElement, "cellCount", IntVec2::ZERO);
-        String const shaderPath           = ParseXmlAttribute(*visualElement, "shader", "DEFAULT");
-        m_shader                          = g_theRenderer->CreateOrGetShaderFromFile(shaderPath.c_str(), eVertexType::VERTEX_PCUTBN);
-        String const   spriteSheetPath    = ParseXmlAttribute(*visualElement, "spriteSheet", "DEFAULT");
-        Texture const* spriteSheetTexture = g_theRenderer->CreateOrGetTextureFromFile(spriteSheetPath.c_str());
-        m_spriteSheet                     = new SpriteSheet(*spriteSheetTexture, m_cellCount);
 
-        if (visualElement->ChildElementCount() > 0)
+        // Shaders, textures and sprite animations only matter to rendering, so headless runs skip them.
+        if (g_theRenderer != nullptr)
         {
-            XmlElement const* visualChildElement = visualElement->FirstChildElement();
+            String const shaderPath           = ParseXmlAttribute(*visualElement, "shader", "DEFAULT");
+            m_shader                          = g_theRenderer->CreateOrGetShaderFromFile(shaderPath.c_str(), eVertexType::VERTEX_PCUTBN);
+            String const   spriteSheetPath    = ParseXmlAttribute(*visualElement, "spriteSheet", "DEFAULT");
+            Texture const* spriteSheetTexture = g_theRenderer->CreateOrGetTextureFromFile(spriteSheetPath.c_str());
+            m_spriteSheet                     = new SpriteSheet(*spriteSheetTexture, m_cellCount);
 
-            while (visualChildElement != nullptr)
+            if (visualElement->ChildElementCount() > 0)
             {
-                AnimationGroup animationGroup = AnimationGroup(*visualChildElement, *m_spriteSheet);
-                m_animationGroup.push_back(animationGroup);
-                visualChildElement = visualChildElement->NextSiblingElement();
+                XmlElement const* visualChildElement = visualElement->FirstChildElement();
+
+                while (visualChildElement != nullptr)
+                {
+                    AnimationGroup animationGroup = AnimationGroup(*visualChildElement, *m_spriteSheet);
+                    m_animationGroup.push_back(animationGroup);
+                    visualChildElement = visualChildElement->NextSiblingElement();
+                }
             }
         }
     }
@@ -141,6 +165,7 @@ bool ActorDefinition::LoadFromXmlElement(XmlElement const* element)
             weaponName = ParseXmlAttribute(*weaponElement, "name", "DEFAULT");
 
             m_inventory.push_back(weaponName);
+            m_inventoryIDs.push_back(NameTable::Intern(weaponName));
 
             weaponElement = weaponElement->NextSiblingElement("Weapon");
         }
@@ -186,38 +211,74 @@ STATIC void ActorDefinition::InitializeActorDefs(char const* path)
 
         actorDefinitionElement = actorDefinitionElement->NextSiblingElement();
     }
+
+    // Sized after loading, since loading interns names.
+    s_defIndexByNameID.assign(NameTable::GetCount(), -1);
+
+    for (int defIndex = 0; defIndex < static_cast<int>(s_actorDefinitions.size()); ++defIndex)
+    {
+        s_defIndexByNameID[s_actorDefinitions[defIndex]->m_nameID] = defIndex;
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
-ActorDefinition* ActorDefinition::GetDefByName(String const& name)
+STATIC ActorDefinition* ActorDefinition::GetDefByName(String const& name)
 {
-    for (ActorDefinition* actorDef : s_actorDefinitions)
-    {
-        if (actorDef->m_name == name)
-        {
-            return actorDef;
-        }
-    }
+    return GetDefByNameID(NameTable::Find(name));
+}
 
-    return nullptr;
+//----------------------------------------------------------------------------------------------------
+STATIC ActorDefinition* ActorDefinition::GetDefByNameID(NameID const nameID)
+{
+    int const defIndex = GetDefIndexByNameID(nameID);
+
+    return defIndex >= 0 ? s_actorDefinitions[defIndex] : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Index into s_actorDefinitions, which stays valid for as long as the definitions are loaded.
+STATIC int ActorDefinition::GetDefIndexByName(String const& name)
+{
+    return GetDefIndexByNameID(NameTable::Find(name));
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC int ActorDefinition::GetDefIndexByNameID(NameID const nameID)
+{
+    if (nameID < 0 || nameID >= static_cast<NameID>(s_defIndexByNameID.size())) return -1;
+
+    return s_defIndexByNameID[nameID];
 }
 
 //----------------------------------------------------------------------------------------------------
 AnimationGroup* ActorDefinition::GetAnimationGroupByName(String const& name)
+{
+    return GetAnimationGroupByNameID(NameTable::Find(name));
+}
+
+//----------------------------------------------------------------------------------------------------
+// A definition has a handful of groups, so comparing ids in order beats any hashing.
+AnimationGroup* ActorDefinition::GetAnimationGroupByNameID(NameID const nameID)
 {
     for (AnimationGroup& animGroup : m_animationGroup)
     {
-        if (animGroup.GetName() == name) return &animGroup;
+        if (animGroup.GetNameID() == nameID) return &animGroup;
     }
     return nullptr;
 }
 
 //----------------------------------------------------------------------------------------------------
 Sound* ActorDefinition::GetSoundByName(String const& name)
+{
+    return GetSoundByNameID(NameTable::Find(name));
+}
+
+//----------------------------------------------------------------------------------------------------
+Sound* ActorDefinition::GetSoundByNameID(NameID const nameID)
 {
     for (Sound& sound : m_sounds)
     {
-        if (sound.m_name == name) return &sound;
+        if (sound.m_nameID == nameID) return &sound;
     }
     return nullptr;
 }
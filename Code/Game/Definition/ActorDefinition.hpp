@@ -13,6 +13,7 @@
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Renderer/Shader.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
+#include "Game/Framework/NameTable.hpp"
 
 class Sound;
 class AnimationGroup;
@@ -29,13 +30,22 @@ public:
 
     static void             InitializeActorDefs(char const* path);
     static ActorDefinition* GetDefByName(String const& name);
+    static ActorDefinition* GetDefByNameID(NameID nameID);
+    static int              GetDefIndexByName(String const& name);
+    static int              GetDefIndexByNameID(NameID nameID);
     AnimationGroup*         GetAnimationGroupByName(String const& name);
+    AnimationGroup*         GetAnimationGroupByNameID(NameID nameID);
     Sound*                  GetSoundByName(String const& name);
+    Sound*                  GetSoundByNameID(NameID nameID);
 
     static std::vector<ActorDefinition*> s_actorDefinitions;
+    static std::vector<int>              s_defIndexByNameID;     // Indexed by NameID, -1 for names that are not actor definitions.
 
     String m_name;
     String m_faction        = "NEUTRAL";    // Faction for the actor. Determines which actors are enemies for purposes of AI target selection.
+    NameID m_nameID         = NameTable::INVALID;
+    NameID m_factionID      = NameTable::NEUTRAL;
+    int    m_factionIndex   = 0;            // Into FactionDefinition::s_factionDefinitions.
     int    m_health         = 0;            // Starting health for the actor.
     bool   m_canBePossessed = false;        // Determines whether this actor can be possessed, by either the player or an AI.
     float  m_corpseLifetime = 0.f;          // Time that the actor should linger after death, in seconds. For purposes of playing death animations and effects.
@@ -59,6 +69,10 @@ public:
     float m_turnSpeed = 0.f;
     float m_drag      = 0.f;
 
+    // Projectile
+    bool  m_isPooledProjectile = false;     // Spawned into the map's ProjectilePool instead of as an Actor.
+    float m_projectileLifetime = 10.f;      // Seconds a pooled projectile flies before it is removed without hitting anything.
+
     // Camera
     float m_eyeHeight = 0.f;
     float m_cameraFOV = 0.f;
@@ -83,5 +97,6 @@ public:
     std::vector<Sound> m_sounds;
 
     // Weapons
-    StringList m_inventory;
+    StringList          m_inventory;
+    std::vector<NameID> m_inventoryIDs;     // Interned m_inventory, what spawning looks the weapons up by.
 };
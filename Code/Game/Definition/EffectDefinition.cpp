@@ -0,0 +1,132 @@
+//----------------------------------------------------------------------------------------------------
+// EffectDefinition.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Definition/EffectDefinition.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/SpriteSheet.hpp"
+#include "Game/Framework/GameCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+STATIC std::vector<EffectDefinition*>       EffectDefinition::s_effectDefinitions;
+STATIC std::vector<EffectDefinition const*> EffectDefinition::s_batchDefinitions;
+
+//----------------------------------------------------------------------------------------------------
+bool EffectDefinition::LoadFromXmlElement(XmlElement const& element)
+{
+    m_name                     = ParseXmlAttribute(element, "name", "DEFAULT");
+    m_nameID                   = NameTable::Intern(m_name);
+    m_particleCount            = ParseXmlAttribute(element, "count", m_particleCount);
+    m_lifetime                 = ParseXmlAttribute(element, "lifetime", m_lifetime);
+    m_speed                    = ParseXmlAttribute(element, "speed", m_speed);
+    m_gravity                  = ParseXmlAttribute(element, "gravity", m_gravity);
+    m_size                     = ParseXmlAttribute(element, "size", m_size);
+    String const billboardType = ParseXmlAttribute(element, "billboardType", "FullOpposing");
+    if (billboardType == "FullFacing") m_billboardType = eBillboardType::FULL_FACING;
+    if (billboardType == "FullOpposing") m_billboardType = eBillboardType::FULL_OPPOSING;
+    if (billboardType == "WorldUpFacing") m_billboardType = eBillboardType::WORLD_UP_FACING;
+    if (billboardType == "WorldUpOpposing") m_billboardType = eBillboardType::WORLD_UP_OPPOSING;
+    m_cellCount       = ParseXmlAttribute(element, "cellCount", m_cellCount);
+    m_startFrame      = ParseXmlAttribute(element, "startFrame", m_startFrame);
+    m_endFrame        = ParseXmlAttribute(element, "endFrame", m_endFrame);
+    m_secondsPerFrame = ParseXmlAttribute(element, "secondsPerFrame", m_secondsPerFrame);
+    m_spriteSheetPath = ParseXmlAttribute(element, "spriteSheet", "DEFAULT");
+    m_shaderPath      = ParseXmlAttribute(element, "shader", "Data/Shaders/Default");
+
+    if (m_particleCount <= 0 || m_lifetime <= 0.f || m_secondsPerFrame <= 0.f) return false;
+
+    // Shaders and textures only matter to rendering, so headless runs skip them.
+    if (g_theRenderer != nullptr)
+    {
+        m_shader      = g_theRenderer->CreateOrGetShaderFromFile(m_shaderPath.c_str(), eVertexType::VERTEX_PCU);
+        m_spriteSheet = new SpriteSheet(*g_theRenderer->CreateOrGetTextureFromFile(m_spriteSheetPath.c_str()), m_cellCount);
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Effects are numbered into batches by sprite sheet and shader path, in file order.
+STATIC void EffectDefinition::InitializeEffectDefs(char const* path)
+{
+    XmlDocument     document;
+    XmlResult const result = document.LoadFile(path);
+
+    if (result != XmlResult::XML_SUCCESS)
+    {
+        ERROR_AND_DIE("Failed to load XML file")
+    }
+
+    XmlElement const* rootElement = document.RootElement();
+
+    if (rootElement == nullptr)
+    {
+        ERROR_AND_DIE("XML file is missing a root element.")
+    }
+
+    XmlElement const* effectDefinitionElement = rootElement->FirstChildElement("EffectDefinition");
+
+    while (effectDefinitionElement != nullptr)
+    {
+        EffectDefinition* effectDefinition = new EffectDefinition();
+
+        if (!effectDefinition->LoadFromXmlElement(*effectDefinitionElement))
+        {
+            delete effectDefinition;
+            ERROR_AND_DIE("Failed to load effect definition")
+        }
+
+        effectDefinition->m_batchIndex = static_cast<int>(s_batchDefinitions.size());
+
+        for (int batchIndex = 0; batchIndex < static_cast<int>(s_batchDefinitions.size()); ++batchIndex)
+        {
+            if (s_batchDefinitions[batchIndex]->m_spriteSheetPath == effectDefinition->m_spriteSheetPath &&
+                s_batchDefinitions[batchIndex]->m_shaderPath == effectDefinition->m_shaderPath)
+            {
+                effectDefinition->m_batchIndex = batchIndex;
+                break;
+            }
+        }
+
+        if (effectDefinition->m_batchIndex == static_cast<int>(s_batchDefinitions.size()))
+        {
+            s_batchDefinitions.push_back(effectDefinition);
+        }
+
+        s_effectDefinitions.push_back(effectDefinition);
+        effectDefinitionElement = effectDefinitionElement->NextSiblingElement("EffectDefinition");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC EffectDefinition const* EffectDefinition::GetDefByName(String const& name)
+{
+    int const defIndex = GetDefIndexByName(name);
+
+    return defIndex >= 0 ? s_effectDefinitions[defIndex] : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC int EffectDefinition::GetDefIndexByName(String const& name)
+{
+    return GetDefIndexByNameID(NameTable::Find(name));
+}
+
+//----------------------------------------------------------------------------------------------------
+// There are only a few effects, so comparing ids in order beats any hashing.
+STATIC int EffectDefinition::GetDefIndexByNameID(NameID const nameID)
+{
+    for (int defIndex = 0; defIndex < static_cast<int>(s_effectDefinitions.size()); ++defIndex)
+    {
+        if (s_effectDefinitions[defIndex]->m_nameID == nameID)
+        {
+            return defIndex;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,52 @@
+//----------------------------------------------------------------------------------------------------
+// EffectDefinition.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Game/Framework/NameTable.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Shader;
+class SpriteSheet;
+
+//----------------------------------------------------------------------------------------------------
+// A cosmetic effect, such as a bullet hit, spawned into a map's ParticleSystem instead of as actors.
+// Effects drawn from the same sprite sheet with the same shader share a batch, see m_batchIndex.
+struct EffectDefinition
+{
+    EffectDefinition() = default;
+
+    bool LoadFromXmlElement(XmlElement const& element);
+
+    static void                                 InitializeEffectDefs(char const* path);
+    static EffectDefinition const*              GetDefByName(String const& name);
+    static int                                  GetDefIndexByName(String const& name);
+    static int                                  GetDefIndexByNameID(NameID nameID);
+    static std::vector<EffectDefinition*>       s_effectDefinitions;
+    static std::vector<EffectDefinition const*> s_batchDefinitions;     // First definition of each batch, whose sprite sheet and shader the batch draws with.
+
+    String         m_name;
+    NameID         m_nameID          = NameTable::INVALID;
+    int            m_particleCount   = 1;                                // Particles spawned each time the effect is spawned.
+    float          m_lifetime        = 0.f;                              // Seconds each particle lives.
+    FloatRange     m_speed           = FloatRange::ZERO;                 // Each particle flies off in a random direction at a roll of this speed.
+    float          m_gravity         = 0.f;                              // Downward acceleration, in world units per second squared.
+    Vec2           m_size            = Vec2::ZERO;                       // Size of the particle sprite, in world units.
+    eBillboardType m_billboardType   = eBillboardType::FULL_OPPOSING;    // Possible values: FullFacing, FullOpposing, WorldUpFacing, WorldUpOpposing.
+    IntVec2        m_cellCount       = IntVec2::ZERO;                    // Sprite sheet grid dimensions.
+    int            m_startFrame      = 0;                                // Played once over the particle's life, holding the end frame.
+    int            m_endFrame        = 0;
+    float          m_secondsPerFrame = 0.1f;
+    String         m_spriteSheetPath;
+    String         m_shaderPath;
+    Shader*        m_shader          = nullptr;                          // Null when headless, like the sprite sheet.
+    SpriteSheet*   m_spriteSheet     = nullptr;
+    int            m_batchIndex      = 0;                                // Into s_batchDefinitions.
+};
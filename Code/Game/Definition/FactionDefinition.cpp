@@ -0,0 +1,121 @@
+//----------------------------------------------------------------------------------------------------
+// FactionDefinition.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Definition/FactionDefinition.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+//----------------------------------------------------------------------------------------------------
+STATIC std::vector<FactionDefinition*> FactionDefinition::s_factionDefinitions;
+
+//----------------------------------------------------------------------------------------------------
+bool FactionDefinition::LoadFromXmlElement(XmlElement const& element)
+{
+    m_name   = ParseXmlAttribute(element, "name", "DEFAULT");
+    m_nameID = NameTable::Intern(m_name);
+
+    String const hostileTo = ParseXmlAttribute(element, "hostileTo", "");
+
+    if (!hostileTo.empty())
+    {
+        m_hostileTo = SplitStringOnDelimiter(hostileTo, ',');
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Hostility is resolved once every faction is loaded, since a faction may name factions further down the file.
+STATIC void FactionDefinition::InitializeFactionDefs(char const* path)
+{
+    XmlDocument     document;
+    XmlResult const result = document.LoadFile(path);
+
+    if (result != XmlResult::XML_SUCCESS)
+    {
+        ERROR_AND_DIE("Failed to load XML file")
+    }
+
+    XmlElement const* rootElement = document.RootElement();
+
+    if (rootElement == nullptr)
+    {
+        ERROR_AND_DIE("XML file is missing a root element.")
+    }
+
+    XmlElement const* factionDefinitionElement = rootElement->FirstChildElement("FactionDefinition");
+
+    while (factionDefinitionElement != nullptr)
+    {
+        FactionDefinition* factionDefinition = new FactionDefinition();
+
+        if (!factionDefinition->LoadFromXmlElement(*factionDefinitionElement))
+        {
+            delete factionDefinition;
+            ERROR_AND_DIE("Failed to load faction definition")
+        }
+
+        if (static_cast<int>(s_factionDefinitions.size()) == MAX_FACTIONS)
+        {
+            delete factionDefinition;
+            ERROR_AND_DIE("Too many faction definitions")
+        }
+
+        s_factionDefinitions.push_back(factionDefinition);
+        factionDefinitionElement = factionDefinitionElement->NextSiblingElement("FactionDefinition");
+    }
+
+    for (FactionDefinition* factionDefinition : s_factionDefinitions)
+    {
+        factionDefinition->m_hostileMask = 0;
+
+        for (String const& hostileName : factionDefinition->m_hostileTo)
+        {
+            int const hostileIndex = GetFactionIndexByNameID(NameTable::Find(hostileName));
+
+            if (hostileIndex < 0)
+            {
+                ERROR_AND_DIE("Faction is hostile to a faction that is not defined")
+            }
+
+            factionDefinition->m_hostileMask |= 1u << hostileIndex;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// There are only a few factions, so comparing ids in order beats any hashing.
+STATIC int FactionDefinition::GetFactionIndexByNameID(NameID const nameID)
+{
+    for (int factionIndex = 0; factionIndex < static_cast<int>(s_factionDefinitions.size()); ++factionIndex)
+    {
+        if (s_factionDefinitions[factionIndex]->m_nameID == nameID)
+        {
+            return factionIndex;
+        }
+    }
+
+    return -1;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC uint32_t FactionDefinition::GetHostileMask(int const factionIndex)
+{
+    return s_factionDefinitions[factionIndex]->m_hostileMask;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool FactionDefinition::IsHostile(int const factionIndex,
+                                         int const otherFactionIndex)
+{
+    return (s_factionDefinitions[factionIndex]->m_hostileMask & (1u << otherFactionIndex)) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC int FactionDefinition::GetFactionCount()
+{
+    return static_cast<int>(s_factionDefinitions.size());
+}
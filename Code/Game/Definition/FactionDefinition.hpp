@@ -0,0 +1,37 @@
+//----------------------------------------------------------------------------------------------------
+// FactionDefinition.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/XmlUtils.hpp"
+#include "Game/Framework/NameTable.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// A side actors fight on. Factions are numbered in file order, and who each faction's AI treats as an enemy
+// is a bitmask over those numbers, so hostility is one bit test and enemy searches can skip whole factions.
+struct FactionDefinition
+{
+    static constexpr int MAX_FACTIONS = 32;     // Bits in m_hostileMask.
+
+    FactionDefinition() = default;
+
+    bool LoadFromXmlElement(XmlElement const& element);
+
+    static void     InitializeFactionDefs(char const* path);
+    static int      GetFactionIndexByNameID(NameID nameID);
+    static uint32_t GetHostileMask(int factionIndex);
+    static bool     IsHostile(int factionIndex, int otherFactionIndex);
+    static int      GetFactionCount();
+
+    static std::vector<FactionDefinition*> s_factionDefinitions;
+
+    String     m_name;
+    NameID     m_nameID      = NameTable::INVALID;
+    StringList m_hostileTo;                 // Names of the factions this faction attacks, comma separated in the file.
+    uint32_t   m_hostileMask = 0;           // Bit i is set when this faction attacks faction i.
+};
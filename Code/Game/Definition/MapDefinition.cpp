@@ -10,13 +10,23 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Shader.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Gameplay/CompiledMap.hpp"
 
 //----------------------------------------------------------------------------------------------------
 std::vector<MapDefinition*> MapDefinition::s_mapDefinitions;
 
+//----------------------------------------------------------------------------------------------------
+NameID SpawnInfo::GetNameID() const
+{
+    return m_nameID != NameTable::INVALID ? m_nameID : NameTable::Find(m_name);
+}
+
 //----------------------------------------------------------------------------------------------------
 MapDefinition::~MapDefinition()
 {
+    delete m_compiledMap;
+    m_compiledMap = nullptr;
+
     for (MapDefinition const* mapDef : s_mapDefinitions)
     {
         delete mapDef;
@@ -29,14 +39,42 @@ MapDefinition::~MapDefinition()
 bool MapDefinition::LoadFromXmlElement(XmlElement const& element)
 {
     m_name                                  = ParseXmlAttribute(element, "name", "Unnamed");
-    String const imageFilePath              = ParseXmlAttribute(element, "image", "Unnamed");
+    m_imageFilePath                         = ParseXmlAttribute(element, "image", "Unnamed");
+    m_compiledMapFilePath                   = ParseXmlAttribute(element, "compiledMap", "");
     String const shaderFilePath             = ParseXmlAttribute(element, "shader", "Unnamed");
     String const spriteSheetTextureFilePath = ParseXmlAttribute(element, "spriteSheetTexture", "Unnamed");
     m_spriteSheetCellCount                  = ParseXmlAttribute(element, "spriteSheetCellCount", IntVec2::ZERO);
 
-    m_image              = g_theRenderer->CreateImageFromFile(imageFilePath.c_str());
-    m_shader             = g_theRenderer->CreateOrGetShaderFromFile(shaderFilePath.c_str(), eVertexType::VERTEX_PCUTBN);
-    m_spriteSheetTexture = g_theRenderer->CreateOrGetTextureFromFile(spriteSheetTextureFilePath.c_str());
+    // A compiled map that is missing or stale just falls back to the image; the tile definitions must already be loaded.
+    if (!m_compiledMapFilePath.empty())
+    {
+        m_compiledMap = new CompiledMap();
+
+        if (!m_compiledMap->Open(m_compiledMapFilePath.c_str(), m_spriteSheetCellCount))
+        {
+            delete m_compiledMap;
+            m_compiledMap = nullptr;
+        }
+    }
+
+    // Headless runs have no renderer, but still need the map image to build the tiles.
+    if (g_theRenderer == nullptr)
+    {
+        if (m_compiledMap == nullptr)
+        {
+            m_image = Image(m_imageFilePath.c_str());
+        }
+    }
+    else
+    {
+        if (m_compiledMap == nullptr)
+        {
+            m_image = g_theRenderer->CreateImageFromFile(m_imageFilePath.c_str());
+        }
+
+        m_shader             = g_theRenderer->CreateOrGetShaderFromFile(shaderFilePath.c_str(), eVertexType::VERTEX_PCUTBN);
+        m_spriteSheetTexture = g_theRenderer->CreateOrGetTextureFromFile(spriteSheetTextureFilePath.c_str());
+    }
 
     XmlElement const* spawnInfosElement = element.FirstChildElement("SpawnInfos");
 
@@ -113,3 +151,28 @@ STATIC void MapDefinition::InitializeMapDefs(char const* path)
     //     }
     // }
 }
+
+//----------------------------------------------------------------------------------------------------
+IntVec2 MapDefinition::GetDimensions() const
+{
+    if (m_compiledMap != nullptr)
+    {
+        return m_compiledMap->GetDimensions();
+    }
+
+    return m_image.GetDimensions();
+}
+
+//----------------------------------------------------------------------------------------------------
+MapDefinition const* MapDefinition::GetDefByName(String const& name)
+{
+    for (MapDefinition const* mapDef : s_mapDefinitions)
+    {
+        if (mapDef->m_name == name)
+        {
+            return mapDef;
+        }
+    }
+
+    return nullptr;
+}
@@ -8,15 +8,20 @@
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/Vec3.hpp"
+#include "Game/Framework/NameTable.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
+class CompiledMap;
 class Texture;
 class Shader;
 
 //----------------------------------------------------------------------------------------------------
 struct SpawnInfo
 {
+    NameID GetNameID() const;
+
     String      m_name        = "Unnamed";
+    NameID      m_nameID      = NameTable::INVALID;     // When set, used instead of m_name, so spawning skips the name lookup.
     String      m_faction     = "NEUTRAL";
     Vec3        m_position    = Vec3::ZERO;
     EulerAngles m_orientation = EulerAngles::ZERO;
@@ -32,9 +37,15 @@ struct MapDefinition
     bool LoadFromXmlElement(XmlElement const& element);
 
     static void                        InitializeMapDefs(char const* path);
+    static MapDefinition const*        GetDefByName(String const& name);
     static std::vector<MapDefinition*> s_mapDefinitions;
 
+    IntVec2 GetDimensions() const;
+
     String                 m_name;
+    String                 m_imageFilePath;
+    String                 m_compiledMapFilePath;                 // Optional .dmap written by MapCompiler; when it opens, the image is never decoded.
+    CompiledMap*           m_compiledMap        = nullptr;
     Image                  m_image              = Image(IntVec2::ZERO, Rgba8::WHITE);
     Shader*                m_shader             = nullptr;
     Texture const*         m_spriteSheetTexture = nullptr;
@@ -7,6 +7,7 @@
 
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Game/Gameplay/Tile.hpp"
 
 //----------------------------------------------------------------------------------------------------
 std::vector<TileDefinition*> TileDefinition::s_tileDefinitions;
@@ -68,6 +69,12 @@ STATIC void TileDefinition::InitializeTileDefs(char const* path)
         tileDefinitionElement = tileDefinitionElement->NextSiblingElement();
     }
 
+    // Tiles store their definition as a byte, with 0xff reserved for "no definition".
+    if (s_tileDefinitions.size() >= Tile::INVALID_DEF_INDEX)
+    {
+        ERROR_AND_DIE("Too many tile definitions, tiles can only index 255 of them")
+    }
+
     // XmlDocument mapDefXml;
     //
     // if (mapDefXml.LoadFile("Data/Definitions/TileDefinitions.xml") != XmlResult::XML_SUCCESS)
@@ -100,6 +107,23 @@ TileDefinition const* TileDefinition::GetDefByName(String const& name)
     return nullptr;
 }
 
+//----------------------------------------------------------------------------------------------------
+// The last definition with a matching color wins; Tile::INVALID_DEF_INDEX if none matches.
+uint8_t TileDefinition::GetDefIndexByMapImagePixelColor(Rgba8 const& color)
+{
+    uint8_t tileDefIndex = Tile::INVALID_DEF_INDEX;
+
+    for (int index = 0; index < static_cast<int>(s_tileDefinitions.size()); ++index)
+    {
+        if (s_tileDefinitions[index]->m_mapImagePixelColor == color)
+        {
+            tileDefIndex = static_cast<uint8_t>(index);
+        }
+    }
+
+    return tileDefIndex;
+}
+
 //----------------------------------------------------------------------------------------------------
 StringList TileDefinition::GetTileNames()
 {
@@ -4,6 +4,8 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <cstdint>
+
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/Math/IntVec2.hpp"
@@ -18,6 +20,7 @@ struct TileDefinition
 
     static void                         InitializeTileDefs(char const* path);
     static TileDefinition const*        GetDefByName(String const& name);
+    static uint8_t                      GetDefIndexByMapImagePixelColor(Rgba8 const& color);
     static StringList                   GetTileNames();
     static std::vector<TileDefinition*> s_tileDefinitions;
 
@@ -7,6 +7,7 @@
 
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Game/Framework/GameCommon.hpp"
 #include "Game/Gameplay/HUD.hpp"
 #include "Game/Gameplay/Sound.hpp"
 
@@ -27,7 +28,8 @@ WeaponDefinition::~WeaponDefinition()
 //----------------------------------------------------------------------------------------------------
 bool WeaponDefinition::LoadFromXmlElement(XmlElement const* element)
 {
-    m_name = ParseXmlAttribute(*element, "name", "DEFAULT");
+    m_name   = ParseXmlAttribute(*element, "name", "DEFAULT");
+    m_nameID = NameTable::Intern(m_name);
     if (m_name == "Pistol") m_refireTime = ParseXmlAttribute(*element, "refireTime", -1.f);
     if (m_name == "PlasmaRifle") m_refireTime = ParseXmlAttribute(*element, "refireTime", -1.f);
     if (m_name == "DemonMelee") m_refireTime = ParseXmlAttribute(*element, "refireTime", -1.f);
@@ -46,10 +48,11 @@ bool WeaponDefinition::LoadFromXmlElement(XmlElement const* element)
     m_meleeDamage     = ParseXmlAttribute(*element, "meleeDamage", FloatRange::ZERO);
     m_meleeRange      = ParseXmlAttribute(*element, "meleeRange", -1.f);
     m_meleeImpulse    = ParseXmlAttribute(*element, "meleeImpulse", -1.f);
+    m_projectileActorID = NameTable::Intern(m_projectileActor);
 
     XmlElement const* hudElement = element->FirstChildElement("HUD");
 
-    if (hudElement != nullptr)
+    if (hudElement != nullptr && g_theRenderer != nullptr)
     {
         m_hud = new HUD(*hudElement);
     }
@@ -116,11 +119,17 @@ void WeaponDefinition::InitializeWeaponDefs(char const* path)
 //----------------------------------------------------------------------------------------------------
 WeaponDefinition * WeaponDefinition::GetDefByName(String const& name)
 {
-    for (WeaponDefinition * tileDef : s_weaponDefinitions)
+    return GetDefByNameID(NameTable::Find(name));
+}
+
+//----------------------------------------------------------------------------------------------------
+WeaponDefinition* WeaponDefinition::GetDefByNameID(NameID const nameID)
+{
+    for (WeaponDefinition* weaponDef : s_weaponDefinitions)
     {
-        if (tileDef->m_name == name)
+        if (weaponDef->m_nameID == nameID)
         {
-            return tileDef;
+            return weaponDef;
         }
     }
 
@@ -129,10 +138,16 @@ WeaponDefinition * WeaponDefinition::GetDefByName(String const& name)
 
 //----------------------------------------------------------------------------------------------------
 Sound* WeaponDefinition::GetSoundByName( String const& soundName)
+{
+    return GetSoundByNameID(NameTable::Find(soundName));
+}
+
+//----------------------------------------------------------------------------------------------------
+Sound* WeaponDefinition::GetSoundByNameID(NameID const nameID)
 {
     for (Sound& sound : m_sounds)
     {
-        if (sound.m_name == soundName)
+        if (sound.m_nameID == nameID)
             return &sound;
     }
     return nullptr;
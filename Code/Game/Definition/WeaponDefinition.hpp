@@ -7,6 +7,7 @@
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/Math/FloatRange.hpp"
+#include "Game/Framework/NameTable.hpp"
 
 class HUD;
 class Sound;
@@ -21,10 +22,13 @@ struct WeaponDefinition
 
     static void                           InitializeWeaponDefs(char const* path);
     static WeaponDefinition*              GetDefByName(String const& name);
+    static WeaponDefinition*              GetDefByNameID(NameID nameID);
     Sound*                                GetSoundByName(String const& soundName);
+    Sound*                                GetSoundByNameID(NameID nameID);
     static std::vector<WeaponDefinition*> s_weaponDefinitions;
 
     String     m_name;
+    NameID     m_nameID          = NameTable::INVALID;
     float      m_refireTime      = 0.f;                 // The time that must elapse between firing, in seconds.
     int        m_rayCount        = 0;                   // The number of rays to cast each time the weapon is fired. Each ray can potentially hit an actor and do damage.
     float      m_rayCone         = 0.f;                 // Maximum angle variation for each ray cast, in degrees. Each shot fired should be randomly distributed in a cone of this angle relative forward direction of the firing actor.
@@ -35,6 +39,7 @@ struct WeaponDefinition
     float      m_projectileCone  = 0.f;                 // Maximum angle variation in degrees for each projectile launched cast. Each projectile launched should have its velocity randomly distributed in a cone of this angle relative to the forward direction of the firing actor.
     float      m_projectileSpeed = 0.f;                 // Magnitude of the velocity given to each projectile launched.
     String     m_projectileActor;                       // Definition name for the actor that should be spawned when a projectile is launched.
+    NameID     m_projectileActorID = NameTable::INVALID;
     int        m_meleeCount   = 0;                      // Number of melee attacks that should occur each time the weapon is fired.
     float      m_meleeArc     = 0.f;                    // Arc in which melee attacks occur, in degrees.
     float      m_meleeRange   = 0.f;                    // Range of each melee attack, in world units.
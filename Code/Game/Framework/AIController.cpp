@@ -9,6 +9,7 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Game/Gameplay/Actor.hpp"
 #include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Gameplay/HierarchicalPathfinder.hpp"
 #include "Game/Gameplay/Map.hpp"
 #include "Game/Gameplay/Weapon.hpp"
 
@@ -18,14 +19,27 @@ AIController::AIController(Map* map)
 {
 }
 
+//----------------------------------------------------------------------------------------------------
+AIController::~AIController()
+{
+    if (m_pathRequestID >= 0)
+    {
+        m_map->GetPathfinder().CancelPath(m_pathRequestID);
+    }
+}
+
 void AIController::Update(float const deltaSeconds)
 {
     Actor* possessedActor = m_map->GetActorByHandle(m_actorHandle);
 
     if (possessedActor == nullptr) return;
+
+    // The move is held until this AI thinks again, which may be a few ticks away.
+    possessedActor->m_heldMoveForce = Vec3::ZERO;
+
     if (possessedActor->m_isDead) return;
 
-    Actor const* target = m_map->GetClosestVisibleEnemy(possessedActor);
+    Actor const* target = m_map->GetActorByHandle(m_perceivedEnemyHandle);
 
     if (target != nullptr &&
         // m_targetActorHandle.IsValid() &&
@@ -46,42 +60,142 @@ void AIController::Update(float const deltaSeconds)
 
     float const turnSpeedPerSecond          = possessedActor->m_definition->m_turnSpeed;
     float const maxTurnDegreesThisFrame     = turnSpeedPerSecond * deltaSeconds;
-    Vec3        possessedActorToTargetActor = targetActor->m_position - possessedActor->m_position;
+    Vec3        possessedActorToTargetActor = targetActor->GetPosition() - possessedActor->GetPosition();
     possessedActorToTargetActor.z           = 0.f;
 
-    float const targetActorYaw    = Atan2Degrees(possessedActorToTargetActor.y, possessedActorToTargetActor.x);
+    // Follow the target's flow field around walls, or else the path to a far target; in the target's tile, or before
+    // either is ready, head straight at it.
+    Vec3 const position   = possessedActor->GetPosition();
+    float      desiredYaw = Atan2Degrees(possessedActorToTargetActor.y, possessedActorToTargetActor.x);
+    Vec2       flowDirection;
+
+    if (m_map->GetFlowFieldSystem().GetDirection(targetActor->m_handle, position, flowDirection) ||
+        GetPathDirection(Vec2(position.x, position.y), flowDirection))
+    {
+        desiredYaw = Atan2Degrees(flowDirection.y, flowDirection.x);
+    }
+
     float const possessedActorYaw = possessedActor->m_orientation.m_yawDegrees;
-    float const newYaw            = GetTurnedTowardDegrees(possessedActorYaw, targetActorYaw, maxTurnDegreesThisFrame);
+    float const newYaw            = GetTurnedTowardDegrees(possessedActorYaw, desiredYaw, maxTurnDegreesThisFrame);
 
     EulerAngles const newDirection = EulerAngles(newYaw, possessedActor->m_orientation.m_pitchDegrees, possessedActor->m_orientation.m_rollDegrees);
     possessedActor->TurnInDirection(newDirection);
 
     float const distanceToTarget = possessedActorToTargetActor.GetLength();
-    float const combinedRadius   = possessedActor->m_radius + targetActor->m_radius;
+    float const combinedRadius   = possessedActor->GetRadius() + targetActor->GetRadius();
 
     if (distanceToTarget > combinedRadius + 0.1f)
     {
         float const moveSpeed = possessedActor->m_definition->m_runSpeed;
         Vec3        forward, left, up;
         possessedActor->m_orientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
-        possessedActor->MoveInDirection(forward, moveSpeed);
-        possessedActor->PlayAnimationByName("Walk");
+        possessedActor->HoldMoveInDirection(forward, moveSpeed);
+        possessedActor->PlayAnimationByNameID(NameTable::WALK);
     }
 
     if (possessedActor->m_currentWeapon &&
         possessedActor->m_currentWeapon->m_definition->m_meleeCount > 0)
     {
-        if (distanceToTarget < possessedActor->m_currentWeapon->m_definition->m_meleeRange + targetActor->m_radius)
+        if (distanceToTarget < possessedActor->m_currentWeapon->m_definition->m_meleeRange + targetActor->GetRadius())
         {
             possessedActor->m_currentWeapon->Fire();
-            possessedActor->PlayAnimationByName("Attack", true);
+            possessedActor->PlayAnimationByNameID(NameTable::ATTACK, true);
         }
     }
 }
 
+//----------------------------------------------------------------------------------------------------
+// Runs on the main thread before the think phase, since the pathfinder is shared. A path is only asked for when the
+// target is far and has no flow field, and again when the target changes tiles or the last path was walked to its end.
+void AIController::UpdatePath(HierarchicalPathfinder& pathfinder)
+{
+    Actor const* possessedActor = m_map->GetActorByHandle(m_actorHandle);
+    Actor const* target         = m_map->GetActorByHandle(m_targetActorHandle);
+
+    if (target == nullptr || target->m_isDead)
+    {
+        target = m_map->GetActorByHandle(m_perceivedEnemyHandle);
+    }
+
+    if (possessedActor == nullptr || target == nullptr || target->m_isDead)
+    {
+        ClearPath(pathfinder);
+        return;
+    }
+
+    Vec3 const position       = possessedActor->GetPosition();
+    Vec3 const targetPosition = target->GetPosition();
+    Vec2       flowDirection;
+
+    if (GetDistance2D(Vec2(position.x, position.y), Vec2(targetPosition.x, targetPosition.y)) <= LONG_RANGE_DISTANCE ||
+        m_map->GetFlowFieldSystem().GetDirection(target->m_handle, position, flowDirection))
+    {
+        ClearPath(pathfinder);
+        return;
+    }
+
+    if (m_pathRequestID >= 0)
+    {
+        PathStatus const status = pathfinder.GetPathResult(m_pathRequestID, m_pathWaypoints);
+
+        if (status == PathStatus::PENDING) return;
+
+        m_pathRequestID     = -1;
+        m_pathWaypointIndex = 0;
+        m_isPathFound       = status == PathStatus::FOUND;
+
+        if (!m_isPathFound) m_pathWaypoints.clear();
+    }
+
+    IntVec2 const goalTileCoords  = m_map->GetTileCoordsFromWorldPos(targetPosition);
+    bool const    isPathWalked    = m_isPathFound && m_pathWaypointIndex >= static_cast<int>(m_pathWaypoints.size());
+    bool const    isGoalTileMoved = goalTileCoords != m_pathGoalTileCoords;
+
+    if (!isGoalTileMoved && !isPathWalked) return;
+
+    // The old path is followed until the new one comes in.
+    m_pathRequestID      = pathfinder.RequestPath(Vec2(position.x, position.y), Vec2(targetPosition.x, targetPosition.y));
+    m_pathGoalTileCoords = goalTileCoords;
+}
+
 //----------------------------------------------------------------------------------------------------
 // Notification that the AI actor was damaged so this AI can target them.
 void AIController::DamagedBy(ActorHandle const& attacker)
 {
     m_targetActorHandle = attacker;
+    m_isWakeRequested   = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Skips the waypoints already reached; false once the path runs out.
+bool AIController::GetPathDirection(Vec2 const& position,
+                                    Vec2&       out_direction)
+{
+    int const waypointCount = static_cast<int>(m_pathWaypoints.size());
+
+    while (m_pathWaypointIndex < waypointCount &&
+           GetDistanceSquared2D(position, m_pathWaypoints[m_pathWaypointIndex]) < WAYPOINT_REACHED_DISTANCE * WAYPOINT_REACHED_DISTANCE)
+    {
+        ++m_pathWaypointIndex;
+    }
+
+    if (m_pathWaypointIndex >= waypointCount) return false;
+
+    out_direction = (m_pathWaypoints[m_pathWaypointIndex] - position).GetNormalized();
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIController::ClearPath(HierarchicalPathfinder& pathfinder)
+{
+    if (m_pathRequestID >= 0)
+    {
+        pathfinder.CancelPath(m_pathRequestID);
+    }
+
+    m_pathRequestID      = -1;
+    m_pathGoalTileCoords = IntVec2(-1, -1);
+    m_isPathFound        = false;
+    m_pathWaypointIndex  = 0;
+    m_pathWaypoints.clear();
 }
@@ -4,18 +4,51 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
 #include "Game/Framework/Controller.hpp"
 
+//-Forward-Declaration--------------------------------------------------------------------------------
+class HierarchicalPathfinder;
+
 //----------------------------------------------------------------------------------------------------
 // AI controllers should be constructed by the actor when the actor is spawned and immediately possess that actor.
+// A target far away that has no flow field is chased along a HierarchicalPathfinder path instead.
 class AIController final : public Controller
 {
 public:
+    static constexpr float LONG_RANGE_DISTANCE       = 16.f;     // Farther than this, a target without a flow field is chased along a path.
+    static constexpr float WAYPOINT_REACHED_DISTANCE = 0.5f;
+
     // Construction / Destruction
     explicit AIController(Map* map);
+    ~AIController() override;
 
     void Update(float deltaSeconds) override;
+    void UpdatePath(HierarchicalPathfinder& pathfinder);
     void DamagedBy(ActorHandle const& attacker);
 
     ActorHandle m_targetActorHandle;
+    ActorHandle m_perceivedEnemyHandle;     // Closest visible enemy as of the last AIPerception refresh of this AI.
+
+    // Long-range move, set by UpdatePath.
+    int               m_pathRequestID      = -1;                 // Pending HierarchicalPathfinder request, or -1.
+    IntVec2           m_pathGoalTileCoords = IntVec2(-1, -1);    // The target's tile when the path was last requested.
+    bool              m_isPathFound        = false;
+    std::vector<Vec2> m_pathWaypoints;
+    int               m_pathWaypointIndex  = 0;                  // Next waypoint to head for; Update moves it along.
+
+    // Set by AIScheduler.
+    float m_thinkSeconds      = 0.f;       // Seconds to update by this tick, 0 when this AI skips it.
+    float m_secondsSinceThink = 0.f;
+    int   m_ticksSinceThink   = 0;
+    float m_awakeSeconds      = 0.f;       // Left before this AI may go dormant again away from the players.
+    bool  m_isDormant         = false;
+    bool  m_isWakeRequested   = false;     // Damaged since the last schedule.
+
+private:
+    bool GetPathDirection(Vec2 const& position, Vec2& out_direction);
+    void ClearPath(HierarchicalPathfinder& pathfinder);
 };
@@ -6,7 +6,7 @@
 #include "Game/Framework/ActorHandle.hpp"
 
 //----------------------------------------------------------------------------------------------------
-ActorHandle const ActorHandle::INVALID = ActorHandle(0x0000ffff, 0x0000ffff);
+ActorHandle const ActorHandle::INVALID = ActorHandle(0xffffffffu, 0xffffffffu);
 
 //----------------------------------------------------------------------------------------------------
 ActorHandle::ActorHandle()
@@ -15,10 +15,10 @@ ActorHandle::ActorHandle()
 }
 
 //----------------------------------------------------------------------------------------------------
-ActorHandle::ActorHandle(unsigned int const uid,
+ActorHandle::ActorHandle(unsigned int const generation,
                          unsigned int const index)
 {
-    m_data = (uid << 16) | (index & 0x0000ffff);
+    m_data = (static_cast<uint64_t>(generation) << 32) | static_cast<uint64_t>(index);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -30,7 +30,13 @@ bool ActorHandle::IsValid() const
 //----------------------------------------------------------------------------------------------------
 unsigned int ActorHandle::GetIndex() const
 {
-    return m_data & 0x0000ffff;
+    return static_cast<unsigned int>(m_data & 0xffffffffu);
+}
+
+//----------------------------------------------------------------------------------------------------
+unsigned int ActorHandle::GetGeneration() const
+{
+    return static_cast<unsigned int>(m_data >> 32);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -4,20 +4,24 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <cstdint>
 
 //----------------------------------------------------------------------------------------------------
+// Refers to an actor slot in the map. The generation is bumped every time the slot is freed,
+// so handles to a destroyed actor stop resolving even after the slot is reused.
 struct ActorHandle
 {
     ActorHandle();
-    ActorHandle(unsigned int uid, unsigned int index);
+    ActorHandle(unsigned int generation, unsigned int index);
 
     static const ActorHandle INVALID;
 
     bool         IsValid() const;
     unsigned int GetIndex() const;
+    unsigned int GetGeneration() const;
     bool         operator==(ActorHandle const& other) const;
     bool         operator!=(ActorHandle const& other) const;
 
 private:
-    unsigned int m_data;    // used to store 32-bit integers.
+    uint64_t m_data;    // Generation in the high 32 bits, slot index in the low 32 bits.
 };
@@ -5,13 +5,19 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Framework/AnimationGroup.hpp"
 
+#include <algorithm>
+#include <cfloat>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/SpriteSheet.hpp"
 
 //----------------------------------------------------------------------------------------------------
 AnimationGroup::AnimationGroup(XmlElement const&  animationGroupElement,
                                SpriteSheet const& spriteSheet)
 {
     m_name              = ParseXmlAttribute(animationGroupElement, "name", m_name);
+    m_nameID            = NameTable::Intern(m_name);
     m_scaleBySpeed      = ParseXmlAttribute(animationGroupElement, "scaleBySpeed", m_scaleBySpeed);
     m_secondsPerFrame   = ParseXmlAttribute(animationGroupElement, "secondsPerFrame", m_secondsPerFrame);
     String playbackMode = "Loop";
@@ -20,6 +26,8 @@ AnimationGroup::AnimationGroup(XmlElement const&  animationGroupElement,
     if (playbackMode == "Once") m_playbackType = SpriteAnimPlaybackType::ONCE;
     if (playbackMode == "Pingpong") m_playbackType = SpriteAnimPlaybackType::PINGPONG;
 
+    m_texture = &spriteSheet.GetTexture();
+
     if (animationGroupElement.ChildElementCount() > 0)
     {
         XmlElement const* element = animationGroupElement.FirstChildElement();
@@ -34,10 +42,38 @@ AnimationGroup::AnimationGroup(XmlElement const&  animationGroupElement,
             int const            startFrame       = ParseXmlAttribute(*animationElement, "startFrame", 0);
             int const            endFrame         = ParseXmlAttribute(*animationElement, "endFrame", 0);
             SpriteAnimDefinition animation        = SpriteAnimDefinition(spriteSheet, startFrame, endFrame, 1.f / m_secondsPerFrame, m_playbackType);
-            m_animationDict.insert(std::make_pair(directionVector.GetNormalized(), animation));
+
+            // Sampling each frame in the middle lets the sprite animation decide the playback order once, here.
+            DirectionalAnimation directionalAnimation;
+            directionalAnimation.m_direction  = directionVector.GetNormalized();
+            directionalAnimation.m_firstFrame = static_cast<int>(m_frameUVs.size());
+            directionalAnimation.m_frameCount = std::max(animation.GetTotalFrameInCycle(), 1);
+
+            for (int frame = 0; frame < directionalAnimation.m_frameCount; ++frame)
+            {
+                m_frameUVs.push_back(animation.GetSpriteDefAtTime((static_cast<float>(frame) + 0.5f) * m_secondsPerFrame).GetUVs());
+            }
+
+            if (m_animationLength <= 0.f && animation.GetDuration() > 0.f) m_animationLength = animation.GetDuration();
+            if (m_animationTotalFrame <= 0 && animation.GetTotalFrameInCycle() > 0) m_animationTotalFrame = animation.GetTotalFrameInCycle();
+
+            m_animations.push_back(directionalAnimation);
             element = element->NextSiblingElement();
         }
     }
+
+    if (m_animations.empty() || m_animations.size() > 256)
+    {
+        ERROR_AND_DIE("Animation group needs between 1 and 256 directions")
+    }
+
+    for (int sectorIndex = 0; sectorIndex < SECTOR_COUNT; ++sectorIndex)
+    {
+        float const sectorYawDegrees = (static_cast<float>(sectorIndex) + 0.5f) * (360.f / SECTOR_COUNT) - 180.f;
+        Vec3 const  sectorDirection  = Vec3(CosDegrees(sectorYawDegrees), SinDegrees(sectorYawDegrees), 0.f);
+
+        m_sectorAnimationIndexes[sectorIndex] = static_cast<uint8_t>(FindClosestAnimationIndex(sectorDirection));
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -47,47 +83,94 @@ String AnimationGroup::GetName() const
 }
 
 //----------------------------------------------------------------------------------------------------
-SpriteAnimDefinition const& AnimationGroup::GetSpriteAnimation(Vec3 const& direction) const
+NameID AnimationGroup::GetNameID() const
 {
-    Vec3  offsetMin     = direction;
-    float directionScalar = -FLT_MAX;
+    return m_nameID;
+}
 
-    for (std::pair<Vec3 const, SpriteAnimDefinition> const& animation : m_animationDict)
-    {
-        float const scalar = DotProduct3D(direction, animation.first);
+//----------------------------------------------------------------------------------------------------
+// Uvs of the frame showing at seconds into the animation closest to direction, the viewing direction in the actor's basis.
+AABB2 const& AnimationGroup::GetSpriteUVs(Vec3 const& direction,
+                                          float const seconds) const
+{
+    DirectionalAnimation const& animation = m_animations[GetAnimationIndex(direction)];
+    int                         frame     = static_cast<int>(std::max(seconds, 0.f) / m_secondsPerFrame);
 
-        if (scalar > directionScalar)
-        {
-            directionScalar = scalar;
-            offsetMin     = animation.first;
-        }
+    if (m_playbackType == SpriteAnimPlaybackType::ONCE)
+    {
+        frame = std::min(frame, animation.m_frameCount - 1);
     }
+    else
+    {
+        frame %= animation.m_frameCount;
+    }
+
+    return m_frameUVs[animation.m_firstFrame + frame];
+}
 
-    return m_animationDict.at(offsetMin);
+//----------------------------------------------------------------------------------------------------
+Texture const* AnimationGroup::GetTexture() const
+{
+    return m_texture;
 }
 
 //----------------------------------------------------------------------------------------------------
 float AnimationGroup::GetAnimationLength() const
 {
-    for (std::pair<Vec3 const, SpriteAnimDefinition> const& animation : m_animationDict)
-    {
-        float const totalLength = animation.second.GetDuration();
+    return m_animationLength;
+}
 
-        if (totalLength > 0.f) return totalLength;
-    }
+//----------------------------------------------------------------------------------------------------
+int AnimationGroup::GetAnimationTotalFrame() const
+{
+    return m_animationTotalFrame;
+}
 
-    return -1;
+//----------------------------------------------------------------------------------------------------
+// Only the yaw of direction matters; directions differing in pitch alone pick the same animation.
+int AnimationGroup::GetAnimationIndex(Vec3 const& direction) const
+{
+    return m_sectorAnimationIndexes[GetSectorIndex(direction)];
 }
 
 //----------------------------------------------------------------------------------------------------
-int AnimationGroup::GetAnimationTotalFrame() const
+// The animation whose direction is most aligned with direction, as the lookup table was built with.
+int AnimationGroup::FindClosestAnimationIndex(Vec3 const& direction) const
 {
-    for (std::pair<Vec3 const, SpriteAnimDefinition> const& animation : m_animationDict)
+    int   closestIndex  = 0;
+    float closestScalar = -FLT_MAX;
+
+    for (int animationIndex = 0; animationIndex < static_cast<int>(m_animations.size()); ++animationIndex)
     {
-        int const totalFrame = animation.second.GetTotalFrameInCycle();
+        float const scalar = DotProduct3D(direction, m_animations[animationIndex].m_direction);
 
-        if (totalFrame > 0) return totalFrame;
+        if (scalar > closestScalar)
+        {
+            closestScalar = scalar;
+            closestIndex  = animationIndex;
+        }
     }
 
-    return -1;
+    return closestIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+int AnimationGroup::GetAnimationCount() const
+{
+    return static_cast<int>(m_animations.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 const& AnimationGroup::GetAnimationDirection(int const animationIndex) const
+{
+    return m_animations[animationIndex].m_direction;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC int AnimationGroup::GetSectorIndex(Vec3 const& direction)
+{
+    float const yawDegrees  = Atan2Degrees(direction.y, direction.x);
+    int const   sectorIndex = static_cast<int>((yawDegrees + 180.f) * (SECTOR_COUNT / 360.f));
+
+    return std::clamp(sectorIndex, 0, SECTOR_COUNT - 1);
 }
@@ -4,28 +4,60 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
-#include <map>
+#include <cstdint>
+#include <vector>
 
 #include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Math/AABB2.hpp"
 #include "Engine/Renderer/SpriteAnimDefinition.hpp"
 #include "Engine/Math/Vec3.hpp"
+#include "Game/Framework/NameTable.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Texture;
 
 //----------------------------------------------------------------------------------------------------
+// The directional animations of one actor animation, compiled when loaded into flat tables:
+// a yaw lookup table from the viewing direction to the closest direction's animation, and every animation's
+// frame uvs laid out in playback order, so picking a sprite is two table lookups.
 class AnimationGroup
 {
 public:
+    static constexpr int SECTOR_COUNT = 256;     // Yaw sectors of the viewing direction lookup table.
+
     AnimationGroup(XmlElement const& animationGroupElement, SpriteSheet const& spriteSheet);
 
     // Accessors (const methods)
-    String                      GetName() const;
-    SpriteAnimDefinition const& GetSpriteAnimation(Vec3 const& direction) const;
-    float                       GetAnimationLength() const;
-    int                         GetAnimationTotalFrame() const;
+    String         GetName() const;
+    NameID         GetNameID() const;
+    AABB2 const&   GetSpriteUVs(Vec3 const& direction, float seconds) const;
+    Texture const* GetTexture() const;
+    float          GetAnimationLength() const;
+    int            GetAnimationTotalFrame() const;
+
+    int         GetAnimationIndex(Vec3 const& direction) const;
+    int         FindClosestAnimationIndex(Vec3 const& direction) const;
+    int         GetAnimationCount() const;
+    Vec3 const& GetAnimationDirection(int animationIndex) const;
+    static int  GetSectorIndex(Vec3 const& direction);
 
 private:
-    String                               m_name            = "DEFAULT";
-    float                                m_scaleBySpeed    = false;
-    float                                m_secondsPerFrame = 0.f;
-    SpriteAnimPlaybackType               m_playbackType    = SpriteAnimPlaybackType::LOOP;
-    std::map<Vec3, SpriteAnimDefinition> m_animationDict;
+    struct DirectionalAnimation
+    {
+        Vec3 m_direction;           // Normalized, relative to the basis of the actor.
+        int  m_firstFrame = 0;      // Into m_frameUVs.
+        int  m_frameCount = 0;      // Frames in one cycle; a ping-pong cycle plays the middle frames twice.
+    };
+
+    String                            m_name                = "DEFAULT";
+    NameID                            m_nameID              = NameTable::INVALID;
+    float                             m_scaleBySpeed        = false;
+    float                             m_secondsPerFrame     = 0.f;
+    SpriteAnimPlaybackType            m_playbackType        = SpriteAnimPlaybackType::LOOP;
+    float                             m_animationLength     = -1.f;
+    int                               m_animationTotalFrame = -1;
+    Texture const*                    m_texture             = nullptr;
+    std::vector<DirectionalAnimation> m_animations;
+    std::vector<AABB2>                m_frameUVs;
+    uint8_t                           m_sectorAnimationIndexes[SECTOR_COUNT] = {};
 };
@@ -5,19 +5,25 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Framework/App.hpp"
 
+#include <cstdio>
+
 #include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Platform/Window.hpp"
+#include "Game/Framework/Benchmark.hpp"
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/WorkerPool.hpp"
 #include "Game/Subsystem/Light/LightSubsystem.hpp"
 
 //----------------------------------------------------------------------------------------------------
@@ -29,20 +35,31 @@ Renderer*              g_theRenderer       = nullptr;       // Created and owned
 RandomNumberGenerator* g_theRNG            = nullptr;       // Created and owned by the App
 Window*                g_theWindow         = nullptr;       // Created and owned by the App
 LightSubsystem*        g_theLightSubsystem = nullptr;       // Created and owned by the App
+WorkerPool*            g_theWorkerPool     = nullptr;       // Created and owned by the App
 
 //----------------------------------------------------------------------------------------------------
 STATIC bool App::m_isQuitting = false;
 
 //----------------------------------------------------------------------------------------------------
-void App::Startup()
+void App::Startup(char const* commandLine)
 {
     LoadGameConfig("Data/GameConfig.xml");
+    ParseCommandLine(commandLine);
+
+    m_isHeadless = g_gameConfigBlackboard.GetValue("headless", m_isHeadless);
+
+    if (m_isHeadless)
+    {
+        StartupHeadless();
+        return;
+    }
 
     // Create All Engine Subsystems
     sEventSystemConfig eventSystemConfig;
     g_theEventSystem = new EventSystem(eventSystemConfig);
     g_theEventSystem->SubscribeEventCallbackFunction("OnCloseButtonClicked", OnCloseButtonClicked);
     g_theEventSystem->SubscribeEventCallbackFunction("quit", OnCloseButtonClicked);
+    Benchmark::RegisterCommands();
 
     sInputSystemConfig inputConfig;
     g_theInput = new InputSystem(inputConfig);
@@ -110,6 +127,7 @@ void App::Startup()
 
     g_theBitmapFont = g_theRenderer->CreateOrGetBitmapFontFromFile("Data/Fonts/SquirrelFixedFont"); // DO NOT SPECIFY FILE .EXTENSION!!  (Important later on.)
     g_theRNG        = new RandomNumberGenerator();
+    g_theWorkerPool = new WorkerPool(GetWorkerThreadCount());
     g_theGame       = new Game();
 }
 
@@ -118,10 +136,19 @@ void App::Startup()
 //
 void App::Shutdown()
 {
+    if (m_isHeadless)
+    {
+        ShutdownHeadless();
+        return;
+    }
+
     // Destroy all Engine Subsystem
     delete g_theGame;
     g_theGame = nullptr;
 
+    delete g_theWorkerPool;
+    g_theWorkerPool = nullptr;
+
     delete g_theRNG;
     g_theRNG = nullptr;
 
@@ -168,6 +195,12 @@ void App::RunFrame()
 //----------------------------------------------------------------------------------------------------
 void App::RunMainLoop()
 {
+    if (m_isHeadless)
+    {
+        RunHeadlessLoop();
+        return;
+    }
+
     // Program main loop; keep running frames until it's time to quit
     while (!m_isQuitting)
     {
@@ -284,6 +317,14 @@ void App::LoadGameConfig(char const* gameConfigXmlFilePath)
         if (XmlElement const* rootElement = gameConfigXml.RootElement())
         {
             g_gameConfigBlackboard.PopulateFromXmlElementAttributes(*rootElement);
+
+            // Most settings are child elements, e.g. <Map.DefaultMap>TestMap</Map.DefaultMap>.
+            for (XmlElement const* element = rootElement->FirstChildElement(); element != nullptr; element = element->NextSiblingElement())
+            {
+                if (element->GetText() == nullptr) continue;
+
+                g_gameConfigBlackboard.SetValue(element->Name(), element->GetText());
+            }
         }
         else
         {
@@ -295,3 +336,113 @@ void App::LoadGameConfig(char const* gameConfigXmlFilePath)
         DebuggerPrintf("WARNING: failed to load game config from file \"%s\"\n", gameConfigXmlFilePath);
     }
 }
+
+//----------------------------------------------------------------------------------------------------
+// Command line tokens are either "-flag" or "key=value" and override values from GameConfig.xml,
+// e.g. "-headless Map.DefaultMap=MPMap Headless.TickCount=100000".
+void App::ParseCommandLine(char const* commandLine)
+{
+    if (commandLine == nullptr) return;
+
+    StringList const tokens = SplitStringOnDelimiter(commandLine, ' ');
+
+    for (String const& token : tokens)
+    {
+        if (token.empty()) continue;
+
+        if (token[0] == '-')
+        {
+            g_gameConfigBlackboard.SetValue(token.substr(1), "true");
+            continue;
+        }
+
+        StringList const keyValue = SplitStringOnDelimiter(token, '=');
+
+        if (keyValue.size() == 2)
+        {
+            g_gameConfigBlackboard.SetValue(keyValue[0], keyValue[1]);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// "Game.WorkerThreadCount" threads besides the main one, or one per remaining hardware thread when it is negative.
+STATIC int App::GetWorkerThreadCount()
+{
+    int const workerThreadCount = g_gameConfigBlackboard.GetValue("Game.WorkerThreadCount", -1);
+
+    return workerThreadCount < 0 ? WorkerPool::GetDefaultWorkerThreadCount() : workerThreadCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Only the subsystems the simulation needs are created. g_theWindow, g_theRenderer, g_theInput and g_theAudio stay null,
+// so anything on the simulation path has to treat a null renderer or audio system as "do nothing".
+void App::StartupHeadless()
+{
+    sEventSystemConfig eventSystemConfig;
+    g_theEventSystem = new EventSystem(eventSystemConfig);
+    g_theEventSystem->SubscribeEventCallbackFunction("quit", OnCloseButtonClicked);
+    Benchmark::RegisterCommands();
+    g_theEventSystem->Startup();
+
+    g_theRNG        = new RandomNumberGenerator();
+    g_theWorkerPool = new WorkerPool(GetWorkerThreadCount());
+    g_theGame       = new Game();
+}
+
+//----------------------------------------------------------------------------------------------------
+void App::ShutdownHeadless()
+{
+    delete g_theGame;
+    g_theGame = nullptr;
+
+    delete g_theWorkerPool;
+    g_theWorkerPool = nullptr;
+
+    delete g_theRNG;
+    g_theRNG = nullptr;
+
+    g_theEventSystem->Shutdown();
+
+    delete g_theEventSystem;
+    g_theEventSystem = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs "Headless.Command" if there is one, then runs the current map for a fixed number of ticks as fast as possible
+// and reports the throughput.
+void App::RunHeadlessLoop() const
+{
+    int const   tickCount    = g_gameConfigBlackboard.GetValue("Headless.TickCount", 3600);
+    float const deltaSeconds = g_gameConfigBlackboard.GetValue("Headless.DeltaSeconds", g_theGame->GetFixedDeltaSeconds());
+
+    g_theGame->StartHeadless();
+
+    // A headless command (usually a benchmark) gets every game config and command line value as its arguments.
+    String const command = g_gameConfigBlackboard.GetValue("Headless.Command", "");
+
+    if (!command.empty())
+    {
+        EventArgs args = g_gameConfigBlackboard;
+        g_theEventSystem->FireEvent(command, args);
+    }
+
+    double const startSeconds = GetCurrentTimeSeconds();
+    int          tickIndex    = 0;
+
+    while (tickIndex < tickCount && !m_isQuitting)
+    {
+        Clock::TickSystemClock();
+        g_theGame->UpdateHeadless(deltaSeconds);
+        ++tickIndex;
+    }
+
+    double const elapsedSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+    String const summary = Stringf("Headless: %d ticks in %.3f seconds (%.1f ticks/s)", tickIndex, elapsedSeconds, static_cast<double>(tickIndex) / elapsedSeconds);
+
+    // Also to stdout, for batch and CI runs without a debugger attached.
+    DebuggerPrintf("%s\n", summary.c_str());
+    printf("%s\n", summary.c_str());
+    fflush(stdout);
+}
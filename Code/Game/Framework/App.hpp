@@ -15,7 +15,7 @@ class App
 public:
     App()  = default;
     ~App() = default;
-    void Startup();
+    void Startup(char const* commandLine);
     void Shutdown();
     void RunFrame();
 
@@ -34,6 +34,15 @@ private:
     void UpdateCursorMode();
     void DeleteAndCreateNewGame();
     void LoadGameConfig(char const* gameConfigXmlFilePath);
+    void ParseCommandLine(char const* commandLine);
+
+    static int GetWorkerThreadCount();
+
+    // Headless
+    void StartupHeadless();
+    void ShutdownHeadless();
+    void RunHeadlessLoop() const;
 
     Camera* m_devConsoleCamera = nullptr;
+    bool    m_isHeadless       = false;     // No window, renderer, input or audio; the game is driven by a fixed tick loop.
 };
@@ -0,0 +1,257 @@
+//----------------------------------------------------------------------------------------------------
+// Benchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/Benchmark.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+#include "Game/Definition/MapDefinition.hpp"
+#include "Game/Definition/TileDefinition.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Gameplay/Actor.hpp"
+#include "Game/Gameplay/Game.hpp"
+#include "Game/Gameplay/Map.hpp"
+#include "Game/Gameplay/Tile.hpp"
+
+//----------------------------------------------------------------------------------------------------
+STATIC void Benchmark::RegisterCommands()
+{
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchCollision", OnBenchCollision);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchRaycast", OnBenchRaycast);
+    g_theEventSystem->SubscribeEventCallbackFunction("SoakActors", OnSoakActors);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchMapGeometry", OnBenchMapGeometry);
+    g_theEventSystem->SubscribeEventCallbackFunction("TestChunkCulling", OnTestChunkCulling);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchMapLoad", OnBenchMapLoad);
+    g_theEventSystem->SubscribeEventCallbackFunction("TestParallelUpdate", OnTestParallelUpdate);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchProjectiles", OnBenchProjectiles);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchParticles", OnBenchParticles);
+    g_theEventSystem->SubscribeEventCallbackFunction("TestSpriteBatch", OnTestSpriteBatch);
+    g_theEventSystem->SubscribeEventCallbackFunction("TestAnimationLookup", OnTestAnimationLookup);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchNameLookup", OnBenchNameLookup);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchPerception", OnBenchPerception);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchFlowField", OnBenchFlowField);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchPathfinding", OnBenchPathfinding);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchAIScheduler", OnBenchAIScheduler);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchRaycastBatch", OnBenchRaycastBatch);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchSpatialQueries", OnBenchSpatialQueries);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchActorQueries", OnBenchActorQueries);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchActorIndex", OnBenchActorIndex);
+    g_theEventSystem->SubscribeEventCallbackFunction("BenchPhysics", OnBenchPhysics);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC Map* Benchmark::GetCurrentMap()
+{
+    if (g_theGame == nullptr || g_theGame->m_currentMap == nullptr)
+    {
+        Print("Benchmark: no map is loaded, start a game first.");
+        return nullptr;
+    }
+
+    return g_theGame->m_currentMap;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC std::vector<int> Benchmark::GetCounts(EventArgs const& args,
+                                             String const&    defaultCounts)
+{
+    StringList const countStrings = SplitStringOnDelimiter(args.GetValue("counts", defaultCounts), ',');
+    std::vector<int> counts;
+
+    for (String const& countString : countStrings)
+    {
+        int const count = atoi(countString.c_str());
+
+        if (count > 0) counts.push_back(count);
+    }
+
+    return counts;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC IntVec2 Benchmark::GetRandomOpenTileCoords(Map const& map)
+{
+    IntVec2 const dimensions = map.GetDimensions();
+    IntVec2       tileCoords;
+
+    do
+    {
+        tileCoords = IntVec2(g_theRNG->RollRandomIntInRange(0, dimensions.x - 1), g_theRNG->RollRandomIntInRange(0, dimensions.y - 1));
+    }
+    while (map.IsTileSolid(tileCoords));
+
+    return tileCoords;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Places actors at random positions inside random non-solid tiles.
+STATIC void Benchmark::SpawnActors(Map&                      map,
+                                   String const&             actorName,
+                                   int const                 count,
+                                   std::vector<ActorHandle>& out_handles)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        IntVec2 const tileCoords = GetRandomOpenTileCoords(map);
+
+        SpawnInfo spawnInfo;
+        spawnInfo.m_name        = actorName;
+        spawnInfo.m_position    = Vec3(static_cast<float>(tileCoords.x) + g_theRNG->RollRandomFloatInRange(0.1f, 0.9f),
+                                       static_cast<float>(tileCoords.y) + g_theRNG->RollRandomFloatInRange(0.1f, 0.9f),
+                                       0.f);
+        spawnInfo.m_orientation = EulerAngles(g_theRNG->RollRandomFloatInRange(0.f, 360.f), 0.f, 0.f);
+
+        Actor const* actor = map.SpawnActor(spawnInfo);
+
+        if (actor == nullptr)
+        {
+            Print(Stringf("Benchmark: ran out of actor handles after %d %s actors.", i, actorName.c_str()));
+            return;
+        }
+
+        out_handles.push_back(actor->m_handle);
+    }
+
+    map.RebuildActorQueryGrid();
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void Benchmark::DestroyActors(Map&                            map,
+                                     std::vector<ActorHandle> const& handles)
+{
+    for (ActorHandle const& handle : handles)
+    {
+        if (Actor* actor = map.GetActorByHandle(handle))
+        {
+            actor->m_isGarbage = true;
+        }
+    }
+
+    map.DeleteDestroyedActor();
+    map.RebuildActorQueryGrid();
+}
+
+//----------------------------------------------------------------------------------------------------
+// A walled-in floor of the first open tile definition, with patches of the other open definitions
+// and straight wall segments of random solid definitions, roughly what a hand-made map looks like.
+STATIC void Benchmark::GenerateTiles(IntVec2 const&     dimensions,
+                                     std::vector<Tile>& out_tiles)
+{
+    std::vector<uint8_t> openDefIndexes;
+    std::vector<uint8_t> solidDefIndexes;
+
+    for (int tileDefIndex = 0; tileDefIndex < static_cast<int>(TileDefinition::s_tileDefinitions.size()); ++tileDefIndex)
+    {
+        std::vector<uint8_t>& defIndexes = TileDefinition::s_tileDefinitions[tileDefIndex]->m_isSolid ? solidDefIndexes : openDefIndexes;
+        defIndexes.push_back(static_cast<uint8_t>(tileDefIndex));
+    }
+
+    out_tiles.assign(static_cast<size_t>(dimensions.x * dimensions.y), Tile());
+
+    if (openDefIndexes.empty() || solidDefIndexes.empty()) return;
+
+    auto const SetTile = [&](int const x, int const y, uint8_t const tileDefIndex)
+    {
+        if (x < 0 || y < 0 || x >= dimensions.x || y >= dimensions.y) return;
+
+        out_tiles[x + y * dimensions.x].m_tileDefIndex = tileDefIndex;
+    };
+
+    for (int y = 0; y < dimensions.y; ++y)
+    {
+        for (int x = 0; x < dimensions.x; ++x)
+        {
+            bool const isBorder = x == 0 || y == 0 || x == dimensions.x - 1 || y == dimensions.y - 1;
+            SetTile(x, y, isBorder ? solidDefIndexes[0] : openDefIndexes[0]);
+        }
+    }
+
+    int const featureCount = dimensions.x * dimensions.y / 64;
+
+    for (int i = 0; i < featureCount; ++i)
+    {
+        int const x = g_theRNG->RollRandomIntInRange(1, dimensions.x - 2);
+        int const y = g_theRNG->RollRandomIntInRange(1, dimensions.y - 2);
+
+        uint8_t const openDefIndex = openDefIndexes[g_theRNG->RollRandomIntInRange(0, static_cast<int>(openDefIndexes.size()) - 1)];
+        int const     patchWidth   = g_theRNG->RollRandomIntInRange(2, 8);
+        int const     patchHeight  = g_theRNG->RollRandomIntInRange(2, 8);
+
+        for (int patchY = y; patchY < std::min(y + patchHeight, dimensions.y - 1); ++patchY)
+        {
+            for (int patchX = x; patchX < std::min(x + patchWidth, dimensions.x - 1); ++patchX)
+            {
+                SetTile(patchX, patchY, openDefIndex);
+            }
+        }
+
+        uint8_t const solidDefIndex = solidDefIndexes[g_theRNG->RollRandomIntInRange(0, static_cast<int>(solidDefIndexes.size()) - 1)];
+        int const     wallLength    = g_theRNG->RollRandomIntInRange(2, 12);
+        bool const    isHorizontal  = g_theRNG->RollRandomIntInRange(0, 1) == 0;
+
+        for (int step = 0; step < wallLength; ++step)
+        {
+            SetTile(isHorizontal ? x + step : x, isHorizontal ? y : y + step, solidDefIndex);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC double Benchmark::GetSecondsSince(double const startSeconds)
+{
+    return GetCurrentTimeSeconds() - startSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC double Benchmark::GetMillisecondsSince(double const startSeconds)
+{
+    return (GetCurrentTimeSeconds() - startSeconds) * 1000.0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// How many times cheaper cost is than baselineCost, or 0 when cost is too small to measure.
+STATIC double Benchmark::GetSpeedup(double const baselineCost,
+                                    double const cost)
+{
+    return cost > 0.0 ? baselineCost / cost : 0.0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Two casts of the same ray agree when both miss, or both hit within a millimeter of each other.
+STATIC bool Benchmark::IsSameImpact(RaycastResult3D const& resultA,
+                                    RaycastResult3D const& resultB)
+{
+    if (resultA.m_didImpact != resultB.m_didImpact) return false;
+
+    return !resultA.m_didImpact || fabsf(resultA.m_impactLength - resultB.m_impactLength) <= 0.001f;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC char const* Benchmark::GetPassText(bool const isPassed)
+{
+    return isPassed ? "PASSED" : "FAILED";
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void Benchmark::Print(String const& line)
+{
+    if (g_theDevConsole != nullptr)
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, line);
+    }
+
+    // Also to stdout, so a headless run shows its results without a debugger attached.
+    DebuggerPrintf("%s\n", line.c_str());
+    printf("%s\n", line.c_str());
+    fflush(stdout);
+}
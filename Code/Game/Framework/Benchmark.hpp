@@ -0,0 +1,86 @@
+//----------------------------------------------------------------------------------------------------
+// Benchmark.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Game/Framework/ActorHandle.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Map;
+struct MapDefinition;
+struct RaycastResult3D;
+struct Tile;
+
+//----------------------------------------------------------------------------------------------------
+// Performance benchmarks, exposed as dev console commands that mostly run against the current map.
+// They can also be run from the command line, e.g. "-headless Headless.Command=BenchCollision counts=100,1000,10000",
+// in which case every command line key is passed to the command as an argument.
+// Each subsystem's commands live in their own BenchmarkXXX.cpp; Benchmark.cpp registers them and holds the shared helpers.
+class Benchmark
+{
+public:
+    static void RegisterCommands();
+
+    // BenchmarkActors.cpp
+    static bool OnSoakActors(EventArgs& args);
+    static bool OnTestParallelUpdate(EventArgs& args);
+    static bool OnBenchProjectiles(EventArgs& args);
+    static bool OnBenchNameLookup(EventArgs& args);
+    static bool OnBenchActorIndex(EventArgs& args);
+    static bool OnBenchPhysics(EventArgs& args);
+
+    // BenchmarkAI.cpp
+    static bool OnBenchPerception(EventArgs& args);
+    static bool OnBenchFlowField(EventArgs& args);
+    static bool OnBenchPathfinding(EventArgs& args);
+    static bool OnBenchAIScheduler(EventArgs& args);
+
+    // BenchmarkMap.cpp
+    static bool OnBenchMapGeometry(EventArgs& args);
+    static bool OnTestChunkCulling(EventArgs& args);
+    static bool OnBenchMapLoad(EventArgs& args);
+
+    // BenchmarkQueries.cpp
+    static bool OnBenchCollision(EventArgs& args);
+    static bool OnBenchRaycast(EventArgs& args);
+    static bool OnBenchRaycastBatch(EventArgs& args);
+    static bool OnBenchSpatialQueries(EventArgs& args);
+    static bool OnBenchActorQueries(EventArgs& args);
+
+    // BenchmarkRendering.cpp
+    static bool OnBenchParticles(EventArgs& args);
+    static bool OnTestSpriteBatch(EventArgs& args);
+    static bool OnTestAnimationLookup(EventArgs& args);
+
+private:
+    // Setup, shared by every subsystem.
+    static Map*             GetCurrentMap();
+    static std::vector<int> GetCounts(EventArgs const& args, String const& defaultCounts);
+    static IntVec2          GetRandomOpenTileCoords(Map const& map);
+    static void             SpawnActors(Map& map, String const& actorName, int count, std::vector<ActorHandle>& out_handles);
+    static void             DestroyActors(Map& map, std::vector<ActorHandle> const& handles);
+    static void             GenerateTiles(IntVec2 const& dimensions, std::vector<Tile>& out_tiles);
+
+    // Timing, comparison and report, shared by every subsystem.
+    static double      GetSecondsSince(double startSeconds);
+    static double      GetMillisecondsSince(double startSeconds);
+    static double      GetSpeedup(double baselineCost, double cost);
+    static bool        IsSameImpact(RaycastResult3D const& resultA, RaycastResult3D const& resultB);
+    static char const* GetPassText(bool isPassed);
+    static void        Print(String const& line);
+
+    // BenchmarkActors.cpp
+    static uint64_t GetActorStateHash(Map const& map);
+
+    // BenchmarkMap.cpp
+    static void   PrintMapGeometryCounts(String const& mapName, IntVec2 const& dimensions, std::vector<Tile> const& tiles, IntVec2 const& spriteSheetCellCount);
+    static void   GetMapDefTiles(MapDefinition const& mapDef, std::vector<Tile>& out_tiles);
+    static double TimeMapBuild(IntVec2 const& dimensions, Tile const* tiles, IntVec2 const& spriteSheetCellCount);
+};
@@ -0,0 +1,594 @@
+//----------------------------------------------------------------------------------------------------
+// BenchmarkAI.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/Benchmark.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Definition/MapDefinition.hpp"
+#include "Game/Definition/TileDefinition.hpp"
+#include "Game/Framework/Controller.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/PlayerController.hpp"
+#include "Game/Gameplay/AIPerception.hpp"
+#include "Game/Gameplay/AIScheduler.hpp"
+#include "Game/Gameplay/FlowFieldSystem.hpp"
+#include "Game/Gameplay/Game.hpp"
+#include "Game/Gameplay/HierarchicalPathfinder.hpp"
+#include "Game/Gameplay/Map.hpp"
+#include "Game/Gameplay/Tile.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Plain A* over every tile with HierarchicalPathfinder's step rules, kept as the baseline. Returns the path cost
+// in step cost units, or UINT32_MAX when the goal cannot be reached.
+static uint32_t FindFlatPathCost(IntVec2 const&         dimensions,
+                                 uint64_t const*        solidTileBits,
+                                 int const              solidTileBitsWidth,
+                                 IntVec2 const&         startTileCoords,
+                                 IntVec2 const&         goalTileCoords,
+                                 std::vector<uint32_t>& scratchCosts,
+                                 std::vector<uint64_t>& scratchOpenList)
+{
+    auto const GetHeuristic = [&goalTileCoords](int const x, int const y)
+    {
+        uint32_t const deltaX = static_cast<uint32_t>(abs(x - goalTileCoords.x));
+        uint32_t const deltaY = static_cast<uint32_t>(abs(y - goalTileCoords.y));
+
+        return FlowFieldSystem::STRAIGHT_STEP_COST * std::max(deltaX, deltaY) + (FlowFieldSystem::DIAGONAL_STEP_COST - FlowFieldSystem::STRAIGHT_STEP_COST) * std::min(deltaX, deltaY);
+    };
+
+    scratchCosts.assign(static_cast<size_t>(dimensions.x * dimensions.y), UINT32_MAX);
+    scratchOpenList.clear();
+
+    int const startIndex     = startTileCoords.x + startTileCoords.y * dimensions.x;
+    int const goalIndex      = goalTileCoords.x + goalTileCoords.y * dimensions.x;
+    scratchCosts[startIndex] = 0;
+    scratchOpenList.push_back((static_cast<uint64_t>(GetHeuristic(startTileCoords.x, startTileCoords.y)) << 32) | static_cast<uint32_t>(startIndex));
+
+    while (!scratchOpenList.empty())
+    {
+        std::pop_heap(scratchOpenList.begin(), scratchOpenList.end(), std::greater<uint64_t>());
+        uint64_t const entry = scratchOpenList.back();
+        scratchOpenList.pop_back();
+
+        int const tileIndex = static_cast<int>(entry & 0xffffffffu);
+
+        if (tileIndex == goalIndex) return scratchCosts[goalIndex];
+
+        int const      x    = tileIndex % dimensions.x;
+        int const      y    = tileIndex / dimensions.x;
+        uint32_t const cost = scratchCosts[tileIndex];
+
+        if (static_cast<uint32_t>(entry >> 32) - GetHeuristic(x, y) > cost) continue;
+
+        for (int direction = 0; direction < FlowFieldSystem::DIRECTION_COUNT; ++direction)
+        {
+            if (!FlowFieldSystem::CanStep(dimensions, solidTileBits, solidTileBitsWidth, x, y, direction)) continue;
+
+            IntVec2 const  offset         = FlowFieldSystem::GetDirectionOffset(direction);
+            int const      neighbourIndex = (x + offset.x) + (y + offset.y) * dimensions.x;
+            uint32_t const neighbourCost  = cost + FlowFieldSystem::GetStepCost(direction);
+
+            if (neighbourCost >= scratchCosts[neighbourIndex]) continue;
+
+            scratchCosts[neighbourIndex] = neighbourCost;
+            scratchOpenList.push_back((static_cast<uint64_t>(neighbourCost + GetHeuristic(x + offset.x, y + offset.y)) << 32) | static_cast<uint32_t>(neighbourIndex));
+            std::push_heap(scratchOpenList.begin(), scratchOpenList.end(), std::greater<uint64_t>());
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Stands in for a player in the map copies: AIScheduler counts any actor possessed by a controller other than its AI as one.
+class BenchObserverController final : public Controller
+{
+public:
+    explicit BenchObserverController(Map* map)
+        : Controller(map)
+    {
+    }
+
+    void Update(float const deltaSeconds) override
+    {
+        UNUSED(deltaSeconds)
+    }
+};
+
+//----------------------------------------------------------------------------------------------------
+// BenchPerception count=1000 ticks=300 agentsPerTick=64 seed=1
+// Simulates the same crowd twice on copies of the current map: every AI perceiving every tick without the line of sight
+// cache, as before AIPerception, then with agentsPerTick AIs refreshed per tick and the cache on.
+STATIC bool Benchmark::OnBenchPerception(EventArgs& args)
+{
+    Map const* currentMap = GetCurrentMap();
+
+    if (currentMap == nullptr) return false;
+
+    int const              aiCount       = args.GetValue("count", 1000);
+    int const              tickCount     = args.GetValue("ticks", 300);
+    int const              agentsPerTick = args.GetValue("agentsPerTick", g_gameConfigBlackboard.GetValue("Game.AIPerceptionAgentsPerTick", 64));
+    unsigned int const     seed          = static_cast<unsigned int>(args.GetValue("seed", 1));
+    float constexpr        deltaSeconds  = 1.f / 60.f;
+    MapDefinition const*   mapDef        = currentMap->GetMapDefinition();
+    RandomNumberGenerator* gameRNG       = g_theRNG;
+
+    // Map's constructor spawns and possesses a marine for every local player, which must not happen to the copies.
+    std::vector<PlayerController*> localPlayerControllers;
+    localPlayerControllers.swap(g_theGame->m_localPlayerControllerList);
+
+    for (int runIndex = 0; runIndex < 2; ++runIndex)
+    {
+        bool const isBudgeted = runIndex == 1;
+
+        srand(seed);
+        g_theRNG = new RandomNumberGenerator();
+
+        Map*                     map = new Map(g_theGame, *mapDef);
+        std::vector<ActorHandle> handles;
+        SpawnActors(*map, "Demon", aiCount - aiCount / 8, handles);
+        SpawnActors(*map, "Marine", aiCount / 8, handles);
+        map->GetAIScheduler().SetEnabled(false);
+
+        AIPerception& perception = map->GetAIPerception();
+        perception.SetAgentsPerTick(isBudgeted ? agentsPerTick : 0);
+        perception.SetLineOfSightCacheEnabled(isBudgeted);
+        perception.ResetTotals();
+
+        int          maxRaycastsPerTick = 0;
+        double const startSeconds       = GetCurrentTimeSeconds();
+
+        for (int tick = 0; tick < tickCount; ++tick)
+        {
+            map->UpdateAllActors(deltaSeconds);
+            map->DeleteDestroyedActor();
+            map->RebuildActorQueryGrid();
+            map->CollideActors();
+            map->CollideActorsWithMap();
+            map->RefreshActorQueryGrid();
+
+            maxRaycastsPerTick = std::max(maxRaycastsPerTick, perception.GetRaycastCount());
+        }
+
+        double const   milliseconds     = GetMillisecondsSince(startSeconds) / std::max(tickCount, 1);
+        double const   simulatedSeconds = static_cast<double>(tickCount) * deltaSeconds;
+        uint64_t const lookupCount      = perception.GetTotalRaycastCount() + perception.GetTotalCacheHitCount();
+
+        Print(Stringf("BenchPerception %d AI, %s: %.0f raycasts per second (at most %d in a tick), %.1f%% of line of sight checks cached, %.3f ms per tick",
+                      aiCount, isBudgeted ? Stringf("%d agents per tick with cache", agentsPerTick).c_str() : "every agent every tick",
+                      static_cast<double>(perception.GetTotalRaycastCount()) / std::max(simulatedSeconds, 0.001),
+                      maxRaycastsPerTick,
+                      lookupCount > 0 ? 100.0 * static_cast<double>(perception.GetTotalCacheHitCount()) / static_cast<double>(lookupCount) : 0.0,
+                      milliseconds));
+
+        delete map;
+        GAME_SAFE_RELEASE(g_theRNG);
+    }
+
+    g_theGame->m_localPlayerControllerList.swap(localPlayerControllers);
+    g_theRNG = gameRNG;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchFlowField agents=2000 size=256 targets=1 ticks=600 speed=4
+// On a generated size x size map, targets wander at speed tiles per second and agents chase them, each agent reading
+// the direction to its next tile from its target's shared field every tick. Prints the main thread cost per tick,
+// which includes any wait for the background thread, the cost of one field recompute on that thread,
+// and how many agents reached their target.
+STATIC bool Benchmark::OnBenchFlowField(EventArgs& args)
+{
+    if (TileDefinition::s_tileDefinitions.empty()) return false;
+
+    int const       agentCount   = std::max(args.GetValue("agents", 2000), 1);
+    int const       size         = std::max(args.GetValue("size", 256), 8);
+    int const       targetCount  = std::clamp(args.GetValue("targets", 1), 1, FlowFieldSystem::MAX_FIELDS);
+    int const       tickCount    = std::max(args.GetValue("ticks", 600), 1);
+    float const     speed        = args.GetValue("speed", 4.f);
+    float constexpr deltaSeconds = 1.f / 60.f;
+    IntVec2 const   dimensions   = IntVec2(size, size);
+
+    std::vector<Tile> tiles;
+    GenerateTiles(dimensions, tiles);
+
+    std::vector<uint64_t> solidTileBits;
+    Tile::CreateSolidTileBits(dimensions, tiles.data(), solidTileBits);
+
+    auto const IsOpen = [&tiles, &dimensions](Vec2 const& position)
+    {
+        int const x = RoundDownToInt(position.x);
+        int const y = RoundDownToInt(position.y);
+
+        return x >= 0 && y >= 0 && x < dimensions.x && y < dimensions.y && !tiles[x + y * dimensions.x].IsSolid();
+    };
+
+    auto const GetRandomOpenPosition = [&IsOpen, &dimensions]()
+    {
+        Vec2 position;
+
+        do
+        {
+            position = Vec2(g_theRNG->RollRandomFloatInRange(0.f, static_cast<float>(dimensions.x)),
+                            g_theRNG->RollRandomFloatInRange(0.f, static_cast<float>(dimensions.y)));
+        }
+        while (!IsOpen(position));
+
+        return position;
+    };
+
+    auto const GetRandomHeading = []()
+    {
+        float const degrees = g_theRNG->RollRandomFloatInRange(0.f, 360.f);
+
+        return Vec2(CosDegrees(degrees), SinDegrees(degrees));
+    };
+
+    std::vector<ActorHandle> targetHandles;
+    std::vector<Vec2>        targetPositions;
+    std::vector<Vec2>        targetHeadings;
+
+    for (int targetIndex = 0; targetIndex < targetCount; ++targetIndex)
+    {
+        targetHandles.emplace_back(1u, static_cast<unsigned int>(targetIndex));
+        targetPositions.push_back(GetRandomOpenPosition());
+        targetHeadings.push_back(GetRandomHeading());
+    }
+
+    std::vector<Vec2> agentPositions(static_cast<size_t>(agentCount));
+
+    for (Vec2& agentPosition : agentPositions)
+    {
+        agentPosition = GetRandomOpenPosition();
+    }
+
+    FlowFieldSystem flowFieldSystem;
+    flowFieldSystem.Initialize(dimensions, solidTileBits.data(), Tile::GetSolidTileBitsWidth(dimensions));
+
+    int    steeredCount = 0;
+    double mainSeconds  = 0.0;
+    double worstSeconds = 0.0;
+
+    for (int tick = 0; tick < tickCount; ++tick)
+    {
+        // Targets bounce off walls in a new random direction.
+        for (int targetIndex = 0; targetIndex < targetCount; ++targetIndex)
+        {
+            Vec2 const nextPosition = targetPositions[targetIndex] + targetHeadings[targetIndex] * speed * deltaSeconds;
+
+            if (IsOpen(nextPosition))
+            {
+                targetPositions[targetIndex] = nextPosition;
+            }
+            else
+            {
+                targetHeadings[targetIndex] = GetRandomHeading();
+            }
+        }
+
+        double const startSeconds = GetCurrentTimeSeconds();
+
+        flowFieldSystem.BeginTick();
+
+        for (int targetIndex = 0; targetIndex < targetCount; ++targetIndex)
+        {
+            Vec2 const& targetPosition = targetPositions[targetIndex];
+            flowFieldSystem.RequestField(targetHandles[targetIndex], IntVec2(RoundDownToInt(targetPosition.x), RoundDownToInt(targetPosition.y)));
+        }
+
+        for (int agentIndex = 0; agentIndex < agentCount; ++agentIndex)
+        {
+            int const targetIndex = agentIndex % targetCount;
+            Vec2&     position    = agentPositions[agentIndex];
+            Vec2      direction   = (targetPositions[targetIndex] - position).GetNormalized();
+            Vec2      flowDirection;
+
+            if (flowFieldSystem.GetDirection(targetHandles[targetIndex], Vec3(position.x, position.y, 0.f), flowDirection))
+            {
+                direction = flowDirection;
+                ++steeredCount;
+            }
+
+            Vec2 const nextPosition = position + direction * speed * deltaSeconds;
+
+            if (IsOpen(nextPosition))
+            {
+                position = nextPosition;
+            }
+        }
+
+        double const seconds = GetSecondsSince(startSeconds);
+        mainSeconds += seconds;
+        worstSeconds = std::max(worstSeconds, seconds);
+    }
+
+    flowFieldSystem.BeginTick();
+
+    int reachedCount = 0;
+
+    for (int agentIndex = 0; agentIndex < agentCount; ++agentIndex)
+    {
+        if (GetDistanceSquared2D(agentPositions[agentIndex], targetPositions[agentIndex % targetCount]) < 2.f * 2.f) ++reachedCount;
+    }
+
+    int const computedFieldCount = flowFieldSystem.GetComputedFieldCount();
+
+    Print(Stringf("BenchFlowField %d agents, %d targets, %dx%d, %d ticks: main thread %.3f ms per tick (worst %.3f ms), %d fields computed off it at %.3f ms each, %.1f%% of reads steered, %d agents within 2 tiles of their target",
+                  agentCount, targetCount, size, size, tickCount,
+                  mainSeconds * 1000.0 / tickCount, worstSeconds * 1000.0,
+                  computedFieldCount, computedFieldCount > 0 ? flowFieldSystem.GetComputeMilliseconds() / computedFieldCount : 0.0,
+                  100.0 * steeredCount / (static_cast<double>(agentCount) * tickCount),
+                  reachedCount));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchPathfinding size=512 paths=200 budget=1 edits=20
+// On a generated size x size map: how long the cluster graph takes to build, then paths between random open tiles
+// solved by HierarchicalPathfinder against flat A* over every tile, with how much longer the hierarchical ones are.
+// Walls are then toggled to time the local rebuild, and the same paths go through the request queue at budget
+// milliseconds per tick to count the ticks it takes and the worst tick.
+STATIC bool Benchmark::OnBenchPathfinding(EventArgs& args)
+{
+    if (TileDefinition::s_tileDefinitions.empty()) return false;
+
+    int const     size       = std::max(args.GetValue("size", 512), 16);
+    int const     pathCount  = std::max(args.GetValue("paths", 200), 1);
+    float const   budget     = args.GetValue("budget", 1.f);
+    int const     editCount  = std::max(args.GetValue("edits", 20), 1);
+    IntVec2 const dimensions = IntVec2(size, size);
+
+    std::vector<Tile> tiles;
+    GenerateTiles(dimensions, tiles);
+
+    std::vector<uint64_t> solidTileBits;
+    Tile::CreateSolidTileBits(dimensions, tiles.data(), solidTileBits);
+
+    int const solidTileBitsWidth = Tile::GetSolidTileBitsWidth(dimensions);
+
+    auto const GetRandomOpenTileCoords = [&tiles, &dimensions]()
+    {
+        IntVec2 tileCoords;
+
+        do
+        {
+            tileCoords = IntVec2(g_theRNG->RollRandomIntInRange(0, dimensions.x - 1), g_theRNG->RollRandomIntInRange(0, dimensions.y - 1));
+        }
+        while (tiles[tileCoords.x + tileCoords.y * dimensions.x].IsSolid());
+
+        return tileCoords;
+    };
+
+    HierarchicalPathfinder pathfinder(budget);
+    double const           buildStartSeconds = GetCurrentTimeSeconds();
+
+    pathfinder.Initialize(dimensions, solidTileBits.data(), solidTileBitsWidth);
+
+    double const buildMilliseconds = GetMillisecondsSince(buildStartSeconds);
+
+    std::vector<IntVec2> starts;
+    std::vector<IntVec2> goals;
+
+    for (int pathIndex = 0; pathIndex < pathCount; ++pathIndex)
+    {
+        starts.push_back(GetRandomOpenTileCoords());
+        goals.push_back(GetRandomOpenTileCoords());
+    }
+
+    auto const GetCenter = [](IntVec2 const& tileCoords)
+    {
+        return Vec2(static_cast<float>(tileCoords.x) + 0.5f, static_cast<float>(tileCoords.y) + 0.5f);
+    };
+
+    // Flat A*.
+    std::vector<uint32_t> flatCosts(static_cast<size_t>(pathCount));
+    std::vector<uint32_t> scratchCosts;
+    std::vector<uint64_t> scratchOpenList;
+    double const          flatStartSeconds = GetCurrentTimeSeconds();
+
+    for (int pathIndex = 0; pathIndex < pathCount; ++pathIndex)
+    {
+        flatCosts[pathIndex] = FindFlatPathCost(dimensions, solidTileBits.data(), solidTileBitsWidth, starts[pathIndex], goals[pathIndex], scratchCosts, scratchOpenList);
+    }
+
+    double const flatMilliseconds = GetMillisecondsSince(flatStartSeconds) / pathCount;
+
+    // Hierarchical, solved right away.
+    std::vector<float> lengths(static_cast<size_t>(pathCount), -1.f);
+    std::vector<Vec2>  waypoints;
+    int                waypointCount            = 0;
+    double const       hierarchicalStartSeconds = GetCurrentTimeSeconds();
+
+    for (int pathIndex = 0; pathIndex < pathCount; ++pathIndex)
+    {
+        if (!pathfinder.FindPath(GetCenter(starts[pathIndex]), GetCenter(goals[pathIndex]), waypoints)) continue;
+
+        float length = 0.f;
+
+        for (size_t waypointIndex = 1; waypointIndex < waypoints.size(); ++waypointIndex)
+        {
+            length += (waypoints[waypointIndex] - waypoints[waypointIndex - 1]).GetLength();
+        }
+
+        lengths[pathIndex] = length;
+        waypointCount += static_cast<int>(waypoints.size());
+    }
+
+    double const hierarchicalMilliseconds = GetMillisecondsSince(hierarchicalStartSeconds) / pathCount;
+
+    int    foundCount     = 0;
+    int    mismatchCount  = 0;
+    double lengthRatioSum = 0.0;
+
+    for (int pathIndex = 0; pathIndex < pathCount; ++pathIndex)
+    {
+        bool const isFlatFound = flatCosts[pathIndex] != UINT32_MAX;
+
+        if (isFlatFound != (lengths[pathIndex] >= 0.f)) ++mismatchCount;
+        if (!isFlatFound || lengths[pathIndex] < 0.f || flatCosts[pathIndex] == 0) continue;
+
+        ++foundCount;
+        lengthRatioSum += lengths[pathIndex] / (static_cast<double>(flatCosts[pathIndex]) / FlowFieldSystem::STRAIGHT_STEP_COST);
+    }
+
+    Print(Stringf("BenchPathfinding %dx%d: %d clusters, %d entrance nodes, built in %.2f ms",
+                  size, size, pathfinder.GetClusterCount(), pathfinder.GetNodeCount(), buildMilliseconds));
+    Print(Stringf("BenchPathfinding %d paths: flat A* %.3f ms per path, hierarchical %.3f ms per path (%.1fx), %.2f waypoints per path, %.3f of the flat length, reachability %s: %s",
+                  pathCount, flatMilliseconds, hierarchicalMilliseconds, GetSpeedup(flatMilliseconds, hierarchicalMilliseconds),
+                  foundCount > 0 ? static_cast<double>(waypointCount) / foundCount : 0.0, foundCount > 0 ? lengthRatioSum / foundCount : 0.0,
+                  mismatchCount == 0 ? "matches" : "differs", GetPassText(mismatchCount == 0)));
+
+    // Local rebuilds: flip a tile's solidity bit and back, telling the pathfinder both times.
+    double const editStartSeconds = GetCurrentTimeSeconds();
+
+    for (int editIndex = 0; editIndex < editCount; ++editIndex)
+    {
+        IntVec2 const tileCoords = GetRandomOpenTileCoords();
+        int const     bitIndex   = (tileCoords.x + 1) + (tileCoords.y + 1) * solidTileBitsWidth;
+
+        solidTileBits[bitIndex >> 6] ^= 1ull << (bitIndex & 63);
+        pathfinder.OnTilesChanged(tileCoords, tileCoords + IntVec2(1, 1));
+        solidTileBits[bitIndex >> 6] ^= 1ull << (bitIndex & 63);
+        pathfinder.OnTilesChanged(tileCoords, tileCoords + IntVec2(1, 1));
+    }
+
+    double const editMilliseconds = GetMillisecondsSince(editStartSeconds) / (editCount * 2);
+
+    // The request queue.
+    std::vector<int> requestIDs;
+
+    for (int pathIndex = 0; pathIndex < pathCount; ++pathIndex)
+    {
+        requestIDs.push_back(pathfinder.RequestPath(GetCenter(starts[pathIndex]), GetCenter(goals[pathIndex])));
+    }
+
+    int   tickCount         = 0;
+    float worstMilliseconds = 0.f;
+
+    while (pathfinder.GetPendingPathCount() > 0)
+    {
+        pathfinder.Update();
+        worstMilliseconds = std::max(worstMilliseconds, pathfinder.GetLastUpdateMilliseconds());
+        ++tickCount;
+    }
+
+    int queuedFoundCount = 0;
+
+    for (int const requestID : requestIDs)
+    {
+        if (pathfinder.GetPathResult(requestID, waypoints) == PathStatus::FOUND) ++queuedFoundCount;
+    }
+
+    Print(Stringf("BenchPathfinding: %.3f ms per single tile rebuild, %d nodes after %d edits; queue at %.2f ms per tick solved %d paths (%d found) in %d ticks, worst tick %.3f ms",
+                  editMilliseconds, pathfinder.GetNodeCount(), editCount * 2, budget, pathCount, queuedFoundCount, tickCount, worstMilliseconds));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchAIScheduler count=2000 ticks=300 budget=2 cost=0.008 measured=false lod=16 dormant=48 seed=1
+// Simulates the same crowd of demons twice on copies of the current map, around one marine standing in for the player:
+// every AI thinking every tick, then with the AIScheduler's budget, LOD and dormancy. Prints milliseconds per tick for the
+// whole actor update and for the think phase alone, and how many AIs thought, waited and slept in an average tick.
+// On a map smaller than the LOD distance every AI is close to the player, so only the budget comes into play.
+// The measured cost per AI is printed next to the configured one, to tune Game.AIThinkMillisecondsPerAgent.
+STATIC bool Benchmark::OnBenchAIScheduler(EventArgs& args)
+{
+    Map const* currentMap = GetCurrentMap();
+
+    if (currentMap == nullptr) return false;
+
+    int const              demonCount      = args.GetValue("count", 2000);
+    int const              tickCount       = std::max(args.GetValue("ticks", 300), 1);
+    float const            budget          = args.GetValue("budget", g_gameConfigBlackboard.GetValue("Game.AIBudgetMilliseconds", 2.f));
+    float const            thinkCost       = args.GetValue("cost", g_gameConfigBlackboard.GetValue("Game.AIThinkMillisecondsPerAgent", 0.008f));
+    bool const             isCostMeasured  = args.GetValue("measured", g_gameConfigBlackboard.GetValue("Game.AIThinkCostMeasured", false));
+    float const            lodDistance     = args.GetValue("lod", g_gameConfigBlackboard.GetValue("Game.AILODDistance", 16.f));
+    float const            dormantDistance = args.GetValue("dormant", g_gameConfigBlackboard.GetValue("Game.AIDormantDistance", 48.f));
+    unsigned int const     seed            = static_cast<unsigned int>(args.GetValue("seed", 1));
+    float constexpr        deltaSeconds    = 1.f / 60.f;
+    MapDefinition const*   mapDef          = currentMap->GetMapDefinition();
+    RandomNumberGenerator* gameRNG         = g_theRNG;
+
+    // Map's constructor spawns and possesses a marine for every local player, which must not happen to the copies.
+    std::vector<PlayerController*> localPlayerControllers;
+    localPlayerControllers.swap(g_theGame->m_localPlayerControllerList);
+
+    for (int runIndex = 0; runIndex < 2; ++runIndex)
+    {
+        bool const isScheduled = runIndex == 1;
+
+        srand(seed);
+        g_theRNG = new RandomNumberGenerator();
+
+        Map*                     map = new Map(g_theGame, *mapDef);
+        std::vector<ActorHandle> handles;
+        SpawnActors(*map, "Marine", 1, handles);
+        SpawnActors(*map, "Demon", demonCount, handles);
+
+        BenchObserverController observer(map);
+        observer.Possess(handles.front());
+
+        AIScheduler& scheduler = map->GetAIScheduler();
+        scheduler.SetEnabled(isScheduled);
+        scheduler.SetBudgetMilliseconds(budget);
+        scheduler.SetThinkMillisecondsPerAgent(thinkCost);
+        scheduler.SetThinkCostMeasured(isCostMeasured);
+        scheduler.SetDistances(lodDistance, dormantDistance);
+
+        int64_t tickedTotal  = 0;
+        int64_t skippedTotal = 0;
+        int64_t dormantTotal = 0;
+        int64_t capTotal     = 0;
+        double  thinkTotal   = 0.0;
+
+        double const startSeconds = GetCurrentTimeSeconds();
+
+        for (int tick = 0; tick < tickCount; ++tick)
+        {
+            map->UpdateAllActors(deltaSeconds);
+            map->DeleteDestroyedActor();
+            map->RebuildActorQueryGrid();
+            map->CollideActors();
+            map->CollideActorsWithMap();
+            map->RefreshActorQueryGrid();
+
+            tickedTotal += scheduler.GetTickedCount();
+            skippedTotal += scheduler.GetSkippedCount();
+            dormantTotal += scheduler.GetDormantCount();
+            capTotal += scheduler.GetAgentsPerTick();
+            thinkTotal += static_cast<double>(scheduler.GetMeasuredThinkMillisecondsPerAgent()) * scheduler.GetTickedCount();
+        }
+
+        double const milliseconds = GetMillisecondsSince(startSeconds) / tickCount;
+
+        String const schedule = Stringf("%.1f ms budget at %s ms per AI (up to %.0f AIs per tick), LOD every %.0f tiles, dormant past %.0f",
+                                        budget, isCostMeasured ? "the measured" : Stringf("%.4f", thinkCost).c_str(),
+                                        static_cast<double>(capTotal) / tickCount, lodDistance, dormantDistance);
+
+        Print(Stringf("BenchAIScheduler %d demons, %s: %.3f ms per tick, about %.3f ms of it thinking (%.4f ms per AI); per tick %.0f AIs thought, %.0f waited, %.0f dormant",
+                      demonCount, isScheduled ? schedule.c_str() : "every AI every tick",
+                      milliseconds, thinkTotal / tickCount, scheduler.GetMeasuredThinkMillisecondsPerAgent(),
+                      static_cast<double>(tickedTotal) / tickCount,
+                      static_cast<double>(skippedTotal) / tickCount,
+                      static_cast<double>(dormantTotal) / tickCount));
+
+        delete map;
+        GAME_SAFE_RELEASE(g_theRNG);
+    }
+
+    g_theGame->m_localPlayerControllerList.swap(localPlayerControllers);
+    g_theRNG = gameRNG;
+
+    return true;
+}
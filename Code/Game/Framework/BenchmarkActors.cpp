@@ -0,0 +1,675 @@
+//----------------------------------------------------------------------------------------------------
+// BenchmarkActors.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/Benchmark.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Definition/MapDefinition.hpp"
+#include "Game/Definition/WeaponDefinition.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/NameTable.hpp"
+#include "Game/Framework/PlayerController.hpp"
+#include "Game/Framework/WorkerPool.hpp"
+#include "Game/Gameplay/Actor.hpp"
+#include "Game/Gameplay/ActorPhysicsStore.hpp"
+#include "Game/Gameplay/AIScheduler.hpp"
+#include "Game/Gameplay/Game.hpp"
+#include "Game/Gameplay/Map.hpp"
+#include "Game/Gameplay/ProjectilePool.hpp"
+#include "Game/Gameplay/Sound.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// The lookups spawning and damage did before names were interned, kept as the baseline: a string compare per definition,
+// per inventory weapon and per sound.
+static ActorDefinition const* SpawnLookupByString(String const& actorName)
+{
+    for (ActorDefinition const* actorDef : ActorDefinition::s_actorDefinitions)
+    {
+        if (actorDef->m_name != actorName) continue;
+
+        for (String const& weaponName : actorDef->m_inventory)
+        {
+            for (WeaponDefinition const* weaponDef : WeaponDefinition::s_weaponDefinitions)
+            {
+                if (weaponDef->m_name == weaponName) break;
+            }
+        }
+
+        return actorDef;
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+static Sound const* DamageLookupByString(ActorDefinition const& actorDef)
+{
+    for (Sound const& sound : actorDef.m_sounds)
+    {
+        if (sound.m_name == "Hurt") return &sound;
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The same lookups by interned id.
+static ActorDefinition const* SpawnLookupByNameID(NameID const actorNameID)
+{
+    ActorDefinition const* actorDef = ActorDefinition::GetDefByNameID(actorNameID);
+
+    if (actorDef == nullptr) return nullptr;
+
+    for (NameID const weaponID : actorDef->m_inventoryIDs)
+    {
+        WeaponDefinition::GetDefByNameID(weaponID);
+    }
+
+    return actorDef;
+}
+
+//----------------------------------------------------------------------------------------------------
+// SoakActors count=10000000 batch=1000 actor=PlasmaProjectile
+// Spawns and destroys actors in batches until count spawns have happened, checking that every new handle resolves
+// and that every handle stops resolving once its actor is destroyed. Slot reuse keeps the slot count at the batch size.
+STATIC bool Benchmark::OnSoakActors(EventArgs& args)
+{
+    Map* map = GetCurrentMap();
+
+    if (map == nullptr) return false;
+
+    int const    totalCount = args.GetValue("count", 10000000);
+    int const    batchSize  = args.GetValue("batch", 1000);
+    String const actorName  = args.GetValue("actor", "PlasmaProjectile");
+
+    int                      spawnedCount = 0;
+    int                      failedCount  = 0;
+    std::vector<ActorHandle> handles;
+    handles.reserve(batchSize);
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    while (spawnedCount < totalCount)
+    {
+        int const thisBatch = std::min(batchSize, totalCount - spawnedCount);
+
+        handles.clear();
+        SpawnActors(*map, actorName, thisBatch, handles);
+        spawnedCount += thisBatch;
+
+        for (ActorHandle const& handle : handles)
+        {
+            if (map->GetActorByHandle(handle) == nullptr) ++failedCount;
+        }
+
+        DestroyActors(*map, handles);
+
+        for (ActorHandle const& handle : handles)
+        {
+            if (map->GetActorByHandle(handle) != nullptr) ++failedCount;
+        }
+
+        // SpawnActors stops early once SpawnActor runs out of slots.
+        int const missingCount = thisBatch - static_cast<int>(handles.size());
+
+        if (missingCount > 0)
+        {
+            failedCount += missingCount;
+            break;
+        }
+    }
+
+    double const elapsedSeconds = GetSecondsSince(startSeconds);
+
+    Print(Stringf("SoakActors %d %s actors in %.2f s (%.0f spawn+destroy/s): %u slots allocated, %d live actors, %d handle failures",
+                  spawnedCount, actorName.c_str(), elapsedSeconds,
+                  static_cast<double>(spawnedCount) / elapsedSeconds,
+                  map->GetActorSlotCount(), static_cast<int>(map->m_actors.size()), failedCount));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// TestParallelUpdate count=2000 ticks=60 threads=1,2,4,8 seed=1
+// For each thread count, builds a fresh copy of the current map with the same random state, fills it with count demons
+// and count / 8 marines for them to hunt, and runs the actor update, collision and cleanup for a number of fixed ticks.
+// Reports milliseconds per tick and a hash of every actor's state, which must be the same for every thread count.
+// The game clock is not advanced, so weapon refire and corpse timers only count game time, as when paused.
+STATIC bool Benchmark::OnTestParallelUpdate(EventArgs& args)
+{
+    Map const* currentMap = GetCurrentMap();
+
+    if (currentMap == nullptr) return false;
+
+    int const              demonCount     = args.GetValue("count", 2000);
+    int const              tickCount      = args.GetValue("ticks", 60);
+    unsigned int const     seed           = static_cast<unsigned int>(args.GetValue("seed", 1));
+    float constexpr        deltaSeconds   = 1.f / 60.f;
+    MapDefinition const*   mapDef         = currentMap->GetMapDefinition();
+    WorkerPool*            gameWorkerPool = g_theWorkerPool;
+    RandomNumberGenerator* gameRNG        = g_theRNG;
+
+    // Map's constructor spawns and possesses a marine for every local player, which must not happen to the copies.
+    std::vector<PlayerController*> localPlayerControllers;
+    localPlayerControllers.swap(g_theGame->m_localPlayerControllerList);
+
+    StringList const threadCountStrings = SplitStringOnDelimiter(args.GetValue("threads", "1,2,4,8"), ',');
+    uint64_t         firstHash          = 0;
+    bool             isMatching         = true;
+    double           firstMilliseconds  = 0.0;
+
+    for (int runIndex = 0; runIndex < static_cast<int>(threadCountStrings.size()); ++runIndex)
+    {
+        int const threadCount = std::max(atoi(threadCountStrings[runIndex].c_str()), 1);
+
+        srand(seed);
+        g_theRNG        = new RandomNumberGenerator();
+        g_theWorkerPool = new WorkerPool(threadCount - 1);
+
+        Map*                     map = new Map(g_theGame, *mapDef);
+        std::vector<ActorHandle> handles;
+        SpawnActors(*map, "Demon", demonCount, handles);
+        SpawnActors(*map, "Marine", demonCount / 8, handles);
+
+        // The schedule follows the measured think time, and there are no players to stay awake for.
+        map->GetAIScheduler().SetEnabled(false);
+
+        double const startSeconds = GetCurrentTimeSeconds();
+
+        for (int tick = 0; tick < tickCount; ++tick)
+        {
+            map->UpdateAllActors(deltaSeconds);
+            map->DeleteDestroyedActor();
+            map->RebuildActorQueryGrid();
+            map->CollideActors();
+            map->CollideActorsWithMap();
+            map->RefreshActorQueryGrid();
+        }
+
+        double const   milliseconds = GetMillisecondsSince(startSeconds) / std::max(tickCount, 1);
+        uint64_t const hash         = GetActorStateHash(*map);
+
+        if (runIndex == 0)
+        {
+            firstHash         = hash;
+            firstMilliseconds = milliseconds;
+        }
+
+        isMatching = isMatching && hash == firstHash;
+
+        Print(Stringf("TestParallelUpdate %d threads: %d actors left after %d ticks, %.3f ms per tick (%.2fx), state hash %016llx",
+                      threadCount, static_cast<int>(map->m_actors.size()), tickCount, milliseconds,
+                      GetSpeedup(firstMilliseconds, milliseconds), static_cast<unsigned long long>(hash)));
+
+        delete map;
+        GAME_SAFE_RELEASE(g_theWorkerPool);
+        GAME_SAFE_RELEASE(g_theRNG);
+    }
+
+    g_theGame->m_localPlayerControllerList.swap(localPlayerControllers);
+    g_theWorkerPool = gameWorkerPool;
+    g_theRNG        = gameRNG;
+
+    Print(Stringf("TestParallelUpdate %d demons: results %s across thread counts: %s",
+                  demonCount, isMatching ? "match" : "differ", GetPassText(isMatching)));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchProjectiles count=50000 compare=5000 demons=500 ticks=60 speed=10 projectile=PlasmaProjectile
+// Fills fresh copies of the current map with demons to hit and measures Map::Update per fixed tick: with no projectiles,
+// with compare projectiles as pooled rows and as actors, and with count pooled projectiles.
+// The pool is reserved when the map is created, so spawning into it must not grow it; shots past its capacity are dropped.
+STATIC bool Benchmark::OnBenchProjectiles(EventArgs& args)
+{
+    Map const* currentMap = GetCurrentMap();
+
+    if (currentMap == nullptr) return false;
+
+    int const            projectileCount = args.GetValue("count", 50000);
+    int const            compareCount    = args.GetValue("compare", 5000);
+    int const            demonCount      = args.GetValue("demons", 500);
+    int const            tickCount       = std::max(args.GetValue("ticks", 60), 1);
+    float const          speed           = args.GetValue("speed", 10.f);
+    String const         projectileName  = args.GetValue("projectile", "PlasmaProjectile");
+    float constexpr      deltaSeconds    = 1.f / 60.f;
+    MapDefinition const* mapDef          = currentMap->GetMapDefinition();
+    int const            definitionIndex = ActorDefinition::GetDefIndexByName(projectileName);
+
+    if (definitionIndex < 0 || !ActorDefinition::s_actorDefinitions[definitionIndex]->m_isPooledProjectile)
+    {
+        Print(Stringf("BenchProjectiles: %s is not an actor definition with a <Projectile> element.", projectileName.c_str()));
+        return false;
+    }
+
+    // Map's constructor spawns and possesses a marine for every local player, which must not happen to the copies.
+    std::vector<PlayerController*> localPlayerControllers;
+    localPlayerControllers.swap(g_theGame->m_localPlayerControllerList);
+
+    auto const runMap = [&](char const* label, int const pooledCount, int const actorCount)
+    {
+        Map*                     map = new Map(g_theGame, *mapDef);
+        std::vector<ActorHandle> handles;
+        SpawnActors(*map, "Demon", demonCount, handles);
+
+        ProjectilePool& pool         = map->GetProjectilePool();
+        int             spawnedCount = 0;
+        double          spawnSeconds = 0.0;
+
+        for (int i = 0; i < pooledCount + actorCount; ++i)
+        {
+            IntVec2 const tileCoords = GetRandomOpenTileCoords(*map);
+
+            float const yawDegrees = g_theRNG->RollRandomFloatInRange(0.f, 360.f);
+            Vec3 const  position   = Vec3(static_cast<float>(tileCoords.x) + 0.5f, static_cast<float>(tileCoords.y) + 0.5f, 0.5f);
+            Vec3 const  velocity   = Vec3(CosDegrees(yawDegrees), SinDegrees(yawDegrees), 0.f) * speed;
+
+            if (i < pooledCount)
+            {
+                double const startSeconds = GetCurrentTimeSeconds();
+                bool const   isSpawned    = pool.Spawn(definitionIndex, position, velocity, ActorHandle::INVALID);
+                spawnSeconds += GetSecondsSince(startSeconds);
+
+                if (isSpawned) ++spawnedCount;
+                continue;
+            }
+
+            SpawnInfo spawnInfo;
+            spawnInfo.m_name        = projectileName;
+            spawnInfo.m_position    = position;
+            spawnInfo.m_orientation = EulerAngles(yawDegrees, 0.f, 0.f);
+            spawnInfo.m_velocity    = velocity;
+
+            if (map->SpawnActor(spawnInfo) != nullptr) ++spawnedCount;
+        }
+
+        double const startSeconds = GetCurrentTimeSeconds();
+
+        for (int tick = 0; tick < tickCount; ++tick)
+        {
+            map->Update(deltaSeconds);
+        }
+
+        double const milliseconds = GetMillisecondsSince(startSeconds) / tickCount;
+
+        Print(Stringf("BenchProjectiles %-8s %6d of %6d spawned (%.0f ns per pooled shot), %.3f ms per tick, %d pooled and %d actors left, pool capacity %d",
+                      label, spawnedCount, pooledCount + actorCount,
+                      pooledCount > 0 ? spawnSeconds * 1.0e9 / pooledCount : 0.0,
+                      milliseconds, pool.GetCount(), static_cast<int>(map->m_actors.size()), pool.GetCapacity()));
+
+        delete map;
+        return milliseconds;
+    };
+
+    double const baselineMilliseconds = runMap("none", 0, 0);
+    double const pooledMilliseconds   = runMap("pooled", compareCount, 0);
+    double const actorMilliseconds    = runMap("actors", 0, compareCount);
+    double const fullMilliseconds     = runMap("pooled", projectileCount, 0);
+
+    g_theGame->m_localPlayerControllerList.swap(localPlayerControllers);
+
+    Print(Stringf("BenchProjectiles %d projectiles cost %.3f ms per tick as actors and %.3f ms pooled; %d pooled cost %.3f ms per tick",
+                  compareCount, actorMilliseconds - baselineMilliseconds, pooledMilliseconds - baselineMilliseconds,
+                  projectileCount, fullMilliseconds - baselineMilliseconds));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Times the definition, weapon and sound lookups of a spawn and a damage by string and by interned id,
+// then, with a map loaded, real spawns and damage through the map.
+STATIC bool Benchmark::OnBenchNameLookup(EventArgs& args)
+{
+    int const    lookupCount = std::max(args.GetValue("lookups", 1000000), 1);
+    int const    actorCount  = std::max(args.GetValue("count", 2000), 1);
+    String const actorName   = args.GetValue("actor", "Demon");
+    NameID const actorNameID = NameTable::Find(actorName);
+
+    ActorDefinition* actorDef = ActorDefinition::GetDefByNameID(actorNameID);
+
+    if (actorDef == nullptr)
+    {
+        Print(Stringf("BenchNameLookup: no actor definition named %s", actorName.c_str()));
+        return true;
+    }
+
+    int foundCount = 0;
+
+    double const spawnStringStart = GetCurrentTimeSeconds();
+
+    for (int i = 0; i < lookupCount; ++i)
+    {
+        if (SpawnLookupByString(actorName) != nullptr) ++foundCount;
+    }
+
+    double const spawnStringMs = GetMillisecondsSince(spawnStringStart);
+    double const spawnIDStart  = GetCurrentTimeSeconds();
+
+    for (int i = 0; i < lookupCount; ++i)
+    {
+        if (SpawnLookupByNameID(actorNameID) != nullptr) ++foundCount;
+    }
+
+    double const spawnIDMs         = GetMillisecondsSince(spawnIDStart);
+    double const damageStringStart = GetCurrentTimeSeconds();
+
+    for (int i = 0; i < lookupCount; ++i)
+    {
+        if (DamageLookupByString(*actorDef) != nullptr) ++foundCount;
+    }
+
+    double const damageStringMs = GetMillisecondsSince(damageStringStart);
+    double const damageIDStart  = GetCurrentTimeSeconds();
+
+    for (int i = 0; i < lookupCount; ++i)
+    {
+        if (actorDef->GetSoundByNameID(NameTable::HURT) != nullptr) ++foundCount;
+    }
+
+    double const damageIDMs = GetMillisecondsSince(damageIDStart);
+
+    Print(Stringf("BenchNameLookup %d %s lookups (%d found, %d names interned)", lookupCount, actorName.c_str(), foundCount, NameTable::GetCount()));
+    Print(Stringf("  spawn:  by string %8.3f ms, by id %8.3f ms", spawnStringMs, spawnIDMs));
+    Print(Stringf("  damage: by string %8.3f ms, by id %8.3f ms", damageStringMs, damageIDMs));
+
+    Map* map = GetCurrentMap();
+    if (map == nullptr) return true;
+
+    std::vector<ActorHandle> handles;
+    double const             spawnStart = GetCurrentTimeSeconds();
+    SpawnActors(*map, actorName, actorCount, handles);
+    double const spawnMs = GetMillisecondsSince(spawnStart);
+
+    double const damageStart = GetCurrentTimeSeconds();
+
+    for (ActorHandle const& handle : handles)
+    {
+        if (Actor* actor = map->GetActorByHandle(handle))
+        {
+            actor->Damage(0, ActorHandle::INVALID);
+        }
+    }
+
+    double const damageMs = GetMillisecondsSince(damageStart);
+
+    DestroyActors(*map, handles);
+
+    Print(Stringf("  map: %d spawns %.3f ms (%.3f us each), %d damages %.3f ms (%.3f us each)",
+                  static_cast<int>(handles.size()), spawnMs, spawnMs * 1000.0 / std::max(static_cast<int>(handles.size()), 1),
+                  static_cast<int>(handles.size()), damageMs, damageMs * 1000.0 / std::max(static_cast<int>(handles.size()), 1)));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchActorIndex actors=5000 lookups=1000 name=SpawnPoint
+// With actors demons added to the current map, finds every actor of the named definition and every actor of the demons'
+// faction lookups times, through the map's per-definition and per-faction lists and through a linear pass comparing
+// every actor's definition name, as GetActorsByName used to. Then times deleting a tenth of the demons.
+STATIC bool Benchmark::OnBenchActorIndex(EventArgs& args)
+{
+    Map* map = GetCurrentMap();
+
+    if (map == nullptr) return false;
+
+    int const    actorCount  = args.GetValue("actors", 5000);
+    int const    lookupCount = std::max(args.GetValue("lookups", 1000), 1);
+    String const name        = args.GetValue("name", "SpawnPoint");
+
+    ActorDefinition const* demonDefinition = ActorDefinition::GetDefByNameID(NameTable::DEMON);
+
+    if (demonDefinition == nullptr)
+    {
+        Print("BenchActorIndex: no Demon actor definition.");
+        return false;
+    }
+
+    std::vector<ActorHandle> handles;
+    SpawnActors(*map, "Demon", actorCount, handles);
+
+    int const factionIndex = demonDefinition->m_factionIndex;
+    size_t    indexedFound = 0;
+    size_t    linearFound  = 0;
+
+    double const indexedStartSeconds = GetCurrentTimeSeconds();
+
+    for (int i = 0; i < lookupCount; ++i)
+    {
+        indexedFound += map->GetActorsByName(name).size();
+        indexedFound += map->GetFactionActors(factionIndex).size();
+    }
+
+    double const indexedSeconds     = GetSecondsSince(indexedStartSeconds);
+    double const linearStartSeconds = GetCurrentTimeSeconds();
+
+    for (int i = 0; i < lookupCount; ++i)
+    {
+        std::vector<Actor*> namedActors;
+        std::vector<Actor*> factionActors;
+
+        for (Actor* actor : map->m_actors)
+        {
+            if (actor->m_definition->m_name == name) namedActors.push_back(actor);
+            if (actor->m_definition->m_factionIndex == factionIndex) factionActors.push_back(actor);
+        }
+
+        linearFound += namedActors.size() + factionActors.size();
+    }
+
+    double const linearSeconds = GetSecondsSince(linearStartSeconds);
+
+    Print(Stringf("BenchActorIndex %d actors, %d lookups of %s and its faction: linear %.3f ms, indexed %.3f ms (%.0fx), %s",
+                  static_cast<int>(map->m_actors.size()), lookupCount, name.c_str(),
+                  linearSeconds * 1000.0, indexedSeconds * 1000.0, GetSpeedup(linearSeconds, indexedSeconds),
+                  indexedFound == linearFound ? "same actors found" : "DIFFERENT actors found"));
+
+    // Every tenth demon, so most of the lists stay untouched.
+    for (size_t i = 0; i < handles.size(); i += 10)
+    {
+        if (Actor* actor = map->GetActorByHandle(handles[i]))
+        {
+            actor->m_isGarbage = true;
+        }
+    }
+
+    double const deleteStartSeconds = GetCurrentTimeSeconds();
+    map->DeleteDestroyedActor();
+    double const deleteSeconds = GetSecondsSince(deleteStartSeconds);
+    map->RebuildActorQueryGrid();
+
+    Print(Stringf("BenchActorIndex: deleting %d demons %.3f ms", static_cast<int>((handles.size() + 9) / 10), deleteSeconds * 1000.0));
+
+    DestroyActors(*map, handles);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchPhysics actors=10000 iterations=100
+// With actors demons added to the current map, moving in random directions, integrates every actor iterations times on
+// this thread, through Actor::UpdatePhysics one actor at a time, through Map::IntegrateActors as the physics phase runs
+// it, and through the physics store's SSE kernel alone. Reports actors per microsecond for each, and passes when one step
+// from the same start leaves every actor's position and velocity bit for bit where the per-actor path leaves them, and
+// the collision cylinder the kernel wrote standing on that position with the actor's radius and height.
+STATIC bool Benchmark::OnBenchPhysics(EventArgs& args)
+{
+    Map* map = GetCurrentMap();
+
+    if (map == nullptr) return false;
+
+    int const   actorCount     = args.GetValue("actors", 10000);
+    int const   iterationCount = std::max(args.GetValue("iterations", 100), 1);
+    float const deltaSeconds   = 1.f / 60.f;
+
+    std::vector<ActorHandle> handles;
+    SpawnActors(*map, "Demon", actorCount, handles);
+
+    for (ActorHandle const& handle : handles)
+    {
+        if (Actor* actor = map->GetActorByHandle(handle))
+        {
+            actor->SetVelocity(Vec3(g_theRNG->RollRandomFloatInRange(-2.f, 2.f), g_theRNG->RollRandomFloatInRange(-2.f, 2.f), 0.f));
+        }
+    }
+
+    struct PhysicsState
+    {
+        Vec3 m_position;
+        Vec3 m_velocity;
+        Vec3 m_acceleration;
+    };
+
+    std::vector<Actor*> const& actors     = map->m_actors;
+    int const                  totalCount = static_cast<int>(actors.size());
+    std::vector<PhysicsState>  startStates(totalCount);
+    std::vector<PhysicsState>  actorStates(totalCount);
+
+    auto const SaveStates = [&actors, totalCount](std::vector<PhysicsState>& out_states)
+    {
+        for (int i = 0; i < totalCount; ++i)
+        {
+            out_states[i] = PhysicsState{actors[i]->GetPosition(), actors[i]->GetVelocity(), actors[i]->GetAcceleration()};
+        }
+    };
+
+    auto const RestoreStates = [&actors, totalCount](std::vector<PhysicsState> const& states)
+    {
+        for (int i = 0; i < totalCount; ++i)
+        {
+            actors[i]->SetPosition(states[i].m_position);
+            actors[i]->SetVelocity(states[i].m_velocity);
+            actors[i]->SetAcceleration(states[i].m_acceleration);
+        }
+    };
+
+    auto const StepActors = [&actors, totalCount, deltaSeconds]()
+    {
+        for (int i = 0; i < totalCount; ++i)
+        {
+            if (!actors[i]->m_isDead)
+            {
+                actors[i]->UpdatePhysics(deltaSeconds);
+            }
+        }
+    };
+
+    ActorPhysicsStore& store = map->GetPhysicsStore();
+
+    auto const StepStore = [map, totalCount, deltaSeconds]()
+    {
+        map->IntegrateActors(deltaSeconds, 0, totalCount);
+    };
+
+    // One step from the same start both ways.
+    SaveStates(startStates);
+    StepActors();
+    SaveStates(actorStates);
+    RestoreStates(startStates);
+    StepStore();
+
+    auto const IsSame = [](Vec3 const& a, Vec3 const& b) { return a.x == b.x && a.y == b.y && a.z == b.z; };
+
+    int mismatchCount = 0;
+
+    for (int i = 0; i < totalCount; ++i)
+    {
+        Actor const*        actor     = actors[i];
+        PhysicsState const& expected  = actorStates[i];
+        Cylinder3 const     cylinder3 = actor->GetCollisionCylinder();
+        bool const          isSame    = IsSame(actor->GetPosition(), expected.m_position) &&
+                                        IsSame(actor->GetVelocity(), expected.m_velocity) &&
+                                        IsSame(cylinder3.m_startPosition, expected.m_position) &&
+                                        IsSame(cylinder3.m_endPosition, expected.m_position + Vec3(0.f, 0.f, actor->GetHeight())) &&
+                                        cylinder3.m_radius == actor->GetRadius();
+
+        if (!isSame) ++mismatchCount;
+    }
+
+    RestoreStates(startStates);
+    double const actorStartSeconds = GetCurrentTimeSeconds();
+
+    for (int iteration = 0; iteration < iterationCount; ++iteration)
+    {
+        StepActors();
+    }
+
+    double const actorSeconds = GetSecondsSince(actorStartSeconds);
+
+    RestoreStates(startStates);
+    double const storeStartSeconds = GetCurrentTimeSeconds();
+
+    for (int iteration = 0; iteration < iterationCount; ++iteration)
+    {
+        StepStore();
+    }
+
+    double const storeSeconds = GetSecondsSince(storeStartSeconds);
+
+    RestoreStates(startStates);
+    double const kernelStartSeconds = GetCurrentTimeSeconds();
+
+    for (int iteration = 0; iteration < iterationCount; ++iteration)
+    {
+        store.Integrate(deltaSeconds, 0, totalCount);
+    }
+
+    double const kernelSeconds = GetSecondsSince(kernelStartSeconds);
+    double const stepCount     = static_cast<double>(totalCount) * static_cast<double>(iterationCount);
+    bool const   isPassed      = mismatchCount == 0;
+
+    Print(Stringf("BenchPhysics %d actors x %d: per actor %.1f actors/us, store %.1f actors/us, kernel alone %.1f actors/us, %d mismatches: %s",
+                  totalCount, iterationCount,
+                  stepCount / (actorSeconds * 1000000.0),
+                  stepCount / (storeSeconds * 1000000.0),
+                  stepCount / (kernelSeconds * 1000000.0),
+                  mismatchCount, GetPassText(isPassed)));
+
+    // Put every actor back where it started, cylinder included.
+    RestoreStates(startStates);
+    DestroyActors(*map, handles);
+
+    return isPassed;
+}
+
+//----------------------------------------------------------------------------------------------------
+// FNV-1a over the actor count and each actor's position, velocity, yaw, health and death flag, in actor order.
+STATIC uint64_t Benchmark::GetActorStateHash(Map const& map)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    auto const addBytes = [&hash](void const* data, size_t const size)
+    {
+        unsigned char const* bytes = static_cast<unsigned char const*>(data);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+
+    int const actorCount = static_cast<int>(map.m_actors.size());
+    addBytes(&actorCount, sizeof(actorCount));
+
+    for (Actor const* actor : map.m_actors)
+    {
+        Vec3 const position = actor->GetPosition();
+        Vec3 const velocity = actor->GetVelocity();
+
+        addBytes(&position, sizeof(position));
+        addBytes(&velocity, sizeof(velocity));
+        addBytes(&actor->m_orientation.m_yawDegrees, sizeof(actor->m_orientation.m_yawDegrees));
+        addBytes(&actor->m_health, sizeof(actor->m_health));
+        addBytes(&actor->m_isDead, sizeof(actor->m_isDead));
+    }
+
+    return hash;
+}
@@ -0,0 +1,338 @@
+//----------------------------------------------------------------------------------------------------
+// BenchmarkMap.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/Benchmark.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Definition/MapDefinition.hpp"
+#include "Game/Definition/TileDefinition.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/PlayerController.hpp"
+#include "Game/Framework/ViewFrustum.hpp"
+#include "Game/Gameplay/CompiledMap.hpp"
+#include "Game/Gameplay/Game.hpp"
+#include "Game/Gameplay/Map.hpp"
+#include "Game/Gameplay/MapGeometryBuilder.hpp"
+#include "Game/Gameplay/Tile.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// BenchMapGeometry size=512
+// Builds the static geometry of every map definition plus a generated size x size map three ways:
+// one quad per tile face as before, with hidden wall faces culled, and culled with coplanar faces merged.
+// Needs no map or renderer, since only the tile grid and sprite indexes matter for the counts.
+STATIC bool Benchmark::OnBenchMapGeometry(EventArgs& args)
+{
+    int const size = args.GetValue("size", 512);
+
+    for (MapDefinition const* mapDef : MapDefinition::s_mapDefinitions)
+    {
+        std::vector<Tile> tiles;
+        GetMapDefTiles(*mapDef, tiles);
+
+        PrintMapGeometryCounts(mapDef->m_name, mapDef->GetDimensions(), tiles, mapDef->m_spriteSheetCellCount);
+    }
+
+    std::vector<Tile> generatedTiles;
+    GenerateTiles(IntVec2(size, size), generatedTiles);
+    PrintMapGeometryCounts(Stringf("Generated%dx%d", size, size), IntVec2(size, size), generatedTiles, IntVec2(8, 8));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// TestChunkCulling views=1000 fov=60
+// Culls the current map's chunks against the view of every local player and of random eye-height views,
+// and reports how many chunks each view draws. A chunk is only allowed to be culled when none of a grid of
+// sample points inside it is in the view, so "wrongly culled" must stay at zero. Runs headless.
+STATIC bool Benchmark::OnTestChunkCulling(EventArgs& args)
+{
+    Map const* map = GetCurrentMap();
+
+    if (map == nullptr) return false;
+
+    int const     viewCount  = args.GetValue("views", 1000);
+    float const   fovDegrees = args.GetValue("fov", 60.f);
+    IntVec2 const dimensions = map->GetDimensions();
+    int const     chunkCount = map->GetChunkCount();
+
+    unsigned int totalIndexCount = 0;
+
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+        totalIndexCount += map->GetChunkIndexCount(chunkIndex);
+    }
+
+    std::vector<int> visibleChunkIndexes;
+
+    for (PlayerController const* controller : g_theGame->m_localPlayerControllerList)
+    {
+        int const drawnCount = map->GetVisibleChunks(controller->GetWorldCameraFrustum(), visibleChunkIndexes);
+
+        Print(Stringf("TestChunkCulling player %d: %d of %d chunks drawn", controller->m_index, drawnCount, chunkCount));
+    }
+
+    std::vector<bool> isVisible(chunkCount);
+    int               totalDrawnCount    = 0;
+    int               minDrawnCount      = chunkCount;
+    int               maxDrawnCount      = 0;
+    int               wronglyCulledCount = 0;
+    double            drawnIndexCountSum = 0.0;
+    int constexpr     samplesPerAxis     = 8;
+
+    for (int view = 0; view < viewCount; ++view)
+    {
+        IntVec2 const tileCoords = GetRandomOpenTileCoords(*map);
+
+        Vec3 const        position    = Vec3(static_cast<float>(tileCoords.x) + 0.5f, static_cast<float>(tileCoords.y) + 0.5f, 0.5f);
+        EulerAngles const orientation = EulerAngles(g_theRNG->RollRandomFloatInRange(0.f, 360.f), g_theRNG->RollRandomFloatInRange(-45.f, 45.f), 0.f);
+        ViewFrustum const frustum     = ViewFrustum(position, orientation, fovDegrees, PlayerController::WORLD_CAMERA_ASPECT, PlayerController::WORLD_CAMERA_NEAR, PlayerController::WORLD_CAMERA_FAR);
+
+        int const drawnCount = map->GetVisibleChunks(frustum, visibleChunkIndexes);
+
+        totalDrawnCount += drawnCount;
+        minDrawnCount = std::min(minDrawnCount, drawnCount);
+        maxDrawnCount = std::max(maxDrawnCount, drawnCount);
+
+        std::fill(isVisible.begin(), isVisible.end(), false);
+
+        for (int const chunkIndex : visibleChunkIndexes)
+        {
+            isVisible[chunkIndex] = true;
+            drawnIndexCountSum += map->GetChunkIndexCount(chunkIndex);
+        }
+
+        for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+        {
+            if (isVisible[chunkIndex]) continue;
+
+            AABB3 const bounds    = map->GetChunkBounds(chunkIndex);
+            Vec3 const  size      = bounds.m_maxs - bounds.m_mins;
+            bool        isSampled = false;
+
+            for (int sampleIndex = 0; sampleIndex < samplesPerAxis * samplesPerAxis * samplesPerAxis && !isSampled; ++sampleIndex)
+            {
+                float const fractionX = static_cast<float>(sampleIndex % samplesPerAxis) / static_cast<float>(samplesPerAxis - 1);
+                float const fractionY = static_cast<float>(sampleIndex / samplesPerAxis % samplesPerAxis) / static_cast<float>(samplesPerAxis - 1);
+                float const fractionZ = static_cast<float>(sampleIndex / (samplesPerAxis * samplesPerAxis)) / static_cast<float>(samplesPerAxis - 1);
+
+                isSampled = frustum.IsPointInside(bounds.m_mins + Vec3(size.x * fractionX, size.y * fractionY, size.z * fractionZ));
+            }
+
+            if (isSampled) ++wronglyCulledCount;
+        }
+    }
+
+    double const averageDrawnCount = viewCount > 0 ? static_cast<double>(totalDrawnCount) / viewCount : 0.0;
+    String const submittedText     = totalIndexCount > 0 && viewCount > 0 ? Stringf(", %.1f%% of map indexes submitted", drawnIndexCountSum * 100.0 / (static_cast<double>(totalIndexCount) * viewCount)) : String();
+
+    Print(Stringf("TestChunkCulling %d random views on %dx%d (%d chunks of %d tiles): %.1f chunks drawn per view (min %d, max %d)%s, %d wrongly culled: %s",
+                  viewCount, dimensions.x, dimensions.y, chunkCount, Map::CHUNK_SIZE,
+                  averageDrawnCount, minDrawnCount, maxDrawnCount, submittedText.c_str(),
+                  wronglyCulledCount, GetPassText(wronglyCulledCount == 0)));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchMapLoad size=1024
+// Compares loading every map definition from its image (decode, match texel colors to tile definitions,
+// build the solidity bitset and the chunk geometry) with opening its compiled .dmap, which does none of that.
+// A generated size x size map is then compiled to a temporary .dmap and opened the same way; it has no image,
+// so its image path starts from tiles already matched to colors and leaves out the decode. GPU uploads are left out of both.
+STATIC bool Benchmark::OnBenchMapLoad(EventArgs& args)
+{
+    int const size = args.GetValue("size", 1024);
+
+    for (MapDefinition const* mapDef : MapDefinition::s_mapDefinitions)
+    {
+        double const startSeconds = GetCurrentTimeSeconds();
+        Image const  image        = Image(mapDef->m_imageFilePath.c_str());
+        double const imageSeconds = GetSecondsSince(startSeconds);
+
+        IntVec2 const     dimensions = image.GetDimensions();
+        std::vector<Tile> tiles(static_cast<size_t>(dimensions.x * dimensions.y));
+        double const      matchStartSeconds = GetCurrentTimeSeconds();
+
+        for (int y = 0; y < dimensions.y; ++y)
+        {
+            for (int x = 0; x < dimensions.x; ++x)
+            {
+                tiles[x + y * dimensions.x].m_tileDefIndex = TileDefinition::GetDefIndexByMapImagePixelColor(image.GetTexelColor(IntVec2(x, y)));
+            }
+        }
+
+        double const imageMilliseconds = (imageSeconds + GetSecondsSince(matchStartSeconds)) * 1000.0 + TimeMapBuild(dimensions, tiles.data(), mapDef->m_spriteSheetCellCount);
+
+        if (mapDef->m_compiledMapFilePath.empty())
+        {
+            Print(Stringf("BenchMapLoad %s %dx%d: image %.2f ms, no compiledMap set", mapDef->m_name.c_str(), dimensions.x, dimensions.y, imageMilliseconds));
+            continue;
+        }
+
+        CompiledMap  compiledMap;
+        double const openStartSeconds = GetCurrentTimeSeconds();
+        bool const   isOpen           = compiledMap.Open(mapDef->m_compiledMapFilePath.c_str(), mapDef->m_spriteSheetCellCount);
+        double const openMilliseconds = GetMillisecondsSince(openStartSeconds);
+
+        if (!isOpen)
+        {
+            Print(Stringf("BenchMapLoad %s %dx%d: image %.2f ms, %s did not open, run MapCompiler", mapDef->m_name.c_str(), dimensions.x, dimensions.y, imageMilliseconds, mapDef->m_compiledMapFilePath.c_str()));
+            continue;
+        }
+
+        Print(Stringf("BenchMapLoad %s %dx%d: image %.2f ms, compiled %.3f ms (%.2f MB mapped)",
+                      mapDef->m_name.c_str(), dimensions.x, dimensions.y, imageMilliseconds, openMilliseconds,
+                      static_cast<double>(compiledMap.GetFileSize()) / (1024.0 * 1024.0)));
+    }
+
+    if (MapDefinition::s_mapDefinitions.empty() || TileDefinition::s_tileDefinitions.empty()) return true;
+
+    IntVec2 const     dimensions           = IntVec2(size, size);
+    IntVec2 const     spriteSheetCellCount = MapDefinition::s_mapDefinitions[0]->m_spriteSheetCellCount;
+    std::vector<Tile> generatedTiles;
+    GenerateTiles(dimensions, generatedTiles);
+
+    std::vector<Rgba8> texelColors(generatedTiles.size());
+
+    for (size_t tileIndex = 0; tileIndex < generatedTiles.size(); ++tileIndex)
+    {
+        TileDefinition const* tileDef = generatedTiles[tileIndex].GetDefinition();
+        texelColors[tileIndex]        = tileDef != nullptr ? tileDef->m_mapImagePixelColor : Rgba8::BLACK;
+    }
+
+    std::vector<Tile> tiles(generatedTiles.size());
+    double const      matchStartSeconds = GetCurrentTimeSeconds();
+
+    for (size_t tileIndex = 0; tileIndex < tiles.size(); ++tileIndex)
+    {
+        tiles[tileIndex].m_tileDefIndex = TileDefinition::GetDefIndexByMapImagePixelColor(texelColors[tileIndex]);
+    }
+
+    double const imageMilliseconds = GetMillisecondsSince(matchStartSeconds) + TimeMapBuild(dimensions, tiles.data(), spriteSheetCellCount);
+
+    char const*  path              = "Data/Maps/BenchMapLoad.dmap";
+    double const writeStartSeconds = GetCurrentTimeSeconds();
+
+    if (!CompiledMap::Write(path, dimensions, tiles.data(), spriteSheetCellCount, std::vector<SpawnInfo>()))
+    {
+        Print(Stringf("BenchMapLoad: could not write %s", path));
+        return false;
+    }
+
+    double const writeMilliseconds = GetMillisecondsSince(writeStartSeconds);
+
+    CompiledMap  compiledMap;
+    double const openStartSeconds = GetCurrentTimeSeconds();
+    bool const   isOpen           = compiledMap.Open(path, spriteSheetCellCount);
+    double const openMilliseconds = GetMillisecondsSince(openStartSeconds);
+    bool const   isMatching       = isOpen && std::equal(tiles.begin(), tiles.end(), compiledMap.GetTiles(),
+                                                         [](Tile const& tileA, Tile const& tileB) { return tileA.m_tileDefIndex == tileB.m_tileDefIndex; });
+    double const fileMegabytes    = static_cast<double>(compiledMap.GetFileSize()) / (1024.0 * 1024.0);
+
+    compiledMap.Close();
+    std::remove(path);
+
+    Print(Stringf("BenchMapLoad Generated%dx%d: image without decode %.2f ms, compiled %.3f ms (%.2f MB mapped, written in %.2f ms), tiles round trip: %s",
+                  size, size, imageMilliseconds, openMilliseconds, fileMegabytes, writeMilliseconds, GetPassText(isMatching)));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void Benchmark::PrintMapGeometryCounts(String const&            mapName,
+                                              IntVec2 const&           dimensions,
+                                              std::vector<Tile> const& tiles,
+                                              IntVec2 const&           spriteSheetCellCount)
+{
+    // Only the counts matter here, so every sprite gets the whole texture.
+    std::vector<AABB2> const spriteUVs(static_cast<size_t>(spriteSheetCellCount.x * spriteSheetCellCount.y), AABB2(Vec2(0.f, 0.f), Vec2(1.f, 1.f)));
+    MapGeometryBuilder       builder = MapGeometryBuilder(dimensions, tiles.data(), spriteSheetCellCount, spriteUVs);
+
+    String const modeNames[3]      = {"per tile", "culled", "culled+merged"};
+    bool const   cullHiddenFaces[] = {false, true, true};
+    bool const   mergeFaces[]      = {false, false, true};
+
+    for (int mode = 0; mode < 3; ++mode)
+    {
+        builder.m_cullHiddenFaces = cullHiddenFaces[mode];
+        builder.m_mergeFaces      = mergeFaces[mode];
+
+        VertexList_PCUTBN verts;
+        IndexList         indexes;
+        double const      startSeconds = GetCurrentTimeSeconds();
+
+        builder.Build(verts, indexes);
+
+        double const milliseconds = GetMillisecondsSince(startSeconds);
+
+        Print(Stringf("BenchMapGeometry %s %dx%d %s: %d vertexes, %d indexes, %.2f MB, built in %.2f ms",
+                      mapName.c_str(), dimensions.x, dimensions.y, modeNames[mode].c_str(),
+                      static_cast<int>(verts.size()), static_cast<int>(indexes.size()),
+                      static_cast<double>(verts.size() * sizeof(Vertex_PCUTBN) + indexes.size() * sizeof(unsigned int)) / (1024.0 * 1024.0),
+                      milliseconds));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void Benchmark::GetMapDefTiles(MapDefinition const& mapDef,
+                                      std::vector<Tile>&   out_tiles)
+{
+    IntVec2 const dimensions = mapDef.GetDimensions();
+
+    if (mapDef.m_compiledMap != nullptr)
+    {
+        Tile const* tiles = mapDef.m_compiledMap->GetTiles();
+        out_tiles.assign(tiles, tiles + dimensions.x * dimensions.y);
+        return;
+    }
+
+    out_tiles.assign(static_cast<size_t>(dimensions.x * dimensions.y), Tile());
+
+    for (int y = 0; y < dimensions.y; ++y)
+    {
+        for (int x = 0; x < dimensions.x; ++x)
+        {
+            out_tiles[x + y * dimensions.x].m_tileDefIndex = TileDefinition::GetDefIndexByMapImagePixelColor(mapDef.m_image.GetTexelColor(IntVec2(x, y)));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Milliseconds for what Map does with its tiles once they are matched: the solidity bitset and every chunk's geometry.
+STATIC double Benchmark::TimeMapBuild(IntVec2 const& dimensions,
+                                      Tile const*    tiles,
+                                      IntVec2 const& spriteSheetCellCount)
+{
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    std::vector<uint64_t> solidTileBits;
+    Tile::CreateSolidTileBits(dimensions, tiles, solidTileBits);
+
+    std::vector<AABB2> spriteUVs;
+    MapGeometryBuilder::GetSpriteSheetUVs(spriteSheetCellCount, spriteUVs);
+
+    MapGeometryBuilder const builder = MapGeometryBuilder(dimensions, tiles, spriteSheetCellCount, spriteUVs);
+    VertexList_PCUTBN        verts;
+    IndexList                indexes;
+
+    for (int chunkIndex = 0; chunkIndex < MapGeometryBuilder::GetChunkCount(dimensions); ++chunkIndex)
+    {
+        IntVec2 tileMins;
+        IntVec2 tileMaxs;
+        MapGeometryBuilder::GetChunkRegion(dimensions, chunkIndex, tileMins, tileMaxs);
+
+        verts.clear();
+        indexes.clear();
+        builder.Build(verts, indexes, tileMins, tileMaxs);
+    }
+
+    return GetMillisecondsSince(startSeconds);
+}
@@ -0,0 +1,643 @@
+//----------------------------------------------------------------------------------------------------
+// BenchmarkQueries.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Gameplay/Actor.hpp"
+#include "Game/Gameplay/ActorQueryGrid.hpp"
+#include "Game/Gameplay/Map.hpp"
+#include "Game/Gameplay/SpatialQuery.hpp"
+#include "Game/Gameplay/SpatialQueryService.hpp"
+#include "Game/Gameplay/Tile.hpp"
+#include "Game/Gameplay/Weapon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Same narrow phase as Map::CollideActors(Actor*, Actor*) followed by Actor::OnCollisionEnterWithActor,
+// without the response, so both broadphases can be measured on an unchanging set of actors.
+static bool IsActorPairTouching(Actor const* actorA,
+                                Actor const* actorB)
+{
+    if (!actorA->GetCollisionCylinder().GetFloatRange().IsOverlappingWith(actorB->GetCollisionCylinder().GetFloatRange())) return false;
+
+    Vec3 const positionA = actorA->GetPosition();
+    Vec3 const positionB = actorB->GetPosition();
+
+    return DoDiscsOverlap2D(Vec2(positionA.x, positionA.y), actorA->GetRadius(),
+                            Vec2(positionB.x, positionB.y), actorB->GetRadius());
+}
+
+//----------------------------------------------------------------------------------------------------
+// The fixed-step ray march Map::RaycastWorldXY used before it switched to grid traversal, kept as the baseline.
+static RaycastResult3D RaycastWorldXYStepped(Map const&  map,
+                                             Vec3 const& startPosition,
+                                             Vec3 const& forwardNormal,
+                                             float const maxLength)
+{
+    RaycastResult3D result;
+    result.m_rayStartPosition = startPosition;
+    result.m_rayForwardNormal = forwardNormal;
+    result.m_rayMaxLength     = maxLength;
+
+    Vec3             currentPosition   = startPosition;
+    float            currentLength     = 0.f;
+    float constexpr  stepSize          = 0.01f;
+    Vec3 const       rayMoveStep       = forwardNormal * stepSize;
+    float const      rayMoveStepLength = rayMoveStep.GetLength();
+    FloatRange const rangeWorldZ       = FloatRange(0.f, 1.f);
+
+    while (currentLength < maxLength)
+    {
+        currentPosition += rayMoveStep;
+        currentLength += rayMoveStepLength;
+
+        IntVec2 currentTileCoords = map.GetTileCoordsFromWorldPos(currentPosition);
+
+        if (map.IsTileCoordsOutOfBounds(currentTileCoords)) { continue; }
+
+        AABB3 const currentTileBounds3D = Tile::GetBounds(currentTileCoords);
+        AABB2 const currentTileBounds2D = AABB2(Vec2(currentTileBounds3D.m_mins.x, currentTileBounds3D.m_mins.y), Vec2(currentTileBounds3D.m_maxs.x, currentTileBounds3D.m_maxs.y));
+        Vec3 const  previousPosition    = currentPosition - forwardNormal * rayMoveStepLength;
+
+        if (map.IsTileSolid(currentTileCoords) &&
+            rangeWorldZ.IsOnRange(currentPosition.z) &&
+            !currentTileBounds2D.IsPointInside(Vec2(previousPosition.x, previousPosition.y)))
+        {
+            result.m_didImpact      = true;
+            result.m_impactPosition = currentPosition;
+            result.m_impactLength   = currentLength;
+
+            return result;
+        }
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchCollision counts=100,1000,10000 iterations=10 actor=Demon
+// Spawns actors on random open tiles and compares the old all-pairs loop against the query grid's broadphase:
+// pairs tested, pairs actually touching and milliseconds per tick.
+STATIC bool Benchmark::OnBenchCollision(EventArgs& args)
+{
+    Map* map = GetCurrentMap();
+
+    if (map == nullptr) return false;
+
+    std::vector<int> const counts     = GetCounts(args, "100,1000,10000");
+    int const              iterations = args.GetValue("iterations", 10);
+    String const           actorName  = args.GetValue("actor", "Demon");
+
+    ActorQueryGrid queryGrid;
+    queryGrid.Initialize(map->GetDimensions());
+    std::vector<ActorPair> pairs;
+
+    for (int const count : counts)
+    {
+        std::vector<ActorHandle> handles;
+        SpawnActors(*map, actorName, count, handles);
+
+        std::vector<Actor*> const& actors = map->m_actors;
+
+        // Old loop: every valid actor against every other one.
+        int          bruteTestedPairs   = 0;
+        int          bruteTouchingPairs = 0;
+        double const bruteStartSeconds  = GetCurrentTimeSeconds();
+
+        for (int iteration = 0; iteration < iterations; ++iteration)
+        {
+            bruteTestedPairs   = 0;
+            bruteTouchingPairs = 0;
+
+            for (int i = 0; i < static_cast<int>(actors.size()); ++i)
+            {
+                if (actors[i] == nullptr || !actors[i]->m_handle.IsValid()) continue;
+
+                for (int j = i + 1; j < static_cast<int>(actors.size()); ++j)
+                {
+                    if (actors[j] == nullptr || !actors[j]->m_handle.IsValid()) continue;
+
+                    ++bruteTestedPairs;
+
+                    if (IsActorPairTouching(actors[i], actors[j])) ++bruteTouchingPairs;
+                }
+            }
+        }
+
+        double const bruteMilliseconds = GetMillisecondsSince(bruteStartSeconds) / iterations;
+
+        // Query grid: rebuild, gather candidates, then the same narrow phase.
+        int          gridTestedPairs   = 0;
+        int          gridTouchingPairs = 0;
+        double const gridStartSeconds  = GetCurrentTimeSeconds();
+
+        for (int iteration = 0; iteration < iterations; ++iteration)
+        {
+            gridTouchingPairs = 0;
+
+            queryGrid.Rebuild(actors);
+            queryGrid.GetCandidatePairs(pairs);
+            gridTestedPairs = static_cast<int>(pairs.size());
+
+            for (ActorPair const& pair : pairs)
+            {
+                if (IsActorPairTouching(actors[pair.m_first], actors[pair.m_second])) ++gridTouchingPairs;
+            }
+        }
+
+        double const gridMilliseconds = GetMillisecondsSince(gridStartSeconds) / iterations;
+
+        Print(Stringf("BenchCollision %d actors: all-pairs %d tested / %d touching / %.3f ms, query grid %d tested / %d touching / %.3f ms (%.1fx)",
+                      count,
+                      bruteTestedPairs, bruteTouchingPairs, bruteMilliseconds,
+                      gridTestedPairs, gridTouchingPairs, gridMilliseconds,
+                      GetSpeedup(bruteMilliseconds, gridMilliseconds)));
+
+        DestroyActors(*map, handles);
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchRaycast rays=100000 maxLength=10
+// Casts the same random rays from open tiles through the old fixed-step march and Map::RaycastWorldXY,
+// and reports rays per second for both plus how many rays disagree on hit or miss.
+// Disagreements are rays that clip a wall corner or graze the floor/ceiling by less than one old step.
+STATIC bool Benchmark::OnBenchRaycast(EventArgs& args)
+{
+    Map const* map = GetCurrentMap();
+
+    if (map == nullptr) return false;
+
+    int const   rayCount  = args.GetValue("rays", 100000);
+    float const maxLength = args.GetValue("maxLength", 10.f);
+
+    std::vector<Vec3> startPositions;
+    std::vector<Vec3> forwardNormals;
+    startPositions.reserve(rayCount);
+    forwardNormals.reserve(rayCount);
+
+    for (int i = 0; i < rayCount; ++i)
+    {
+        IntVec2 const tileCoords = GetRandomOpenTileCoords(*map);
+
+        startPositions.emplace_back(static_cast<float>(tileCoords.x) + g_theRNG->RollRandomFloatInRange(0.f, 1.f),
+                                    static_cast<float>(tileCoords.y) + g_theRNG->RollRandomFloatInRange(0.f, 1.f),
+                                    g_theRNG->RollRandomFloatInRange(0.f, 1.f));
+
+        Vec3 forward, left, up;
+        EulerAngles(g_theRNG->RollRandomFloatInRange(0.f, 360.f), g_theRNG->RollRandomFloatInRange(-30.f, 30.f), 0.f).GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
+        forwardNormals.push_back(forward);
+    }
+
+    std::vector<bool> steppedHits(rayCount);
+    double const      steppedStartSeconds = GetCurrentTimeSeconds();
+
+    for (int i = 0; i < rayCount; ++i)
+    {
+        steppedHits[i] = RaycastWorldXYStepped(*map, startPositions[i], forwardNormals[i], maxLength).m_didImpact;
+    }
+
+    double const steppedSeconds = GetSecondsSince(steppedStartSeconds);
+
+    std::vector<bool> traversalHits(rayCount);
+    double const      traversalStartSeconds = GetCurrentTimeSeconds();
+
+    for (int i = 0; i < rayCount; ++i)
+    {
+        traversalHits[i] = map->RaycastWorldXY(startPositions[i], forwardNormals[i], maxLength).m_didImpact;
+    }
+
+    double const traversalSeconds = GetSecondsSince(traversalStartSeconds);
+
+    int hitCount      = 0;
+    int mismatchCount = 0;
+
+    for (int i = 0; i < rayCount; ++i)
+    {
+        if (traversalHits[i]) ++hitCount;
+        if (traversalHits[i] != steppedHits[i]) ++mismatchCount;
+    }
+
+    Print(Stringf("BenchRaycast %d rays of %.1f: fixed step %.0f rays/s, grid traversal %.0f rays/s (%.1fx), %d hits, %d hit/miss mismatches",
+                  rayCount, maxLength,
+                  static_cast<double>(rayCount) / steppedSeconds,
+                  static_cast<double>(rayCount) / traversalSeconds,
+                  GetSpeedup(steppedSeconds, traversalSeconds),
+                  hitCount, mismatchCount));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchRaycastBatch rays=100000 actors=1000 pellets=8 cone=5 maxLength=10
+// With actors demons added to the current map, casts the same rays one at a time through Map::RaycastAll and in one
+// Map::RaycastBatch, first as unrelated rays from random open tiles, then as shots of pellets rays sharing an origin.
+// Reports rays per millisecond for both and how many rays disagree on what they hit or where.
+STATIC bool Benchmark::OnBenchRaycastBatch(EventArgs& args)
+{
+    Map* map = GetCurrentMap();
+
+    if (map == nullptr) return false;
+
+    int const   rayCount    = std::max(args.GetValue("rays", 100000), 1);
+    int const   actorCount  = args.GetValue("actors", 1000);
+    int const   pelletCount = std::max(args.GetValue("pellets", 8), 1);
+    float const coneDegrees = args.GetValue("cone", 5.f);
+    float const maxLength   = args.GetValue("maxLength", 10.f);
+
+    std::vector<ActorHandle> handles;
+    SpawnActors(*map, "Demon", actorCount, handles);
+
+    auto const GetRandomOpenPosition = [map]()
+    {
+        IntVec2 const tileCoords = GetRandomOpenTileCoords(*map);
+
+        return Vec3(static_cast<float>(tileCoords.x) + g_theRNG->RollRandomFloatInRange(0.f, 1.f),
+                    static_cast<float>(tileCoords.y) + g_theRNG->RollRandomFloatInRange(0.f, 1.f),
+                    g_theRNG->RollRandomFloatInRange(0.f, 1.f));
+    };
+
+    auto const RunRays = [map, rayCount](char const* label, std::vector<BatchRay> const& rays, int raysPerBatch)
+    {
+        std::vector<RaycastResult3D> singleResults(rayCount);
+        std::vector<ActorHandle>     singleHandles(rayCount);
+        double const                 singleStartSeconds = GetCurrentTimeSeconds();
+
+        for (int i = 0; i < rayCount; ++i)
+        {
+            singleResults[i] = map->RaycastAll(nullptr, singleHandles[i], rays[i].m_startPosition, rays[i].m_forwardNormal, rays[i].m_maxLength);
+        }
+
+        double const singleSeconds = GetSecondsSince(singleStartSeconds);
+
+        std::vector<BatchRay>       batchRays;
+        std::vector<BatchRayResult> batchResults;
+        std::vector<BatchRayResult> allBatchResults;
+        allBatchResults.reserve(rayCount);
+        double const batchStartSeconds = GetCurrentTimeSeconds();
+
+        for (int batchStart = 0; batchStart < rayCount; batchStart += raysPerBatch)
+        {
+            batchRays.assign(rays.begin() + batchStart, rays.begin() + std::min(batchStart + raysPerBatch, rayCount));
+            map->RaycastBatch(nullptr, batchRays, batchResults);
+            allBatchResults.insert(allBatchResults.end(), batchResults.begin(), batchResults.end());
+        }
+
+        double const batchSeconds = GetSecondsSince(batchStartSeconds);
+
+        // RaycastAll reports the closest actor even when a wall is closer, so its actor is only compared when the batch hit one.
+        int hitCount      = 0;
+        int mismatchCount = 0;
+
+        for (int i = 0; i < rayCount; ++i)
+        {
+            RaycastResult3D const& single      = singleResults[i];
+            RaycastResult3D const& batch       = allBatchResults[i].m_result;
+            ActorHandle const&     batchHandle = allBatchResults[i].m_impactedActorHandle;
+
+            if (batch.m_didImpact) ++hitCount;
+
+            if (!IsSameImpact(single, batch) || (batchHandle.IsValid() && batchHandle != singleHandles[i])) ++mismatchCount;
+        }
+
+        Print(Stringf("BenchRaycastBatch %s: %d rays, RaycastAll %.0f rays/ms, RaycastBatch %.0f rays/ms (%.2fx), %d hits, %d mismatches",
+                      label, rayCount,
+                      static_cast<double>(rayCount) / (singleSeconds * 1000.0),
+                      static_cast<double>(rayCount) / (batchSeconds * 1000.0),
+                      GetSpeedup(singleSeconds, batchSeconds), hitCount, mismatchCount));
+    };
+
+    std::vector<BatchRay> rays(rayCount);
+
+    for (BatchRay& ray : rays)
+    {
+        Vec3 forward, left, up;
+        EulerAngles(g_theRNG->RollRandomFloatInRange(0.f, 360.f), g_theRNG->RollRandomFloatInRange(-30.f, 30.f), 0.f).GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
+        ray.m_startPosition = GetRandomOpenPosition();
+        ray.m_forwardNormal = forward;
+        ray.m_maxLength     = maxLength;
+    }
+
+    RunRays("unrelated rays", rays, rayCount);
+
+    std::vector<Vec3> pelletNormals;
+
+    for (int shotStart = 0; shotStart < rayCount; shotStart += pelletCount)
+    {
+        Vec3 const        startPosition = GetRandomOpenPosition();
+        EulerAngles const orientation   = EulerAngles(g_theRNG->RollRandomFloatInRange(0.f, 360.f), g_theRNG->RollRandomFloatInRange(-10.f, 10.f), 0.f);
+        Weapon::GetRayDirectionsInCone(orientation, coneDegrees, pelletCount, pelletNormals);
+
+        for (int pelletIndex = 0; pelletIndex < pelletCount && shotStart + pelletIndex < rayCount; ++pelletIndex)
+        {
+            rays[shotStart + pelletIndex].m_startPosition = startPosition;
+            rays[shotStart + pelletIndex].m_forwardNormal = pelletNormals[pelletIndex];
+        }
+    }
+
+    RunRays(Stringf("shots of %d pellets", pelletCount).c_str(), rays, pelletCount);
+
+    DestroyActors(*map, handles);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchSpatialQueries actors=1000 queries=4 ticks=30 maxLength=10
+// With actors demons added to the current map, every living actor asks queries rays a tick, as AIs firing from Think
+// would. Compares casting them on the spot, one Map::RaycastAll at a time, with queueing them as spatial queries and
+// answering them all at once through a SpatialQueryService. Reports the queries per tick, the milliseconds per tick
+// of both and how many answers disagree on what they hit or where.
+STATIC bool Benchmark::OnBenchSpatialQueries(EventArgs& args)
+{
+    Map* map = GetCurrentMap();
+
+    if (map == nullptr) return false;
+
+    int const   actorCount      = args.GetValue("actors", 1000);
+    int const   queriesPerActor = std::max(args.GetValue("queries", 4), 1);
+    int const   tickCount       = std::max(args.GetValue("ticks", 30), 1);
+    float const maxLength       = args.GetValue("maxLength", 10.f);
+
+    std::vector<ActorHandle> handles;
+    SpawnActors(*map, "Demon", actorCount, handles);
+
+    SpatialQueryService             service;
+    std::vector<BatchRay>           rays;
+    std::vector<Actor*>             rayActors;
+    std::vector<SpatialQueryResult> answers;
+    double                          immediateSeconds = 0.0;
+    double                          deferredSeconds  = 0.0;
+    double                          resolveSeconds   = 0.0;
+    int                             queryCount       = 0;
+    int                             hitCount         = 0;
+    int                             mismatchCount    = 0;
+
+    for (int tick = 0; tick < tickCount; ++tick)
+    {
+        rays.clear();
+        rayActors.clear();
+
+        for (Actor* actor : map->m_actors)
+        {
+            if (actor->m_isDead) continue;
+
+            for (int i = 0; i < queriesPerActor; ++i)
+            {
+                Vec3 forward, left, up;
+                EulerAngles(g_theRNG->RollRandomFloatInRange(0.f, 360.f), g_theRNG->RollRandomFloatInRange(-10.f, 10.f), 0.f).GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
+
+                BatchRay ray;
+                ray.m_startPosition = actor->GetPosition() + Vec3(0.f, 0.f, actor->m_definition->m_eyeHeight);
+                ray.m_forwardNormal = forward;
+                ray.m_maxLength     = maxLength;
+                rays.push_back(ray);
+                rayActors.push_back(actor);
+            }
+        }
+
+        int const tickQueryCount = static_cast<int>(rays.size());
+        queryCount += tickQueryCount;
+
+        std::vector<RaycastResult3D> immediateResults(tickQueryCount);
+        double const                 immediateStartSeconds = GetCurrentTimeSeconds();
+
+        for (int i = 0; i < tickQueryCount; ++i)
+        {
+            ActorHandle impactedActorHandle;
+            immediateResults[i] = map->RaycastAll(rayActors[i], impactedActorHandle, rays[i].m_startPosition, rays[i].m_forwardNormal, rays[i].m_maxLength);
+        }
+
+        immediateSeconds += GetSecondsSince(immediateStartSeconds);
+
+        // The answers' slots must not move once queued.
+        answers.assign(tickQueryCount, SpatialQueryResult());
+        double const deferredStartSeconds = GetCurrentTimeSeconds();
+
+        for (int i = 0; i < tickQueryCount; ++i)
+        {
+            SpatialQuery query;
+            query.m_type       = eSpatialQueryType::RAY;
+            query.m_ray        = rays[i];
+            query.m_resultSlot = &answers[i];
+            rayActors[i]->m_queries.push_back(query);
+        }
+
+        service.Resolve(*map, map->m_actors, static_cast<int>(map->m_actors.size()));
+
+        for (Actor* actor : map->m_actors)
+        {
+            service.Deliver(*actor);
+        }
+
+        deferredSeconds += GetSecondsSince(deferredStartSeconds);
+        resolveSeconds += static_cast<double>(service.GetResolveMilliseconds()) / 1000.0;
+
+        for (int i = 0; i < tickQueryCount; ++i)
+        {
+            RaycastResult3D const& immediate = immediateResults[i];
+            RaycastResult3D const& deferred  = answers[i].m_rayResult.m_result;
+
+            if (deferred.m_didImpact) ++hitCount;
+
+            if (!IsSameImpact(immediate, deferred)) ++mismatchCount;
+        }
+    }
+
+    Print(Stringf("BenchSpatialQueries: %d queries/tick, immediate %.3f ms/tick, deferred %.3f ms/tick (resolve %.3f ms, %.2fx), %d hits, %d mismatches",
+                  queryCount / tickCount,
+                  immediateSeconds * 1000.0 / tickCount,
+                  deferredSeconds * 1000.0 / tickCount,
+                  resolveSeconds * 1000.0 / tickCount,
+                  GetSpeedup(immediateSeconds, deferredSeconds), hitCount, mismatchCount));
+
+    DestroyActors(*map, handles);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// BenchActorQueries actors=10000 queries=10000 radius=4 halfAngle=45 nearest=8 length=10 width=0.5
+// With actors demons added to the current map, asks each query shape queries times from random open positions, through
+// an ActorQueryGrid and through a linear pass over every actor as the callers used to. Reports the grid's rebuild time,
+// queries per millisecond for both and how many answers disagree.
+STATIC bool Benchmark::OnBenchActorQueries(EventArgs& args)
+{
+    Map* map = GetCurrentMap();
+
+    if (map == nullptr) return false;
+
+    int const     actorCount       = args.GetValue("actors", 10000);
+    int const     queryCount       = std::max(args.GetValue("queries", 10000), 1);
+    float const   radius           = args.GetValue("radius", 4.f);
+    float const   halfAngleDegrees = args.GetValue("halfAngle", 45.f);
+    int const     nearestCount     = std::max(args.GetValue("nearest", 8), 1);
+    float const   length           = args.GetValue("length", 10.f);
+    float const   halfWidth        = args.GetValue("width", 0.5f);
+    IntVec2 const dimensions       = map->GetDimensions();
+
+    std::vector<ActorHandle> handles;
+    SpawnActors(*map, "Demon", actorCount, handles);
+
+    ActorQueryGrid grid;
+    grid.Initialize(dimensions);
+
+    double const rebuildStartSeconds = GetCurrentTimeSeconds();
+    grid.Rebuild(map->m_actors);
+    double const rebuildSeconds = GetSecondsSince(rebuildStartSeconds);
+
+    Print(Stringf("BenchActorQueries: %d actors, rebuild %.3f ms", grid.GetActorCount(), rebuildSeconds * 1000.0));
+
+    std::vector<Vec2> centers(queryCount);
+    std::vector<Vec2> directions(queryCount);
+
+    for (int i = 0; i < queryCount; ++i)
+    {
+        IntVec2 const tileCoords = GetRandomOpenTileCoords(*map);
+
+        float const directionDegrees = g_theRNG->RollRandomFloatInRange(0.f, 360.f);
+        centers[i]                   = Vec2(static_cast<float>(tileCoords.x) + g_theRNG->RollRandomFloatInRange(0.f, 1.f), static_cast<float>(tileCoords.y) + g_theRNG->RollRandomFloatInRange(0.f, 1.f));
+        directions[i]                = Vec2(CosDegrees(directionDegrees), SinDegrees(directionDegrees));
+    }
+
+    ActorQueryFilter const filter;
+    float const            minDotProduct = CosDegrees(halfAngleDegrees);
+
+    typedef std::function<void(int queryIndex, std::vector<ActorQueryHit>& out_hits)> QueryFunction;
+
+    // The linear pass keeps every hit its shape accepts, and trims to the closest for the nearest shape.
+    auto const QueryLinear = [map](std::function<bool(Actor* actor, float& out_distance)> const& IsHit, std::vector<ActorQueryHit>& out_hits)
+    {
+        out_hits.clear();
+
+        for (Actor* actor : map->m_actors)
+        {
+            float distance = 0.f;
+
+            if (actor->m_isDead || !IsHit(actor, distance)) continue;
+
+            out_hits.push_back(ActorQueryHit{actor, distance});
+        }
+    };
+
+    auto const RunShape = [queryCount](char const* label, QueryFunction const& QueryGrid, QueryFunction const& QueryReference)
+    {
+        std::vector<std::vector<ActorQueryHit>> gridHits(queryCount);
+        std::vector<std::vector<ActorQueryHit>> referenceHits(queryCount);
+
+        double const gridStartSeconds = GetCurrentTimeSeconds();
+
+        for (int i = 0; i < queryCount; ++i)
+        {
+            QueryGrid(i, gridHits[i]);
+        }
+
+        double const gridSeconds           = GetSecondsSince(gridStartSeconds);
+        double const referenceStartSeconds = GetCurrentTimeSeconds();
+
+        for (int i = 0; i < queryCount; ++i)
+        {
+            QueryReference(i, referenceHits[i]);
+        }
+
+        double const referenceSeconds = GetSecondsSince(referenceStartSeconds);
+
+        // Compared by distance, since actors as close may come back in either order.
+        int hitCount      = 0;
+        int mismatchCount = 0;
+
+        auto const IsCloser = [](ActorQueryHit const& a, ActorQueryHit const& b) { return a.m_distance < b.m_distance; };
+
+        for (int i = 0; i < queryCount; ++i)
+        {
+            std::sort(gridHits[i].begin(), gridHits[i].end(), IsCloser);
+            std::sort(referenceHits[i].begin(), referenceHits[i].end(), IsCloser);
+            hitCount += static_cast<int>(gridHits[i].size());
+
+            bool isMismatch = gridHits[i].size() != referenceHits[i].size();
+
+            for (size_t hitIndex = 0; !isMismatch && hitIndex < gridHits[i].size(); ++hitIndex)
+            {
+                isMismatch = fabsf(gridHits[i][hitIndex].m_distance - referenceHits[i][hitIndex].m_distance) > 0.0001f;
+            }
+
+            if (isMismatch) ++mismatchCount;
+        }
+
+        Print(Stringf("BenchActorQueries %s: linear %.1f queries/ms, grid %.1f queries/ms (%.1fx), %.1f hits/query, %d mismatches",
+                      label,
+                      static_cast<double>(queryCount) / (referenceSeconds * 1000.0),
+                      static_cast<double>(queryCount) / (gridSeconds * 1000.0),
+                      GetSpeedup(referenceSeconds, gridSeconds),
+                      static_cast<double>(hitCount) / static_cast<double>(queryCount), mismatchCount));
+    };
+
+    RunShape("disc",
+             [&](int const i, std::vector<ActorQueryHit>& out_hits) { grid.QueryDisc(centers[i], radius, filter, out_hits); },
+             [&](int const i, std::vector<ActorQueryHit>& out_hits)
+             {
+                 QueryLinear([&](Actor* actor, float& out_distance)
+                 {
+                     out_distance = GetDistance2D(Vec2(actor->GetPosition().x, actor->GetPosition().y), centers[i]);
+                     return out_distance <= radius;
+                 }, out_hits);
+             });
+
+    RunShape("sector",
+             [&](int const i, std::vector<ActorQueryHit>& out_hits) { grid.QuerySector(centers[i], directions[i], halfAngleDegrees, radius, filter, out_hits); },
+             [&](int const i, std::vector<ActorQueryHit>& out_hits)
+             {
+                 QueryLinear([&](Actor* actor, float& out_distance)
+                 {
+                     Vec2 const toActor = Vec2(actor->GetPosition().x, actor->GetPosition().y) - centers[i];
+                     out_distance       = toActor.GetLength();
+                     return out_distance <= radius && (out_distance == 0.f || DotProduct2D(toActor, directions[i]) >= minDotProduct * out_distance);
+                 }, out_hits);
+             });
+
+    RunShape(Stringf("nearest %d", nearestCount).c_str(),
+             [&](int const i, std::vector<ActorQueryHit>& out_hits) { grid.QueryNearest(centers[i], nearestCount, FLT_MAX, filter, out_hits); },
+             [&](int const i, std::vector<ActorQueryHit>& out_hits)
+             {
+                 QueryLinear([&](Actor* actor, float& out_distance)
+                 {
+                     out_distance = GetDistance2D(Vec2(actor->GetPosition().x, actor->GetPosition().y), centers[i]);
+                     return true;
+                 }, out_hits);
+
+                 int const keptCount = std::min(nearestCount, static_cast<int>(out_hits.size()));
+                 std::partial_sort(out_hits.begin(), out_hits.begin() + keptCount, out_hits.end(), [](ActorQueryHit const& a, ActorQueryHit const& b) { return a.m_distance < b.m_distance; });
+                 out_hits.resize(keptCount);
+             });
+
+    RunShape("segment",
+             [&](int const i, std::vector<ActorQueryHit>& out_hits) { grid.QuerySegment(centers[i], centers[i] + directions[i] * length, halfWidth, filter, out_hits); },
+             [&](int const i, std::vector<ActorQueryHit>& out_hits)
+             {
+                 QueryLinear([&](Actor* actor, float& out_distance)
+                 {
+                     Vec2 const actorPosition = Vec2(actor->GetPosition().x, actor->GetPosition().y);
+                     out_distance             = GetClamped(DotProduct2D(actorPosition - centers[i], directions[i]), 0.f, length);
+                     return GetDistance2D(actorPosition, centers[i] + directions[i] * out_distance) <= halfWidth;
+                 }, out_hits);
+             });
+
+    DestroyActors(*map, handles);
+
+    return true;
+}
@@ -0,0 +1,239 @@
+//----------------------------------------------------------------------------------------------------
+// BenchmarkRendering.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Definition/EffectDefinition.hpp"
+#include "Game/Framework/AnimationGroup.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/SpriteBatcher.hpp"
+#include "Game/Gameplay/Game.hpp"
+#include "Game/Gameplay/Map.hpp"
+#include "Game/Gameplay/ParticleSystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// BenchParticles count=100000 capacity=65536 ticks=60 effect=BulletHit
+// Spawns count effects into a particle system of its own, overflowing it when count is past the capacity,
+// then times its update per tick, with ticks short enough that every particle lives through all of them.
+// Needs no map; no actor is spawned and no handle is used.
+STATIC bool Benchmark::OnBenchParticles(EventArgs& args)
+{
+    int const    effectCount = args.GetValue("count", 100000);
+    int const    capacity    = args.GetValue("capacity", 65536);
+    int const    tickCount   = std::max(args.GetValue("ticks", 60), 1);
+    String const effectName  = args.GetValue("effect", "BulletHit");
+    int const    effectIndex = EffectDefinition::GetDefIndexByName(effectName);
+
+    if (effectIndex < 0)
+    {
+        Print(Stringf("BenchParticles: there is no effect definition named %s.", effectName.c_str()));
+        return false;
+    }
+
+    float const    deltaSeconds = EffectDefinition::s_effectDefinitions[effectIndex]->m_lifetime / static_cast<float>(tickCount + 1);
+    ParticleSystem particleSystem(capacity);
+    double const   spawnStartSeconds = GetCurrentTimeSeconds();
+
+    for (int i = 0; i < effectCount; ++i)
+    {
+        particleSystem.SpawnEffect(effectIndex, Vec3(g_theRNG->RollRandomFloatInRange(0.f, 32.f), g_theRNG->RollRandomFloatInRange(0.f, 32.f), 0.5f));
+    }
+
+    double const spawnSeconds = GetSecondsSince(spawnStartSeconds);
+    int const    spawnedCount = particleSystem.GetCount();
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    for (int tick = 0; tick < tickCount; ++tick)
+    {
+        particleSystem.Update(deltaSeconds);
+    }
+
+    double const milliseconds = GetMillisecondsSince(startSeconds) / tickCount;
+
+    Print(Stringf("BenchParticles %d %s effects: %.0f ns per effect, %d of %d particles live, %.3f ms per tick (%.2f ns per particle) over %d ticks",
+                  effectCount, effectName.c_str(), spawnSeconds * 1.0e9 / std::max(effectCount, 1),
+                  spawnedCount, particleSystem.GetCapacity(), milliseconds,
+                  spawnedCount > 0 ? milliseconds * 1.0e6 / spawnedCount : 0.0, tickCount));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// TestSpriteBatch sprites=5000 shaders=2 textures=4
+// Feeds a renderer-less SpriteBatcher sprites with every (shader, texture) pair in turn, using stand-in pointers,
+// and checks that it submits one draw per pair and exactly the bytes of the sprites' vertexes.
+// With a renderer and a map, also reports what the last frame's actor pass of the current map submitted.
+STATIC bool Benchmark::OnTestSpriteBatch(EventArgs& args)
+{
+    int const spriteCount  = std::max(args.GetValue("sprites", 5000), 1);
+    int const shaderCount  = std::max(args.GetValue("shaders", 2), 1);
+    int const textureCount = std::max(args.GetValue("textures", 4), 1);
+
+    SpriteBatcher batcher(nullptr);
+
+    // One sprite alone gives the bytes per sprite.
+    batcher.Begin();
+    batcher.AddQuad(nullptr, nullptr, eRasterizerMode::SOLID_CULL_NONE, Vec3::ZERO, Vec3::ZERO, Vec3::ZERO, Vec3::ZERO, AABB2(Vec2::ZERO, Vec2::ONE));
+    batcher.End();
+    size_t const bytesPerSprite = batcher.GetSubmittedBytes();
+
+    double const startSeconds = GetCurrentTimeSeconds();
+    batcher.Begin();
+
+    for (int i = 0; i < spriteCount; ++i)
+    {
+        // Stand-ins only, never dereferenced without a renderer.
+        Shader*        shader  = reinterpret_cast<Shader*>(static_cast<uintptr_t>(0x1000 + (i % shaderCount) * 0x10));
+        Texture const* texture = reinterpret_cast<Texture const*>(static_cast<uintptr_t>(0x2000 + (i / shaderCount % textureCount) * 0x10));
+        Vec3 const     center  = Vec3(static_cast<float>(i % 64), static_cast<float>(i / 64), 0.5f);
+
+        batcher.AddQuad(shader, texture, eRasterizerMode::SOLID_CULL_BACK, center, center + Vec3(0.f, 1.f, 0.f), center + Vec3(0.f, 0.f, 1.f), center + Vec3(0.f, 1.f, 1.f), AABB2(Vec2::ZERO, Vec2::ONE));
+    }
+
+    batcher.End();
+    double const milliseconds = GetMillisecondsSince(startSeconds);
+
+    int const    materialCount = std::min(spriteCount, shaderCount * textureCount);
+    size_t const expectedBytes = bytesPerSprite * static_cast<size_t>(spriteCount);
+    bool const   isPassed      = batcher.GetSpriteCount() == spriteCount && batcher.GetDrawCount() == materialCount && batcher.GetSubmittedBytes() == expectedBytes;
+
+    Print(Stringf("TestSpriteBatch %d sprites over %d materials: %d draws (was %d), %zu bytes (expected %zu), %.3f ms to batch: %s",
+                  spriteCount, materialCount, batcher.GetDrawCount(), spriteCount,
+                  batcher.GetSubmittedBytes(), expectedBytes, milliseconds, GetPassText(isPassed)));
+
+    if (g_theRenderer != nullptr && g_theGame != nullptr && g_theGame->m_currentMap != nullptr)
+    {
+        SpriteBatcher const& mapBatcher = g_theGame->m_currentMap->GetSpriteBatcher();
+
+        Print(Stringf("TestSpriteBatch current map, last view: %d actor sprites in %d draws, %zu bytes",
+                      mapBatcher.GetSpriteCount(), mapBatcher.GetDrawCount(), mapBatcher.GetSubmittedBytes()));
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The yaw table is checked against a brute-force search by yaw angle, independent of the dot products the table
+// was built with, at yaws spread across each sector away from its center and at random yaws. Snapping to a sector
+// may pick a direction up to one sector's width worse than the closest one near a boundary, but never more.
+STATIC bool Benchmark::OnTestAnimationLookup(EventArgs& args)
+{
+    int const lookupCount = std::max(args.GetValue("lookups", 1000000), 1);
+
+    std::vector<AnimationGroup const*> groups;
+
+    for (ActorDefinition const* definition : ActorDefinition::s_actorDefinitions)
+    {
+        for (AnimationGroup const& group : definition->m_animationGroup)
+        {
+            groups.push_back(&group);
+        }
+    }
+
+    if (groups.empty())
+    {
+        Print("TestAnimationLookup needs animation groups, which only load with a renderer");
+        return true;
+    }
+
+    float const sectorDegrees      = 360.f / AnimationGroup::SECTOR_COUNT;
+    float       worstErrorDegrees  = 0.f;
+    int         exactMismatchCount = 0;
+    int         failedCount        = 0;
+    int         checkCount         = 0;
+
+    auto const GetYawErrorDegrees = [](AnimationGroup const& group, int const animationIndex, float const yawDegrees)
+    {
+        Vec3 const& direction = group.GetAnimationDirection(animationIndex);
+
+        return fabsf(GetShortestAngularDispDegrees(yawDegrees, Atan2Degrees(direction.y, direction.x)));
+    };
+
+    auto const CheckYaw = [&](AnimationGroup const& group, float const yawDegrees)
+    {
+        int   closestIndex        = 0;
+        float closestErrorDegrees = FLT_MAX;
+
+        for (int animationIndex = 0; animationIndex < group.GetAnimationCount(); ++animationIndex)
+        {
+            float const errorDegrees = GetYawErrorDegrees(group, animationIndex, yawDegrees);
+
+            if (errorDegrees < closestErrorDegrees)
+            {
+                closestErrorDegrees = errorDegrees;
+                closestIndex        = animationIndex;
+            }
+        }
+
+        int const   tableIndex   = group.GetAnimationIndex(Vec3(CosDegrees(yawDegrees), SinDegrees(yawDegrees), 0.f));
+        float const extraDegrees = GetYawErrorDegrees(group, tableIndex, yawDegrees) - closestErrorDegrees;
+
+        worstErrorDegrees = std::max(worstErrorDegrees, extraDegrees);
+        ++checkCount;
+
+        if (tableIndex != closestIndex) ++exactMismatchCount;
+        if (extraDegrees > sectorDegrees + 0.001f) ++failedCount;
+    };
+
+    for (AnimationGroup const* group : groups)
+    {
+        for (int sectorIndex = 0; sectorIndex < AnimationGroup::SECTOR_COUNT; ++sectorIndex)
+        {
+            for (float const fraction : { 0.01f, 0.2f, 0.4f, 0.6f, 0.8f, 0.99f })
+            {
+                CheckYaw(*group, (static_cast<float>(sectorIndex) + fraction) * sectorDegrees - 180.f);
+            }
+        }
+    }
+
+    std::vector<Vec3> directions;
+    directions.reserve(lookupCount);
+
+    for (int i = 0; i < lookupCount; ++i)
+    {
+        float const yawDegrees = g_theRNG->RollRandomFloatInRange(-180.f, 180.f);
+        directions.push_back(Vec3(CosDegrees(yawDegrees), SinDegrees(yawDegrees), 0.f));
+    }
+
+    int          checksum           = 0;
+    double const searchStartSeconds = GetCurrentTimeSeconds();
+
+    for (int i = 0; i < lookupCount; ++i)
+    {
+        checksum += groups[i % groups.size()]->FindClosestAnimationIndex(directions[i]);
+    }
+
+    double const searchMilliseconds = GetMillisecondsSince(searchStartSeconds);
+    double const tableStartSeconds  = GetCurrentTimeSeconds();
+
+    for (int i = 0; i < lookupCount; ++i)
+    {
+        checksum -= groups[i % groups.size()]->GetAnimationIndex(directions[i]);
+    }
+
+    double const tableMilliseconds = GetMillisecondsSince(tableStartSeconds);
+
+    for (int i = 0; i < lookupCount; ++i)
+    {
+        CheckYaw(*groups[i % groups.size()], Atan2Degrees(directions[i].y, directions[i].x));
+    }
+
+    bool const isPassed = failedCount == 0;
+
+    Print(Stringf("TestAnimationLookup %d groups, %d yaws: %d pick another direction than the closest, worst by %.3f degrees (sector %.3f), %d beyond a sector (checksum %d)",
+                  static_cast<int>(groups.size()), checkCount, exactMismatchCount, worstErrorDegrees, sectorDegrees, failedCount, checksum));
+    Print(Stringf("TestAnimationLookup closest-direction search %.3f ms, yaw table %.3f ms: %s",
+                  searchMilliseconds, tableMilliseconds, GetPassText(isPassed)));
+
+    return isPassed;
+}
@@ -13,6 +13,7 @@ class Game;
 class LightSubsystem;
 class Renderer;
 class RandomNumberGenerator;
+class WorkerPool;
 
 // one-time declaration
 extern App*                   g_theApp;
@@ -22,6 +23,7 @@ extern Game*                  g_theGame;
 extern Renderer*              g_theRenderer;
 extern RandomNumberGenerator* g_theRNG;
 extern LightSubsystem*         g_theLightSubsystem;
+extern WorkerPool*            g_theWorkerPool;
 
 //----------------------------------------------------------------------------------------------------
 template <typename T>
@@ -0,0 +1,96 @@
+//----------------------------------------------------------------------------------------------------
+// NameTable.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/NameTable.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// In the order of the built-in ids in NameTable.hpp.
+static char const* s_builtInNames[] =
+{
+    "NEUTRAL",
+    "SpawnPoint",
+    "Marine",
+    "Demon",
+    "PlasmaProjectile",
+    "Walk",
+    "Attack",
+    "Death",
+    "Hurt",
+    "Fire",
+    "BulletHit",
+    "BloodSplatter",
+};
+
+static_assert(sizeof(s_builtInNames) / sizeof(s_builtInNames[0]) == NameTable::BUILT_IN_COUNT, "Built-in names and ids must match");
+
+//----------------------------------------------------------------------------------------------------
+NameTable::NameTable()
+{
+    for (char const* builtInName : s_builtInNames)
+    {
+        NameID const nameID = static_cast<NameID>(m_names.size());
+
+        m_names.push_back(builtInName);
+        m_nameIDs[builtInName] = nameID;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC NameID NameTable::Intern(String const& name)
+{
+    NameTable& table = GetInstance();
+
+    std::unordered_map<String, NameID>::const_iterator const it = table.m_nameIDs.find(name);
+
+    if (it != table.m_nameIDs.end()) return it->second;
+
+    NameID const nameID = static_cast<NameID>(table.m_names.size());
+
+    table.m_names.push_back(name);
+    table.m_nameIDs[name] = nameID;
+
+    return nameID;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC NameID NameTable::Find(String const& name)
+{
+    NameTable const& table = GetInstance();
+
+    std::unordered_map<String, NameID>::const_iterator const it = table.m_nameIDs.find(name);
+
+    return it != table.m_nameIDs.end() ? it->second : INVALID;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC String const& NameTable::GetName(NameID const nameID)
+{
+    NameTable const& table = GetInstance();
+
+    if (nameID < 0 || nameID >= static_cast<NameID>(table.m_names.size()))
+    {
+        ERROR_AND_DIE("Name id was never interned")
+    }
+
+    return table.m_names[nameID];
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC int NameTable::GetCount()
+{
+    return static_cast<int>(GetInstance().m_names.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Built on first use, so the built-in names are in place before anything is interned.
+STATIC NameTable& NameTable::GetInstance()
+{
+    static NameTable s_nameTable;
+
+    return s_nameTable;
+}
@@ -0,0 +1,53 @@
+//----------------------------------------------------------------------------------------------------
+// NameTable.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Core/StringUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Dense id of an interned name. Equal names get equal ids, so comparing names is comparing ints.
+typedef int NameID;
+
+//----------------------------------------------------------------------------------------------------
+// Interns the names definitions are looked up by: actor, effect and weapon definitions, animation groups,
+// sounds and factions. Names are interned while definitions load, on the main thread; afterwards the table
+// is only read, so ids can be compared and looked up from the parallel actor phases.
+// The names the code refers to by literal are interned first, in order, so their ids are constants.
+class NameTable
+{
+public:
+    static constexpr NameID INVALID = -1;
+
+    // Built-in names, see s_builtInNames.
+    static constexpr NameID NEUTRAL           = 0;
+    static constexpr NameID SPAWN_POINT       = 1;
+    static constexpr NameID MARINE            = 2;
+    static constexpr NameID DEMON             = 3;
+    static constexpr NameID PLASMA_PROJECTILE = 4;
+    static constexpr NameID WALK              = 5;
+    static constexpr NameID ATTACK            = 6;
+    static constexpr NameID DEATH             = 7;
+    static constexpr NameID HURT              = 8;
+    static constexpr NameID FIRE              = 9;
+    static constexpr NameID BULLET_HIT        = 10;
+    static constexpr NameID BLOOD_SPLATTER    = 11;
+    static constexpr NameID BUILT_IN_COUNT    = 12;
+
+    static NameID        Intern(String const& name);
+    static NameID        Find(String const& name);     // INVALID if the name was never interned.
+    static String const& GetName(NameID nameID);
+    static int           GetCount();
+
+private:
+    NameTable();
+
+    static NameTable& GetInstance();
+
+    std::unordered_map<String, NameID> m_nameIDs;
+    std::vector<String>                m_names;     // Indexed by NameID.
+};
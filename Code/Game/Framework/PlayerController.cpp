@@ -48,17 +48,22 @@ PlayerController::~PlayerController()
 }
 
 //----------------------------------------------------------------------------------------------------
+// Runs once per frame on the system clock. The world camera is updated by Game::UpdateWorldCameras after the simulation.
 void PlayerController::Update(float const deltaSeconds)
 {
     UpdateInput(deltaSeconds);
-
-    UpdateWorldCamera();
 }
 
 void PlayerController::UpdateInput(float const deltaSeconds)
 {
     UNUSED(deltaSeconds)
 
+    // Movement is held on the actor until the next frame replaces it, however many simulation ticks run in between.
+    if (Actor* possessedActor = GetActor())
+    {
+        possessedActor->m_heldMoveForce = Vec3::ZERO;
+    }
+
     switch (m_deviceType)
     {
     case eDeviceType::CONTROLLER:
@@ -95,7 +100,7 @@ void PlayerController::Render() const
     if (!m_actorHandle.IsValid()) return;
     if (m_isCameraMode) return;
     Actor* possessActor = m_map->GetActorByHandle(m_actorHandle);
-    if (possessActor&&possessActor->m_definition->m_name == "Marine")
+    if (possessActor&&possessActor->m_definition->m_nameID == NameTable::MARINE)
     {
         if (possessActor->m_currentWeapon) possessActor->m_currentWeapon->Render();
     }
@@ -158,7 +163,7 @@ void PlayerController::UpdateFromKeyboard(float deltaSeconds)
         Actor* possessedActor = GetActor();
 
         if (possessedActor == nullptr) return;
-        if (possessedActor->m_definition->m_name == "Marine")
+        if (possessedActor->m_definition->m_nameID == NameTable::MARINE)
         {
             if (possessedActor->m_currentWeapon)
             {
@@ -199,23 +204,23 @@ void PlayerController::UpdateFromKeyboard(float deltaSeconds)
 
         if (g_theInput->IsKeyDown(KEYCODE_W))
         {
-            possessedActor->MoveInDirection(forward, speed);
-            possessedActor->PlayAnimationByName("Walk");
+            possessedActor->HoldMoveInDirection(forward, speed);
+            possessedActor->PlayAnimationByNameID(NameTable::WALK);
         }
 
         if (g_theInput->IsKeyDown(KEYCODE_S))
         {
-            possessedActor->MoveInDirection(-forward, speed);
+            possessedActor->HoldMoveInDirection(-forward, speed);
         }
 
         if (g_theInput->IsKeyDown(KEYCODE_A))
         {
-            possessedActor->MoveInDirection(left, speed);
+            possessedActor->HoldMoveInDirection(left, speed);
         }
 
         if (g_theInput->IsKeyDown(KEYCODE_D))
         {
-            possessedActor->MoveInDirection(-left, speed);
+            possessedActor->HoldMoveInDirection(-left, speed);
         }
     }
     else
@@ -301,8 +306,8 @@ if (!m_isCameraMode)
         // Combine X / Y stick input into one movement vector
         Vec3 moveDir = forward * leftStickPos.y + -left * leftStickPos.x;
         moveDir.z    = 0.f;
-        possessActor->MoveInDirection(moveDir.GetNormalized(), actorSpeed);
-        possessActor->PlayAnimationByName("Walk");
+        possessActor->HoldMoveInDirection(moveDir.GetNormalized(), actorSpeed);
+        possessActor->PlayAnimationByNameID(NameTable::WALK);
     }
 
     if (controller.WasButtonJustPressed(XBOX_BUTTON_DPAD_DOWN))
@@ -353,25 +358,28 @@ void PlayerController::UpdateWorldCamera()
         {
             // m_worldCamera->SetOrthoGraphicView(Vec2(-1, -1), Vec2(1, 1));
             // m_worldCamera->SetPerspectiveGraphicView(2.0f, possessedActor->m_definition->m_cameraFOV, 0.1f, 100.f);
-            m_worldCamera->SetPerspectiveGraphicView(2.0f, possessedActor->m_definition->m_cameraFOV, 0.1f, 100.f);
+            m_worldCameraFOV = possessedActor->m_definition->m_cameraFOV;
+            m_worldCamera->SetPerspectiveGraphicView(WORLD_CAMERA_ASPECT, m_worldCameraFOV, WORLD_CAMERA_NEAR, WORLD_CAMERA_FAR);
             // Set the world camera to use the possessed actor's eye height and FOV.
-            m_position = Vec3(possessedActor->m_position.x, possessedActor->m_position.y, possessedActor->m_definition->m_eyeHeight);
+            Vec3 const renderPosition = possessedActor->GetRenderPosition();
+            m_position                = Vec3(renderPosition.x, renderPosition.y, possessedActor->m_definition->m_eyeHeight);
             // m_position += Vec3::X_BASIS;
             m_orientation = possessedActor->m_orientation;
         }
         else
         {
-            m_worldCamera->SetPerspectiveGraphicView(2.0f, possessedActor->m_definition->m_cameraFOV, 0.1f, 100.f);
+            m_worldCameraFOV = possessedActor->m_definition->m_cameraFOV;
+            m_worldCamera->SetPerspectiveGraphicView(WORLD_CAMERA_ASPECT, m_worldCameraFOV, WORLD_CAMERA_NEAR, WORLD_CAMERA_FAR);
         }
     }
 
     if (possessedActor->m_isDead)
     {
-        Vec3  startPos      = possessedActor->m_position + Vec3(0.f, 0.f, possessedActor->m_definition->m_eyeHeight);
-        Vec3  endPos        = possessedActor->m_position;
+        Vec3  endPos        = possessedActor->GetPosition();
+        Vec3  startPos      = endPos + Vec3(0.f, 0.f, possessedActor->m_definition->m_eyeHeight);
         float deathFraction = possessedActor->m_dead / possessedActor->m_definition->m_corpseLifetime;
         float interpolate   = Interpolate(startPos.z, endPos.z, deathFraction);
-        m_position          = Vec3(possessedActor->m_position.x, possessedActor->m_position.y, interpolate);
+        m_position          = Vec3(endPos.x, endPos.y, interpolate);
     }
 
     m_viewCamera->SetOrthoGraphicView(g_theGame->m_screenSpace.m_mins, g_theGame->m_screenSpace.m_maxs);
@@ -384,6 +392,14 @@ void PlayerController::UpdateWorldCamera()
     m_worldCamera->SetCameraToRenderTransform(ndcMatrix);
 }
 
+//----------------------------------------------------------------------------------------------------
+// Matches the projection set up in UpdateWorldCamera, for culling map chunks against this player's view.
+ViewFrustum PlayerController::GetWorldCameraFrustum() const
+{
+    return ViewFrustum(m_position, m_orientation, m_worldCameraFOV, WORLD_CAMERA_ASPECT, WORLD_CAMERA_NEAR, WORLD_CAMERA_FAR);
+}
+
+//----------------------------------------------------------------------------------------------------
 Mat44 PlayerController::GetModelToWorldTransform() const
 {
     Mat44 m2w;
@@ -9,6 +9,7 @@
 
 #include "Engine/Math/EulerAngles.hpp"
 #include "Game/Framework/Controller.hpp"
+#include "Game/Framework/ViewFrustum.hpp"
 
 //----------------------------------------------------------------------------------------------------
 class Camera;
@@ -40,11 +41,17 @@ public:
     eDeviceType SetInputDeviceType(eDeviceType newDeviceType);
     eDeviceType GetInputDeviceType() const;
     Mat44       GetModelToWorldTransform() const;
+    ViewFrustum GetWorldCameraFrustum() const;
+
+    static constexpr float WORLD_CAMERA_ASPECT = 2.f;
+    static constexpr float WORLD_CAMERA_NEAR   = 0.1f;
+    static constexpr float WORLD_CAMERA_FAR    = 100.f;
 
     Vec3        m_position     = Vec3::ZERO;
     Vec3        m_velocity     = Vec3::ZERO;
     EulerAngles m_orientation  = EulerAngles::ZERO;
     bool        m_isCameraMode = false;
+    float       m_worldCameraFOV = 60.f;     // Vertical, taken from the possessed actor's definition.
     // Camera*     m_worldCamera  = nullptr;
     eDeviceType m_deviceType   = eDeviceType::KEYBOARD_AND_MOUSE;
     float         m_speed = 0.f;
@@ -0,0 +1,163 @@
+//----------------------------------------------------------------------------------------------------
+// SpriteBatcher.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/SpriteBatcher.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+//----------------------------------------------------------------------------------------------------
+SpriteBatcher::SpriteBatcher(Renderer* renderer)
+    : m_renderer(renderer)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void SpriteBatcher::Begin()
+{
+    m_vertexes.clear();
+    m_items.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void SpriteBatcher::AddQuad(Shader*               shader,
+                            Texture const*        texture,
+                            eRasterizerMode const rasterizerMode,
+                            Vec3 const&           bottomLeft,
+                            Vec3 const&           bottomRight,
+                            Vec3 const&           topLeft,
+                            Vec3 const&           topRight,
+                            AABB2 const&          uvs,
+                            Rgba8 const&          color)
+{
+    int const firstVertex = static_cast<int>(m_vertexes.size());
+
+    AddVertsForQuad3D(m_vertexes, bottomLeft, bottomRight, topLeft, topRight, color, uvs);
+    AddItem(shader, texture, rasterizerMode, firstVertex);
+}
+
+//----------------------------------------------------------------------------------------------------
+void SpriteBatcher::AddRoundedQuad(Shader*               shader,
+                                   Texture const*        texture,
+                                   eRasterizerMode const rasterizerMode,
+                                   Vec3 const&           topRight,
+                                   Vec3 const&           bottomRight,
+                                   Vec3 const&           bottomLeft,
+                                   Vec3 const&           topLeft,
+                                   AABB2 const&          uvs,
+                                   Rgba8 const&          color)
+{
+    int const firstVertex = static_cast<int>(m_vertexes.size());
+
+    AddVertsForRoundedQuad3D(m_vertexes, topRight, bottomRight, bottomLeft, topLeft, color, uvs);
+    AddItem(shader, texture, rasterizerMode, firstVertex);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Sprites are opaque, so the order within a material does not matter; the sort is stable anyway to keep frames alike.
+void SpriteBatcher::End()
+{
+    m_spriteCount    = static_cast<int>(m_items.size());
+    m_drawCount      = 0;
+    m_submittedBytes = 0;
+
+    if (m_items.empty()) return;
+
+    std::stable_sort(m_items.begin(), m_items.end(), [](SpriteBatchItem const& a, SpriteBatchItem const& b)
+    {
+        if (a.m_rasterizerMode != b.m_rasterizerMode) return a.m_rasterizerMode < b.m_rasterizerMode;
+        if (a.m_shader != b.m_shader) return std::less<Shader*>()(a.m_shader, b.m_shader);
+        return std::less<Texture const*>()(a.m_texture, b.m_texture);
+    });
+
+    m_sortedVertexes.clear();
+
+    for (SpriteBatchItem const& item : m_items)
+    {
+        m_sortedVertexes.insert(m_sortedVertexes.end(), m_vertexes.begin() + item.m_firstVertex, m_vertexes.begin() + item.m_firstVertex + item.m_vertexCount);
+    }
+
+    if (m_renderer != nullptr)
+    {
+        m_renderer->SetModelConstants();
+        m_renderer->SetBlendMode(eBlendMode::OPAQUE);
+        m_renderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
+        m_renderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
+    }
+
+    int runStartItem   = 0;
+    int runStartVertex = 0;
+
+    for (int itemIndex = 1; itemIndex <= static_cast<int>(m_items.size()); ++itemIndex)
+    {
+        SpriteBatchItem const& runItem = m_items[runStartItem];
+
+        if (itemIndex < static_cast<int>(m_items.size()) &&
+            m_items[itemIndex].m_rasterizerMode == runItem.m_rasterizerMode &&
+            m_items[itemIndex].m_shader == runItem.m_shader &&
+            m_items[itemIndex].m_texture == runItem.m_texture)
+        {
+            continue;
+        }
+
+        int runVertexCount = 0;
+
+        for (int i = runStartItem; i < itemIndex; ++i)
+        {
+            runVertexCount += m_items[i].m_vertexCount;
+        }
+
+        if (m_renderer != nullptr)
+        {
+            m_renderer->SetRasterizerMode(runItem.m_rasterizerMode);
+            m_renderer->BindShader(runItem.m_shader);
+            m_renderer->BindTexture(runItem.m_texture);
+            m_renderer->DrawVertexArray(runVertexCount, m_sortedVertexes.data() + runStartVertex);
+        }
+
+        ++m_drawCount;
+        m_submittedBytes += static_cast<size_t>(runVertexCount) * sizeof(Vertex_PCUTBN);
+
+        runStartItem = itemIndex;
+        runStartVertex += runVertexCount;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int SpriteBatcher::GetSpriteCount() const
+{
+    return m_spriteCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int SpriteBatcher::GetDrawCount() const
+{
+    return m_drawCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t SpriteBatcher::GetSubmittedBytes() const
+{
+    return m_submittedBytes;
+}
+
+//----------------------------------------------------------------------------------------------------
+void SpriteBatcher::AddItem(Shader*               shader,
+                            Texture const*        texture,
+                            eRasterizerMode const rasterizerMode,
+                            int const             firstVertex)
+{
+    SpriteBatchItem item;
+    item.m_rasterizerMode = rasterizerMode;
+    item.m_shader         = shader;
+    item.m_texture        = texture;
+    item.m_firstVertex    = firstVertex;
+    item.m_vertexCount    = static_cast<int>(m_vertexes.size()) - firstVertex;
+
+    m_items.push_back(item);
+}
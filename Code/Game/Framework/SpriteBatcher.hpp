@@ -0,0 +1,60 @@
+//----------------------------------------------------------------------------------------------------
+// SpriteBatcher.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Shader;
+class Texture;
+
+//----------------------------------------------------------------------------------------------------
+// Collects world-space sprite quads between Begin and End, then draws them sorted by material
+// (rasterizer mode, then shader, then texture) with one draw per material, all out of one vertex list reused every frame.
+// Without a renderer nothing is drawn, but the draws and bytes that would have been submitted are still counted,
+// so batching can be checked headless.
+class SpriteBatcher
+{
+public:
+    explicit SpriteBatcher(Renderer* renderer);
+
+    void Begin();
+    void AddQuad(Shader* shader, Texture const* texture, eRasterizerMode rasterizerMode, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topLeft, Vec3 const& topRight, AABB2 const& uvs, Rgba8 const& color = Rgba8::WHITE);
+    void AddRoundedQuad(Shader* shader, Texture const* texture, eRasterizerMode rasterizerMode, Vec3 const& topRight, Vec3 const& bottomRight, Vec3 const& bottomLeft, Vec3 const& topLeft, AABB2 const& uvs, Rgba8 const& color = Rgba8::WHITE);
+    void End();
+
+    // Counts of the last End.
+    int    GetSpriteCount() const;
+    int    GetDrawCount() const;
+    size_t GetSubmittedBytes() const;
+
+private:
+    struct SpriteBatchItem
+    {
+        eRasterizerMode m_rasterizerMode = eRasterizerMode::SOLID_CULL_NONE;
+        Shader*         m_shader         = nullptr;
+        Texture const*  m_texture        = nullptr;
+        int             m_firstVertex    = 0;      // Into m_vertexes.
+        int             m_vertexCount    = 0;
+    };
+
+    void AddItem(Shader* shader, Texture const* texture, eRasterizerMode rasterizerMode, int firstVertex);
+
+    Renderer*                    m_renderer = nullptr;
+    VertexList_PCUTBN            m_vertexes;               // In the order the sprites were added.
+    VertexList_PCUTBN            m_sortedVertexes;         // Grouped by material, what is drawn.
+    std::vector<SpriteBatchItem> m_items;
+    int                          m_spriteCount    = 0;
+    int                          m_drawCount      = 0;
+    size_t                       m_submittedBytes = 0;
+};
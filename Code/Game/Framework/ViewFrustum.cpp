@@ -0,0 +1,68 @@
+//----------------------------------------------------------------------------------------------------
+// ViewFrustum.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ViewFrustum.hpp"
+
+#include <cmath>
+
+#include "Engine/Math/MathUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+ViewFrustum::ViewFrustum(Vec3 const&        position,
+                         EulerAngles const& orientation,
+                         float const        fovDegrees,
+                         float const        aspect,
+                         float const        nearDistance,
+                         float const        farDistance)
+{
+    Vec3 forward, left, up;
+    orientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
+
+    // A side plane leans out from the forward axis by the half angle, so its inward normal is
+    // forward * sin(halfAngle) minus the side axis * cos(halfAngle).
+    float const halfFovRadians        = ConvertDegreesToRadians(fovDegrees * 0.5f);
+    float const halfHorizontalRadians = std::atan(std::tan(halfFovRadians) * aspect);
+    Vec3 const  leftNormal            = forward * std::sin(halfHorizontalRadians) - left * std::cos(halfHorizontalRadians);
+    Vec3 const  rightNormal           = forward * std::sin(halfHorizontalRadians) + left * std::cos(halfHorizontalRadians);
+    Vec3 const  bottomNormal          = forward * std::sin(halfFovRadians) + up * std::cos(halfFovRadians);
+    Vec3 const  topNormal             = forward * std::sin(halfFovRadians) - up * std::cos(halfFovRadians);
+    float const forwardDistance       = DotProduct3D(forward, position);
+
+    m_planes[0] = ViewPlane{forward, forwardDistance + nearDistance};
+    m_planes[1] = ViewPlane{forward * -1.f, -(forwardDistance + farDistance)};
+    m_planes[2] = ViewPlane{leftNormal, DotProduct3D(leftNormal, position)};
+    m_planes[3] = ViewPlane{rightNormal, DotProduct3D(rightNormal, position)};
+    m_planes[4] = ViewPlane{bottomNormal, DotProduct3D(bottomNormal, position)};
+    m_planes[5] = ViewPlane{topNormal, DotProduct3D(topNormal, position)};
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ViewFrustum::IsPointInside(Vec3 const& point) const
+{
+    for (ViewPlane const& plane : m_planes)
+    {
+        if (DotProduct3D(plane.m_normal, point) < plane.m_distance) return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Conservative: only reports bounds that are fully behind one of the planes, which is what culling needs.
+// Some boxes near the frustum's edges are kept even though they are outside.
+bool ViewFrustum::IsAABB3Outside(AABB3 const& bounds) const
+{
+    for (ViewPlane const& plane : m_planes)
+    {
+        // The corner furthest along the plane normal.
+        Vec3 const corner = Vec3(plane.m_normal.x >= 0.f ? bounds.m_maxs.x : bounds.m_mins.x,
+                                 plane.m_normal.y >= 0.f ? bounds.m_maxs.y : bounds.m_mins.y,
+                                 plane.m_normal.z >= 0.f ? bounds.m_maxs.z : bounds.m_mins.z);
+
+        if (DotProduct3D(plane.m_normal, corner) < plane.m_distance) return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,31 @@
+//----------------------------------------------------------------------------------------------------
+// ViewFrustum.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// A point p is on the inside of the plane when DotProduct3D(m_normal, p) >= m_distance.
+struct ViewPlane
+{
+    Vec3  m_normal;
+    float m_distance = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+// The six planes of a perspective camera, built from the same values passed to Camera::SetPerspectiveGraphicView,
+// so world geometry can be culled before it is submitted. fovDegrees is the vertical field of view.
+struct ViewFrustum
+{
+    ViewFrustum() = default;
+    ViewFrustum(Vec3 const& position, EulerAngles const& orientation, float fovDegrees, float aspect, float nearDistance, float farDistance);
+
+    bool IsPointInside(Vec3 const& point) const;
+    bool IsAABB3Outside(AABB3 const& bounds) const;
+
+    ViewPlane m_planes[6];      // Near, far, left, right, bottom, top; all facing inward.
+};
@@ -0,0 +1,126 @@
+//----------------------------------------------------------------------------------------------------
+// WorkerPool.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/WorkerPool.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+WorkerPool::WorkerPool(int const workerThreadCount)
+{
+    for (int i = 0; i < workerThreadCount; ++i)
+    {
+        m_workerThreads.emplace_back(&WorkerPool::RunWorker, this);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_isQuitting = true;
+    }
+
+    m_wakeCondition.notify_all();
+
+    for (std::thread& workerThread : m_workerThreads)
+    {
+        workerThread.join();
+    }
+
+    m_workerThreads.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// One worker per hardware thread besides the one calling ParallelFor.
+STATIC int WorkerPool::GetDefaultWorkerThreadCount()
+{
+    int const hardwareThreadCount = static_cast<int>(std::thread::hardware_concurrency());
+
+    return std::max(hardwareThreadCount - 1, 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Counting the thread that calls ParallelFor.
+int WorkerPool::GetThreadCount() const
+{
+    return static_cast<int>(m_workerThreads.size()) + 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs job over [0, count) in batches of batchSize and waits for all of them.
+// Ranges that fit in one batch, or a pool without workers, run inline without waking anyone.
+void WorkerPool::ParallelFor(int const                                      count,
+                             int const                                      batchSize,
+                             std::function<void(int begin, int end)> const& job)
+{
+    if (count <= 0) return;
+
+    if (m_workerThreads.empty() || count <= batchSize)
+    {
+        job(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_job             = &job;
+        m_count           = count;
+        m_batchSize       = std::max(batchSize, 1);
+        m_nextIndex       = 0;
+        m_busyWorkerCount = static_cast<int>(m_workerThreads.size());
+        ++m_jobGeneration;
+    }
+
+    m_wakeCondition.notify_all();
+    RunBatches();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_busyWorkerCount == 0; });
+    m_job = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+void WorkerPool::RunWorker()
+{
+    unsigned int seenJobGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [this, seenJobGeneration] { return m_isQuitting || m_jobGeneration != seenJobGeneration; });
+
+            if (m_isQuitting) return;
+
+            seenJobGeneration = m_jobGeneration;
+        }
+
+        RunBatches();
+
+        {
+            std::lock_guard<std::mutex> const lock(m_mutex);
+            --m_busyWorkerCount;
+        }
+
+        m_doneCondition.notify_one();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void WorkerPool::RunBatches()
+{
+    while (true)
+    {
+        int const begin = m_nextIndex.fetch_add(m_batchSize);
+
+        if (begin >= m_count) return;
+
+        (*m_job)(begin, std::min(begin + m_batchSize, m_count));
+    }
+}
@@ -0,0 +1,47 @@
+//----------------------------------------------------------------------------------------------------
+// WorkerPool.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// A fixed set of worker threads for data-parallel loops over the simulation.
+// ParallelFor hands out [begin, end) batches of an index range to the workers and the calling thread,
+// and returns once every batch has run. Which thread runs which batch is not fixed, so a job must only write
+// to the elements of its own batch for the result to be the same for any thread count.
+class WorkerPool
+{
+public:
+    explicit WorkerPool(int workerThreadCount);
+    ~WorkerPool();
+    WorkerPool(WorkerPool const&)            = delete;
+    WorkerPool& operator=(WorkerPool const&) = delete;
+
+    static int GetDefaultWorkerThreadCount();
+
+    int  GetThreadCount() const;
+    void ParallelFor(int count, int batchSize, std::function<void(int begin, int end)> const& job);
+
+private:
+    void RunWorker();
+    void RunBatches();
+
+    std::vector<std::thread>                       m_workerThreads;
+    std::mutex                                     m_mutex;
+    std::condition_variable                        m_wakeCondition;
+    std::condition_variable                        m_doneCondition;
+    std::function<void(int begin, int end)> const* m_job             = nullptr;
+    int                                            m_count           = 0;
+    int                                            m_batchSize       = 1;
+    std::atomic<int>                               m_nextIndex       = 0;
+    int                                            m_busyWorkerCount = 0;      // Workers yet to finish the current job.
+    unsigned int                                   m_jobGeneration   = 0;      // Bumped for every job so each worker joins it exactly once.
+    bool                                           m_isQuitting      = false;
+};
@@ -0,0 +1,300 @@
+//----------------------------------------------------------------------------------------------------
+// AIPerception.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/AIPerception.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Definition/FactionDefinition.hpp"
+#include "Game/Framework/AIController.hpp"
+#include "Game/Gameplay/Actor.hpp"
+#include "Game/Gameplay/Map.hpp"
+
+//----------------------------------------------------------------------------------------------------
+AIPerception::AIPerception(int const agentsPerTick)
+    : m_agentsPerTick(std::max(agentsPerTick, 0))
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+// Agents are AI-controlled actors that are alive; player-possessed actors and the rest are passed over for free.
+void AIPerception::Update(Map const&                 map,
+                          std::vector<Actor*> const& actors)
+{
+    ++m_tick;
+    m_refreshedAgentCount = 0;
+    m_raycastCount        = 0;
+    m_cacheHitCount       = 0;
+
+    int const actorCount = static_cast<int>(actors.size());
+    int const budget     = m_agentsPerTick > 0 ? m_agentsPerTick : actorCount;
+
+    if (m_nextActorIndex >= actorCount) m_nextActorIndex = 0;
+
+    for (int visitedCount = 0; visitedCount < actorCount && m_refreshedAgentCount < budget; ++visitedCount)
+    {
+        Actor* actor = actors[m_nextActorIndex];
+        m_nextActorIndex = (m_nextActorIndex + 1) % actorCount;
+
+        if (actor->m_isDead || !actor->m_definition->m_aiEnabled) continue;
+        if (actor->m_aiController == nullptr || actor->m_controller != actor->m_aiController) continue;
+        if (actor->m_aiController->m_isDormant) continue;
+
+        Actor const* enemy = FindClosestVisibleEnemy(map, actor);
+
+        actor->m_aiController->m_perceivedEnemyHandle = enemy != nullptr ? enemy->m_handle : ActorHandle::INVALID;
+        ++m_refreshedAgentCount;
+    }
+
+    m_totalRaycastCount += static_cast<uint64_t>(m_raycastCount);
+    m_totalCacheHitCount += static_cast<uint64_t>(m_cacheHitCount);
+
+    PruneLineOfSightCache();
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIPerception::Clear()
+{
+    m_lineOfSightCache.clear();
+    m_nextActorIndex = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIPerception::SetAgentsPerTick(int const agentsPerTick)
+{
+    m_agentsPerTick = std::max(agentsPerTick, 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIPerception::SetLineOfSightCacheEnabled(bool const isEnabled)
+{
+    m_isCacheEnabled = isEnabled;
+
+    if (!m_isCacheEnabled)
+    {
+        m_lineOfSightCache.clear();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIPerception::GetAgentsPerTick() const
+{
+    return m_agentsPerTick;
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIPerception::GetRefreshedAgentCount() const
+{
+    return m_refreshedAgentCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIPerception::GetRaycastCount() const
+{
+    return m_raycastCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIPerception::GetCacheHitCount() const
+{
+    return m_cacheHitCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t AIPerception::GetTotalRaycastCount() const
+{
+    return m_totalRaycastCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t AIPerception::GetTotalCacheHitCount() const
+{
+    return m_totalCacheHitCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIPerception::ResetTotals()
+{
+    m_totalRaycastCount  = 0;
+    m_totalCacheHitCount = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The closest actor of a hostile faction inside the owner's sight radius and cone with nothing in the way.
+// The map's sector query finds the candidates; they are tried closest first, so the first one in sight is the answer.
+// Lines of sight that are not cached are cast in packets of the next few candidates at once.
+Actor const* AIPerception::FindClosestVisibleEnemy(Map const&   map,
+                                                   Actor const* owner)
+{
+    Vec3 forward, left, up;
+    owner->m_orientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
+
+    ActorQueryFilter filter;
+    filter.m_ignoredActor = owner;
+    filter.m_factionMask  = FactionDefinition::GetHostileMask(owner->m_definition->m_factionIndex);
+
+    Vec3 const ownerPosition = owner->GetPosition();
+
+    map.QueryActorsInSector(Vec2(ownerPosition.x, ownerPosition.y),
+                            Vec2(forward.x, forward.y).GetNormalized(),
+                            owner->m_definition->m_sightAngle * 0.5f,
+                            owner->m_definition->m_sightRadius,
+                            filter,
+                            m_candidates);
+
+    // Stable, so of two candidates as close, the one found first wins.
+    std::stable_sort(m_candidates.begin(), m_candidates.end(), [](ActorQueryHit const& a, ActorQueryHit const& b)
+    {
+        return a.m_distance < b.m_distance;
+    });
+
+    int const candidateCount = static_cast<int>(m_candidates.size());
+    int       nextIndex      = 0;
+
+    while (nextIndex < candidateCount)
+    {
+        bool isVisible = false;
+
+        if (FindCachedLineOfSight(map, owner, m_candidates[nextIndex].m_actor, isVisible))
+        {
+            ++m_cacheHitCount;
+
+            if (isVisible) return m_candidates[nextIndex].m_actor;
+
+            ++nextIndex;
+            continue;
+        }
+
+        // Cast this candidate and the uncached ones right after it together.
+        int packetEnd = nextIndex + 1;
+
+        while (packetEnd < candidateCount && packetEnd - nextIndex < RayPacket::LANE_COUNT && !FindCachedLineOfSight(map, owner, m_candidates[packetEnd].m_actor, isVisible))
+        {
+            ++packetEnd;
+        }
+
+        Actor const* visibleEnemy = CastLinesOfSight(map, owner, nextIndex, packetEnd);
+
+        if (visibleEnemy != nullptr) return visibleEnemy;
+
+        nextIndex = packetEnd;
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool AIPerception::FindCachedLineOfSight(Map const&   map,
+                                         Actor const* observer,
+                                         Actor const* target,
+                                         bool&        out_isVisible) const
+{
+    if (!m_isCacheEnabled) return false;
+
+    std::unordered_map<uint64_t, LineOfSightEntry>::const_iterator const it = m_lineOfSightCache.find(GetLineOfSightKey(observer, target));
+
+    if (it == m_lineOfSightCache.end() ||
+        it->second.m_observerGeneration != observer->m_handle.GetGeneration() ||
+        it->second.m_targetGeneration != target->m_handle.GetGeneration() ||
+        it->second.m_observerTileCoords != map.GetTileCoordsFromWorldPos(observer->GetPosition()) ||
+        it->second.m_targetTileCoords != map.GetTileCoordsFromWorldPos(target->GetPosition()) ||
+        m_tick - it->second.m_tick > MAX_LINE_OF_SIGHT_AGE_TICKS)
+    {
+        return false;
+    }
+
+    out_isVisible = it->second.m_isVisible;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Casts from the observer's eye to the eyes of m_candidates[begin] up to [end] in one batch, caches every result and
+// returns the first of them in sight. Visible when the first thing a ray hits is the target. A ray reaches a little past
+// its target, so it can hit the target's cylinder even when the eyes are at different heights.
+Actor const* AIPerception::CastLinesOfSight(Map const&   map,
+                                            Actor const* observer,
+                                            int const    begin,
+                                            int const    end)
+{
+    Vec3 const eyePosition = observer->GetActorEyePosition();
+
+    m_rays.resize(end - begin);
+
+    for (int i = begin; i < end; ++i)
+    {
+        Actor const* target   = m_candidates[i].m_actor;
+        Vec3 const   toTarget = target->GetActorEyePosition() - eyePosition;
+        BatchRay&    ray      = m_rays[i - begin];
+        ray.m_startPosition   = eyePosition;
+        ray.m_forwardNormal   = toTarget.GetNormalized();
+        ray.m_maxLength       = m_candidates[i].m_distance + target->GetRadius() + 0.1f;
+    }
+
+    map.RaycastBatch(observer, m_rays, m_rayResults);
+    m_raycastCount += end - begin;
+
+    Actor const* visibleEnemy = nullptr;
+
+    for (int i = begin; i < end; ++i)
+    {
+        Actor const*           target         = m_candidates[i].m_actor;
+        Vec3 const             targetPosition = target->GetPosition();
+        RaycastResult3D const& result         = m_rayResults[i - begin].m_result;
+        bool const             isVisible      = result.m_didImpact &&
+                                                IsPointInsideDisc2D(Vec2(result.m_impactPosition.x, result.m_impactPosition.y), Vec2(targetPosition.x, targetPosition.y), target->GetRadius() + 0.1f);
+
+        if (m_isCacheEnabled)
+        {
+            LineOfSightEntry& entry    = m_lineOfSightCache[GetLineOfSightKey(observer, target)];
+            entry.m_observerGeneration = observer->m_handle.GetGeneration();
+            entry.m_targetGeneration   = target->m_handle.GetGeneration();
+            entry.m_observerTileCoords = map.GetTileCoordsFromWorldPos(observer->GetPosition());
+            entry.m_targetTileCoords   = map.GetTileCoordsFromWorldPos(targetPosition);
+            entry.m_tick               = m_tick;
+            entry.m_isVisible          = isVisible;
+        }
+
+        if (isVisible && visibleEnemy == nullptr)
+        {
+            visibleEnemy = target;
+        }
+    }
+
+    return visibleEnemy;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC uint64_t AIPerception::GetLineOfSightKey(Actor const* observer,
+                                                Actor const* target)
+{
+    return (static_cast<uint64_t>(observer->m_handle.GetIndex()) << 32) | target->m_handle.GetIndex();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Stale entries are only swept out once the cache is full; if that frees too little, it starts over.
+void AIPerception::PruneLineOfSightCache()
+{
+    if (m_lineOfSightCache.size() <= MAX_CACHED_LINES_OF_SIGHT) return;
+
+    for (std::unordered_map<uint64_t, LineOfSightEntry>::iterator it = m_lineOfSightCache.begin(); it != m_lineOfSightCache.end();)
+    {
+        if (m_tick - it->second.m_tick > MAX_LINE_OF_SIGHT_AGE_TICKS)
+        {
+            it = m_lineOfSightCache.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (m_lineOfSightCache.size() > MAX_CACHED_LINES_OF_SIGHT / 2)
+    {
+        m_lineOfSightCache.clear();
+    }
+}
@@ -0,0 +1,86 @@
+//----------------------------------------------------------------------------------------------------
+// AIPerception.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Game/Gameplay/ActorQueryGrid.hpp"
+#include "Game/Gameplay/RayPacket.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+class Map;
+
+//----------------------------------------------------------------------------------------------------
+// Finds each AI's closest visible enemy on a staggered schedule instead of every AI every tick:
+// each Update refreshes the next agents in the actor list, up to the agents-per-tick budget, and hands each
+// its result through AIController::m_perceivedEnemyHandle, which the AI acts on until its next refresh.
+// Line-of-sight raycasts are cast in packets through Map::RaycastBatch and cached per observer and target;
+// an entry holds until either actor moves to another tile, either slot is reused, or it gets too old to trust
+// with other actors moving in between.
+// Runs on the main thread before the parallel think phase.
+class AIPerception
+{
+public:
+    explicit AIPerception(int agentsPerTick);
+
+    void Update(Map const& map, std::vector<Actor*> const& actors);
+    void Clear();
+
+    void SetAgentsPerTick(int agentsPerTick);     // 0 refreshes every agent every tick.
+    void SetLineOfSightCacheEnabled(bool isEnabled);
+    int  GetAgentsPerTick() const;
+
+    // Counts of the last Update.
+    int GetRefreshedAgentCount() const;
+    int GetRaycastCount() const;
+    int GetCacheHitCount() const;
+
+    // Counts since the last ResetTotals.
+    uint64_t GetTotalRaycastCount() const;
+    uint64_t GetTotalCacheHitCount() const;
+    void     ResetTotals();
+
+private:
+    struct LineOfSightEntry
+    {
+        unsigned int m_observerGeneration = 0;
+        unsigned int m_targetGeneration   = 0;
+        IntVec2      m_observerTileCoords;
+        IntVec2      m_targetTileCoords;
+        int          m_tick      = 0;         // When the raycast was made.
+        bool         m_isVisible = false;
+    };
+
+    static constexpr int    MAX_LINE_OF_SIGHT_AGE_TICKS = 30;
+    static constexpr size_t MAX_CACHED_LINES_OF_SIGHT   = 1 << 16;
+
+    Actor const* FindClosestVisibleEnemy(Map const& map, Actor const* owner);
+    bool         FindCachedLineOfSight(Map const& map, Actor const* observer, Actor const* target, bool& out_isVisible) const;
+    Actor const* CastLinesOfSight(Map const& map, Actor const* observer, int begin, int end);
+    void         PruneLineOfSightCache();
+
+    static uint64_t GetLineOfSightKey(Actor const* observer, Actor const* target);
+
+    int                                            m_agentsPerTick       = 0;
+    bool                                           m_isCacheEnabled      = true;
+    int                                            m_nextActorIndex      = 0;     // Where the next Update resumes in the actor list.
+    int                                            m_tick                = 0;
+    std::unordered_map<uint64_t, LineOfSightEntry> m_lineOfSightCache;            // Keyed by observer and target slot index.
+    int                                            m_refreshedAgentCount = 0;
+    int                                            m_raycastCount        = 0;
+    int                                            m_cacheHitCount       = 0;
+    uint64_t                                       m_totalRaycastCount   = 0;
+    uint64_t                                       m_totalCacheHitCount  = 0;
+
+    // Scratch, reused by every agent.
+    std::vector<ActorQueryHit>  m_candidates;
+    std::vector<BatchRay>       m_rays;
+    std::vector<BatchRayResult> m_rayResults;
+};
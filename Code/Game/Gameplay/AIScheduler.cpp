@@ -0,0 +1,305 @@
+//----------------------------------------------------------------------------------------------------
+// AIScheduler.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/AIScheduler.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Framework/AIController.hpp"
+#include "Game/Gameplay/Actor.hpp"
+
+//----------------------------------------------------------------------------------------------------
+AIScheduler::AIScheduler(float const budgetMilliseconds,
+                         float const thinkMillisecondsPerAgent,
+                         float const lodDistance,
+                         float const dormantDistance,
+                         float const noiseRadius)
+    : m_noiseRadius(noiseRadius)
+{
+    SetBudgetMilliseconds(budgetMilliseconds);
+    SetThinkMillisecondsPerAgent(thinkMillisecondsPerAgent);
+    SetDistances(lodDistance, dormantDistance);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Agents are AI-controlled actors that are alive; players are actors possessed by any other controller,
+// dead or alive, so the AIs around a fallen player keep going until it respawns.
+// Sets every agent's AIController::m_thinkSeconds, which is 0 for the agents that skip this tick.
+void AIScheduler::Schedule(std::vector<Actor*> const& actors,
+                           float const                deltaSeconds)
+{
+    m_tickedCount  = 0;
+    m_skippedCount = 0;
+    m_dormantCount = 0;
+    m_candidates.clear();
+    m_playerPositions.clear();
+
+    for (Actor const* actor : actors)
+    {
+        if (actor->m_controller != nullptr && actor->m_controller != actor->m_aiController)
+        {
+            Vec3 const position = actor->GetPosition();
+            m_playerPositions.emplace_back(position.x, position.y);
+        }
+    }
+
+    float const dormantDistanceSquared = m_dormantDistance * m_dormantDistance;
+    int const   actorCount             = static_cast<int>(actors.size());
+
+    for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+    {
+        Actor* actor = actors[actorIndex];
+
+        if (actor->m_isDead || !actor->m_definition->m_aiEnabled) continue;
+        if (actor->m_aiController == nullptr || actor->m_controller != actor->m_aiController) continue;
+
+        AIController* aiController = actor->m_aiController;
+        aiController->m_thinkSeconds = 0.f;
+        aiController->m_secondsSinceThink += deltaSeconds;
+        ++aiController->m_ticksSinceThink;
+
+        if (!m_isEnabled)
+        {
+            aiController->m_isDormant         = false;
+            aiController->m_isWakeRequested   = false;
+            aiController->m_thinkSeconds      = aiController->m_secondsSinceThink;
+            aiController->m_secondsSinceThink = 0.f;
+            aiController->m_ticksSinceThink   = 0;
+            ++m_tickedCount;
+            continue;
+        }
+
+        Vec3 const  position3D      = actor->GetPosition();
+        Vec2 const  position        = Vec2(position3D.x, position3D.y);
+        float const distanceSquared = GetClosestPlayerDistanceSquared(position);
+
+        if (distanceSquared > dormantDistanceSquared)
+        {
+            if (aiController->m_isWakeRequested || IsNoiseHeard(position))
+            {
+                aiController->m_awakeSeconds = WAKE_SECONDS;
+            }
+
+            aiController->m_isWakeRequested = false;
+
+            if (aiController->m_awakeSeconds <= 0.f)
+            {
+                // Stop walking on the move it was holding, and wake up without the seconds it slept through.
+                if (!aiController->m_isDormant)
+                {
+                    actor->m_heldMoveForce = Vec3::ZERO;
+                }
+
+                aiController->m_isDormant         = true;
+                aiController->m_secondsSinceThink = 0.f;
+                aiController->m_ticksSinceThink   = 0;
+                ++m_dormantCount;
+                continue;
+            }
+
+            aiController->m_awakeSeconds -= deltaSeconds;
+        }
+
+        aiController->m_isDormant       = false;
+        aiController->m_isWakeRequested = false;
+
+        // A player may be any distance away once the agent is awake, so the interval is capped where dormancy would begin.
+        float const distance      = std::min(sqrtf(distanceSquared), m_dormantDistance);
+        int const   intervalTicks = 1 + (m_lodDistance > 0.f ? RoundDownToInt(distance / m_lodDistance) : 0);
+
+        if (aiController->m_ticksSinceThink < intervalTicks)
+        {
+            ++m_skippedCount;
+            continue;
+        }
+
+        Candidate candidate;
+        candidate.m_priority   = static_cast<float>(aiController->m_ticksSinceThink) / static_cast<float>(intervalTicks);
+        candidate.m_actorIndex = actorIndex;
+        m_candidates.push_back(candidate);
+    }
+
+    m_noisePositions.clear();
+
+    if (!m_isEnabled) return;
+
+    int thinkCount = static_cast<int>(m_candidates.size());
+
+    // The share of the budget was worked out between ticks, so nothing measured during this one changes it.
+    if (m_agentsPerTick > 0)
+    {
+        thinkCount = std::min(thinkCount, m_agentsPerTick);
+    }
+
+    auto const IsMoreOverdue = [](Candidate const& a, Candidate const& b)
+    {
+        if (a.m_priority != b.m_priority) return a.m_priority > b.m_priority;
+        return a.m_actorIndex < b.m_actorIndex;
+    };
+
+    if (thinkCount < static_cast<int>(m_candidates.size()))
+    {
+        std::nth_element(m_candidates.begin(), m_candidates.begin() + thinkCount, m_candidates.end(), IsMoreOverdue);
+    }
+
+    for (int i = 0; i < thinkCount; ++i)
+    {
+        AIController* aiController = actors[m_candidates[i].m_actorIndex]->m_aiController;
+
+        aiController->m_thinkSeconds      = aiController->m_secondsSinceThink;
+        aiController->m_secondsSinceThink = 0.f;
+        aiController->m_ticksSinceThink   = 0;
+    }
+
+    m_tickedCount = thinkCount;
+    m_skippedCount += static_cast<int>(m_candidates.size()) - thinkCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Called with how long the think phase after the last Schedule took. Only resizes the next tick's share of the budget
+// when the cost is measured.
+void AIScheduler::RecordThinkMilliseconds(float const thinkMilliseconds)
+{
+    if (m_tickedCount == 0) return;
+
+    float const millisecondsPerAgent = thinkMilliseconds / static_cast<float>(m_tickedCount);
+
+    if (m_measuredMillisecondsPerAgent <= 0.f)
+    {
+        m_measuredMillisecondsPerAgent = millisecondsPerAgent;
+    }
+    else
+    {
+        m_measuredMillisecondsPerAgent = Interpolate(m_measuredMillisecondsPerAgent, millisecondsPerAgent, 0.1f);
+    }
+
+    if (m_isThinkCostMeasured)
+    {
+        UpdateAgentsPerTick();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Wakes the dormant agents within the noise radius at the next Schedule.
+void AIScheduler::AddNoise(Vec3 const& position)
+{
+    m_noisePositions.emplace_back(position.x, position.y);
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIScheduler::SetEnabled(bool const isEnabled)
+{
+    m_isEnabled = isEnabled;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIScheduler::SetBudgetMilliseconds(float const budgetMilliseconds)
+{
+    m_budgetMilliseconds = std::max(budgetMilliseconds, 0.f);
+    UpdateAgentsPerTick();
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIScheduler::SetThinkMillisecondsPerAgent(float const thinkMillisecondsPerAgent)
+{
+    m_thinkMillisecondsPerAgent = std::max(thinkMillisecondsPerAgent, 0.f);
+    UpdateAgentsPerTick();
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIScheduler::SetThinkCostMeasured(bool const isThinkCostMeasured)
+{
+    m_isThinkCostMeasured = isThinkCostMeasured;
+    UpdateAgentsPerTick();
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIScheduler::SetDistances(float const lodDistance,
+                               float const dormantDistance)
+{
+    m_lodDistance     = std::max(lodDistance, 0.f);
+    m_dormantDistance = std::max(dormantDistance, m_lodDistance);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool AIScheduler::IsEnabled() const
+{
+    return m_isEnabled;
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIScheduler::GetTickedCount() const
+{
+    return m_tickedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIScheduler::GetSkippedCount() const
+{
+    return m_skippedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIScheduler::GetDormantCount() const
+{
+    return m_dormantCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int AIScheduler::GetAgentsPerTick() const
+{
+    return m_agentsPerTick;
+}
+
+//----------------------------------------------------------------------------------------------------
+float AIScheduler::GetMeasuredThinkMillisecondsPerAgent() const
+{
+    return m_measuredMillisecondsPerAgent;
+}
+
+//----------------------------------------------------------------------------------------------------
+float AIScheduler::GetClosestPlayerDistanceSquared(Vec2 const& position) const
+{
+    float closestDistanceSquared = FLT_MAX;
+
+    for (Vec2 const& playerPosition : m_playerPositions)
+    {
+        closestDistanceSquared = std::min(closestDistanceSquared, GetDistanceSquared2D(position, playerPosition));
+    }
+
+    return closestDistanceSquared;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool AIScheduler::IsNoiseHeard(Vec2 const& position) const
+{
+    float const noiseRadiusSquared = m_noiseRadius * m_noiseRadius;
+
+    for (Vec2 const& noisePosition : m_noisePositions)
+    {
+        if (GetDistanceSquared2D(position, noisePosition) <= noiseRadiusSquared) return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Until a measured cost is recorded, or with no budget or cost, every due agent thinks.
+void AIScheduler::UpdateAgentsPerTick()
+{
+    float const millisecondsPerAgent = m_isThinkCostMeasured ? m_measuredMillisecondsPerAgent : m_thinkMillisecondsPerAgent;
+
+    if (m_budgetMilliseconds <= 0.f || millisecondsPerAgent <= 0.f)
+    {
+        m_agentsPerTick = 0;
+        return;
+    }
+
+    m_agentsPerTick = std::max(1, static_cast<int>(m_budgetMilliseconds / millisecondsPerAgent));
+}
@@ -0,0 +1,76 @@
+//----------------------------------------------------------------------------------------------------
+// AIScheduler.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+
+//----------------------------------------------------------------------------------------------------
+// Decides which AIs think this tick, on the main thread before perception and the parallel think phase.
+// The farther an agent is from the closest player, the fewer ticks it thinks on: every tick within the LOD
+// distance, every second tick within twice of it, and so on. Agents that are due are ranked by how overdue they
+// are and only as many as fit in the time budget think; the rest keep the move they held and catch up later with
+// the seconds they missed. The budget is turned into an agent count between ticks, from a configured cost per agent
+// by default, so which agents think never depends on the machine or the thread count; the measured cost can be used
+// instead. Agents with no player within the dormant distance go dormant until damage or a nearby
+// sound wakes them for a while. The actors keep owning their AIControllers; the schedule lives on the controllers.
+class AIScheduler
+{
+public:
+    static constexpr float WAKE_SECONDS = 10.f;     // How long damage or a sound keeps an agent awake away from the players.
+
+    AIScheduler(float budgetMilliseconds, float thinkMillisecondsPerAgent, float lodDistance, float dormantDistance, float noiseRadius);
+
+    void Schedule(std::vector<Actor*> const& actors, float deltaSeconds);
+    void RecordThinkMilliseconds(float thinkMilliseconds);
+    void AddNoise(Vec3 const& position);
+
+    void SetEnabled(bool isEnabled);                                         // Disabled, every agent thinks every tick and none goes dormant.
+    void SetBudgetMilliseconds(float budgetMilliseconds);                    // 0 lets every due agent think.
+    void SetThinkMillisecondsPerAgent(float thinkMillisecondsPerAgent);      // The configured cost the budget is divided by.
+    void SetThinkCostMeasured(bool isThinkCostMeasured);                     // Divide by the measured cost instead, which the machine's speed then sways.
+    void SetDistances(float lodDistance, float dormantDistance);             // In tiles.
+    bool IsEnabled() const;
+
+    // Counts of the last Schedule.
+    int GetTickedCount() const;
+    int GetSkippedCount() const;
+    int GetDormantCount() const;
+
+    int   GetAgentsPerTick() const;                         // What the budget affords, 0 for no limit.
+    float GetMeasuredThinkMillisecondsPerAgent() const;     // Moving average, 0 until a think phase is recorded.
+
+private:
+    struct Candidate
+    {
+        float m_priority   = 0.f;     // Ticks since the agent last thought, over the ticks it is meant to wait.
+        int   m_actorIndex = -1;
+    };
+
+    float GetClosestPlayerDistanceSquared(Vec2 const& position) const;
+    bool  IsNoiseHeard(Vec2 const& position) const;
+    void  UpdateAgentsPerTick();
+
+    bool                   m_isEnabled                    = true;
+    bool                   m_isThinkCostMeasured          = false;
+    float                  m_budgetMilliseconds           = 0.f;
+    float                  m_thinkMillisecondsPerAgent    = 0.f;   // Configured.
+    float                  m_measuredMillisecondsPerAgent = 0.f;   // Moving average of the think phase time over the agents that thought.
+    int                    m_agentsPerTick                = 0;     // What the budget affords, updated between ticks.
+    float                  m_lodDistance                  = 0.f;
+    float                  m_dormantDistance              = 0.f;
+    float                  m_noiseRadius                  = 0.f;
+    std::vector<Vec2>      m_playerPositions;                      // Reused by every Schedule.
+    std::vector<Vec2>      m_noisePositions;                       // Since the last Schedule.
+    std::vector<Candidate> m_candidates;                           // Reused by every Schedule.
+    int                    m_tickedCount                  = 0;
+    int                    m_skippedCount                 = 0;
+    int                    m_dormantCount                 = 0;
+};
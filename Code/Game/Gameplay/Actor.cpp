@@ -20,15 +20,18 @@
 #include "Game/Gameplay/Map.hpp"
 #include "Game/Definition/MapDefinition.hpp"
 #include "Game/Framework/PlayerController.hpp"
+#include "Game/Framework/SpriteBatcher.hpp"
+#include "Game/Gameplay/ActorPhysicsStore.hpp"
 #include "Game/Gameplay/Sound.hpp"
 #include "Game/Gameplay/Tile.hpp"
 #include "Game/Gameplay/Weapon.hpp"
 #include "Game/Definition//WeaponDefinition.hpp"
 
 //----------------------------------------------------------------------------------------------------
+// The physics state is not set up yet: Map::SpawnActor adds it to the map's ActorPhysicsStore along with the actor.
 Actor::Actor(SpawnInfo const& spawnInfo)
 {
-    m_definition = ActorDefinition::GetDefByName(spawnInfo.m_name);
+    m_definition = ActorDefinition::GetDefByNameID(spawnInfo.GetNameID());
 
     if (m_definition == nullptr)
     {
@@ -36,15 +39,14 @@ Actor::Actor(SpawnInfo const& spawnInfo)
     }
 
     m_health      = m_definition->m_health;
-    m_height      = m_definition->m_height;
-    m_radius      = m_definition->m_radius;
-    m_position    = spawnInfo.m_position;
     m_orientation = spawnInfo.m_orientation;
-    m_velocity    = spawnInfo.m_velocity;
 
-    for (String const& weapon : m_definition->m_inventory)
+    m_previousPosition    = spawnInfo.m_position;
+    m_previousOrientation = m_orientation;
+
+    for (NameID const weaponID : m_definition->m_inventoryIDs)
     {
-        if (WeaponDefinition* weaponDef = WeaponDefinition::GetDefByName(weapon))
+        if (WeaponDefinition* weaponDef = WeaponDefinition::GetDefByNameID(weaponID))
         {
             m_weapons.push_back(new Weapon(this, weaponDef));
         }
@@ -55,68 +57,86 @@ Actor::Actor(SpawnInfo const& spawnInfo)
         m_currentWeapon = m_weapons[0];
     }
 
-    if (spawnInfo.m_name == "Marine")
+    if (m_definition->m_nameID == NameTable::MARINE)
     {
         m_color = Rgba8::GREEN;
     }
 
-    if (spawnInfo.m_name == "Demon")
+    if (m_definition->m_nameID == NameTable::DEMON)
     {
         m_color = Rgba8::RED;
     }
 
-    if (spawnInfo.m_name == "PlasmaProjectile")
+    if (m_definition->m_nameID == NameTable::PLASMA_PROJECTILE)
     {
         m_color = Rgba8::BLUE;
     }
 
-    m_collisionCylinder = Cylinder3(m_position, m_position + Vec3(0.f, 0.f, m_height), m_radius);
-
     m_animationTimer = new Timer(0, g_theGame->m_gameClock);
 }
 
 //----------------------------------------------------------------------------------------------------
-void Actor::Update(float const deltaSeconds)
+// The actor owns its weapons, its animation timer and its default AI controller.
+// A player controller possessing us is owned by the game and is left alone.
+Actor::~Actor()
+{
+    for (Weapon*& weapon : m_weapons)
+    {
+        GAME_SAFE_RELEASE(weapon);
+    }
+
+    m_weapons.clear();
+    m_currentWeapon = nullptr;
+
+    GAME_SAFE_RELEASE(m_animationTimer);
+    GAME_SAFE_RELEASE(m_aiController);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs on the main thread before the parallel phases, since it plays sounds.
+void Actor::UpdateLifetime(float const deltaSeconds)
 {
     if (m_isDead || m_definition->m_dieOnSpawn)
     {
-        PlayAnimationByName("Death", true);
+        PlayAnimationByNameID(NameTable::DEATH, true);
 
         m_isDead = true;
         m_dead += deltaSeconds;
     }
 
-    if (m_dead > m_definition->m_corpseLifetime && m_definition->m_name != "SpawnPoint")
+    if (m_dead > m_definition->m_corpseLifetime && m_definition->m_nameID != NameTable::SPAWN_POINT)
     {
-        if (m_definition->GetSoundByName("Death"))
+        if (g_theAudio != nullptr && m_definition->GetSoundByNameID(NameTable::DEATH))
         {
-            SoundID actorDamagedSound = m_definition->GetSoundByName("Death")->GetSoundID();
+            SoundID actorDamagedSound = m_definition->GetSoundByNameID(NameTable::DEATH)->GetSoundID();
 
             if (!g_theAudio->IsPlaying(actorDamagedSound))
             {
-                g_theAudio->StartSoundAt(actorDamagedSound, m_position);
+                g_theAudio->StartSoundAt(actorDamagedSound, GetPosition());
             }
         }
         m_isGarbage = true;
     }
+}
 
-    if (!m_isDead)
-    {
-        UpdatePhysics(deltaSeconds);
-    }
+//----------------------------------------------------------------------------------------------------
+// Runs on a worker thread alongside other actors' Think. The AI may read any actor but only writes to this one,
+// its controller and its weapons; damage, impulses, spawns and sounds are queued in m_commands.
+// The AI only thinks on the ticks Map's AIScheduler gave it, by the seconds since it last did.
+void Actor::Think(float const deltaSeconds)
+{
+    UNUSED(deltaSeconds)
 
-    if (m_aiController != nullptr && m_definition->m_aiEnabled && dynamic_cast<PlayerController*>(m_controller) == nullptr)
+    if (m_aiController != nullptr && m_definition->m_aiEnabled && m_controller == m_aiController && m_aiController->m_thinkSeconds > 0.f)
     {
-        m_aiController->Update(deltaSeconds);
+        m_aiController->Update(m_aiController->m_thinkSeconds);
     }
-
-    m_collisionCylinder.m_startPosition = m_position;
-    m_collisionCylinder.m_endPosition   = m_position + Vec3(0.f, 0.f, m_height);
 }
 
 //----------------------------------------------------------------------------------------------------
-// If visible, we will need vertexes and any other information necessary for rendering.
-void Actor::Render(PlayerController const* toPlayer) const
+// If visible, adds this actor's sprite as seen by toPlayer to spriteBatcher, which draws it along with the other sprites of its material.
+void Actor::Render(PlayerController const* toPlayer,
+                   SpriteBatcher&          spriteBatcher) const
 {
     // if (m_definition->m_name == "SpawnPoint") return;
     // if (!m_isVisible) return;
@@ -131,6 +151,13 @@ void Actor::Render(PlayerController const* toPlayer) const
             return ;
     }
 
+    // Drawn where the simulation was partway between its last two ticks, not where it stopped.
+    Vec3 const        renderPosition    = GetRenderPosition();
+    EulerAngles const renderOrientation = GetRenderOrientation();
+    Mat44             renderTransform;
+    renderTransform.SetTranslation3D(renderPosition);
+    renderTransform.Append(renderOrientation.GetAsMatrix_IFwd_JLeft_KUp());
+
     Mat44 localToWorldMat;
     Vec3  eyeHeight = Vec3(0.f, 0.f, m_definition->m_eyeHeight);
     // if (m_definition->m_billboardType == eBillboardType::NONE)localToWorldMat = GetModelToWorldTransform();
@@ -139,7 +166,7 @@ void Actor::Render(PlayerController const* toPlayer) const
     // if (m_definition->m_billboardType == eBillboardType::WORLD_UP_OPPOSING)localToWorldMat.Append(GetBillboardMatrix(eBillboardType::WORLD_UP_OPPOSING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), m_position));
     if (m_definition->m_billboardType == eBillboardType::NONE)
     {
-        localToWorldMat = GetModelToWorldTransform();
+        localToWorldMat = renderTransform;
     }
     else
     {
@@ -148,33 +175,33 @@ void Actor::Render(PlayerController const* toPlayer) const
             // Mat44 cameraTransform = Mat44::MakeTranslation3D(toPlayer->m_position);
             // cameraTransform.Append(toPlayer->m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
             // localToWorldMat = Mat44::MakeTranslation3D(m_position);
-            localToWorldMat.Append(GetBillboardMatrix(eBillboardType::WORLD_UP_FACING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), m_position));
+            localToWorldMat.Append(GetBillboardMatrix(eBillboardType::WORLD_UP_FACING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), renderPosition));
         }
         else if (m_definition->m_billboardType == eBillboardType::FULL_OPPOSING)
         {
             // Mat44 cameraTransform = Mat44::MakeTranslation3D(toPlayer->m_position);
             // cameraTransform.Append(toPlayer->m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
-            localToWorldMat.Append(GetBillboardMatrix(eBillboardType::FULL_OPPOSING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), m_position));
+            localToWorldMat.Append(GetBillboardMatrix(eBillboardType::FULL_OPPOSING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), renderPosition));
         }
         else if (m_definition->m_billboardType == eBillboardType::WORLD_UP_OPPOSING)
         {
             // Mat44 cameraTransform = Mat44::MakeTranslation3D(toPlayer->m_position);
             // cameraTransform.Append(toPlayer->m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
-            localToWorldMat.Append(GetBillboardMatrix(eBillboardType::WORLD_UP_OPPOSING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), m_position + eyeHeight));
+            localToWorldMat.Append(GetBillboardMatrix(eBillboardType::WORLD_UP_OPPOSING, toPlayer->m_worldCamera->GetCameraToWorldTransform(), renderPosition + eyeHeight));
         }
         else
         {
-            localToWorldMat = GetModelToWorldTransform();
+            localToWorldMat = renderTransform;
         }
     }
 
     // verts.reserve(8192);
     // float const eyeHeight         = m_definition->m_eyeHeight;
-    Vec3 const forwardNormal   = m_orientation.GetAsMatrix_IFwd_JLeft_KUp().GetIBasis3D().GetNormalized();
+    Vec3 const forwardNormal   = renderOrientation.GetAsMatrix_IFwd_JLeft_KUp().GetIBasis3D().GetNormalized();
     Vec3 const forwardNormalXY = Vec3(forwardNormal.x, forwardNormal.y, 0.f).GetNormalized();
     // Vec3 const  coneStartPosition = m_collisionCylinder.m_startPosition + Vec3(0.f, 0.f, eyeHeight) + forwardNormalXY * m_collisionCylinder.m_radius;
 
-    if (m_definition->m_name != "PlasmaProjectile")
+    if (m_definition->m_nameID != NameTable::PLASMA_PROJECTILE)
     {
         if (m_isDead)
         {
@@ -199,9 +226,9 @@ void Actor::Render(PlayerController const* toPlayer) const
     // AddVertsForWireframeCylinder3D(verts, m_collisionCylinder.m_startPosition, m_collisionCylinder.m_endPosition, m_collisionCylinder.m_radius, 0.001f);
 
     /// Get facing sprite UVs.
-    Vec2 dirCameraToActorXY = Vec2(m_position.x - toPlayer->m_position.x, m_position.y - toPlayer->m_position.y).GetNormalized();
+    Vec2 dirCameraToActorXY = Vec2(renderPosition.x - toPlayer->m_position.x, renderPosition.y - toPlayer->m_position.y).GetNormalized();
     Vec3 dirCameraToActor   = Vec3(dirCameraToActorXY.x, dirCameraToActorXY.y, 0.f).GetNormalized();
-    Vec3 viewingDirection   = GetModelToWorldTransform().GetOrthonormalInverse().TransformVectorQuantity3D(dirCameraToActor);
+    Vec3 viewingDirection   = renderTransform.GetOrthonormalInverse().TransformVectorQuantity3D(dirCameraToActor);
 
     AnimationGroup const* animationGroup = m_currentPlayingAnimationGroup;
     if (animationGroup == nullptr && (int)m_definition->m_animationGroup.size() > 0) // We use the index 0 animation group
@@ -209,10 +236,8 @@ void Actor::Render(PlayerController const* toPlayer) const
         animationGroup = &m_definition->m_animationGroup[0];
     }
 
-    SpriteAnimDefinition const* anim = &animationGroup->GetSpriteAnimation(viewingDirection);
-
-    SpriteDefinition const spriteAtTime = anim->GetSpriteDefAtTime(m_animationTimer->GetElapsedTime() * 1); // TODO: Handle animation speed.
-    AABB2                  uvAtTime     = spriteAtTime.GetUVs();
+    AABB2 const&   uvAtTime = animationGroup->GetSpriteUVs(viewingDirection, m_animationTimer->GetElapsedTime() * 1); // TODO: Handle animation speed.
+    Texture const* texture  = animationGroup->GetTexture();
 
     Vec2 spriteOffSet = -m_definition->m_size * m_definition->m_pivot;
     Vec3 bottomLeft   = Vec3(0.f, spriteOffSet.x, spriteOffSet.y);
@@ -220,75 +245,24 @@ void Actor::Render(PlayerController const* toPlayer) const
     Vec3 topLeft      = bottomLeft + Vec3(0.f, 0.f, m_definition->m_size.y);
     Vec3 topRight     = bottomRight + Vec3(0.f, 0.f, m_definition->m_size.y);
 
-    bool const        bIsLit = m_definition->m_renderLit;
-    VertexList_PCU    unlitVerts;
-    VertexList_PCUTBN litVerts;
+    // The corners go to the batcher in world space, since every sprite of a material shares one draw.
+    // Lit sprites are back-face culled and unlit ones are not, as when each actor drew its own.
+    eRasterizerMode const rasterizerMode = m_definition->m_renderLit ? eRasterizerMode::SOLID_CULL_BACK : eRasterizerMode::SOLID_CULL_NONE;
+    Vec3 const worldBottomLeft  = localToWorldMat.TransformPosition3D(bottomLeft);
+    Vec3 const worldBottomRight = localToWorldMat.TransformPosition3D(bottomRight);
+    Vec3 const worldTopLeft     = localToWorldMat.TransformPosition3D(topLeft);
+    Vec3 const worldTopRight    = localToWorldMat.TransformPosition3D(topRight);
 
-    if (bIsLit)
+    if (m_definition->m_renderRounded)
     {
-        if (m_definition->m_renderRounded)
-        {
-            litVerts.reserve(12000);
-            AddVertsForRoundedQuad3D(litVerts, topRight, bottomRight, bottomLeft, topLeft, Rgba8::WHITE, uvAtTime);
-            g_theRenderer->SetModelConstants(localToWorldMat, Rgba8::WHITE);
-            // g_theRenderer->SetLightConstants(m_map->m_sunDirection, m_map->m_sunIntensity, m_map->m_ambientIntensity);
-            g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-            g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-            g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-            g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-            g_theRenderer->BindShader(m_definition->m_shader);
-            g_theRenderer->BindTexture(&spriteAtTime.GetTexture());
-            g_theRenderer->DrawVertexArray(litVerts);
-            return;
-        }
+        // Rounded sprites only have lit vertexes.
+        if (!m_definition->m_renderLit) return;
 
-        litVerts.reserve(12000);
-        AddVertsForQuad3D(litVerts, bottomLeft, bottomRight, topLeft, topRight, Rgba8::WHITE, uvAtTime);
-        g_theRenderer->SetModelConstants(localToWorldMat, Rgba8::WHITE);
-        // g_theRenderer->SetLightConstants(m_map->m_sunDirection, m_map->m_sunIntensity, m_map->m_ambientIntensity);
-        g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-        g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-        g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-        g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-        g_theRenderer->BindShader(m_definition->m_shader);
-        g_theRenderer->BindTexture(&spriteAtTime.GetTexture());
-        g_theRenderer->DrawVertexArray(litVerts);
+        spriteBatcher.AddRoundedQuad(m_definition->m_shader, texture, rasterizerMode, worldTopRight, worldBottomRight, worldBottomLeft, worldTopLeft, uvAtTime);
         return;
     }
-    else
-    {
-        if (m_definition->m_renderRounded)
-        {
-            // unlitVerts.reserve(12000);
-            // AddVertsForRoundedQuad3D(litVerts, topRight, bottomRight, bottomLeft, topLeft, Rgba8::WHITE, uvAtTime);
-            // g_theRenderer->SetModelConstants(localToWorldMat, Rgba8::WHITE);
-            // g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-            // g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-            // g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_NONE);
-            // // g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-            // g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-            // g_theRenderer->BindShader(m_definition->m_shader);
-            // g_theRenderer->BindTexture(&spriteAtTime.GetTexture());
-            // g_theRenderer->DrawVertexArray(unlitVerts);
-            return;
-        }
-        else
-        {
-            unlitVerts.reserve(12000);
-            AddVertsForQuad3D(unlitVerts, bottomLeft, bottomRight, topLeft, topRight, Rgba8::WHITE, uvAtTime);
-            g_theRenderer->SetModelConstants(localToWorldMat, Rgba8::WHITE);
-            g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-            g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-            g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_NONE);
-            // g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-            g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-            g_theRenderer->BindShader(m_definition->m_shader);
-            g_theRenderer->BindTexture(&spriteAtTime.GetTexture());
-            g_theRenderer->DrawVertexArray(unlitVerts);
-            return;
-        }
-    }
 
+    spriteBatcher.AddQuad(m_definition->m_shader, texture, rasterizerMode, worldBottomLeft, worldBottomRight, worldTopLeft, worldTopRight, uvAtTime);
 
     // bool const bIsLit = m_definition->m_renderLit;
     // bool const renderRounded = m_definition->m_renderRounded;
@@ -352,32 +326,113 @@ Mat44 Actor::GetModelToWorldTransform() const
 {
     Mat44 m2w;
 
-    m2w.SetTranslation3D(m_position);
+    m2w.SetTranslation3D(GetPosition());
     m2w.Append(m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
 
     return m2w;
 }
 
 //----------------------------------------------------------------------------------------------------
+// Called by the map before every simulation tick.
+void Actor::SaveTransformForInterpolation()
+{
+    m_previousPosition    = GetPosition();
+    m_previousOrientation = m_orientation;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Where the actor is drawn this frame: between the last two simulation ticks, by how far the game clock is into the next one.
+Vec3 Actor::GetRenderPosition() const
+{
+    return m_previousPosition + (GetPosition() - m_previousPosition) * g_theGame->GetSimulationAlpha();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Blends each angle the short way around, so a yaw going from 179 to -179 does not spin the whole way back.
+EulerAngles Actor::GetRenderOrientation() const
+{
+    float const alpha = g_theGame->GetSimulationAlpha();
+
+    return EulerAngles(m_previousOrientation.m_yawDegrees + GetShortestAngularDispDegrees(m_previousOrientation.m_yawDegrees, m_orientation.m_yawDegrees) * alpha,
+                       m_previousOrientation.m_pitchDegrees + GetShortestAngularDispDegrees(m_previousOrientation.m_pitchDegrees, m_orientation.m_pitchDegrees) * alpha,
+                       m_previousOrientation.m_rollDegrees + GetShortestAngularDispDegrees(m_previousOrientation.m_rollDegrees, m_orientation.m_rollDegrees) * alpha);
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 Actor::GetPosition() const
+{
+    return m_physicsStore->GetPosition(m_physicsIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 Actor::GetVelocity() const
+{
+    return m_physicsStore->GetVelocity(m_physicsIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 Actor::GetAcceleration() const
+{
+    return m_physicsStore->GetAcceleration(m_physicsIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+float Actor::GetRadius() const
+{
+    return m_physicsStore->GetRadius(m_physicsIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+float Actor::GetHeight() const
+{
+    return m_physicsStore->GetHeight(m_physicsIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+Cylinder3 Actor::GetCollisionCylinder() const
+{
+    return m_physicsStore->GetCollisionCylinder(m_physicsIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Actor::SetPosition(Vec3 const& position)
+{
+    m_physicsStore->SetPosition(m_physicsIndex, position);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Actor::SetVelocity(Vec3 const& velocity)
+{
+    m_physicsStore->SetVelocity(m_physicsIndex, velocity);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Actor::SetAcceleration(Vec3 const& acceleration)
+{
+    m_physicsStore->SetAcceleration(m_physicsIndex, acceleration);
+}
+
+//----------------------------------------------------------------------------------------------------
+// One actor at a time, as the reference for ActorPhysicsStore::Integrate, which Map updates the actors with.
 void Actor::UpdatePhysics(float const deltaSeconds)
 {
-    float const dragValue = m_definition->m_drag;
-    Vec3 const  dragForce = -m_velocity * dragValue;
+    AddForce(m_heldMoveForce);
+
+    float const dragValue = m_physicsStore->GetDrag(m_physicsIndex);
+    Vec3 const  dragForce = -GetVelocity() * dragValue;
     AddForce(dragForce);
 
-    m_velocity += m_acceleration * deltaSeconds;
-    m_position += m_velocity * deltaSeconds;
+    Vec3 const velocity = GetVelocity() + GetAcceleration() * deltaSeconds;
+    Vec3       position = GetPosition() + velocity * deltaSeconds;
 
-    if (!m_definition->m_flying)
+    if (!m_physicsStore->IsFlying(m_physicsIndex))
     {
-        if (m_definition->m_name != "BulletHit" &&
-            m_definition->m_name != "BloodSplatter")
-        {
-            m_position.z = 0.f;
-        }
+        position.z = 0.f;
     }
 
-    m_acceleration = Vec3::ZERO;
+    SetVelocity(velocity);
+    SetPosition(position);
+    SetAcceleration(Vec3::ZERO);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -394,7 +449,7 @@ void Actor::UpdateAnimation(float const deltaSeconds)
 
     if (m_definition->m_runSpeed != 0.f)
     {
-        m_animationTimerSpeedMultiplier = m_velocity.GetLength() / m_definition->m_runSpeed;
+        m_animationTimerSpeedMultiplier = GetVelocity().GetLength() / m_definition->m_runSpeed;
     }
 }
 
@@ -414,8 +469,12 @@ void Actor::Damage(int const          damage,
         m_aiController->DamagedBy(other);
     }
 
+    Sound const* hurtSound = m_definition->GetSoundByNameID(NameTable::HURT);
+
+    if (g_theAudio == nullptr || hurtSound == nullptr) return;
+
     // Sound with disable duplication sounds
-    SoundID                                                          actorDamagedSound = m_definition->GetSoundByName("Hurt")->GetSoundID();
+    SoundID                                                          actorDamagedSound = hurtSound->GetSoundID();
     std::map<unsigned long long, unsigned long long>::iterator const it                = m_soundPlaybackIDs.find(actorDamagedSound);
 
     if (it != m_soundPlaybackIDs.end())
@@ -424,25 +483,25 @@ void Actor::Damage(int const          damage,
 
         if (!g_theAudio->IsPlaying(playbackID))
         {
-            SoundPlaybackID id = g_theAudio->StartSoundAt(actorDamagedSound, m_position);
+            SoundPlaybackID id = g_theAudio->StartSoundAt(actorDamagedSound, GetPosition());
             m_soundPlaybackIDs.insert(std::pair<SoundID, SoundPlaybackID>(id, actorDamagedSound));
         }
     }
     else
     {
-        SoundPlaybackID id = g_theAudio->StartSoundAt(actorDamagedSound, m_position);
+        SoundPlaybackID id = g_theAudio->StartSoundAt(actorDamagedSound, GetPosition());
         m_soundPlaybackIDs.insert(std::pair<SoundID, SoundPlaybackID>(id, actorDamagedSound));
     }
 }
 
 void Actor::AddForce(Vec3 const& force)
 {
-    m_acceleration += force;
+    SetAcceleration(GetAcceleration() + force);
 }
 
 void Actor::AddImpulse(Vec3 const& impulse)
 {
-    m_velocity += impulse;
+    SetVelocity(GetVelocity() + impulse);
 }
 
 void Actor::MoveInDirection(Vec3 const& direction,
@@ -454,6 +513,17 @@ void Actor::MoveInDirection(Vec3 const& direction,
     AddForce(force);
 }
 
+//----------------------------------------------------------------------------------------------------
+// Unlike MoveInDirection, which only lasts for the next tick, the force is kept for every tick until it is cleared.
+// Player input is read once per frame, and a frame can run any number of simulation ticks.
+void Actor::HoldMoveInDirection(Vec3 const& direction,
+                                float const speed)
+{
+    Vec3 const  directionNormal = direction.GetNormalized();
+    float const dragValue       = m_definition->m_drag;
+    m_heldMoveForce += directionNormal * speed * dragValue;
+}
+
 void Actor::TurnInDirection(EulerAngles const& direction)
 {
     m_orientation = direction;
@@ -471,7 +541,8 @@ void Actor::OnPossessed(Controller* controller)
 // b. If the player possesses an actor with an AI controller, the AI controller is saved and then restored if the player unpossesses the actor.
 void Actor::OnUnpossessed()
 {
-    m_controller = nullptr;
+    m_controller    = nullptr;
+    m_heldMoveForce = Vec3::ZERO;
     // m_isVisible  = true;
 
     if (m_aiController == nullptr) return;
@@ -485,11 +556,13 @@ void Actor::OnCollisionEnterWithActor(Actor* other)
     // if (m_owner && other->m_definition->m_name == "Marine") return;
     // if (this == other) return;
 
-    Vec2 positionXY       = Vec2(m_position.x, m_position.y);
-    Vec2 otherPositionXY  = Vec2(other->m_position.x, other->m_position.y);
-    Vec2 actorAPositionXY = Vec2(m_position.x, m_position.y);
+    Vec3 position         = GetPosition();
+    Vec3 otherPosition    = other->GetPosition();
+    Vec2 positionXY       = Vec2(position.x, position.y);
+    Vec2 otherPositionXY  = Vec2(otherPosition.x, otherPosition.y);
+    Vec2 actorAPositionXY = Vec2(position.x, position.y);
 
-    if (DoDiscsOverlap2D(positionXY, m_radius, otherPositionXY, other->m_radius))
+    if (DoDiscsOverlap2D(positionXY, GetRadius(), otherPositionXY, other->GetRadius()))
     {
         if (m_owner&& !other->m_owner)
         {
@@ -518,44 +591,44 @@ void Actor::OnCollisionEnterWithActor(Actor* other)
         }
     }
 
-    Vec2        actorBPositionXY = Vec2(other->m_position.x, other->m_position.y);
-    float const actorARadius     = m_radius;
-    float const actorBRadius     = other->m_radius;
+    Vec2        actorBPositionXY = Vec2(otherPosition.x, otherPosition.y);
+    float const actorARadius     = GetRadius();
+    float const actorBRadius     = other->GetRadius();
 
     // 5. Push movable actor out of immovable actor.
     PushDiscsOutOfEachOther2D(actorAPositionXY, actorARadius, actorBPositionXY, actorBRadius);
 
     // 6. Update actors' position.
-    m_position.x        = actorAPositionXY.x;
-    m_position.y        = actorAPositionXY.y;
-    other->m_position.x = actorBPositionXY.x;
-    other->m_position.y = actorBPositionXY.y;
+    SetPosition(Vec3(actorAPositionXY.x, actorAPositionXY.y, position.z));
+    other->SetPosition(Vec3(actorBPositionXY.x, actorBPositionXY.y, otherPosition.z));
 }
 
 void Actor::OnCollisionEnterWithMap(IntVec2 const& tileCoords)
 {
     // TODO: Swap check method for Sprinting if needed (PushCapsuleOutOfAABB2D/DoCapsuleAndAABB2Overlap2D)
 
-    AABB3 const aabb3Box = m_map->GetTile(tileCoords.x, tileCoords.y)->m_bounds;
+    AABB3 const aabb3Box = Tile::GetBounds(tileCoords);
     AABB2 const aabb2Box = AABB2(Vec2(aabb3Box.m_mins.x, aabb3Box.m_mins.y), Vec2(aabb3Box.m_maxs.x, aabb3Box.m_maxs.y));
 
-    Vec2 actorPositionXY = Vec2(m_position.x, m_position.y);
+    Vec3 const position        = GetPosition();
+    Vec2       actorPositionXY = Vec2(position.x, position.y);
 
-    bool const isPushed = PushDiscOutOfAABB2D(actorPositionXY, m_radius, aabb2Box);
+    bool const isPushed = PushDiscOutOfAABB2D(actorPositionXY, GetRadius(), aabb2Box);
 
     if (isPushed && m_definition->m_dieOnCollide)
     {
         m_isDead = true;
     }
 
-    m_position.x = actorPositionXY.x;
-    m_position.y = actorPositionXY.y;
+    SetPosition(Vec3(actorPositionXY.x, actorPositionXY.y, position.z));
 }
 
 void Actor::OnCollisionEnterWithMap(AABB3 const& bounds)
 {
-    float zCylinderMaxZ = m_position.z + m_height;
-    float zCylinderMinZ = m_position.z;
+    Vec3        position      = GetPosition();
+    float const height        = GetHeight();
+    float       zCylinderMaxZ = position.z + height;
+    float       zCylinderMinZ = position.z;
 
     if (zCylinderMaxZ > bounds.m_maxs.z || zCylinderMinZ < bounds.m_mins.z)
     {
@@ -565,14 +638,16 @@ void Actor::OnCollisionEnterWithMap(AABB3 const& bounds)
     if (zCylinderMaxZ > bounds.m_maxs.z)
     {
         zCylinderMaxZ = bounds.m_maxs.z;
-        m_position.z  = zCylinderMaxZ - m_height;
+        position.z    = zCylinderMaxZ - height;
     }
 
     if (zCylinderMinZ < bounds.m_mins.z)
     {
         zCylinderMinZ = bounds.m_mins.z;
-        m_position.z  = zCylinderMinZ;
+        position.z    = zCylinderMinZ;
     }
+
+    SetPosition(position);
 }
 
 void Actor::Attack() const
@@ -595,13 +670,20 @@ void Actor::SwitchInventory(unsigned int const index)
 
 Vec3 Actor::GetActorEyePosition() const
 {
-    return m_position + Vec3(0.f, 0.f, m_definition->m_eyeHeight);
+    return GetPosition() + Vec3(0.f, 0.f, m_definition->m_eyeHeight);
 }
 
 AnimationGroup* Actor::PlayAnimationByName(String const& animationName,
                                            bool const    force)
 {
-    AnimationGroup* foundedGroup = m_definition->GetAnimationGroupByName(animationName);
+    return PlayAnimationByNameID(NameTable::Find(animationName), force);
+}
+
+//----------------------------------------------------------------------------------------------------
+AnimationGroup* Actor::PlayAnimationByNameID(NameID const nameID,
+                                             bool const   force)
+{
+    AnimationGroup* foundedGroup = m_definition->GetAnimationGroupByNameID(nameID);
 
     if (foundedGroup)
     {
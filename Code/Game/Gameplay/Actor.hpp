@@ -14,13 +14,18 @@
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/Vec3.hpp"
 #include "Game/Framework/ActorHandle.hpp"
+#include "Game/Framework/NameTable.hpp"
+#include "Game/Gameplay/ActorCommand.hpp"
 #include "Game/Gameplay/Sound.hpp"
+#include "Game/Gameplay/SpatialQuery.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
+class ActorPhysicsStore;
 class AIController;
 class AnimationGroup;
 class Controller;
 class PlayerController;
+class SpriteBatcher;
 class Texture;
 class Timer;
 class Weapon;
@@ -35,17 +40,36 @@ class Actor
 
 public:
     explicit Actor(SpawnInfo const& spawnInfo);
+    ~Actor();
 
-    void  Update(float deltaSeconds);
-    void  Render(PlayerController const* toPlayer) const;
+    void  UpdateLifetime(float deltaSeconds);
+    void  Think(float deltaSeconds);
+    void  Render(PlayerController const* toPlayer, SpriteBatcher& spriteBatcher) const;
     Mat44 GetModelToWorldTransform() const;
 
+    // Interpolation
+    void        SaveTransformForInterpolation();
+    Vec3        GetRenderPosition() const;
+    EulerAngles GetRenderOrientation() const;
+
+    // Physics state, kept in the map's ActorPhysicsStore.
+    Vec3      GetPosition() const;
+    Vec3      GetVelocity() const;
+    Vec3      GetAcceleration() const;
+    float     GetRadius() const;
+    float     GetHeight() const;
+    Cylinder3 GetCollisionCylinder() const;
+    void      SetPosition(Vec3 const& position);
+    void      SetVelocity(Vec3 const& velocity);
+    void      SetAcceleration(Vec3 const& acceleration);
+
     void UpdatePhysics(float deltaSeconds);
     void UpdateAnimation(float deltaSeconds);
     void Damage(int damage, ActorHandle const& other);
     void AddForce(Vec3 const& force);
     void AddImpulse(Vec3 const& impulse);
     void MoveInDirection(Vec3 const& direction, float speed);
+    void HoldMoveInDirection(Vec3 const& direction, float speed);
     void TurnInDirection(EulerAngles const& direction);
 
     // Possession
@@ -62,6 +86,7 @@ public:
     Vec3 GetActorEyePosition() const;
 
     AnimationGroup* PlayAnimationByName(String const& animationName, bool force = false);
+    AnimationGroup* PlayAnimationByNameID(NameID nameID, bool force = false);
 
 
     ActorHandle      m_handle;
@@ -69,16 +94,15 @@ public:
     Actor*           m_owner      = nullptr;
 
     // bool        m_isVisible    = true;
-    bool        m_isStatic     = false;
-    Vec3        m_position     = Vec3::ZERO;               // 3D position, as a Vec3, in world units.
-    Vec3        m_velocity     = Vec3::ZERO;               // 3D velocity, as a Vec3, in world units per second.
-    Vec3        m_acceleration = Vec3::ZERO;                // 3D acceleration, as a Vec3, in world units per second squared.
-    EulerAngles m_orientation  = EulerAngles::ZERO;        // 3D orientation, as EulerAngles, in degrees.
-
-    float                m_radius            = 0.f;
-    float                m_height            = 0.f;
-    Rgba8                m_color             = Rgba8::WHITE;
-    Cylinder3            m_collisionCylinder = Cylinder3();
+    bool        m_isStatic            = false;
+    EulerAngles m_orientation         = EulerAngles::ZERO;        // 3D orientation, as EulerAngles, in degrees.
+    Vec3        m_heldMoveForce       = Vec3::ZERO;               // Player movement, added at every simulation tick until the player controller replaces it.
+    Vec3        m_previousPosition    = Vec3::ZERO;               // Transform before the latest simulation tick; rendering blends from it to the current one.
+    EulerAngles m_previousOrientation = EulerAngles::ZERO;
+
+    ActorPhysicsStore*   m_physicsStore = nullptr;      // The map's; holds the position, velocity, acceleration and collision cylinder.
+    int                  m_physicsIndex = -1;           // Into m_physicsStore; set by Map::SpawnActor to this actor's index in Map::m_actors.
+    Rgba8                m_color        = Rgba8::WHITE;
     String               m_weaponName;
     float                m_dead           = 0.f;
     bool                 m_isDead         = false;        // Any data needed to track if and how long we have been dead.
@@ -102,4 +126,6 @@ public:
     // in which case he pushes the AI out of the way until he releases possession.
     AIController*                      m_aiController = nullptr;    // AI controllers should be constructed by the actor when the actor is spawned and immediately possess that actor.
     std::map<SoundID, SoundPlaybackID> m_soundPlaybackIDs;
+    std::vector<ActorCommand>          m_commands;          // Queued by Think and Weapon::Fire, applied and cleared by Map::ApplyActorCommands.
+    std::vector<SpatialQuery>          m_queries;           // Queued by Think and Weapon::Fire, answered by Map's SpatialQueryService in the same tick.
 };
@@ -0,0 +1,43 @@
+//----------------------------------------------------------------------------------------------------
+// ActorCommand.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+#include "Engine/Audio/AudioSystem.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Game/Definition/MapDefinition.hpp"
+#include "Game/Framework/ActorHandle.hpp"
+
+//----------------------------------------------------------------------------------------------------
+enum class eActorCommandType : int8_t
+{
+    DAMAGE,                 // m_target takes a roll of m_damage from m_source.
+    IMPULSE,                // m_target gets m_vector added to its velocity.
+    SPAWN,                  // m_spawnInfo is spawned.
+    SPAWN_PROJECTILE,       // m_spawnInfo is spawned at a random direction within m_coneDegrees of its orientation, moving at m_speed, owned by m_source.
+    SPAWN_EFFECT,           // Effect m_effectIndex is spawned into the map's particles at m_vector.
+    PLAY_SOUND              // m_soundID is played at m_vector.
+};
+
+//----------------------------------------------------------------------------------------------------
+// Something an actor does to the rest of the map while the map's actors update in parallel.
+// Actors only write to themselves during those phases and queue everything else as commands,
+// which Map::ApplyActorCommands carries out afterwards on one thread, in actor order, so random rolls and spawns
+// come out the same however the actors were spread over threads.
+struct ActorCommand
+{
+    eActorCommandType m_type        = eActorCommandType::DAMAGE;
+    ActorHandle       m_target;
+    ActorHandle       m_source;
+    FloatRange        m_damage;
+    Vec3              m_vector;
+    SpawnInfo         m_spawnInfo;
+    float             m_coneDegrees = 0.f;
+    float             m_speed       = 0.f;
+    SoundID           m_soundID     = MISSING_SOUND_ID;
+    int               m_effectIndex = -1;
+};
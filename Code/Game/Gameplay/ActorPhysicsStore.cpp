@@ -0,0 +1,278 @@
+//----------------------------------------------------------------------------------------------------
+// ActorPhysicsStore.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/ActorPhysicsStore.hpp"
+
+#include <emmintrin.h>
+
+//----------------------------------------------------------------------------------------------------
+// Appends a simulated actor with no acceleration yet and returns its index.
+int ActorPhysicsStore::AddActor(Vec3 const& position,
+                                Vec3 const& velocity,
+                                float const radius,
+                                float const height,
+                                float const drag,
+                                bool const  isFlying)
+{
+    m_positionXs.push_back(position.x);
+    m_positionYs.push_back(position.y);
+    m_positionZs.push_back(position.z);
+    m_velocityXs.push_back(velocity.x);
+    m_velocityYs.push_back(velocity.y);
+    m_velocityZs.push_back(velocity.z);
+    m_accelerationXs.push_back(0.f);
+    m_accelerationYs.push_back(0.f);
+    m_accelerationZs.push_back(0.f);
+    m_radii.push_back(radius);
+    m_heights.push_back(height);
+    m_drags.push_back(drag);
+    m_cylinderMinZs.push_back(position.z);
+    m_cylinderMaxZs.push_back(position.z + height);
+    m_isFlyingMasks.push_back(isFlying ? 0xFFFFFFFFu : 0u);
+    m_isSimulatedMasks.push_back(0xFFFFFFFFu);
+
+    return GetActorCount() - 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorPhysicsStore::MoveActor(int const fromIndex,
+                                  int const toIndex)
+{
+    m_positionXs[toIndex]       = m_positionXs[fromIndex];
+    m_positionYs[toIndex]       = m_positionYs[fromIndex];
+    m_positionZs[toIndex]       = m_positionZs[fromIndex];
+    m_velocityXs[toIndex]       = m_velocityXs[fromIndex];
+    m_velocityYs[toIndex]       = m_velocityYs[fromIndex];
+    m_velocityZs[toIndex]       = m_velocityZs[fromIndex];
+    m_accelerationXs[toIndex]   = m_accelerationXs[fromIndex];
+    m_accelerationYs[toIndex]   = m_accelerationYs[fromIndex];
+    m_accelerationZs[toIndex]   = m_accelerationZs[fromIndex];
+    m_radii[toIndex]            = m_radii[fromIndex];
+    m_heights[toIndex]          = m_heights[fromIndex];
+    m_drags[toIndex]            = m_drags[fromIndex];
+    m_cylinderMinZs[toIndex]    = m_cylinderMinZs[fromIndex];
+    m_cylinderMaxZs[toIndex]    = m_cylinderMaxZs[fromIndex];
+    m_isFlyingMasks[toIndex]    = m_isFlyingMasks[fromIndex];
+    m_isSimulatedMasks[toIndex] = m_isSimulatedMasks[fromIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorPhysicsStore::Resize(int const actorCount)
+{
+    m_positionXs.resize(actorCount);
+    m_positionYs.resize(actorCount);
+    m_positionZs.resize(actorCount);
+    m_velocityXs.resize(actorCount);
+    m_velocityYs.resize(actorCount);
+    m_velocityZs.resize(actorCount);
+    m_accelerationXs.resize(actorCount);
+    m_accelerationYs.resize(actorCount);
+    m_accelerationZs.resize(actorCount);
+    m_radii.resize(actorCount);
+    m_heights.resize(actorCount);
+    m_drags.resize(actorCount);
+    m_cylinderMinZs.resize(actorCount);
+    m_cylinderMaxZs.resize(actorCount);
+    m_isFlyingMasks.resize(actorCount);
+    m_isSimulatedMasks.resize(actorCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Drag is added to the acceleration, which moves the velocity, which moves the position; actors that do not fly are
+// put back on the floor and their acceleration is cleared. Dead lanes are blended back to what they were.
+// The collision cylinders follow the positions in the same pass.
+// Forces such as the held move force must already be in the acceleration, see Actor::AddForce.
+void ActorPhysicsStore::Integrate(float const deltaSeconds,
+                                  int const   begin,
+                                  int const   end)
+{
+    __m128 const seconds  = _mm_set1_ps(deltaSeconds);
+    __m128 const signBits = _mm_set1_ps(-0.f);
+
+    auto const Blend = [](__m128 const mask, __m128 const integrated, __m128 const original)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, integrated), _mm_andnot_ps(mask, original));
+    };
+
+    auto const Load = [](std::vector<float> const& values, int const index)
+    {
+        return _mm_loadu_ps(values.data() + index);
+    };
+
+    auto const LoadMask = [](std::vector<uint32_t> const& masks, int const index)
+    {
+        return _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(masks.data() + index)));
+    };
+
+    int i = begin;
+
+    for (; i + LANE_COUNT <= end; i += LANE_COUNT)
+    {
+        __m128 const isSimulated = LoadMask(m_isSimulatedMasks, i);
+        __m128 const isFlying    = LoadMask(m_isFlyingMasks, i);
+        __m128 const drag        = Load(m_drags, i);
+        __m128 const height      = Load(m_heights, i);
+        __m128 const positionX   = Load(m_positionXs, i);
+        __m128 const positionY   = Load(m_positionYs, i);
+        __m128 const positionZ   = Load(m_positionZs, i);
+        __m128 const velocityX   = Load(m_velocityXs, i);
+        __m128 const velocityY   = Load(m_velocityYs, i);
+        __m128 const velocityZ   = Load(m_velocityZs, i);
+
+        __m128 const accelerationX = _mm_add_ps(Load(m_accelerationXs, i), _mm_mul_ps(_mm_xor_ps(velocityX, signBits), drag));
+        __m128 const accelerationY = _mm_add_ps(Load(m_accelerationYs, i), _mm_mul_ps(_mm_xor_ps(velocityY, signBits), drag));
+        __m128 const accelerationZ = _mm_add_ps(Load(m_accelerationZs, i), _mm_mul_ps(_mm_xor_ps(velocityZ, signBits), drag));
+
+        __m128 const newVelocityX = _mm_add_ps(velocityX, _mm_mul_ps(accelerationX, seconds));
+        __m128 const newVelocityY = _mm_add_ps(velocityY, _mm_mul_ps(accelerationY, seconds));
+        __m128 const newVelocityZ = _mm_add_ps(velocityZ, _mm_mul_ps(accelerationZ, seconds));
+        __m128 const newPositionX = _mm_add_ps(positionX, _mm_mul_ps(newVelocityX, seconds));
+        __m128 const newPositionY = _mm_add_ps(positionY, _mm_mul_ps(newVelocityY, seconds));
+        __m128 const newPositionZ = _mm_and_ps(isFlying, _mm_add_ps(positionZ, _mm_mul_ps(newVelocityZ, seconds)));
+
+        __m128 const finalPositionZ = Blend(isSimulated, newPositionZ, positionZ);
+
+        _mm_storeu_ps(m_positionXs.data() + i, Blend(isSimulated, newPositionX, positionX));
+        _mm_storeu_ps(m_positionYs.data() + i, Blend(isSimulated, newPositionY, positionY));
+        _mm_storeu_ps(m_positionZs.data() + i, finalPositionZ);
+        _mm_storeu_ps(m_velocityXs.data() + i, Blend(isSimulated, newVelocityX, velocityX));
+        _mm_storeu_ps(m_velocityYs.data() + i, Blend(isSimulated, newVelocityY, velocityY));
+        _mm_storeu_ps(m_velocityZs.data() + i, Blend(isSimulated, newVelocityZ, velocityZ));
+        _mm_storeu_ps(m_accelerationXs.data() + i, _mm_andnot_ps(isSimulated, Load(m_accelerationXs, i)));
+        _mm_storeu_ps(m_accelerationYs.data() + i, _mm_andnot_ps(isSimulated, Load(m_accelerationYs, i)));
+        _mm_storeu_ps(m_accelerationZs.data() + i, _mm_andnot_ps(isSimulated, Load(m_accelerationZs, i)));
+        _mm_storeu_ps(m_cylinderMinZs.data() + i, finalPositionZ);
+        _mm_storeu_ps(m_cylinderMaxZs.data() + i, _mm_add_ps(finalPositionZ, height));
+    }
+
+    // The last few actors of the range, one at a time with the same operations.
+    for (; i < end; ++i)
+    {
+        if (m_isSimulatedMasks[i] == 0) continue;
+
+        float const accelerationX = m_accelerationXs[i] + -m_velocityXs[i] * m_drags[i];
+        float const accelerationY = m_accelerationYs[i] + -m_velocityYs[i] * m_drags[i];
+        float const accelerationZ = m_accelerationZs[i] + -m_velocityZs[i] * m_drags[i];
+
+        m_velocityXs[i] += accelerationX * deltaSeconds;
+        m_velocityYs[i] += accelerationY * deltaSeconds;
+        m_velocityZs[i] += accelerationZ * deltaSeconds;
+        m_positionXs[i] += m_velocityXs[i] * deltaSeconds;
+        m_positionYs[i] += m_velocityYs[i] * deltaSeconds;
+        m_positionZs[i] = m_isFlyingMasks[i] != 0 ? m_positionZs[i] + m_velocityZs[i] * deltaSeconds : 0.f;
+
+        m_cylinderMinZs[i] = m_positionZs[i];
+        m_cylinderMaxZs[i] = m_positionZs[i] + m_heights[i];
+
+        m_accelerationXs[i] = 0.f;
+        m_accelerationYs[i] = 0.f;
+        m_accelerationZs[i] = 0.f;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int ActorPhysicsStore::GetActorCount() const
+{
+    return static_cast<int>(m_positionXs.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 ActorPhysicsStore::GetPosition(int const actorIndex) const
+{
+    return Vec3(m_positionXs[actorIndex], m_positionYs[actorIndex], m_positionZs[actorIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 ActorPhysicsStore::GetVelocity(int const actorIndex) const
+{
+    return Vec3(m_velocityXs[actorIndex], m_velocityYs[actorIndex], m_velocityZs[actorIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 ActorPhysicsStore::GetAcceleration(int const actorIndex) const
+{
+    return Vec3(m_accelerationXs[actorIndex], m_accelerationYs[actorIndex], m_accelerationZs[actorIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+float ActorPhysicsStore::GetRadius(int const actorIndex) const
+{
+    return m_radii[actorIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+float ActorPhysicsStore::GetHeight(int const actorIndex) const
+{
+    return m_heights[actorIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+float ActorPhysicsStore::GetDrag(int const actorIndex) const
+{
+    return m_drags[actorIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ActorPhysicsStore::IsFlying(int const actorIndex) const
+{
+    return m_isFlyingMasks[actorIndex] != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ActorPhysicsStore::IsSimulated(int const actorIndex) const
+{
+    return m_isSimulatedMasks[actorIndex] != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+FloatRange ActorPhysicsStore::GetCylinderRangeZ(int const actorIndex) const
+{
+    return FloatRange(m_cylinderMinZs[actorIndex], m_cylinderMaxZs[actorIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+Cylinder3 ActorPhysicsStore::GetCollisionCylinder(int const actorIndex) const
+{
+    Vec3 const startPosition = Vec3(m_positionXs[actorIndex], m_positionYs[actorIndex], m_cylinderMinZs[actorIndex]);
+    Vec3 const endPosition   = Vec3(m_positionXs[actorIndex], m_positionYs[actorIndex], m_cylinderMaxZs[actorIndex]);
+
+    return Cylinder3(startPosition, endPosition, m_radii[actorIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorPhysicsStore::SetPosition(int const   actorIndex,
+                                    Vec3 const& position)
+{
+    m_positionXs[actorIndex]    = position.x;
+    m_positionYs[actorIndex]    = position.y;
+    m_positionZs[actorIndex]    = position.z;
+    m_cylinderMinZs[actorIndex] = position.z;
+    m_cylinderMaxZs[actorIndex] = position.z + m_heights[actorIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorPhysicsStore::SetVelocity(int const   actorIndex,
+                                    Vec3 const& velocity)
+{
+    m_velocityXs[actorIndex] = velocity.x;
+    m_velocityYs[actorIndex] = velocity.y;
+    m_velocityZs[actorIndex] = velocity.z;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorPhysicsStore::SetAcceleration(int const   actorIndex,
+                                        Vec3 const& acceleration)
+{
+    m_accelerationXs[actorIndex] = acceleration.x;
+    m_accelerationYs[actorIndex] = acceleration.y;
+    m_accelerationZs[actorIndex] = acceleration.z;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorPhysicsStore::SetSimulated(int const  actorIndex,
+                                     bool const isSimulated)
+{
+    m_isSimulatedMasks[actorIndex] = isSimulated ? 0xFFFFFFFFu : 0u;
+}
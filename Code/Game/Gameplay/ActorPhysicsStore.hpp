@@ -0,0 +1,69 @@
+//----------------------------------------------------------------------------------------------------
+// ActorPhysicsStore.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/Cylinder3.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Owns the physics state of every actor of a map in structure-of-arrays form: position, velocity, acceleration, radius,
+// height, drag, flags and the Z bounds of the collision cylinder, one array per component. Actor i of Map::m_actors is
+// entry i; actors reach theirs through Actor::m_physicsIndex and its accessors. Map appends an entry in SpawnActor and
+// moves the live ones down in DeleteDestroyedActor, so the entries stay in actor order.
+// An actor's collision cylinder stands on its position with its radius and height; its Z bounds are written with every
+// position, by Integrate in the same pass, so collision and raycasts read them without touching the actor.
+// Integrate steps LANE_COUNT actors at a time with SSE, in place, the same math in the same order as
+// Actor::UpdatePhysics, so the results are bit for bit the same. Actors that are not simulated, the dead ones, are
+// carried along unchanged. Disjoint ranges can be integrated in parallel, as can different entries be read and written.
+class ActorPhysicsStore
+{
+public:
+    static constexpr int LANE_COUNT = 4;
+
+    int  AddActor(Vec3 const& position, Vec3 const& velocity, float radius, float height, float drag, bool isFlying);
+    void MoveActor(int fromIndex, int toIndex);
+    void Resize(int actorCount);     // Drops the entries from actorCount on, once the live actors were moved below it.
+    void Integrate(float deltaSeconds, int begin, int end);
+    int  GetActorCount() const;
+
+    Vec3  GetPosition(int actorIndex) const;
+    Vec3  GetVelocity(int actorIndex) const;
+    Vec3  GetAcceleration(int actorIndex) const;
+    float GetRadius(int actorIndex) const;
+    float GetHeight(int actorIndex) const;
+    float GetDrag(int actorIndex) const;
+    bool  IsFlying(int actorIndex) const;
+    bool  IsSimulated(int actorIndex) const;
+
+    FloatRange GetCylinderRangeZ(int actorIndex) const;
+    Cylinder3  GetCollisionCylinder(int actorIndex) const;
+
+    void SetPosition(int actorIndex, Vec3 const& position);     // Moves the collision cylinder along.
+    void SetVelocity(int actorIndex, Vec3 const& velocity);
+    void SetAcceleration(int actorIndex, Vec3 const& acceleration);
+    void SetSimulated(int actorIndex, bool isSimulated);
+
+private:
+    std::vector<float>    m_positionXs;
+    std::vector<float>    m_positionYs;
+    std::vector<float>    m_positionZs;
+    std::vector<float>    m_velocityXs;
+    std::vector<float>    m_velocityYs;
+    std::vector<float>    m_velocityZs;
+    std::vector<float>    m_accelerationXs;
+    std::vector<float>    m_accelerationYs;
+    std::vector<float>    m_accelerationZs;
+    std::vector<float>    m_radii;
+    std::vector<float>    m_heights;
+    std::vector<float>    m_drags;
+    std::vector<float>    m_cylinderMinZs;      // Position Z.
+    std::vector<float>    m_cylinderMaxZs;      // Position Z plus the height.
+    std::vector<uint32_t> m_isFlyingMasks;      // All bits set for actors free to leave the floor, 0 for the rest.
+    std::vector<uint32_t> m_isSimulatedMasks;   // All bits set for living actors, 0 for dead ones.
+};
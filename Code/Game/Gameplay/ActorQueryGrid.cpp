@@ -0,0 +1,507 @@
+//----------------------------------------------------------------------------------------------------
+// ActorQueryGrid.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/ActorQueryGrid.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Gameplay/Actor.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void ActorQueryGrid::Initialize(IntVec2 const& dimensions,
+                                float const    cellSize)
+{
+    m_cellSize        = cellSize;
+    m_oneOverCellSize = 1.f / cellSize;
+    m_dimensions      = IntVec2(static_cast<int>(std::ceil(static_cast<float>(dimensions.x) * m_oneOverCellSize)),
+                                static_cast<int>(std::ceil(static_cast<float>(dimensions.y) * m_oneOverCellSize)));
+    m_dimensions.x    = std::max(m_dimensions.x, 1);
+    m_dimensions.y    = std::max(m_dimensions.y, 1);
+
+    int const cellCount = m_dimensions.x * m_dimensions.y;
+
+    m_cellStarts.assign(cellCount + 1, 0);
+    m_cellFills.assign(cellCount, 0);
+    m_actorCells.clear();
+    m_entryActors.clear();
+    m_entryPositions.clear();
+    m_entryRadii.clear();
+    m_entryFactionIndexes.clear();
+    m_entryActorIndexes.clear();
+    m_entryIsCollidable.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Counting sort of the actors by the cell their center is in, actors outside of the map clamped into the border cells.
+void ActorQueryGrid::Rebuild(std::vector<Actor*> const& actors)
+{
+    int const actorCount = static_cast<int>(actors.size());
+
+    m_actorCells.resize(actorCount);
+    std::fill(m_cellStarts.begin(), m_cellStarts.end(), 0);
+
+    float maxRadius = 0.f;
+
+    for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+    {
+        Vec3 const position  = actors[actorIndex]->GetPosition();
+        int const  cellIndex = GetCellCoord(position.x, m_dimensions.x) + GetCellCoord(position.y, m_dimensions.y) * m_dimensions.x;
+
+        m_actorCells[actorIndex] = cellIndex;
+        ++m_cellStarts[cellIndex + 1];
+        maxRadius = std::max(maxRadius, actors[actorIndex]->GetRadius());
+    }
+
+    m_maxRadius = maxRadius;
+    m_maxDrift  = 0.f;
+
+    for (int cellIndex = 0; cellIndex < static_cast<int>(m_cellFills.size()); ++cellIndex)
+    {
+        m_cellStarts[cellIndex + 1] += m_cellStarts[cellIndex];
+        m_cellFills[cellIndex] = m_cellStarts[cellIndex];
+    }
+
+    m_entryActors.resize(actorCount);
+    m_entryPositions.resize(actorCount);
+    m_entryRadii.resize(actorCount);
+    m_entryFactionIndexes.resize(actorCount);
+    m_entryActorIndexes.resize(actorCount);
+
+    for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+    {
+        Actor*     actor      = actors[actorIndex];
+        Vec3 const position   = actor->GetPosition();
+        int const  entryIndex = m_cellFills[m_actorCells[actorIndex]]++;
+
+        m_entryActors[entryIndex]         = actor;
+        m_entryPositions[entryIndex]      = Vec2(position.x, position.y);
+        m_entryRadii[entryIndex]          = actor->GetRadius();
+        m_entryFactionIndexes[entryIndex] = actor->m_definition->m_factionIndex;
+        m_entryActorIndexes[entryIndex]   = actorIndex;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Linear in the actors, with no sort. Border cells reach out to infinity, since they hold the actors outside of the map.
+void ActorQueryGrid::RefreshPositions()
+{
+    float maxDrift = 0.f;
+
+    for (int cellY = 0; cellY < m_dimensions.y; ++cellY)
+    {
+        float const cellMinY = cellY == 0 ? -FLT_MAX : static_cast<float>(cellY) * m_cellSize;
+        float const cellMaxY = cellY == m_dimensions.y - 1 ? FLT_MAX : static_cast<float>(cellY + 1) * m_cellSize;
+
+        for (int cellX = 0; cellX < m_dimensions.x; ++cellX)
+        {
+            int const   cellIndex = cellX + cellY * m_dimensions.x;
+            float const cellMinX  = cellX == 0 ? -FLT_MAX : static_cast<float>(cellX) * m_cellSize;
+            float const cellMaxX  = cellX == m_dimensions.x - 1 ? FLT_MAX : static_cast<float>(cellX + 1) * m_cellSize;
+
+            for (int i = m_cellStarts[cellIndex]; i < m_cellStarts[cellIndex + 1]; ++i)
+            {
+                Vec3 const  position = m_entryActors[i]->GetPosition();
+                float const driftX   = std::max(std::max(cellMinX - position.x, position.x - cellMaxX), 0.f);
+                float const driftY   = std::max(std::max(cellMinY - position.y, position.y - cellMaxY), 0.f);
+
+                m_entryPositions[i] = Vec2(position.x, position.y);
+                maxDrift            = std::max(maxDrift, std::max(driftX, driftY));
+            }
+        }
+    }
+
+    m_maxDrift = maxDrift;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorQueryGrid::QueryDisc(Vec2 const&                 center,
+                               float const                 radius,
+                               ActorQueryFilter const&     filter,
+                               std::vector<ActorQueryHit>& out_hits) const
+{
+    out_hits.clear();
+
+    float const reach     = radius + (filter.m_isMeasuredToSurface ? m_maxRadius : 0.f);
+    float const cellReach = reach + m_maxDrift;
+    int const   minX      = GetCellCoord(center.x - cellReach, m_dimensions.x);
+    int const   maxX      = GetCellCoord(center.x + cellReach, m_dimensions.x);
+    int const   minY      = GetCellCoord(center.y - cellReach, m_dimensions.y);
+    int const   maxY      = GetCellCoord(center.y + cellReach, m_dimensions.y);
+
+    for (int cellY = minY; cellY <= maxY; ++cellY)
+    {
+        for (int cellX = minX; cellX <= maxX; ++cellX)
+        {
+            int const cellIndex = cellX + cellY * m_dimensions.x;
+
+            for (int i = m_cellStarts[cellIndex]; i < m_cellStarts[cellIndex + 1]; ++i)
+            {
+                if (GetDistanceSquared2D(m_entryPositions[i], center) > reach * reach) continue;
+
+                float distance = GetDistance2D(m_entryPositions[i], center);
+
+                if (filter.m_isMeasuredToSurface) distance = std::max(distance - m_entryRadii[i], 0.f);
+
+                if (distance > radius || !IsAccepted(i, filter)) continue;
+
+                out_hits.push_back(ActorQueryHit{m_entryActors[i], distance});
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// The angle is always measured to the actor's center; an actor right at the origin is inside of any sector.
+void ActorQueryGrid::QuerySector(Vec2 const&                 origin,
+                                 Vec2 const&                 forwardNormal,
+                                 float const                 halfAngleDegrees,
+                                 float const                 range,
+                                 ActorQueryFilter const&     filter,
+                                 std::vector<ActorQueryHit>& out_hits) const
+{
+    out_hits.clear();
+
+    float const minDotProduct = CosDegrees(std::min(halfAngleDegrees, 180.f));
+    float const reach         = range + (filter.m_isMeasuredToSurface ? m_maxRadius : 0.f);
+    float const cellReach     = reach + m_maxDrift;
+    int const   minX          = GetCellCoord(origin.x - cellReach, m_dimensions.x);
+    int const   maxX          = GetCellCoord(origin.x + cellReach, m_dimensions.x);
+    int const   minY          = GetCellCoord(origin.y - cellReach, m_dimensions.y);
+    int const   maxY          = GetCellCoord(origin.y + cellReach, m_dimensions.y);
+
+    for (int cellY = minY; cellY <= maxY; ++cellY)
+    {
+        for (int cellX = minX; cellX <= maxX; ++cellX)
+        {
+            int const cellIndex = cellX + cellY * m_dimensions.x;
+
+            for (int i = m_cellStarts[cellIndex]; i < m_cellStarts[cellIndex + 1]; ++i)
+            {
+                Vec2 const  toEntry        = m_entryPositions[i] - origin;
+                float const centerDistance = toEntry.GetLength();
+
+                if (centerDistance > reach) continue;
+                if (centerDistance > 0.f && DotProduct2D(toEntry, forwardNormal) < minDotProduct * centerDistance) continue;
+
+                float const distance = filter.m_isMeasuredToSurface ? std::max(centerDistance - m_entryRadii[i], 0.f) : centerDistance;
+
+                if (distance > range || !IsAccepted(i, filter)) continue;
+
+                out_hits.push_back(ActorQueryHit{m_entryActors[i], distance});
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Searches rings of cells outward from the center's cell, and stops as soon as the count closest found so far are
+// closer than anything in the cells not yet searched could be. Of actors as close, the one searched first wins.
+void ActorQueryGrid::QueryNearest(Vec2 const&                 center,
+                                  int const                   count,
+                                  float const                 maxDistance,
+                                  ActorQueryFilter const&     filter,
+                                  std::vector<ActorQueryHit>& out_hits) const
+{
+    out_hits.clear();
+
+    if (count <= 0) return;
+
+    IntVec2 const centerCell = IntVec2(GetCellCoord(center.x, m_dimensions.x), GetCellCoord(center.y, m_dimensions.y));
+    int const     maxRing    = std::max(m_dimensions.x, m_dimensions.y);
+    float const   slack      = (filter.m_isMeasuredToSurface ? m_maxRadius : 0.f) + m_maxDrift;
+
+    for (int ring = 0; ring <= maxRing; ++ring)
+    {
+        AddRingHits(centerCell, ring, center, maxDistance, filter, out_hits);
+
+        std::stable_sort(out_hits.begin(), out_hits.end(), [](ActorQueryHit const& a, ActorQueryHit const& b)
+        {
+            return a.m_distance < b.m_distance;
+        });
+
+        if (static_cast<int>(out_hits.size()) > count) out_hits.resize(count);
+
+        // How far the center is from the nearest cell not yet searched.
+        float const searchedMinX    = static_cast<float>(centerCell.x - ring) * m_cellSize;
+        float const searchedMaxX    = static_cast<float>(centerCell.x + ring + 1) * m_cellSize;
+        float const searchedMinY    = static_cast<float>(centerCell.y - ring) * m_cellSize;
+        float const searchedMaxY    = static_cast<float>(centerCell.y + ring + 1) * m_cellSize;
+        float const searchedReach   = std::min(std::min(center.x - searchedMinX, searchedMaxX - center.x), std::min(center.y - searchedMinY, searchedMaxY - center.y));
+        float const unsearchedReach = searchedReach - slack;
+
+        if (unsearchedReach > maxDistance) return;
+        if (static_cast<int>(out_hits.size()) == count && out_hits.back().m_distance <= unsearchedReach) return;
+
+        bool const isWholeGridSearched = centerCell.x - ring <= 0 && centerCell.y - ring <= 0 && centerCell.x + ring >= m_dimensions.x - 1 && centerCell.y + ring >= m_dimensions.y - 1;
+
+        if (isWholeGridSearched) return;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Actors within halfWidth of the segment, ordered by how far along the segment they are closest to it.
+void ActorQueryGrid::QuerySegment(Vec2 const&                 start,
+                                  Vec2 const&                 end,
+                                  float const                 halfWidth,
+                                  ActorQueryFilter const&     filter,
+                                  std::vector<ActorQueryHit>& out_hits) const
+{
+    out_hits.clear();
+
+    Vec2 const  segment          = end - start;
+    float const length           = segment.GetLength();
+    Vec2 const  direction        = length > 0.f ? segment / length : Vec2(1.f, 0.f);
+    float const reach            = halfWidth + (filter.m_isMeasuredToSurface ? m_maxRadius : 0.f);
+    float const cellReach        = reach + m_maxDrift;
+    float const cellHalfDiagonal = 0.70711f * (m_cellSize + 2.f * m_maxDrift);     // Of a cell grown by the drift.
+    int const   minX             = GetCellCoord(std::min(start.x, end.x) - cellReach, m_dimensions.x);
+    int const   maxX             = GetCellCoord(std::max(start.x, end.x) + cellReach, m_dimensions.x);
+    int const   minY             = GetCellCoord(std::min(start.y, end.y) - cellReach, m_dimensions.y);
+    int const   maxY             = GetCellCoord(std::max(start.y, end.y) + cellReach, m_dimensions.y);
+
+    auto const GetDistanceToSegment = [&start, &direction, length](Vec2 const& point, float& out_alongDistance)
+    {
+        out_alongDistance = GetClamped(DotProduct2D(point - start, direction), 0.f, length);
+        return GetDistance2D(point, start + direction * out_alongDistance);
+    };
+
+    for (int cellY = minY; cellY <= maxY; ++cellY)
+    {
+        for (int cellX = minX; cellX <= maxX; ++cellX)
+        {
+            int const cellIndex = cellX + cellY * m_dimensions.x;
+
+            if (m_cellStarts[cellIndex] == m_cellStarts[cellIndex + 1]) continue;
+
+            // Skip the cells of the bounding box the segment passes far from. Border cells also hold the actors
+            // clamped into them from outside of the map, so they are always searched.
+            bool const isBorderCell = cellX == 0 || cellY == 0 || cellX == m_dimensions.x - 1 || cellY == m_dimensions.y - 1;
+            Vec2 const cellCenter   = Vec2((static_cast<float>(cellX) + 0.5f) * m_cellSize, (static_cast<float>(cellY) + 0.5f) * m_cellSize);
+            float      alongDistance;
+
+            if (!isBorderCell && GetDistanceToSegment(cellCenter, alongDistance) > reach + cellHalfDiagonal) continue;
+
+            for (int i = m_cellStarts[cellIndex]; i < m_cellStarts[cellIndex + 1]; ++i)
+            {
+                float distance = GetDistanceToSegment(m_entryPositions[i], alongDistance);
+
+                if (filter.m_isMeasuredToSurface) distance = std::max(distance - m_entryRadii[i], 0.f);
+
+                if (distance > halfWidth || !IsAccepted(i, filter)) continue;
+
+                out_hits.push_back(ActorQueryHit{m_entryActors[i], alongDistance});
+            }
+        }
+    }
+
+    std::stable_sort(out_hits.begin(), out_hits.end(), [](ActorQueryHit const& a, ActorQueryHit const& b)
+    {
+        return a.m_distance < b.m_distance;
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorQueryGrid::QueryBounds(Vec2 const&          mins,
+                                 Vec2 const&          maxs,
+                                 std::vector<Actor*>& out_actors) const
+{
+    out_actors.clear();
+
+    float const cellReach = m_maxRadius + m_maxDrift;
+    int const   minX      = GetCellCoord(mins.x - cellReach, m_dimensions.x);
+    int const   maxX      = GetCellCoord(maxs.x + cellReach, m_dimensions.x);
+    int const   minY      = GetCellCoord(mins.y - cellReach, m_dimensions.y);
+    int const   maxY      = GetCellCoord(maxs.y + cellReach, m_dimensions.y);
+
+    for (int cellY = minY; cellY <= maxY; ++cellY)
+    {
+        for (int cellX = minX; cellX <= maxX; ++cellX)
+        {
+            int const cellIndex = cellX + cellY * m_dimensions.x;
+
+            for (int i = m_cellStarts[cellIndex]; i < m_cellStarts[cellIndex + 1]; ++i)
+            {
+                Vec2 const& position = m_entryPositions[i];
+                float const radius   = m_entryRadii[i];
+
+                if (position.x + radius < mins.x || position.x - radius > maxs.x) continue;
+                if (position.y + radius < mins.y || position.y - radius > maxs.y) continue;
+
+                out_actors.push_back(m_entryActors[i]);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Candidates only come from the same cell and the forward half of its neighbors, as far as two touching actors that
+// strayed from their cells can be apart. Pairs come back sorted, which is the order the old all-pairs loop visited them
+// in, so collision response stays deterministic regardless of how actors are spread over the cells.
+void ActorQueryGrid::GetCandidatePairs(std::vector<ActorPair>& out_pairs)
+{
+    out_pairs.clear();
+
+    int const entryCount = static_cast<int>(m_entryActors.size());
+    float     maxRadius  = 0.f;
+
+    m_entryIsCollidable.resize(entryCount);
+
+    for (int i = 0; i < entryCount; ++i)
+    {
+        m_entryIsCollidable[i] = IsCollidableWithActors(m_entryActors[i]) ? 1 : 0;
+
+        if (m_entryIsCollidable[i]) maxRadius = std::max(maxRadius, m_entryRadii[i]);
+    }
+
+    // Two discs touch when their centers are closer than the sum of their radii.
+    int const neighborReach = std::max(1, static_cast<int>(std::ceil((2.f * maxRadius + 2.f * m_maxDrift) * m_oneOverCellSize)));
+
+    for (int cellY = 0; cellY < m_dimensions.y; ++cellY)
+    {
+        for (int cellX = 0; cellX < m_dimensions.x; ++cellX)
+        {
+            int const cellIndex = cellX + cellY * m_dimensions.x;
+
+            if (m_cellStarts[cellIndex] == m_cellStarts[cellIndex + 1]) continue;
+
+            AddPairsBetweenCells(cellIndex, cellIndex, out_pairs);
+
+            // Forward half of the neighborhood: the rest of this row to the right, then every row above.
+            for (int offsetY = 0; offsetY <= neighborReach; ++offsetY)
+            {
+                int const neighborY = cellY + offsetY;
+
+                if (neighborY >= m_dimensions.y) break;
+
+                for (int offsetX = -neighborReach; offsetX <= neighborReach; ++offsetX)
+                {
+                    if (offsetY == 0 && offsetX <= 0) continue;
+
+                    int const neighborX = cellX + offsetX;
+
+                    if (neighborX < 0 || neighborX >= m_dimensions.x) continue;
+
+                    AddPairsBetweenCells(cellIndex, neighborX + neighborY * m_dimensions.x, out_pairs);
+                }
+            }
+        }
+    }
+
+    std::sort(out_pairs.begin(), out_pairs.end(), [](ActorPair const& a, ActorPair const& b)
+    {
+        return a.m_first != b.m_first ? a.m_first < b.m_first : a.m_second < b.m_second;
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+int ActorQueryGrid::GetActorCount() const
+{
+    return static_cast<int>(m_entryActors.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Layer filter: cosmetic actors (spawn points, hit effects) do not set collidesWithActors and never become pairs.
+// Dead actors are skipped too, since Actor::OnCollisionEnterWithActor ignores them anyway.
+STATIC bool ActorQueryGrid::IsCollidableWithActors(Actor const* actor)
+{
+    return
+        actor != nullptr &&
+        actor->m_handle.IsValid() &&
+        actor->m_definition->m_collidesWithActors &&
+        !actor->m_isDead;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ActorQueryGrid::GetCellCoord(float const value,
+                                 int const   dimension) const
+{
+    return std::clamp(RoundDownToInt(value * m_oneOverCellSize), 0, dimension - 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The snapshot is checked first; the actor itself is only touched for the ones that pass it.
+bool ActorQueryGrid::IsAccepted(int const               entryIndex,
+                                ActorQueryFilter const& filter) const
+{
+    Actor const* actor = m_entryActors[entryIndex];
+
+    if (actor == filter.m_ignoredActor) return false;
+    if ((filter.m_factionMask & (1u << m_entryFactionIndexes[entryIndex])) == 0) return false;
+    if (actor->m_isDead) return false;
+
+    return !filter.m_predicate || filter.m_predicate(*actor);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Adds the accepted actors within maxDistance of center from the cells exactly ring cells away from centerCell.
+void ActorQueryGrid::AddRingHits(IntVec2 const&              centerCell,
+                                 int const                   ring,
+                                 Vec2 const&                 center,
+                                 float const                 maxDistance,
+                                 ActorQueryFilter const&     filter,
+                                 std::vector<ActorQueryHit>& out_hits) const
+{
+    int const minY = std::max(centerCell.y - ring, 0);
+    int const maxY = std::min(centerCell.y + ring, m_dimensions.y - 1);
+
+    for (int cellY = minY; cellY <= maxY; ++cellY)
+    {
+        // Whole rows at the top and bottom of the ring, only its two ends in between.
+        bool const isEdgeRow = cellY == centerCell.y - ring || cellY == centerCell.y + ring;
+        int const  stepX     = isEdgeRow ? 1 : std::max(2 * ring, 1);
+
+        for (int cellX = centerCell.x - ring; cellX <= centerCell.x + ring; cellX += stepX)
+        {
+            if (cellX < 0 || cellX >= m_dimensions.x) continue;
+
+            int const cellIndex = cellX + cellY * m_dimensions.x;
+
+            for (int i = m_cellStarts[cellIndex]; i < m_cellStarts[cellIndex + 1]; ++i)
+            {
+                float distance = GetDistance2D(m_entryPositions[i], center);
+
+                if (filter.m_isMeasuredToSurface) distance = std::max(distance - m_entryRadii[i], 0.f);
+
+                if (distance > maxDistance || !IsAccepted(i, filter)) continue;
+
+                out_hits.push_back(ActorQueryHit{m_entryActors[i], distance});
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ActorQueryGrid::AddPairsBetweenCells(int const               cellIndexA,
+                                          int const               cellIndexB,
+                                          std::vector<ActorPair>& out_pairs) const
+{
+    int const startA = m_cellStarts[cellIndexA];
+    int const endA   = m_cellStarts[cellIndexA + 1];
+    int const startB = m_cellStarts[cellIndexB];
+    int const endB   = m_cellStarts[cellIndexB + 1];
+
+    for (int a = startA; a < endA; ++a)
+    {
+        if (!m_entryIsCollidable[a]) continue;
+
+        // Within a single cell, only pair each actor with the ones after it.
+        int const firstB = cellIndexA == cellIndexB ? a + 1 : startB;
+
+        for (int b = firstB; b < endB; ++b)
+        {
+            if (!m_entryIsCollidable[b]) continue;
+
+            int const actorIndexA = m_entryActorIndexes[a];
+            int const actorIndexB = m_entryActorIndexes[b];
+
+            out_pairs.push_back(ActorPair{std::min(actorIndexA, actorIndexB), std::max(actorIndexA, actorIndexB)});
+        }
+    }
+}
@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------------------------------
+// ActorQueryGrid.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+
+//----------------------------------------------------------------------------------------------------
+// Which of the actors a query shape covers are returned. Dead actors never are.
+struct ActorQueryFilter
+{
+    Actor const*                            m_ignoredActor        = nullptr;
+    uint32_t                                m_factionMask         = 0xFFFFFFFFu;     // Bit i accepts faction index i.
+    bool                                    m_isMeasuredToSurface = false;           // Measure to the edge of each actor's disc instead of its center.
+    std::function<bool(Actor const& actor)> m_predicate;                             // Optional, only asked about actors in the shape.
+};
+
+//----------------------------------------------------------------------------------------------------
+// Two indexes into the actor list the grid was rebuilt from, with m_first < m_second.
+struct ActorPair
+{
+    int m_first  = -1;
+    int m_second = -1;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct ActorQueryHit
+{
+    Actor* m_actor    = nullptr;
+    float  m_distance = 0.f;      // From the query center, or along the segment for segment queries.
+};
+
+//----------------------------------------------------------------------------------------------------
+// Uniform grid over every actor in the map for gameplay queries and the actor vs actor collision broadphase, one cell
+// per map tile by default. It snapshots the actors' positions, radii and factions cell by cell, so a query scans
+// contiguous memory and only touches an actor to check that it is alive and to ask the filter's predicate.
+// Rebuilt by Map once per tick, after the physics phase and before the actors collide, and at the start of the next
+// actor update only if actors were spawned or deleted since. Once collision has pushed the actors a little, their
+// positions are refreshed without moving them between cells; the queries search as much further as the farthest one
+// strayed from its cell. Read-only and thread-safe in between.
+// Results come back in the same order for the same actors, whatever thread asks.
+class ActorQueryGrid
+{
+public:
+    void Initialize(IntVec2 const& dimensions, float cellSize = 1.f);
+    void Rebuild(std::vector<Actor*> const& actors);
+    void RefreshPositions();     // For actors that moved since the last rebuild; none may have been deleted.
+
+    // Actors in no particular order.
+    void QueryDisc(Vec2 const& center, float radius, ActorQueryFilter const& filter, std::vector<ActorQueryHit>& out_hits) const;
+    void QuerySector(Vec2 const& origin, Vec2 const& forwardNormal, float halfAngleDegrees, float range, ActorQueryFilter const& filter, std::vector<ActorQueryHit>& out_hits) const;
+
+    // Closest first.
+    void QueryNearest(Vec2 const& center, int count, float maxDistance, ActorQueryFilter const& filter, std::vector<ActorQueryHit>& out_hits) const;
+    void QuerySegment(Vec2 const& start, Vec2 const& end, float halfWidth, ActorQueryFilter const& filter, std::vector<ActorQueryHit>& out_hits) const;
+
+    // Every actor, dead or alive, whose disc overlapped the box as of the last rebuild or refresh, in no particular order; unfiltered for broadphases.
+    void QueryBounds(Vec2 const& mins, Vec2 const& maxs, std::vector<Actor*>& out_actors) const;
+
+    // Pairs of collidable actors that could touch, sorted by (m_first, m_second), each pair once.
+    void GetCandidatePairs(std::vector<ActorPair>& out_pairs);
+
+    int GetActorCount() const;     // As of the last rebuild; actors spawned since are at the end of the list it was rebuilt from.
+
+    static bool IsCollidableWithActors(Actor const* actor);
+
+private:
+    int  GetCellCoord(float value, int dimension) const;
+    bool IsAccepted(int entryIndex, ActorQueryFilter const& filter) const;
+    void AddRingHits(IntVec2 const& centerCell, int ring, Vec2 const& center, float maxDistance, ActorQueryFilter const& filter, std::vector<ActorQueryHit>& out_hits) const;
+    void AddPairsBetweenCells(int cellIndexA, int cellIndexB, std::vector<ActorPair>& out_pairs) const;
+
+    IntVec2              m_dimensions;
+    float                m_cellSize        = 1.f;
+    float                m_oneOverCellSize = 1.f;
+    float                m_maxRadius       = 0.f;     // Largest radius seen in the last rebuild.
+    float                m_maxDrift        = 0.f;     // Farthest any actor is outside of its cell as of the last refresh.
+    std::vector<int>     m_cellStarts;                // Entries of cell c are [m_cellStarts[c], m_cellStarts[c + 1]).
+    std::vector<int>     m_cellFills;                 // Scratch write cursors for the counting sort.
+    std::vector<int>     m_actorCells;                // Scratch cell index of each actor in the list being rebuilt from.
+
+    // Entries grouped by cell, in actor order inside each cell.
+    std::vector<Actor*>  m_entryActors;
+    std::vector<Vec2>    m_entryPositions;
+    std::vector<float>   m_entryRadii;
+    std::vector<int>     m_entryFactionIndexes;
+    std::vector<int>     m_entryActorIndexes;         // Into the list rebuilt from.
+    std::vector<uint8_t> m_entryIsCollidable;         // Scratch for GetCandidatePairs.
+};
@@ -0,0 +1,451 @@
+//----------------------------------------------------------------------------------------------------
+// CompiledMap.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/CompiledMap.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Game/Definition/TileDefinition.hpp"
+#include "Game/Gameplay/MapGeometryBuilder.hpp"
+#include "Game/Gameplay/Tile.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static_assert(sizeof(Tile) == 1, "CompiledMap stores tiles as their definition index and maps them straight onto Tile");
+static_assert(sizeof(CompiledMapHeader) % 8 == 0, "CompiledMap sections are 8 byte aligned");
+
+//----------------------------------------------------------------------------------------------------
+// Pads the blob to 8 bytes and appends the section, returning its offset.
+static uint64_t AppendSection(std::vector<uint8_t>& blob,
+                              void const*           data,
+                              size_t const          size)
+{
+    blob.resize((blob.size() + 7) & ~static_cast<size_t>(7), 0);
+
+    uint64_t const offset = blob.size();
+    uint8_t const* bytes  = static_cast<uint8_t const*>(data);
+
+    blob.insert(blob.end(), bytes, bytes + size);
+
+    return offset;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool CopyName(CompiledMapName& out_name,
+                     String const&    name)
+{
+    std::memset(out_name.m_name, 0, sizeof(out_name.m_name));
+
+    if (name.size() >= sizeof(out_name.m_name)) return false;
+
+    std::memcpy(out_name.m_name, name.c_str(), name.size());
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+CompiledMap::~CompiledMap()
+{
+    Close();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Bakes everything Map would otherwise work out at load time: the tiles and their solidity,
+// and the culled and merged geometry of every chunk, with uvs laid out as in the sprite sheet.
+STATIC bool CompiledMap::Write(char const*                   path,
+                               IntVec2 const&                dimensions,
+                               Tile const*                   tiles,
+                               IntVec2 const&                spriteSheetCellCount,
+                               std::vector<SpawnInfo> const& spawnInfos)
+{
+    std::vector<uint64_t> solidTileBits;
+    Tile::CreateSolidTileBits(dimensions, tiles, solidTileBits);
+
+    std::vector<CompiledMapSpawnInfo> compiledSpawnInfos(spawnInfos.size());
+
+    for (size_t i = 0; i < spawnInfos.size(); ++i)
+    {
+        SpawnInfo const&      spawnInfo         = spawnInfos[i];
+        CompiledMapSpawnInfo& compiledSpawnInfo = compiledSpawnInfos[i];
+
+        if (!CopyName(compiledSpawnInfo.m_actorName, spawnInfo.m_name) ||
+            !CopyName(compiledSpawnInfo.m_faction, spawnInfo.m_faction))
+        {
+            DebuggerPrintf("CompiledMap: spawn info name \"%s\" is too long for %s\n", spawnInfo.m_name.c_str(), path);
+            return false;
+        }
+
+        compiledSpawnInfo.m_position[0]    = spawnInfo.m_position.x;
+        compiledSpawnInfo.m_position[1]    = spawnInfo.m_position.y;
+        compiledSpawnInfo.m_position[2]    = spawnInfo.m_position.z;
+        compiledSpawnInfo.m_orientation[0] = spawnInfo.m_orientation.m_yawDegrees;
+        compiledSpawnInfo.m_orientation[1] = spawnInfo.m_orientation.m_pitchDegrees;
+        compiledSpawnInfo.m_orientation[2] = spawnInfo.m_orientation.m_rollDegrees;
+        compiledSpawnInfo.m_velocity[0]    = spawnInfo.m_velocity.x;
+        compiledSpawnInfo.m_velocity[1]    = spawnInfo.m_velocity.y;
+        compiledSpawnInfo.m_velocity[2]    = spawnInfo.m_velocity.z;
+        compiledSpawnInfo.m_reserved       = 0.f;
+    }
+
+    std::vector<AABB2> spriteUVs;
+    MapGeometryBuilder::GetSpriteSheetUVs(spriteSheetCellCount, spriteUVs);
+
+    MapGeometryBuilder const      builder    = MapGeometryBuilder(dimensions, tiles, spriteSheetCellCount, spriteUVs);
+    int const                     chunkCount = MapGeometryBuilder::GetChunkCount(dimensions);
+    std::vector<CompiledMapChunk> chunks(chunkCount);
+    VertexList_PCUTBN             verts;
+    IndexList                     indexes;
+    VertexList_PCUTBN             chunkVerts;
+    IndexList                     chunkIndexes;
+
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+        IntVec2 tileMins;
+        IntVec2 tileMaxs;
+        MapGeometryBuilder::GetChunkRegion(dimensions, chunkIndex, tileMins, tileMaxs);
+
+        chunkVerts.clear();
+        chunkIndexes.clear();
+        builder.Build(chunkVerts, chunkIndexes, tileMins, tileMaxs);
+
+        chunks[chunkIndex] = CompiledMapChunk{static_cast<uint32_t>(verts.size()), static_cast<uint32_t>(chunkVerts.size()),
+                                              static_cast<uint32_t>(indexes.size()), static_cast<uint32_t>(chunkIndexes.size())};
+
+        verts.insert(verts.end(), chunkVerts.begin(), chunkVerts.end());
+        indexes.insert(indexes.end(), chunkIndexes.begin(), chunkIndexes.end());
+    }
+
+    CompiledMapHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.m_magic                 = MAGIC;
+    header.m_version               = VERSION;
+    header.m_vertexSize            = sizeof(Vertex_PCUTBN);
+    header.m_chunkSize             = MapGeometryBuilder::CHUNK_SIZE;
+    header.m_dimensionsX           = dimensions.x;
+    header.m_dimensionsY           = dimensions.y;
+    header.m_spriteSheetCellCountX = spriteSheetCellCount.x;
+    header.m_spriteSheetCellCountY = spriteSheetCellCount.y;
+    header.m_spawnInfoCount        = static_cast<uint32_t>(compiledSpawnInfos.size());
+    header.m_chunkCount            = static_cast<uint32_t>(chunks.size());
+    header.m_vertexCount           = static_cast<uint32_t>(verts.size());
+    header.m_indexCount            = static_cast<uint32_t>(indexes.size());
+    header.m_tileDefinitionHash    = GetTileDefinitionHash();
+
+    std::vector<uint8_t> blob(sizeof(CompiledMapHeader), 0);
+    header.m_tilesOffset         = AppendSection(blob, tiles, static_cast<size_t>(dimensions.x * dimensions.y) * sizeof(Tile));
+    header.m_solidTileBitsOffset = AppendSection(blob, solidTileBits.data(), solidTileBits.size() * sizeof(uint64_t));
+    header.m_spawnInfosOffset    = AppendSection(blob, compiledSpawnInfos.data(), compiledSpawnInfos.size() * sizeof(CompiledMapSpawnInfo));
+    header.m_chunksOffset        = AppendSection(blob, chunks.data(), chunks.size() * sizeof(CompiledMapChunk));
+    header.m_vertexesOffset      = AppendSection(blob, verts.data(), verts.size() * sizeof(Vertex_PCUTBN));
+    header.m_indexesOffset       = AppendSection(blob, indexes.data(), indexes.size() * sizeof(uint32_t));
+    header.m_fileSize            = blob.size();
+    std::memcpy(blob.data(), &header, sizeof(header));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    if (!file) return false;
+
+    file.write(reinterpret_cast<char const*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+
+    return file.good();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns false, leaving nothing mapped, when the file is missing or was compiled against different
+// tile definitions, sprite sheet layout, vertex format or chunk size than the running game uses.
+bool CompiledMap::Open(char const*    path,
+                       IntVec2 const& spriteSheetCellCount)
+{
+    Close();
+
+#if defined(_WIN32)
+    HANDLE const file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE const mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void const* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle    = file;
+    m_mappingHandle = mapping;
+    m_data          = static_cast<uint8_t const*>(view);
+    m_size          = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int const fileDescriptor = open(path, O_RDONLY);
+
+    if (fileDescriptor < 0) return false;
+
+    struct stat fileStatus;
+
+    if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+
+    if (view == MAP_FAILED) return false;
+
+    m_data = static_cast<uint8_t const*>(view);
+    m_size = static_cast<size_t>(fileStatus.st_size);
+#endif
+
+    if (!IsValid(spriteSheetCellCount))
+    {
+        DebuggerPrintf("CompiledMap: %s is out of date or corrupt, rerun MapCompiler\n", path);
+        Close();
+        return false;
+    }
+
+    CompiledMapHeader const&    header             = GetHeader();
+    CompiledMapSpawnInfo const* compiledSpawnInfos = GetSection<CompiledMapSpawnInfo>(header.m_spawnInfosOffset);
+
+    m_spawnInfos.resize(header.m_spawnInfoCount);
+
+    for (uint32_t i = 0; i < header.m_spawnInfoCount; ++i)
+    {
+        CompiledMapSpawnInfo const& compiledSpawnInfo = compiledSpawnInfos[i];
+        SpawnInfo&                  spawnInfo         = m_spawnInfos[i];
+
+        spawnInfo.m_name        = compiledSpawnInfo.m_actorName.m_name;
+        spawnInfo.m_faction     = compiledSpawnInfo.m_faction.m_name;
+        spawnInfo.m_position    = Vec3(compiledSpawnInfo.m_position[0], compiledSpawnInfo.m_position[1], compiledSpawnInfo.m_position[2]);
+        spawnInfo.m_orientation = EulerAngles(compiledSpawnInfo.m_orientation[0], compiledSpawnInfo.m_orientation[1], compiledSpawnInfo.m_orientation[2]);
+        spawnInfo.m_velocity    = Vec3(compiledSpawnInfo.m_velocity[0], compiledSpawnInfo.m_velocity[1], compiledSpawnInfo.m_velocity[2]);
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void CompiledMap::Close()
+{
+#if defined(_WIN32)
+    if (m_data != nullptr) UnmapViewOfFile(m_data);
+    if (m_mappingHandle != nullptr) CloseHandle(m_mappingHandle);
+    if (m_fileHandle != nullptr) CloseHandle(m_fileHandle);
+#else
+    if (m_data != nullptr) munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+
+    m_data          = nullptr;
+    m_size          = 0;
+    m_fileHandle    = nullptr;
+    m_mappingHandle = nullptr;
+    m_spawnInfos.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool CompiledMap::IsOpen() const
+{
+    return m_data != nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+IntVec2 CompiledMap::GetDimensions() const
+{
+    return IntVec2(GetHeader().m_dimensionsX, GetHeader().m_dimensionsY);
+}
+
+//----------------------------------------------------------------------------------------------------
+Tile const* CompiledMap::GetTiles() const
+{
+    return GetSection<Tile>(GetHeader().m_tilesOffset);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t const* CompiledMap::GetSolidTileBits() const
+{
+    return GetSection<uint64_t>(GetHeader().m_solidTileBitsOffset);
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<SpawnInfo> const& CompiledMap::GetSpawnInfos() const
+{
+    return m_spawnInfos;
+}
+
+//----------------------------------------------------------------------------------------------------
+int CompiledMap::GetChunkCount() const
+{
+    return static_cast<int>(GetHeader().m_chunkCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+CompiledMapChunk const& CompiledMap::GetChunk(int const chunkIndex) const
+{
+    return GetSection<CompiledMapChunk>(GetHeader().m_chunksOffset)[chunkIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+Vertex_PCUTBN const* CompiledMap::GetVertexes() const
+{
+    return GetSection<Vertex_PCUTBN>(GetHeader().m_vertexesOffset);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t const* CompiledMap::GetIndexes() const
+{
+    return GetSection<uint32_t>(GetHeader().m_indexesOffset);
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t CompiledMap::GetFileSize() const
+{
+    return m_size;
+}
+
+//----------------------------------------------------------------------------------------------------
+// FNV-1a over everything a compiled map depends on in TileDefinitions.xml, in definition order.
+STATIC uint64_t CompiledMap::GetTileDefinitionHash()
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    auto const HashBytes = [&hash](void const* data, size_t const size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash = (hash ^ static_cast<uint8_t const*>(data)[i]) * 1099511628211ull;
+        }
+    };
+
+    for (TileDefinition const* tileDef : TileDefinition::s_tileDefinitions)
+    {
+        int const spriteCoords[6] = {tileDef->m_floorSpriteCoords.x, tileDef->m_floorSpriteCoords.y,
+                                     tileDef->m_ceilingSpriteCoords.x, tileDef->m_ceilingSpriteCoords.y,
+                                     tileDef->m_wallSpriteCoords.x, tileDef->m_wallSpriteCoords.y};
+
+        HashBytes(tileDef->m_name.c_str(), tileDef->m_name.size() + 1);
+        HashBytes(&tileDef->m_isSolid, sizeof(tileDef->m_isSolid));
+        HashBytes(spriteCoords, sizeof(spriteCoords));
+    }
+
+    return hash;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Checks the header against the running game and that every section lies inside the file.
+// Tile indexes are range checked too, since Tile::GetDefinition trusts them; that is the only pass over the data.
+bool CompiledMap::IsValid(IntVec2 const& spriteSheetCellCount) const
+{
+    if (m_size < sizeof(CompiledMapHeader)) return false;
+
+    CompiledMapHeader const& header = GetHeader();
+
+    if (header.m_magic != MAGIC ||
+        header.m_version != VERSION ||
+        header.m_vertexSize != sizeof(Vertex_PCUTBN) ||
+        header.m_chunkSize != MapGeometryBuilder::CHUNK_SIZE ||
+        header.m_fileSize != m_size ||
+        header.m_dimensionsX <= 0 ||
+        header.m_dimensionsY <= 0 ||
+        header.m_spriteSheetCellCountX != spriteSheetCellCount.x ||
+        header.m_spriteSheetCellCountY != spriteSheetCellCount.y ||
+        header.m_tileDefinitionHash != GetTileDefinitionHash())
+    {
+        return false;
+    }
+
+    IntVec2 const dimensions = GetDimensions();
+
+    if (static_cast<int>(header.m_chunkCount) != MapGeometryBuilder::GetChunkCount(dimensions)) return false;
+
+    auto const IsSectionInside = [this](uint64_t const offset, uint64_t const count, uint64_t const elementSize)
+    {
+        return
+            offset % 8 == 0 &&
+            offset <= m_size &&
+            count <= (m_size - offset) / elementSize;
+    };
+
+    uint64_t const tileCount          = static_cast<uint64_t>(dimensions.x) * static_cast<uint64_t>(dimensions.y);
+    uint64_t const paddedTileCount    = static_cast<uint64_t>(Tile::GetSolidTileBitsWidth(dimensions)) * static_cast<uint64_t>(dimensions.y + 2);
+    uint64_t const solidTileWordCount = (paddedTileCount + 63) / 64;
+
+    if (!IsSectionInside(header.m_tilesOffset, tileCount, sizeof(Tile)) ||
+        !IsSectionInside(header.m_solidTileBitsOffset, solidTileWordCount, sizeof(uint64_t)) ||
+        !IsSectionInside(header.m_spawnInfosOffset, header.m_spawnInfoCount, sizeof(CompiledMapSpawnInfo)) ||
+        !IsSectionInside(header.m_chunksOffset, header.m_chunkCount, sizeof(CompiledMapChunk)) ||
+        !IsSectionInside(header.m_vertexesOffset, header.m_vertexCount, sizeof(Vertex_PCUTBN)) ||
+        !IsSectionInside(header.m_indexesOffset, header.m_indexCount, sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    for (uint32_t chunkIndex = 0; chunkIndex < header.m_chunkCount; ++chunkIndex)
+    {
+        CompiledMapChunk const& chunk = GetChunk(static_cast<int>(chunkIndex));
+
+        if (static_cast<uint64_t>(chunk.m_firstVertex) + chunk.m_vertexCount > header.m_vertexCount ||
+            static_cast<uint64_t>(chunk.m_firstIndex) + chunk.m_indexCount > header.m_indexCount)
+        {
+            return false;
+        }
+    }
+
+    CompiledMapSpawnInfo const* spawnInfos = GetSection<CompiledMapSpawnInfo>(header.m_spawnInfosOffset);
+
+    for (uint32_t i = 0; i < header.m_spawnInfoCount; ++i)
+    {
+        if (spawnInfos[i].m_actorName.m_name[sizeof(CompiledMapName) - 1] != '\0' ||
+            spawnInfos[i].m_faction.m_name[sizeof(CompiledMapName) - 1] != '\0')
+        {
+            return false;
+        }
+    }
+
+    uint8_t const  tileDefinitionCount = static_cast<uint8_t>(TileDefinition::s_tileDefinitions.size());
+    uint8_t const* tileDefIndexes      = GetSection<uint8_t>(header.m_tilesOffset);
+
+    for (uint64_t tileIndex = 0; tileIndex < tileCount; ++tileIndex)
+    {
+        if (tileDefIndexes[tileIndex] >= tileDefinitionCount && tileDefIndexes[tileIndex] != Tile::INVALID_DEF_INDEX) return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+CompiledMapHeader const& CompiledMap::GetHeader() const
+{
+    return *reinterpret_cast<CompiledMapHeader const*>(m_data);
+}
@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------------------------------
+// CompiledMap.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Game/Definition/MapDefinition.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct Tile;
+
+//----------------------------------------------------------------------------------------------------
+// Layout of a .dmap file: this header, then each section at the offset the header gives for it.
+// Every section starts on an 8 byte boundary, so once the file is mapped all of them are used in place.
+struct CompiledMapHeader
+{
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint32_t m_vertexSize;                  // sizeof(Vertex_PCUTBN) of the compiler, must match the game's.
+    int32_t  m_chunkSize;                   // MapGeometryBuilder::CHUNK_SIZE of the compiler, must match the game's.
+    int32_t  m_dimensionsX;
+    int32_t  m_dimensionsY;
+    int32_t  m_spriteSheetCellCountX;       // The baked uvs are only right for this sprite sheet layout.
+    int32_t  m_spriteSheetCellCountY;
+    uint32_t m_spawnInfoCount;
+    uint32_t m_chunkCount;
+    uint32_t m_vertexCount;
+    uint32_t m_indexCount;
+    uint64_t m_tileDefinitionHash;          // Tile indexes, solidity and uvs are only right for these tile definitions.
+    uint64_t m_tilesOffset;                 // Tile[m_dimensionsX * m_dimensionsY]
+    uint64_t m_solidTileBitsOffset;         // uint64_t[], laid out as Tile::CreateSolidTileBits
+    uint64_t m_spawnInfosOffset;            // CompiledMapSpawnInfo[m_spawnInfoCount]
+    uint64_t m_chunksOffset;                // CompiledMapChunk[m_chunkCount]
+    uint64_t m_vertexesOffset;              // Vertex_PCUTBN[m_vertexCount]
+    uint64_t m_indexesOffset;               // uint32_t[m_indexCount], relative to their chunk's first vertex
+    uint64_t m_fileSize;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct CompiledMapName
+{
+    char m_name[64];
+};
+
+//----------------------------------------------------------------------------------------------------
+struct CompiledMapSpawnInfo
+{
+    CompiledMapName m_actorName;
+    CompiledMapName m_faction;
+    float           m_position[3];
+    float           m_orientation[3];      // Yaw, pitch, roll in degrees.
+    float           m_velocity[3];
+    float           m_reserved;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Chunks are in MapGeometryBuilder::GetChunkRegion order.
+struct CompiledMapChunk
+{
+    uint32_t m_firstVertex;
+    uint32_t m_vertexCount;
+    uint32_t m_firstIndex;
+    uint32_t m_indexCount;
+};
+
+//----------------------------------------------------------------------------------------------------
+// A baked map: tile definition indexes, the solidity bitset, spawn infos and per-chunk vertex/index streams.
+// Write is what MapCompiler runs offline. Open memory-maps a .dmap and checks it against the running game,
+// after which tiles, solidity and geometry are read straight out of the mapping until Close.
+class CompiledMap
+{
+public:
+    static constexpr uint32_t MAGIC   = 0x50414d44u;   // "DMAP" in file order.
+    static constexpr uint32_t VERSION = 1;
+
+    CompiledMap() = default;
+    ~CompiledMap();
+    CompiledMap(CompiledMap const&)            = delete;
+    CompiledMap& operator=(CompiledMap const&) = delete;
+
+    static bool Write(char const* path, IntVec2 const& dimensions, Tile const* tiles, IntVec2 const& spriteSheetCellCount, std::vector<SpawnInfo> const& spawnInfos);
+
+    bool Open(char const* path, IntVec2 const& spriteSheetCellCount);
+    void Close();
+    bool IsOpen() const;
+
+    IntVec2                       GetDimensions() const;
+    Tile const*                   GetTiles() const;
+    uint64_t const*               GetSolidTileBits() const;
+    std::vector<SpawnInfo> const& GetSpawnInfos() const;
+    int                           GetChunkCount() const;
+    CompiledMapChunk const&       GetChunk(int chunkIndex) const;
+    Vertex_PCUTBN const*          GetVertexes() const;
+    uint32_t const*               GetIndexes() const;
+    size_t                        GetFileSize() const;
+
+private:
+    static uint64_t GetTileDefinitionHash();
+
+    bool                     IsValid(IntVec2 const& spriteSheetCellCount) const;
+    CompiledMapHeader const& GetHeader() const;
+
+    template <typename T>
+    T const* GetSection(uint64_t offset) const { return reinterpret_cast<T const*>(m_data + offset); }
+
+    uint8_t const*         m_data          = nullptr;
+    size_t                 m_size          = 0;
+    void*                  m_fileHandle    = nullptr;      // Platform handles for the mapping, opaque here to keep <windows.h> out of headers.
+    void*                  m_mappingHandle = nullptr;
+    std::vector<SpawnInfo> m_spawnInfos;                   // Decoded on open; everything else stays in the mapping.
+};
@@ -0,0 +1,379 @@
+//----------------------------------------------------------------------------------------------------
+// FlowFieldSystem.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/FlowFieldSystem.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Framework/AIController.hpp"
+#include "Game/Gameplay/Actor.hpp"
+#include "Game/Gameplay/Map.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    IntVec2 const DIRECTION_OFFSETS[FlowFieldSystem::DIRECTION_COUNT] =
+    {
+        IntVec2(1, 0), IntVec2(1, 1), IntVec2(0, 1), IntVec2(-1, 1),
+        IntVec2(-1, 0), IntVec2(-1, -1), IntVec2(0, -1), IntVec2(1, -1)
+    };
+}
+
+//----------------------------------------------------------------------------------------------------
+FlowFieldSystem::~FlowFieldSystem()
+{
+    if (!m_workerThread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_isQuitting = true;
+    }
+
+    m_wakeCondition.notify_all();
+    m_workerThread.join();
+}
+
+//----------------------------------------------------------------------------------------------------
+// The bitset must outlive this system; Map's does, whether it is its own or a compiled map's.
+void FlowFieldSystem::Initialize(IntVec2 const&  dimensions,
+                                 uint64_t const* solidTileBits,
+                                 int const       solidTileBitsWidth)
+{
+    m_dimensions         = dimensions;
+    m_solidTileBits      = solidTileBits;
+    m_solidTileBitsWidth = solidTileBitsWidth;
+
+    if (!m_workerThread.joinable())
+    {
+        m_workerThread = std::thread(&FlowFieldSystem::RunWorker, this);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Asks for a field to every target an AI is chasing, on the main thread before the parallel think phase.
+// An AI that has yet to pick up its perceived enemy as its target asks for that one, so its field is ready a tick sooner.
+void FlowFieldSystem::Update(Map const&                 map,
+                             std::vector<Actor*> const& actors)
+{
+    BeginTick();
+
+    for (Actor const* actor : actors)
+    {
+        if (actor->m_isDead || actor->m_aiController == nullptr || actor->m_controller != actor->m_aiController) continue;
+        if (actor->m_aiController->m_isDormant) continue;
+
+        AIController const* aiController = actor->m_aiController;
+        Actor const*        target       = map.GetActorByHandle(aiController->m_targetActorHandle);
+
+        if (target == nullptr || target->m_isDead)
+        {
+            target = map.GetActorByHandle(aiController->m_perceivedEnemyHandle);
+        }
+
+        if (target == nullptr || target->m_isDead) continue;
+
+        RequestField(target->m_handle, map.GetTileCoordsFromWorldPos(target->GetPosition()));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Publishes the recomputes requested last tick and releases the fields nobody has asked for in a while.
+void FlowFieldSystem::BeginTick()
+{
+    WaitForPendingFields();
+
+    ++m_tick;
+
+    for (Field& field : m_fields)
+    {
+        if (field.m_isPending)
+        {
+            field.m_directions.swap(field.m_nextDirections);
+            field.m_goalTileCoords = field.m_requestedGoalTileCoords;
+            field.m_hasDirections  = true;
+            field.m_isPending      = false;
+            m_computeSeconds += field.m_computeSeconds;
+            ++m_computedFieldCount;
+        }
+
+        if (field.m_target.IsValid() && m_tick - field.m_lastRequestedTick > MAX_UNUSED_TICKS)
+        {
+            field.m_target        = ActorHandle::INVALID;
+            field.m_hasDirections = false;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Keeps the target's field alive and recomputes it when the target has entered another tile since the last one.
+// A target without a field takes a free one, or the least recently requested; when there are none, it goes without.
+void FlowFieldSystem::RequestField(ActorHandle const& target,
+                                   IntVec2 const&     goalTileCoords)
+{
+    if (goalTileCoords.x < 0 || goalTileCoords.y < 0 || goalTileCoords.x >= m_dimensions.x || goalTileCoords.y >= m_dimensions.y) return;
+
+    int fieldIndex = -1;
+
+    for (int i = 0; i < MAX_FIELDS; ++i)
+    {
+        if (m_fields[i].m_target == target)
+        {
+            fieldIndex = i;
+            break;
+        }
+
+        if (m_fields[i].m_isPending || m_fields[i].m_lastRequestedTick == m_tick) continue;
+
+        if (fieldIndex < 0 || !m_fields[i].m_target.IsValid() ||
+            (m_fields[fieldIndex].m_target.IsValid() && m_fields[i].m_lastRequestedTick < m_fields[fieldIndex].m_lastRequestedTick))
+        {
+            fieldIndex = i;
+        }
+    }
+
+    if (fieldIndex < 0) return;
+
+    Field& field = m_fields[fieldIndex];
+
+    if (field.m_target != target)
+    {
+        field.m_target        = target;
+        field.m_hasDirections = false;
+    }
+
+    field.m_lastRequestedTick = m_tick;
+
+    if (field.m_isPending) return;
+    if (field.m_hasDirections && field.m_goalTileCoords == goalTileCoords) return;
+
+    field.m_requestedGoalTileCoords = goalTileCoords;
+    field.m_isPending               = true;
+
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_pendingFieldIndexes.push_back(fieldIndex);
+    }
+
+    m_wakeCondition.notify_one();
+}
+
+//----------------------------------------------------------------------------------------------------
+void FlowFieldSystem::WaitForPendingFields()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_pendingFieldIndexes.empty() && m_busyFieldIndex < 0; });
+}
+
+//----------------------------------------------------------------------------------------------------
+// Safe from the parallel think phase: fields only change in BeginTick and RequestField, on the main thread.
+// False on the goal tile and wherever the field has no way on, where the agent should head straight for the target.
+bool FlowFieldSystem::GetDirection(ActorHandle const& target,
+                                   Vec3 const&        position,
+                                   Vec2&              out_direction) const
+{
+    Field const* field = FindField(target);
+
+    if (field == nullptr || !field->m_hasDirections) return false;
+
+    int const x = RoundDownToInt(position.x);
+    int const y = RoundDownToInt(position.y);
+
+    if (x < 0 || y < 0 || x >= m_dimensions.x || y >= m_dimensions.y) return false;
+
+    uint8_t const direction = field->m_directions[x + y * m_dimensions.x];
+
+    if (direction == NO_DIRECTION) return false;
+
+    out_direction = GetDirectionVector(direction);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+int FlowFieldSystem::GetFieldCount() const
+{
+    int fieldCount = 0;
+
+    for (Field const& field : m_fields)
+    {
+        if (field.m_target.IsValid()) ++fieldCount;
+    }
+
+    return fieldCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int FlowFieldSystem::GetComputedFieldCount() const
+{
+    return m_computedFieldCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Time the thread spent on the fields published so far.
+double FlowFieldSystem::GetComputeMilliseconds() const
+{
+    return m_computeSeconds * 1000.0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Dijkstra from the goal tile over open tiles, 8-connected; each tile points back along the step that settled it.
+// Tiles are expanded in a fixed order, so the same grid and goal always give the same field.
+STATIC void FlowFieldSystem::ComputeField(IntVec2 const&         dimensions,
+                                          uint64_t const*        solidTileBits,
+                                          int const              solidTileBitsWidth,
+                                          IntVec2 const&         goalTileCoords,
+                                          std::vector<uint32_t>& scratchDistances,
+                                          std::vector<uint8_t>&  out_directions)
+{
+    int const tileCount = dimensions.x * dimensions.y;
+
+    scratchDistances.assign(static_cast<size_t>(tileCount), UINT32_MAX);
+    out_directions.assign(static_cast<size_t>(tileCount), NO_DIRECTION);
+
+    // Step costs are small integers, so a ring of buckets indexed by distance replaces a heap (Dial's algorithm).
+    // No step reaches past the ring, so the bucket being drained never gains entries.
+    int constexpr                 BUCKET_COUNT = static_cast<int>(DIAGONAL_STEP_COST) + 1;
+    std::vector<std::vector<int>> buckets(BUCKET_COUNT);
+
+    int const goalIndex         = goalTileCoords.x + goalTileCoords.y * dimensions.x;
+    scratchDistances[goalIndex] = 0;
+    buckets[0].push_back(goalIndex);
+
+    int queuedCount = 1;
+
+    for (uint32_t distance = 0; queuedCount > 0; ++distance)
+    {
+        std::vector<int>& bucket = buckets[distance % BUCKET_COUNT];
+
+        while (!bucket.empty())
+        {
+            int const tileIndex = bucket.back();
+            bucket.pop_back();
+            --queuedCount;
+
+            if (scratchDistances[tileIndex] != distance) continue;
+
+            int const x = tileIndex % dimensions.x;
+            int const y = tileIndex / dimensions.x;
+
+            // Steps are symmetric, so stepping out of a tile costs what stepping into it from there would.
+            for (int direction = 0; direction < DIRECTION_COUNT; ++direction)
+            {
+                if (!CanStep(dimensions, solidTileBits, solidTileBitsWidth, x, y, direction)) continue;
+
+                IntVec2 const  offset            = DIRECTION_OFFSETS[direction];
+                int const      neighbourIndex    = (x + offset.x) + (y + offset.y) * dimensions.x;
+                uint32_t const neighbourDistance = distance + GetStepCost(direction);
+
+                if (neighbourDistance >= scratchDistances[neighbourIndex]) continue;
+
+                scratchDistances[neighbourIndex] = neighbourDistance;
+                out_directions[neighbourIndex]   = static_cast<uint8_t>((direction + DIRECTION_COUNT / 2) % DIRECTION_COUNT);
+                buckets[neighbourDistance % BUCKET_COUNT].push_back(neighbourIndex);
+                ++queuedCount;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same layout as Map::IsTileSolid; the caller keeps the coordinates inside of the map.
+STATIC bool FlowFieldSystem::IsSolid(uint64_t const* solidTileBits,
+                                     int const       solidTileBitsWidth,
+                                     int const       x,
+                                     int const       y)
+{
+    int const bitIndex = (x + 1) + (y + 1) * solidTileBitsWidth;
+
+    return ((solidTileBits[bitIndex >> 6] >> (bitIndex & 63)) & 1) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A diagonal step may not cut the corner of a solid tile, or agents would try to squeeze between two walls.
+STATIC bool FlowFieldSystem::CanStep(IntVec2 const&  dimensions,
+                                     uint64_t const* solidTileBits,
+                                     int const       solidTileBitsWidth,
+                                     int const       x,
+                                     int const       y,
+                                     int const       direction)
+{
+    IntVec2 const offset = DIRECTION_OFFSETS[direction];
+    int const     toX    = x + offset.x;
+    int const     toY    = y + offset.y;
+
+    if (toX < 0 || toY < 0 || toX >= dimensions.x || toY >= dimensions.y) return false;
+    if (IsSolid(solidTileBits, solidTileBitsWidth, toX, toY)) return false;
+    if (offset.x == 0 || offset.y == 0) return true;
+
+    return !IsSolid(solidTileBits, solidTileBitsWidth, toX, y) && !IsSolid(solidTileBits, solidTileBitsWidth, x, toY);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC IntVec2 FlowFieldSystem::GetDirectionOffset(int const direction)
+{
+    return DIRECTION_OFFSETS[direction];
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC uint32_t FlowFieldSystem::GetStepCost(int const direction)
+{
+    return (direction & 1) != 0 ? DIAGONAL_STEP_COST : STRAIGHT_STEP_COST;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC Vec2 FlowFieldSystem::GetDirectionVector(uint8_t const direction)
+{
+    IntVec2 const offset = DIRECTION_OFFSETS[direction];
+
+    return Vec2(static_cast<float>(offset.x), static_cast<float>(offset.y)).GetNormalized();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Each field is computed into its m_nextDirections and m_computeSeconds, which nothing else touches until BeginTick sees it is done.
+void FlowFieldSystem::RunWorker()
+{
+    for (;;)
+    {
+        int fieldIndex;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [this] { return m_isQuitting || !m_pendingFieldIndexes.empty(); });
+
+            if (m_isQuitting) return;
+
+            fieldIndex       = m_pendingFieldIndexes.front();
+            m_busyFieldIndex = fieldIndex;
+            m_pendingFieldIndexes.pop_front();
+        }
+
+        Field&       field        = m_fields[fieldIndex];
+        double const startSeconds = GetCurrentTimeSeconds();
+
+        ComputeField(m_dimensions, m_solidTileBits, m_solidTileBitsWidth, field.m_requestedGoalTileCoords, m_scratchDistances, field.m_nextDirections);
+
+        field.m_computeSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+        {
+            std::lock_guard<std::mutex> const lock(m_mutex);
+            m_busyFieldIndex = -1;
+        }
+
+        m_doneCondition.notify_all();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+FlowFieldSystem::Field const* FlowFieldSystem::FindField(ActorHandle const& target) const
+{
+    if (!target.IsValid()) return nullptr;
+
+    for (Field const& field : m_fields)
+    {
+        if (field.m_target == target) return &field;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,99 @@
+//----------------------------------------------------------------------------------------------------
+// FlowFieldSystem.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Game/Framework/ActorHandle.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+class Map;
+
+//----------------------------------------------------------------------------------------------------
+// Shared pathfinding for AI chasing a target: one Dijkstra field over the tile grid per target actor, from which
+// any number of agents read the direction to their next tile in O(1).
+// A field is recomputed on a background thread whenever its target enters another tile. A recompute requested
+// in one tick is published at the start of the next, waiting for the thread if it has not finished, so agents
+// always read a complete field and the result does not depend on how fast the thread ran.
+class FlowFieldSystem
+{
+public:
+    static constexpr int      MAX_FIELDS         = 8;
+    static constexpr int      MAX_UNUSED_TICKS   = 120;       // A field nobody asked for in this many ticks is released.
+    static constexpr uint8_t  NO_DIRECTION       = 0xff;      // Goal, solid and unreachable tiles.
+    static constexpr int      DIRECTION_COUNT    = 8;         // East, then counterclockwise in 45 degree steps.
+    static constexpr uint32_t STRAIGHT_STEP_COST = 10;
+    static constexpr uint32_t DIAGONAL_STEP_COST = 14;
+
+    FlowFieldSystem() = default;
+    ~FlowFieldSystem();
+    FlowFieldSystem(FlowFieldSystem const&)            = delete;
+    FlowFieldSystem& operator=(FlowFieldSystem const&) = delete;
+
+    void Initialize(IntVec2 const& dimensions, uint64_t const* solidTileBits, int solidTileBitsWidth);
+    void Update(Map const& map, std::vector<Actor*> const& actors);
+    void BeginTick();
+    void RequestField(ActorHandle const& target, IntVec2 const& goalTileCoords);
+    void WaitForPendingFields();
+    bool GetDirection(ActorHandle const& target, Vec3 const& position, Vec2& out_direction) const;
+
+    int    GetFieldCount() const;
+    int    GetComputedFieldCount() const;
+    double GetComputeMilliseconds() const;
+
+    static void     ComputeField(IntVec2 const& dimensions, uint64_t const* solidTileBits, int solidTileBitsWidth, IntVec2 const& goalTileCoords,
+                                 std::vector<uint32_t>& scratchDistances, std::vector<uint8_t>& out_directions);
+    static Vec2     GetDirectionVector(uint8_t direction);
+
+    // Grid steps shared with the other tile searches, so every path follows the same rules.
+    static bool     IsSolid(uint64_t const* solidTileBits, int solidTileBitsWidth, int x, int y);
+    static bool     CanStep(IntVec2 const& dimensions, uint64_t const* solidTileBits, int solidTileBitsWidth, int x, int y, int direction);
+    static IntVec2  GetDirectionOffset(int direction);
+    static uint32_t GetStepCost(int direction);
+
+private:
+    struct Field
+    {
+        ActorHandle          m_target;
+        IntVec2              m_goalTileCoords;              // Of m_directions.
+        IntVec2              m_requestedGoalTileCoords;     // Of the recompute in flight.
+        std::vector<uint8_t> m_directions;                  // Read by agents, one per tile, row major.
+        std::vector<uint8_t> m_nextDirections;              // Written by the background thread while m_isPending.
+        double               m_computeSeconds    = 0.0;     // Of m_nextDirections.
+        int                  m_lastRequestedTick = 0;
+        bool                 m_isPending         = false;
+        bool                 m_hasDirections     = false;
+    };
+
+    void         RunWorker();
+    Field const* FindField(ActorHandle const& target) const;
+
+    IntVec2         m_dimensions;
+    uint64_t const* m_solidTileBits      = nullptr;      // Map's bitset with its padding ring, see Map::IsTileSolid.
+    int             m_solidTileBitsWidth = 0;
+    Field           m_fields[MAX_FIELDS];
+    int             m_tick               = 0;
+    int             m_computedFieldCount = 0;
+    double          m_computeSeconds     = 0.0;          // Total time the thread spent on the fields published so far.
+
+    // Background thread, everything below m_scratchDistances is guarded by m_mutex.
+    std::thread             m_workerThread;
+    std::vector<uint32_t>   m_scratchDistances;           // Only touched by the thread.
+    std::mutex              m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+    std::deque<int>         m_pendingFieldIndexes;
+    int                     m_busyFieldIndex = -1;
+    bool                    m_isQuitting     = false;
+};
@@ -15,6 +15,8 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Game/Gameplay/Actor.hpp"
 #include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Definition/EffectDefinition.hpp"
+#include "Game/Definition/FactionDefinition.hpp"
 #include "Game/Framework/App.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "Game/Gameplay/Map.hpp"
@@ -46,6 +48,13 @@ Game::Game()
 
     m_gameClock = new Clock(Clock::GetSystemClock());
 
+    float const simulationHz     = g_gameConfigBlackboard.GetValue("Game.SimulationHz", 60.f);
+    m_fixedDeltaSeconds          = 1.f / (simulationHz > 0.f ? simulationHz : 60.f);
+    m_maxSimulationTicksPerFrame = g_gameConfigBlackboard.GetValue("Game.MaxSimulationTicksPerFrame", m_maxSimulationTicksPerFrame);
+
+    // There is no debug render system to talk to in headless mode.
+    if (g_theRenderer == nullptr) return;
+
     DebugAddWorldBasis(Mat44(), -1.f);
 
     Mat44 transform;
@@ -73,6 +82,8 @@ Game::~Game()
 
 //----------------------------------------------------------------------------------------------------
 // All timers in the game, such as those required by weapons, should use the game clock.
+// Input and cameras update once per frame; the map is simulated in fixed ticks of m_fixedDeltaSeconds of game time,
+// zero or more per frame, and actors are drawn interpolated between the last two ticks.
 void Game::Update()
 {
     float const gameDeltaSeconds = static_cast<float>(m_gameClock->GetDeltaSeconds());
@@ -91,7 +102,62 @@ void Game::Update()
 
     if (m_currentMap != nullptr)
     {
-        m_currentMap->Update(gameDeltaSeconds);
+        m_currentMap->UpdateFromKeyboard();
+        UpdateSimulation(gameDeltaSeconds);
+    }
+
+    UpdateWorldCameras();
+}
+
+//----------------------------------------------------------------------------------------------------
+// A paused game clock has no delta, so nothing is simulated. After a long hitch at most m_maxSimulationTicksPerFrame
+// ticks run and the rest of the backlog is dropped, rather than falling further behind every frame.
+void Game::UpdateSimulation(float const deltaSeconds)
+{
+    m_simulationAccumulatorSeconds += deltaSeconds;
+
+    int tickCount = 0;
+
+    while (m_simulationAccumulatorSeconds >= m_fixedDeltaSeconds && tickCount < m_maxSimulationTicksPerFrame)
+    {
+        m_currentMap->Update(m_fixedDeltaSeconds);
+        m_simulationAccumulatorSeconds -= m_fixedDeltaSeconds;
+        ++tickCount;
+    }
+
+    if (m_simulationAccumulatorSeconds >= m_fixedDeltaSeconds)
+    {
+        m_simulationAccumulatorSeconds = 0.0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// After the simulation, so the cameras follow this frame's interpolated actors.
+void Game::UpdateWorldCameras() const
+{
+    if (m_currentGameState != eGameState::INGAME) return;
+
+    for (PlayerController* controller : m_localPlayerControllerList)
+    {
+        controller->UpdateWorldCamera();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Headless runs skip the attract mode and lobby and go straight into the map named by "Map.DefaultMap".
+void Game::StartHeadless()
+{
+    ChangeState(eGameState::INGAME);
+    InitializeMaps();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Ticks the simulation only. No input is polled, no player controllers exist and nothing is rendered.
+void Game::UpdateHeadless(float const deltaSeconds) const
+{
+    if (m_currentMap != nullptr)
+    {
+        m_currentMap->Update(deltaSeconds);
     }
 }
 
@@ -660,6 +726,19 @@ bool Game::GetIsSingleMode() const
     return m_localPlayerControllerList.size() == 1;
 }
 
+//----------------------------------------------------------------------------------------------------
+float Game::GetFixedDeltaSeconds() const
+{
+    return m_fixedDeltaSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+// How far the game clock is into the next simulation tick, from 0 to 1.
+float Game::GetSimulationAlpha() const
+{
+    return static_cast<float>(m_simulationAccumulatorSeconds) / m_fixedDeltaSeconds;
+}
+
 //----------------------------------------------------------------------------------------------------
 void Game::ChangeState(eGameState const nextState)
 {
@@ -680,18 +759,28 @@ eGameState Game::GetGameState() const
 //----------------------------------------------------------------------------------------------------
 void Game::InitializeMaps()
 {
-    MapDefinition::InitializeMapDefs("Data/Definitions/MapDefinitions.xml");
+    // Tile definitions come first, compiled maps are checked against them as they open.
     TileDefinition::InitializeTileDefs("Data/Definitions/TileDefinitions.xml");
+    MapDefinition::InitializeMapDefs("Data/Definitions/MapDefinitions.xml");
+    EffectDefinition::InitializeEffectDefs("Data/Definitions/EffectDefinitions.xml");
+    // Factions come before actors, which resolve their faction as they load.
+    FactionDefinition::InitializeFactionDefs("Data/Definitions/FactionDefinitions.xml");
     ActorDefinition::InitializeActorDefs("Data/Definitions/ProjectileActorDefinitions.xml");
     WeaponDefinition::InitializeWeaponDefs("Data/Definitions/WeaponDefinitions.xml");
     ActorDefinition::InitializeActorDefs("Data/Definitions/ActorDefinitions.xml");
 
     m_maps.reserve(1);
 
-    for (int mapIndex = 0; mapIndex < 1; ++mapIndex)
+    String const         defaultMapName = g_gameConfigBlackboard.GetValue("Map.DefaultMap", "TestMap");
+    MapDefinition const* defaultMapDef  = MapDefinition::GetDefByName(defaultMapName);
+
+    if (defaultMapDef == nullptr)
     {
-        m_maps.push_back(new Map(this, *MapDefinition::s_mapDefinitions[mapIndex]));
+        defaultMapDef = MapDefinition::s_mapDefinitions[0];
     }
 
-    m_currentMap = m_maps[0];
+    m_maps.push_back(new Map(this, *defaultMapDef));
+
+    m_currentMap                   = m_maps[0];
+    m_simulationAccumulatorSeconds = 0.0;
 }
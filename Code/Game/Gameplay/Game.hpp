@@ -36,6 +36,10 @@ public:
     void Update();
     void Render() const;
 
+    // Headless
+    void StartHeadless();
+    void UpdateHeadless(float deltaSeconds) const;
+
     eGameState                     GetGameState() const;
     void                           ChangeState(eGameState nextState);
     PlayerController*              CreateLocalPlayer(int id, eDeviceType deviceType);
@@ -43,6 +47,8 @@ public:
     PlayerController*              GetLocalPlayer(int id) const; // Return the PlayerController with specific controller id.
     PlayerController*              GetControllerByDeviceType(eDeviceType deviceType) const; // Return the first found controller that has the specific device type.
     bool                           GetIsSingleMode() const;
+    float                          GetFixedDeltaSeconds() const;
+    float                          GetSimulationAlpha() const;
     Clock*                         m_gameClock = nullptr;
     AABB2                          m_screenSpace;
     AABB2                          m_worldSpace;
@@ -53,6 +59,8 @@ private:
     void UpdateFromKeyBoard();
     void UpdateFromController();
     void UpdatePlayerController(float deltaSeconds) const;
+    void UpdateSimulation(float deltaSeconds);
+    void UpdateWorldCameras() const;
     void UpdateListeners(float deltaSeconds) const;
     void RenderAttractMode() const;
     void RenderLobby() const;
@@ -65,6 +73,11 @@ private:
     eGameState        m_currentGameState = eGameState::ATTRACT;
     std::vector<Map*> m_maps;
 
+    // Simulation
+    float  m_fixedDeltaSeconds            = 1.f / 60.f;     // One simulation tick, 1 / "Game.SimulationHz".
+    int    m_maxSimulationTicksPerFrame   = 8;              // "Game.MaxSimulationTicksPerFrame"; time beyond that is dropped instead of caught up.
+    double m_simulationAccumulatorSeconds = 0.0;            // Game time not simulated yet, less than one tick between frames.
+
     SoundPlaybackID m_mainMenuPlaybackID;
     SoundPlaybackID m_inGamePlaybackID;
 };
@@ -0,0 +1,796 @@
+//----------------------------------------------------------------------------------------------------
+// HierarchicalPathfinder.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/HierarchicalPathfinder.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Gameplay/FlowFieldSystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+HierarchicalPathfinder::HierarchicalPathfinder(float const budgetMilliseconds)
+    : m_budgetMilliseconds(budgetMilliseconds)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+// The bitset must outlive this pathfinder; Map's does, whether it is its own or a compiled map's.
+void HierarchicalPathfinder::Initialize(IntVec2 const&  dimensions,
+                                        uint64_t const* solidTileBits,
+                                        int const       solidTileBitsWidth)
+{
+    m_dimensions         = dimensions;
+    m_solidTileBits      = solidTileBits;
+    m_solidTileBitsWidth = solidTileBitsWidth;
+    m_clusterCounts      = IntVec2((dimensions.x + CLUSTER_SIZE - 1) / CLUSTER_SIZE, (dimensions.y + CLUSTER_SIZE - 1) / CLUSTER_SIZE);
+
+    m_nodes.clear();
+    m_freeNodeIndexes.clear();
+    m_clusterNodeIndexes.assign(static_cast<size_t>(GetClusterCount()), std::vector<int>());
+    m_clusterDistances.resize(static_cast<size_t>(CLUSTER_SIZE * CLUSTER_SIZE));
+    m_requests.clear();
+    m_pendingRequestIDs.clear();
+
+    std::vector<int> clusterIndexes(static_cast<size_t>(GetClusterCount()));
+
+    for (int clusterIndex = 0; clusterIndex < GetClusterCount(); ++clusterIndex)
+    {
+        clusterIndexes[clusterIndex] = clusterIndex;
+    }
+
+    RebuildClusters(clusterIndexes);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Call after the solidity of [tileMins, tileMaxs) changed. Only the clusters holding those tiles are rebuilt,
+// along with the entrances on their borders and the costs inside of the clusters across those borders.
+void HierarchicalPathfinder::OnTilesChanged(IntVec2 const& tileMins,
+                                            IntVec2 const& tileMaxs)
+{
+    int const minX = std::clamp(tileMins.x, 0, m_dimensions.x - 1) / CLUSTER_SIZE;
+    int const minY = std::clamp(tileMins.y, 0, m_dimensions.y - 1) / CLUSTER_SIZE;
+    int const maxX = std::clamp(tileMaxs.x - 1, 0, m_dimensions.x - 1) / CLUSTER_SIZE;
+    int const maxY = std::clamp(tileMaxs.y - 1, 0, m_dimensions.y - 1) / CLUSTER_SIZE;
+
+    std::vector<int> clusterIndexes;
+
+    for (int y = minY; y <= maxY; ++y)
+    {
+        for (int x = minX; x <= maxX; ++x)
+        {
+            clusterIndexes.push_back(x + y * m_clusterCounts.x);
+        }
+    }
+
+    RebuildClusters(clusterIndexes);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Solves a path right away. The waypoints start at startPosition and end at goalPosition, and every straight run
+// between two of them stays WAYPOINT_CLEARANCE away from solid tiles. False when either end is solid or out of
+// the map, or nothing connects them.
+bool HierarchicalPathfinder::FindPath(Vec2 const&        startPosition,
+                                      Vec2 const&        goalPosition,
+                                      std::vector<Vec2>& out_waypoints)
+{
+    out_waypoints.clear();
+
+    IntVec2 const startTileCoords = IntVec2(RoundDownToInt(startPosition.x), RoundDownToInt(startPosition.y));
+    IntVec2 const goalTileCoords  = IntVec2(RoundDownToInt(goalPosition.x), RoundDownToInt(goalPosition.y));
+
+    if (!IsTileOpen(startTileCoords.x, startTileCoords.y) || !IsTileOpen(goalTileCoords.x, goalTileCoords.y)) return false;
+
+    int const            startClusterIndex = GetClusterIndex(startTileCoords);
+    int const            goalClusterIndex  = GetClusterIndex(goalTileCoords);
+    std::vector<IntVec2> tiles;
+    tiles.push_back(startTileCoords);
+
+    // Within one cluster the local search is exact unless the way round leaves the cluster.
+    bool isFound = startClusterIndex == goalClusterIndex && AppendClusterPath(startClusterIndex, startTileCoords, goalTileCoords, tiles);
+
+    if (!isFound)
+    {
+        std::vector<int> nodeIndexes;
+
+        if (!FindAbstractPath(startTileCoords, goalTileCoords, nodeIndexes)) return false;
+
+        IntVec2 fromTileCoords = startTileCoords;
+        int     clusterIndex   = startClusterIndex;
+
+        // Consecutive nodes are either in the same cluster, searched again for the tiles between them,
+        // or partners across a border, one step apart.
+        for (int const nodeIndex : nodeIndexes)
+        {
+            Node const& node = m_nodes[nodeIndex];
+
+            if (node.m_clusterIndex == clusterIndex)
+            {
+                if (!AppendClusterPath(clusterIndex, fromTileCoords, node.m_tileCoords, tiles)) return false;
+            }
+            else
+            {
+                tiles.push_back(node.m_tileCoords);
+            }
+
+            fromTileCoords = node.m_tileCoords;
+            clusterIndex   = node.m_clusterIndex;
+        }
+
+        if (!AppendClusterPath(goalClusterIndex, fromTileCoords, goalTileCoords, tiles)) return false;
+    }
+
+    PullString(startPosition, goalPosition, tiles, out_waypoints);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Queues a path for Update; poll GetPathResult with the returned id until it stops being PENDING.
+int HierarchicalPathfinder::RequestPath(Vec2 const& startPosition,
+                                        Vec2 const& goalPosition)
+{
+    int const    requestID = m_nextRequestID++;
+    PathRequest& request   = m_requests[requestID];
+
+    request.m_startPosition = startPosition;
+    request.m_goalPosition  = goalPosition;
+
+    m_pendingRequestIDs.push_back(requestID);
+
+    return requestID;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A finished request hands over its waypoints and is forgotten, so each result is read once.
+// Unknown and cancelled ids read as NOT_FOUND.
+PathStatus HierarchicalPathfinder::GetPathResult(int const          requestID,
+                                                 std::vector<Vec2>& out_waypoints)
+{
+    std::unordered_map<int, PathRequest>::iterator const it = m_requests.find(requestID);
+
+    if (it == m_requests.end()) return PathStatus::NOT_FOUND;
+
+    PathStatus const status = it->second.m_status;
+
+    if (status == PathStatus::PENDING) return status;
+
+    out_waypoints.swap(it->second.m_waypoints);
+    m_requests.erase(it);
+
+    return status;
+}
+
+//----------------------------------------------------------------------------------------------------
+void HierarchicalPathfinder::CancelPath(int const requestID)
+{
+    m_requests.erase(requestID);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Solves queued requests, oldest first, until the budget is spent. A path is never split across calls,
+// so one is always solved even when it alone takes longer than the budget.
+void HierarchicalPathfinder::Update()
+{
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    m_lastUpdateSolvedCount = 0;
+
+    while (!m_pendingRequestIDs.empty())
+    {
+        if (m_lastUpdateSolvedCount > 0 && (GetCurrentTimeSeconds() - startSeconds) * 1000.0 >= m_budgetMilliseconds) break;
+
+        int const requestID = m_pendingRequestIDs.front();
+        m_pendingRequestIDs.pop_front();
+
+        std::unordered_map<int, PathRequest>::iterator const it = m_requests.find(requestID);
+
+        if (it == m_requests.end()) continue;
+
+        PathRequest& request = it->second;
+        request.m_status     = FindPath(request.m_startPosition, request.m_goalPosition, request.m_waypoints) ? PathStatus::FOUND : PathStatus::NOT_FOUND;
+        ++m_lastUpdateSolvedCount;
+    }
+
+    m_lastUpdateMilliseconds = static_cast<float>((GetCurrentTimeSeconds() - startSeconds) * 1000.0);
+}
+
+//----------------------------------------------------------------------------------------------------
+void HierarchicalPathfinder::SetBudgetMilliseconds(float const budgetMilliseconds)
+{
+    m_budgetMilliseconds = budgetMilliseconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Includes cancelled requests still in the queue.
+int HierarchicalPathfinder::GetPendingPathCount() const
+{
+    return static_cast<int>(m_pendingRequestIDs.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int HierarchicalPathfinder::GetNodeCount() const
+{
+    return static_cast<int>(m_nodes.size() - m_freeNodeIndexes.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int HierarchicalPathfinder::GetClusterCount() const
+{
+    return m_clusterCounts.x * m_clusterCounts.y;
+}
+
+//----------------------------------------------------------------------------------------------------
+int HierarchicalPathfinder::GetLastUpdateSolvedCount() const
+{
+    return m_lastUpdateSolvedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+float HierarchicalPathfinder::GetLastUpdateMilliseconds() const
+{
+    return m_lastUpdateMilliseconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Every border of a rebuilt cluster loses its entrances on both sides and gets new ones, so the clusters across
+// those borders need their inside costs searched again too; their other borders are left alone.
+void HierarchicalPathfinder::RebuildClusters(std::vector<int> const& clusterIndexes)
+{
+    std::vector<int> borderIndexes;
+    std::vector<int> connectedClusterIndexes;
+
+    for (int const clusterIndex : clusterIndexes)
+    {
+        int const clusterX = clusterIndex % m_clusterCounts.x;
+        int const clusterY = clusterIndex / m_clusterCounts.x;
+
+        borderIndexes.push_back(clusterIndex * 2);
+        borderIndexes.push_back(clusterIndex * 2 + 1);
+        connectedClusterIndexes.push_back(clusterIndex);
+
+        if (clusterX > 0)
+        {
+            borderIndexes.push_back((clusterIndex - 1) * 2);
+            connectedClusterIndexes.push_back(clusterIndex - 1);
+        }
+
+        if (clusterY > 0)
+        {
+            borderIndexes.push_back((clusterIndex - m_clusterCounts.x) * 2 + 1);
+            connectedClusterIndexes.push_back(clusterIndex - m_clusterCounts.x);
+        }
+
+        if (clusterX + 1 < m_clusterCounts.x) connectedClusterIndexes.push_back(clusterIndex + 1);
+        if (clusterY + 1 < m_clusterCounts.y) connectedClusterIndexes.push_back(clusterIndex + m_clusterCounts.x);
+    }
+
+    std::sort(borderIndexes.begin(), borderIndexes.end());
+    borderIndexes.erase(std::unique(borderIndexes.begin(), borderIndexes.end()), borderIndexes.end());
+    std::sort(connectedClusterIndexes.begin(), connectedClusterIndexes.end());
+    connectedClusterIndexes.erase(std::unique(connectedClusterIndexes.begin(), connectedClusterIndexes.end()), connectedClusterIndexes.end());
+
+    // Both sides of a border are in connectedClusterIndexes, so this finds every entrance on the rebuilt borders.
+    for (int const clusterIndex : connectedClusterIndexes)
+    {
+        std::vector<int> const nodeIndexes = m_clusterNodeIndexes[clusterIndex];
+
+        for (int const nodeIndex : nodeIndexes)
+        {
+            if (std::binary_search(borderIndexes.begin(), borderIndexes.end(), m_nodes[nodeIndex].m_borderIndex))
+            {
+                RemoveNode(nodeIndex);
+            }
+        }
+    }
+
+    for (int const borderIndex : borderIndexes)
+    {
+        CreateEntrances(borderIndex);
+    }
+
+    for (int const clusterIndex : connectedClusterIndexes)
+    {
+        ConnectClusterNodes(clusterIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// An entrance is a run of tiles along the border that are open on both sides. A narrow one gets a node pair
+// in its middle; a wide one gets a pair at each end, so paths along a wide opening do not detour to its middle.
+void HierarchicalPathfinder::CreateEntrances(int const borderIndex)
+{
+    int const  clusterIndex = borderIndex / 2;
+    bool const isNorth      = (borderIndex & 1) != 0;
+    int const  clusterX     = clusterIndex % m_clusterCounts.x;
+    int const  clusterY     = clusterIndex / m_clusterCounts.x;
+
+    if (isNorth ? clusterY + 1 >= m_clusterCounts.y : clusterX + 1 >= m_clusterCounts.x) return;
+
+    int const     otherClusterIndex = isNorth ? clusterIndex + m_clusterCounts.x : clusterIndex + 1;
+    IntVec2 const along             = isNorth ? IntVec2(1, 0) : IntVec2(0, 1);
+    IntVec2 const across            = isNorth ? IntVec2(0, 1) : IntVec2(1, 0);
+    IntVec2 const first             = isNorth ? IntVec2(clusterX * CLUSTER_SIZE, (clusterY + 1) * CLUSTER_SIZE - 1)
+                                              : IntVec2((clusterX + 1) * CLUSTER_SIZE - 1, clusterY * CLUSTER_SIZE);
+    int const     length            = std::min(CLUSTER_SIZE, isNorth ? m_dimensions.x - first.x : m_dimensions.y - first.y);
+    int           runStart          = -1;
+
+    for (int i = 0; i <= length; ++i)
+    {
+        IntVec2 const tileCoords = first + along * i;
+        bool const    isOpen     = i < length &&
+                                   IsTileOpen(tileCoords.x, tileCoords.y) &&
+                                   IsTileOpen(tileCoords.x + across.x, tileCoords.y + across.y);
+
+        if (isOpen)
+        {
+            if (runStart < 0) runStart = i;
+            continue;
+        }
+
+        if (runStart < 0) continue;
+
+        int const runLength     = i - runStart;
+        int const entranceCount = runLength < MAX_ENTRANCE_WIDTH ? 1 : 2;
+        int const offsets[2]    = { entranceCount == 1 ? runStart + runLength / 2 : runStart, i - 1 };
+
+        for (int entranceIndex = 0; entranceIndex < entranceCount; ++entranceIndex)
+        {
+            IntVec2 const inside         = first + along * offsets[entranceIndex];
+            int const     nodeIndex      = CreateNode(inside, clusterIndex, borderIndex);
+            int const     otherNodeIndex = CreateNode(inside + across, otherClusterIndex, borderIndex);
+
+            m_nodes[nodeIndex].m_partnerNodeIndex      = otherNodeIndex;
+            m_nodes[otherNodeIndex].m_partnerNodeIndex = nodeIndex;
+        }
+
+        runStart = -1;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Costs are symmetric, so one search from each entrance covers its edges to every later one.
+void HierarchicalPathfinder::ConnectClusterNodes(int const clusterIndex)
+{
+    std::vector<int> const& nodeIndexes = m_clusterNodeIndexes[clusterIndex];
+
+    for (int const nodeIndex : nodeIndexes)
+    {
+        m_nodes[nodeIndex].m_edges.clear();
+    }
+
+    IntVec2 tileMins;
+    IntVec2 tileMaxs;
+    GetClusterBounds(clusterIndex, tileMins, tileMaxs);
+
+    for (size_t i = 0; i + 1 < nodeIndexes.size(); ++i)
+    {
+        SearchCluster(clusterIndex, m_nodes[nodeIndexes[i]].m_tileCoords);
+
+        for (size_t j = i + 1; j < nodeIndexes.size(); ++j)
+        {
+            IntVec2 const  tileCoords = m_nodes[nodeIndexes[j]].m_tileCoords;
+            uint32_t const cost       = m_clusterDistances[(tileCoords.x - tileMins.x) + (tileCoords.y - tileMins.y) * CLUSTER_SIZE];
+
+            if (cost == UINT32_MAX) continue;
+
+            m_nodes[nodeIndexes[i]].m_edges.push_back(Edge{ nodeIndexes[j], cost });
+            m_nodes[nodeIndexes[j]].m_edges.push_back(Edge{ nodeIndexes[i], cost });
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int HierarchicalPathfinder::CreateNode(IntVec2 const& tileCoords,
+                                       int const      clusterIndex,
+                                       int const      borderIndex)
+{
+    int nodeIndex;
+
+    if (m_freeNodeIndexes.empty())
+    {
+        nodeIndex = static_cast<int>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+    else
+    {
+        nodeIndex = m_freeNodeIndexes.back();
+        m_freeNodeIndexes.pop_back();
+    }
+
+    Node& node              = m_nodes[nodeIndex];
+    node.m_tileCoords       = tileCoords;
+    node.m_clusterIndex     = clusterIndex;
+    node.m_borderIndex      = borderIndex;
+    node.m_partnerNodeIndex = -1;
+    node.m_isActive         = true;
+    node.m_edges.clear();
+
+    m_clusterNodeIndexes[clusterIndex].push_back(nodeIndex);
+
+    return nodeIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Edges to the node are not touched; RebuildClusters reconnects every cluster that could have one.
+void HierarchicalPathfinder::RemoveNode(int const nodeIndex)
+{
+    Node&             node        = m_nodes[nodeIndex];
+    std::vector<int>& nodeIndexes = m_clusterNodeIndexes[node.m_clusterIndex];
+
+    nodeIndexes.erase(std::find(nodeIndexes.begin(), nodeIndexes.end(), nodeIndex));
+    node.m_edges.clear();
+    node.m_isActive = false;
+    m_freeNodeIndexes.push_back(nodeIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool HierarchicalPathfinder::IsTileOpen(int const x,
+                                        int const y) const
+{
+    if (x < 0 || y < 0 || x >= m_dimensions.x || y >= m_dimensions.y) return false;
+
+    return !FlowFieldSystem::IsSolid(m_solidTileBits, m_solidTileBitsWidth, x, y);
+}
+
+//----------------------------------------------------------------------------------------------------
+int HierarchicalPathfinder::GetClusterIndex(IntVec2 const& tileCoords) const
+{
+    return tileCoords.x / CLUSTER_SIZE + tileCoords.y / CLUSTER_SIZE * m_clusterCounts.x;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Mins are inclusive and maxs exclusive; clusters along the far edges are cut off by the map.
+void HierarchicalPathfinder::GetClusterBounds(int const clusterIndex,
+                                              IntVec2&  out_tileMins,
+                                              IntVec2&  out_tileMaxs) const
+{
+    out_tileMins = IntVec2(clusterIndex % m_clusterCounts.x * CLUSTER_SIZE, clusterIndex / m_clusterCounts.x * CLUSTER_SIZE);
+    out_tileMaxs = IntVec2(std::min(out_tileMins.x + CLUSTER_SIZE, m_dimensions.x), std::min(out_tileMins.y + CLUSTER_SIZE, m_dimensions.y));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Dijkstra from startTileCoords without leaving the cluster, into m_clusterDistances.
+void HierarchicalPathfinder::SearchCluster(int const      clusterIndex,
+                                           IntVec2 const& startTileCoords)
+{
+    IntVec2 tileMins;
+    IntVec2 tileMaxs;
+    GetClusterBounds(clusterIndex, tileMins, tileMaxs);
+
+    std::fill(m_clusterDistances.begin(), m_clusterDistances.end(), UINT32_MAX);
+    m_openList.clear();
+
+    int const startIndex          = (startTileCoords.x - tileMins.x) + (startTileCoords.y - tileMins.y) * CLUSTER_SIZE;
+    m_clusterDistances[startIndex] = 0;
+    m_openList.push_back(static_cast<uint64_t>(startIndex));
+
+    while (!m_openList.empty())
+    {
+        std::pop_heap(m_openList.begin(), m_openList.end(), std::greater<uint64_t>());
+        uint64_t const entry = m_openList.back();
+        m_openList.pop_back();
+
+        uint32_t const distance  = static_cast<uint32_t>(entry >> 32);
+        int const      tileIndex = static_cast<int>(entry & 0xffffffffu);
+
+        if (distance > m_clusterDistances[tileIndex]) continue;
+
+        int const x = tileMins.x + tileIndex % CLUSTER_SIZE;
+        int const y = tileMins.y + tileIndex / CLUSTER_SIZE;
+
+        for (int direction = 0; direction < FlowFieldSystem::DIRECTION_COUNT; ++direction)
+        {
+            IntVec2 const offset = FlowFieldSystem::GetDirectionOffset(direction);
+            int const     toX    = x + offset.x;
+            int const     toY    = y + offset.y;
+
+            if (toX < tileMins.x || toY < tileMins.y || toX >= tileMaxs.x || toY >= tileMaxs.y) continue;
+            if (!FlowFieldSystem::CanStep(m_dimensions, m_solidTileBits, m_solidTileBitsWidth, x, y, direction)) continue;
+
+            int const      neighbourIndex    = (toX - tileMins.x) + (toY - tileMins.y) * CLUSTER_SIZE;
+            uint32_t const neighbourDistance = distance + FlowFieldSystem::GetStepCost(direction);
+
+            if (neighbourDistance >= m_clusterDistances[neighbourIndex]) continue;
+
+            m_clusterDistances[neighbourIndex] = neighbourDistance;
+            m_openList.push_back((static_cast<uint64_t>(neighbourDistance) << 32) | static_cast<uint32_t>(neighbourIndex));
+            std::push_heap(m_openList.begin(), m_openList.end(), std::greater<uint64_t>());
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Appends the tiles after fromTileCoords up to and including toTileCoords, both inside of the cluster,
+// by walking the search's distances back down from toTileCoords.
+bool HierarchicalPathfinder::AppendClusterPath(int const             clusterIndex,
+                                               IntVec2 const&        fromTileCoords,
+                                               IntVec2 const&        toTileCoords,
+                                               std::vector<IntVec2>& out_tiles)
+{
+    IntVec2 tileMins;
+    IntVec2 tileMaxs;
+    GetClusterBounds(clusterIndex, tileMins, tileMaxs);
+    SearchCluster(clusterIndex, fromTileCoords);
+
+    auto const GetDistance = [this, &tileMins](IntVec2 const& tileCoords)
+    {
+        return m_clusterDistances[(tileCoords.x - tileMins.x) + (tileCoords.y - tileMins.y) * CLUSTER_SIZE];
+    };
+
+    if (GetDistance(toTileCoords) == UINT32_MAX) return false;
+
+    size_t const firstIndex = out_tiles.size();
+    IntVec2      tileCoords = toTileCoords;
+
+    while (tileCoords != fromTileCoords)
+    {
+        out_tiles.push_back(tileCoords);
+
+        IntVec2  bestTileCoords = tileCoords;
+        uint32_t bestDistance   = GetDistance(tileCoords);
+
+        for (int direction = 0; direction < FlowFieldSystem::DIRECTION_COUNT; ++direction)
+        {
+            IntVec2 const neighbourTileCoords = tileCoords + FlowFieldSystem::GetDirectionOffset(direction);
+
+            if (neighbourTileCoords.x < tileMins.x || neighbourTileCoords.y < tileMins.y || neighbourTileCoords.x >= tileMaxs.x || neighbourTileCoords.y >= tileMaxs.y) continue;
+            if (!FlowFieldSystem::CanStep(m_dimensions, m_solidTileBits, m_solidTileBitsWidth, tileCoords.x, tileCoords.y, direction)) continue;
+
+            uint32_t const neighbourDistance = GetDistance(neighbourTileCoords);
+
+            if (neighbourDistance < bestDistance)
+            {
+                bestDistance   = neighbourDistance;
+                bestTileCoords = neighbourTileCoords;
+            }
+        }
+
+        tileCoords = bestTileCoords;
+    }
+
+    std::reverse(out_tiles.begin() + static_cast<std::ptrdiff_t>(firstIndex), out_tiles.end());
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A* over the entrance graph. The start connects to the entrances of its cluster and the goal to those of its,
+// at their costs inside of those clusters; the best way to the goal is settled once nothing open can beat it.
+bool HierarchicalPathfinder::FindAbstractPath(IntVec2 const&    startTileCoords,
+                                              IntVec2 const&    goalTileCoords,
+                                              std::vector<int>& out_nodeIndexes)
+{
+    size_t const nodeCount = m_nodes.size();
+
+    if (m_nodeSearchIDs.size() < nodeCount)
+    {
+        m_nodeCosts.resize(nodeCount);
+        m_nodeParents.resize(nodeCount);
+        m_nodeGoalCosts.resize(nodeCount);
+        m_nodeSearchIDs.resize(nodeCount, 0);
+    }
+
+    ++m_searchID;
+
+    auto const Touch = [this](int const nodeIndex)
+    {
+        if (m_nodeSearchIDs[nodeIndex] == m_searchID) return;
+
+        m_nodeSearchIDs[nodeIndex] = m_searchID;
+        m_nodeCosts[nodeIndex]     = UINT32_MAX;
+        m_nodeParents[nodeIndex]   = -1;
+        m_nodeGoalCosts[nodeIndex] = UINT32_MAX;
+    };
+
+    int const goalClusterIndex  = GetClusterIndex(goalTileCoords);
+    int const startClusterIndex = GetClusterIndex(startTileCoords);
+
+    IntVec2 tileMins;
+    IntVec2 tileMaxs;
+    GetClusterBounds(goalClusterIndex, tileMins, tileMaxs);
+    SearchCluster(goalClusterIndex, goalTileCoords);
+
+    for (int const nodeIndex : m_clusterNodeIndexes[goalClusterIndex])
+    {
+        IntVec2 const tileCoords = m_nodes[nodeIndex].m_tileCoords;
+        Touch(nodeIndex);
+        m_nodeGoalCosts[nodeIndex] = m_clusterDistances[(tileCoords.x - tileMins.x) + (tileCoords.y - tileMins.y) * CLUSTER_SIZE];
+    }
+
+    GetClusterBounds(startClusterIndex, tileMins, tileMaxs);
+    SearchCluster(startClusterIndex, startTileCoords);
+    m_openList.clear();
+
+    for (int const nodeIndex : m_clusterNodeIndexes[startClusterIndex])
+    {
+        IntVec2 const  tileCoords = m_nodes[nodeIndex].m_tileCoords;
+        uint32_t const cost       = m_clusterDistances[(tileCoords.x - tileMins.x) + (tileCoords.y - tileMins.y) * CLUSTER_SIZE];
+
+        if (cost == UINT32_MAX) continue;
+
+        Touch(nodeIndex);
+        m_nodeCosts[nodeIndex] = cost;
+        m_openList.push_back((static_cast<uint64_t>(cost + GetOctileDistance(tileCoords, goalTileCoords)) << 32) | static_cast<uint32_t>(nodeIndex));
+    }
+
+    std::make_heap(m_openList.begin(), m_openList.end(), std::greater<uint64_t>());
+
+    uint32_t bestTotalCost = UINT32_MAX;
+    int      bestNodeIndex = -1;
+
+    while (!m_openList.empty())
+    {
+        std::pop_heap(m_openList.begin(), m_openList.end(), std::greater<uint64_t>());
+        uint64_t const entry = m_openList.back();
+        m_openList.pop_back();
+
+        uint32_t const estimate  = static_cast<uint32_t>(entry >> 32);
+        int const      nodeIndex = static_cast<int>(entry & 0xffffffffu);
+        Node const&    node      = m_nodes[nodeIndex];
+
+        if (estimate >= bestTotalCost) break;
+        if (estimate - GetOctileDistance(node.m_tileCoords, goalTileCoords) > m_nodeCosts[nodeIndex]) continue;
+
+        uint32_t const cost = m_nodeCosts[nodeIndex];
+
+        if (m_nodeGoalCosts[nodeIndex] != UINT32_MAX && cost + m_nodeGoalCosts[nodeIndex] < bestTotalCost)
+        {
+            bestTotalCost = cost + m_nodeGoalCosts[nodeIndex];
+            bestNodeIndex = nodeIndex;
+        }
+
+        auto const Relax = [&](int const toNodeIndex, uint32_t const edgeCost)
+        {
+            Touch(toNodeIndex);
+
+            uint32_t const toCost = cost + edgeCost;
+
+            if (toCost >= m_nodeCosts[toNodeIndex]) return;
+
+            m_nodeCosts[toNodeIndex]   = toCost;
+            m_nodeParents[toNodeIndex] = nodeIndex;
+            m_openList.push_back((static_cast<uint64_t>(toCost + GetOctileDistance(m_nodes[toNodeIndex].m_tileCoords, goalTileCoords)) << 32) | static_cast<uint32_t>(toNodeIndex));
+            std::push_heap(m_openList.begin(), m_openList.end(), std::greater<uint64_t>());
+        };
+
+        for (Edge const& edge : node.m_edges)
+        {
+            Relax(edge.m_toNodeIndex, edge.m_cost);
+        }
+
+        if (node.m_partnerNodeIndex >= 0)
+        {
+            Relax(node.m_partnerNodeIndex, FlowFieldSystem::STRAIGHT_STEP_COST);
+        }
+    }
+
+    if (bestNodeIndex < 0) return false;
+
+    out_nodeIndexes.clear();
+
+    for (int nodeIndex = bestNodeIndex; nodeIndex >= 0; nodeIndex = m_nodeParents[nodeIndex])
+    {
+        out_nodeIndexes.push_back(nodeIndex);
+    }
+
+    std::reverse(out_nodeIndexes.begin(), out_nodeIndexes.end());
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The centre line and both edges of a WAYPOINT_CLEARANCE wide corridor must cross only open tiles.
+bool HierarchicalPathfinder::IsWalkable(Vec2 const& start,
+                                        Vec2 const& end) const
+{
+    Vec2 const direction = end - start;
+
+    if (direction.GetLengthSquared() <= 0.f) return true;
+
+    Vec2 const side = direction.GetNormalized().GetRotated90Degrees() * WAYPOINT_CLEARANCE;
+
+    return IsSegmentOpen(start, end) && IsSegmentOpen(start + side, end + side) && IsSegmentOpen(start - side, end - side);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walks the tiles the segment crosses in order. Passing exactly through a corner needs both tiles beside it open.
+bool HierarchicalPathfinder::IsSegmentOpen(Vec2 const& start,
+                                           Vec2 const& end) const
+{
+    int       x    = RoundDownToInt(start.x);
+    int       y    = RoundDownToInt(start.y);
+    int const endX = RoundDownToInt(end.x);
+    int const endY = RoundDownToInt(end.y);
+
+    if (!IsTileOpen(x, y)) return false;
+
+    Vec2 const  direction = end - start;
+    int const   stepX     = direction.x > 0.f ? 1 : -1;
+    int const   stepY     = direction.y > 0.f ? 1 : -1;
+    float const deltaX    = direction.x != 0.f ? fabsf(1.f / direction.x) : FLT_MAX;
+    float const deltaY    = direction.y != 0.f ? fabsf(1.f / direction.y) : FLT_MAX;
+    float       nextX     = direction.x > 0.f ? (static_cast<float>(x + 1) - start.x) * deltaX : (start.x - static_cast<float>(x)) * deltaX;
+    float       nextY     = direction.y > 0.f ? (static_cast<float>(y + 1) - start.y) * deltaY : (start.y - static_cast<float>(y)) * deltaY;
+    int         stepCount = abs(endX - x) + abs(endY - y);
+
+    while ((x != endX || y != endY) && stepCount-- > 0)
+    {
+        if (nextX < nextY)
+        {
+            x += stepX;
+            nextX += deltaX;
+        }
+        else if (nextY < nextX)
+        {
+            y += stepY;
+            nextY += deltaY;
+        }
+        else
+        {
+            if (!IsTileOpen(x + stepX, y) || !IsTileOpen(x, y + stepY)) return false;
+
+            x += stepX;
+            y += stepY;
+            nextX += deltaX;
+            nextY += deltaY;
+        }
+
+        if (!IsTileOpen(x, y)) return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Greedy string pulling: from each waypoint, keep the farthest tile centre along the path that can still be
+// walked to in a straight line, and make the one before the first that cannot the next waypoint.
+void HierarchicalPathfinder::PullString(Vec2 const&                 startPosition,
+                                        Vec2 const&                 goalPosition,
+                                        std::vector<IntVec2> const& tiles,
+                                        std::vector<Vec2>&          out_waypoints) const
+{
+    std::vector<Vec2> points;
+    points.reserve(tiles.size() + 1);
+    points.push_back(startPosition);
+
+    for (size_t tileIndex = 1; tileIndex + 1 < tiles.size(); ++tileIndex)
+    {
+        points.emplace_back(static_cast<float>(tiles[tileIndex].x) + 0.5f, static_cast<float>(tiles[tileIndex].y) + 0.5f);
+    }
+
+    points.push_back(goalPosition);
+
+    out_waypoints.clear();
+    out_waypoints.push_back(startPosition);
+
+    Vec2 anchor = startPosition;
+
+    for (size_t pointIndex = 1; pointIndex + 1 < points.size(); ++pointIndex)
+    {
+        if (IsWalkable(anchor, points[pointIndex + 1])) continue;
+
+        anchor = points[pointIndex];
+        out_waypoints.push_back(anchor);
+    }
+
+    out_waypoints.push_back(goalPosition);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Exact cost between two tiles on open ground, so never more than a real path and a consistent A* heuristic.
+STATIC uint32_t HierarchicalPathfinder::GetOctileDistance(IntVec2 const& a,
+                                                          IntVec2 const& b)
+{
+    uint32_t const deltaX = static_cast<uint32_t>(abs(a.x - b.x));
+    uint32_t const deltaY = static_cast<uint32_t>(abs(a.y - b.y));
+
+    return FlowFieldSystem::STRAIGHT_STEP_COST * std::max(deltaX, deltaY) + (FlowFieldSystem::DIAGONAL_STEP_COST - FlowFieldSystem::STRAIGHT_STEP_COST) * std::min(deltaX, deltaY);
+}
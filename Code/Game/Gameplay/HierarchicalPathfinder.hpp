@@ -0,0 +1,127 @@
+//----------------------------------------------------------------------------------------------------
+// HierarchicalPathfinder.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+enum class PathStatus : uint8_t
+{
+    PENDING,
+    FOUND,
+    NOT_FOUND
+};
+
+//----------------------------------------------------------------------------------------------------
+// Point to point paths over the tile grid for long-range goals, using HPA*: the map is cut into square clusters,
+// each opening between two clusters gets an entrance node on both sides, and the costs between a cluster's
+// entrances are searched once up front. A path is an A* over that graph, refined into tiles one cluster at a
+// time and then string-pulled into the fewest waypoints an agent can walk in straight lines.
+// Requests queue up and Update solves them until its time budget is spent, so a burst of requests spreads over
+// frames instead of stalling one. When tiles change, OnTilesChanged rebuilds only the clusters around them.
+// Steps follow FlowFieldSystem's rules, so both agree on where an agent can go.
+class HierarchicalPathfinder
+{
+public:
+    static constexpr int   CLUSTER_SIZE       = 16;
+    static constexpr int   MAX_ENTRANCE_WIDTH = 6;          // Wider openings get an entrance at both ends instead of one in the middle.
+    static constexpr float WAYPOINT_CLEARANCE = 0.3f;       // How far a straight run between waypoints must stay from walls.
+
+    explicit HierarchicalPathfinder(float budgetMilliseconds);
+
+    void Initialize(IntVec2 const& dimensions, uint64_t const* solidTileBits, int solidTileBitsWidth);
+    void OnTilesChanged(IntVec2 const& tileMins, IntVec2 const& tileMaxs);
+
+    bool FindPath(Vec2 const& startPosition, Vec2 const& goalPosition, std::vector<Vec2>& out_waypoints);
+
+    int        RequestPath(Vec2 const& startPosition, Vec2 const& goalPosition);
+    PathStatus GetPathResult(int requestID, std::vector<Vec2>& out_waypoints);
+    void       CancelPath(int requestID);
+    void       Update();
+
+    void  SetBudgetMilliseconds(float budgetMilliseconds);
+    int   GetPendingPathCount() const;
+    int   GetNodeCount() const;
+    int   GetClusterCount() const;
+    int   GetLastUpdateSolvedCount() const;
+    float GetLastUpdateMilliseconds() const;
+
+private:
+    struct Edge
+    {
+        int      m_toNodeIndex = -1;
+        uint32_t m_cost        = 0;
+    };
+
+    struct Node
+    {
+        IntVec2           m_tileCoords;
+        int               m_clusterIndex     = -1;
+        int               m_borderIndex      = -1;     // Cluster index * 2, plus 1 for its north border instead of its east one.
+        int               m_partnerNodeIndex = -1;     // Entrance node on the other side of the border, one straight step away.
+        std::vector<Edge> m_edges;                     // To the other entrances of the same cluster.
+        bool              m_isActive         = false;
+    };
+
+    struct PathRequest
+    {
+        Vec2              m_startPosition;
+        Vec2              m_goalPosition;
+        PathStatus        m_status = PathStatus::PENDING;
+        std::vector<Vec2> m_waypoints;
+    };
+
+    void RebuildClusters(std::vector<int> const& clusterIndexes);
+    void CreateEntrances(int borderIndex);
+    void ConnectClusterNodes(int clusterIndex);
+    int  CreateNode(IntVec2 const& tileCoords, int clusterIndex, int borderIndex);
+    void RemoveNode(int nodeIndex);
+
+    bool IsTileOpen(int x, int y) const;
+    int  GetClusterIndex(IntVec2 const& tileCoords) const;
+    void GetClusterBounds(int clusterIndex, IntVec2& out_tileMins, IntVec2& out_tileMaxs) const;
+    void SearchCluster(int clusterIndex, IntVec2 const& startTileCoords);
+    bool AppendClusterPath(int clusterIndex, IntVec2 const& fromTileCoords, IntVec2 const& toTileCoords, std::vector<IntVec2>& out_tiles);
+    bool FindAbstractPath(IntVec2 const& startTileCoords, IntVec2 const& goalTileCoords, std::vector<int>& out_nodeIndexes);
+    bool IsWalkable(Vec2 const& start, Vec2 const& end) const;
+    bool IsSegmentOpen(Vec2 const& start, Vec2 const& end) const;
+    void PullString(Vec2 const& startPosition, Vec2 const& goalPosition, std::vector<IntVec2> const& tiles, std::vector<Vec2>& out_waypoints) const;
+
+    static uint32_t GetOctileDistance(IntVec2 const& a, IntVec2 const& b);
+
+    // Grid
+    IntVec2         m_dimensions;
+    uint64_t const* m_solidTileBits      = nullptr;     // Map's bitset with its padding ring, see Map::IsTileSolid.
+    int             m_solidTileBitsWidth = 0;
+    IntVec2         m_clusterCounts;
+
+    // Abstract graph
+    std::vector<Node>             m_nodes;
+    std::vector<int>              m_freeNodeIndexes;
+    std::vector<std::vector<int>> m_clusterNodeIndexes;     // Active nodes of each cluster.
+
+    // Search scratch, reused by every search
+    std::vector<uint32_t> m_clusterDistances;      // CLUSTER_SIZE * CLUSTER_SIZE, by tile inside of the searched cluster.
+    std::vector<uint64_t> m_openList;              // Cost in the high 32 bits, index in the low 32.
+    std::vector<uint32_t> m_nodeCosts;
+    std::vector<int>      m_nodeParents;
+    std::vector<uint32_t> m_nodeGoalCosts;
+    std::vector<int>      m_nodeSearchIDs;         // Which search last touched each node, so nothing is cleared between searches.
+    int                   m_searchID = 0;
+
+    // Requests
+    float                                m_budgetMilliseconds     = 1.f;
+    int                                  m_nextRequestID          = 1;
+    std::unordered_map<int, PathRequest> m_requests;
+    std::deque<int>                      m_pendingRequestIDs;     // Oldest first; cancelled ids are skipped when they come up.
+    int                                  m_lastUpdateSolvedCount  = 0;
+    float                                m_lastUpdateMilliseconds = 0.f;
+};
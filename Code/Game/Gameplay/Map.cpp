@@ -5,48 +5,78 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Gameplay/Map.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include "Engine/Core/EngineCommon.hpp"
 
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/FloatRange.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/Renderer.hpp"
-#include "Engine/Renderer/SpriteSheet.hpp"
 #include "Game/Gameplay/Actor.hpp"
 #include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Definition/FactionDefinition.hpp"
 #include "Game/Framework/ActorHandle.hpp"
 #include "Game/Framework/AIController.hpp"
+#include "Game/Gameplay/CompiledMap.hpp"
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "Game/Definition/MapDefinition.hpp"
 #include "Game/Framework/PlayerController.hpp"
+#include "Game/Framework/ViewFrustum.hpp"
 #include "Game/Gameplay/Tile.hpp"
 #include "Game/Definition/TileDefinition.hpp"
+#include "Game/Framework/WorkerPool.hpp"
+#include "Game/Gameplay/Weapon.hpp"
 
 //----------------------------------------------------------------------------------------------------
 Map::Map(Game*                owner,
          MapDefinition const& mapDef)
     : m_game(owner),
-      m_mapDefinition(&mapDef)
+      m_mapDefinition(&mapDef),
+      m_spriteBatcher(g_theRenderer),
+      m_projectilePool(g_gameConfigBlackboard.GetValue("Game.MaxProjectilesPerMap", 65536)),
+      m_particleSystem(g_gameConfigBlackboard.GetValue("Game.MaxParticlesPerMap", 8192)),
+      m_aiScheduler(g_gameConfigBlackboard.GetValue("Game.AIBudgetMilliseconds", 2.f),
+                    g_gameConfigBlackboard.GetValue("Game.AIThinkMillisecondsPerAgent", 0.008f),
+                    g_gameConfigBlackboard.GetValue("Game.AILODDistance", 16.f),
+                    g_gameConfigBlackboard.GetValue("Game.AIDormantDistance", 48.f),
+                    g_gameConfigBlackboard.GetValue("Game.AINoiseRadius", 12.f)),
+      m_aiPerception(g_gameConfigBlackboard.GetValue("Game.AIPerceptionAgentsPerTick", 64)),
+      m_pathfinder(g_gameConfigBlackboard.GetValue("Game.PathfindingMillisecondsPerTick", 1.f))
 {
-    m_dimensions = m_mapDefinition->m_image.GetDimensions();
+    m_dimensions = m_mapDefinition->GetDimensions();
 
-    m_vertexes.reserve(sizeof(AABB3) * m_dimensions.x * m_dimensions.y);
-    m_tiles.reserve(static_cast<unsigned int>(m_dimensions.x * m_dimensions.y));
     m_actors.reserve(100);
+    m_definitionActors.resize(ActorDefinition::s_actorDefinitions.size());
+    m_factionActors.resize(FactionDefinition::GetFactionCount());
 
     m_texture = m_mapDefinition->m_spriteSheetTexture;
     m_shader  = m_mapDefinition->m_shader;
 
-    CreateBuffers();
     CreateTiles();
-    CreateGeometry();
+    CreateChunks();
+    m_actorQueryGrid.Initialize(m_dimensions);
+    m_flowFieldSystem.Initialize(m_dimensions, m_solidTileBitsData, m_solidTileBitsWidth);
+    m_pathfinder.Initialize(m_dimensions, m_solidTileBitsData, m_solidTileBitsWidth);
+    m_aiScheduler.SetThinkCostMeasured(g_gameConfigBlackboard.GetValue("Game.AIThinkCostMeasured", false));
+
+    // Geometry and GPU buffers are only needed when there is something to render to.
+    if (g_theRenderer != nullptr)
+    {
+        CreateGeometry();
+    }
+
+    std::vector<SpawnInfo> const& spawnInfos = m_mapDefinition->m_compiledMap != nullptr ? m_mapDefinition->m_compiledMap->GetSpawnInfos() : m_mapDefinition->m_spawnInfos;
 
-    for (SpawnInfo const& spawnInfo : m_mapDefinition->m_spawnInfos)
+    for (SpawnInfo const& spawnInfo : spawnInfos)
     {
         SpawnActor(spawnInfo);
     }
@@ -56,157 +86,142 @@ Map::Map(Game*                owner,
         Actor const* playerActor = SpawnPlayer(controller);
         controller->Possess(playerActor->m_handle);
     }
+
+    RebuildActorQueryGrid();
 }
 
 //----------------------------------------------------------------------------------------------------
 Map::~Map()
 {
-    GAME_SAFE_RELEASE(m_vertexBuffer);
-    GAME_SAFE_RELEASE(m_indexBuffer);
+    // The flow field thread reads the solidity bits, which are about to go.
+    m_flowFieldSystem.WaitForPendingFields();
 
-    m_vertexes.clear();
-    m_tiles.clear();
-    m_indexes.clear();
-}
-
-//----------------------------------------------------------------------------------------------------
-void Map::CreateTiles()
-{
-    for (int i = 0; i < m_dimensions.x; ++i)
+    for (MapChunk& chunk : m_chunks)
     {
-        for (int j = 0; j < m_dimensions.y; ++j)
-        {
-            m_tiles.emplace_back();
-        }
+        GAME_SAFE_RELEASE(chunk.m_vertexBuffer);
+        GAME_SAFE_RELEASE(chunk.m_indexBuffer);
     }
 
-    for (int i = 0; i < m_dimensions.x; ++i)
+    for (Actor const* actor : m_actors)
     {
-        for (int j = 0; j < m_dimensions.y; ++j)
-        {
-            AABB3 const bounds = AABB3(Vec3(i, j, 0), Vec3(i + 1, j + 1, 1));
-            IntVec2     coords = IntVec2(bounds.m_mins.x, bounds.m_mins.y);
-
-            for (TileDefinition const* tileDef : TileDefinition::s_tileDefinitions)
-            {
-                if (m_mapDefinition->m_image.GetTexelColor(coords) == tileDef->m_mapImagePixelColor)
-                {
-                    m_tiles[j + i * m_dimensions.y].m_bounds  = bounds;
-                    m_tiles[j + i * m_dimensions.y].m_name    = tileDef->m_name;
-                    m_tiles[j + i * m_dimensions.y].m_isSolid = tileDef->m_isSolid;
-                }
-            }
-        }
+        delete actor;
     }
+
+    m_actors.clear();
+    m_physicsStore.Resize(0);
+    m_actorSlots.clear();
+    m_freeActorSlots.clear();
+    m_chunks.clear();
+    m_tiles.clear();
+    m_solidTileBits.clear();
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::CreateGeometry()
+// Each tile stores the index of the tile definition whose map color matches its texel.
+// Solidity is mirrored into a bitset with a one tile border of non-solid padding, see IsTileSolid.
+// A compiled map already holds both, so they are used in place from its mapping.
+void Map::CreateTiles()
 {
-    unsigned int      indexOffset          = 0;
-    IntVec2 const     spriteSheetCellCount = m_mapDefinition->m_spriteSheetCellCount;
-    SpriteSheet const spriteSheet          = SpriteSheet(*m_mapDefinition->m_spriteSheetTexture, spriteSheetCellCount);
+    m_solidTileBitsWidth = Tile::GetSolidTileBitsWidth(m_dimensions);
 
-    for (int i = 0; i < m_dimensions.x; ++i)
+    if (m_mapDefinition->m_compiledMap != nullptr)
     {
-        for (int j = 0; j < m_dimensions.y; ++j)
-        {
-            AABB3 const bounds = AABB3(Vec3(i, j, 0), Vec3(i + 1, j + 1, 1));
+        m_tileData          = m_mapDefinition->m_compiledMap->GetTiles();
+        m_solidTileBitsData = m_mapDefinition->m_compiledMap->GetSolidTileBits();
+        return;
+    }
 
-            IntVec2 currentTileCoords = IntVec2(i, j);
-            AABB2   wallUVs, floorUVs, ceilingUVs;
+    m_tiles.assign(static_cast<size_t>(m_dimensions.x * m_dimensions.y), Tile());
 
-            for (TileDefinition const* tileDef : TileDefinition::s_tileDefinitions)
-            {
-                if (m_mapDefinition->m_image.GetTexelColor(currentTileCoords) == tileDef->m_mapImagePixelColor)
-                {
-                    wallUVs    = spriteSheet.GetSpriteUVs(tileDef->m_wallSpriteCoords.x + tileDef->m_wallSpriteCoords.y * 8);
-                    floorUVs   = spriteSheet.GetSpriteUVs(tileDef->m_floorSpriteCoords.x + tileDef->m_floorSpriteCoords.y * 8);
-                    ceilingUVs = spriteSheet.GetSpriteUVs(tileDef->m_ceilingSpriteCoords.x + tileDef->m_ceilingSpriteCoords.y * 8);
-                }
-            }
+    for (int y = 0; y < m_dimensions.y; ++y)
+    {
+        for (int x = 0; x < m_dimensions.x; ++x)
+        {
+            Rgba8 const texelColor = m_mapDefinition->m_image.GetTexelColor(IntVec2(x, y));
 
-            AddGeometryForWall(m_vertexes, m_indexes, bounds, wallUVs);
-            AddGeometryForFloor(m_vertexes, m_indexes, bounds, floorUVs);
-            AddGeometryForCeiling(m_vertexes, m_indexes, bounds, ceilingUVs);
+            m_tiles[x + y * m_dimensions.x].m_tileDefIndex = TileDefinition::GetDefIndexByMapImagePixelColor(texelColor);
         }
-
-        indexOffset += 4;
     }
+
+    Tile::CreateSolidTileBits(m_dimensions, m_tiles.data(), m_solidTileBits);
+
+    m_tileData          = m_tiles.data();
+    m_solidTileBitsData = m_solidTileBits.data();
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::AddGeometryForWall(VertexList_PCUTBN& verts,
-                             IndexList&         indexes,
-                             AABB3 const&       bounds,
-                             AABB2 const&       UVs) const
+// Splits the map into CHUNK_SIZE x CHUNK_SIZE tile chunks; the last row and column may be smaller.
+void Map::CreateChunks()
 {
-    Vec3 const frontBottomLeft  = Vec3(bounds.m_maxs.x, bounds.m_maxs.y - 1.f, bounds.m_maxs.z - 1.f);
-    Vec3 const frontBottomRight = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_maxs.z - 1.f);
-    Vec3 const frontTopLeft     = Vec3(bounds.m_maxs.x, bounds.m_maxs.y - 1.f, bounds.m_maxs.z);
-    Vec3 const frontTopRight    = bounds.m_maxs;
-    Vec3 const backBottomLeft   = Vec3(bounds.m_mins.x, bounds.m_mins.y + 1.f, 0.f);
-    Vec3 const backBottomRight  = bounds.m_mins;
-    Vec3 const backTopLeft      = Vec3(bounds.m_mins.x, bounds.m_mins.y + 1.f, 1.f);
-    Vec3 const backTopRight     = Vec3(bounds.m_mins.x, bounds.m_mins.y, 1.f);
+    int const chunkCount = MapGeometryBuilder::GetChunkCount(m_dimensions);
 
-    IntVec2 const currentTileCoords = IntVec2(bounds.m_mins.x, bounds.m_mins.y);
-    Tile const*   currentTile       = GetTile(currentTileCoords.x, currentTileCoords.y);
+    m_chunks.assign(static_cast<size_t>(chunkCount), MapChunk());
 
-    if (currentTile->m_name == "BrickWall")
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
     {
-        AddVertsForQuad3D(verts, indexes, frontBottomLeft, frontBottomRight, frontTopLeft, frontTopRight, Rgba8::WHITE, UVs);        // Front
-        AddVertsForQuad3D(verts, indexes, backBottomLeft, backBottomRight, backTopLeft, backTopRight, Rgba8::WHITE, UVs);            // Back
-        AddVertsForQuad3D(verts, indexes, backBottomRight, frontBottomLeft, backTopRight, frontTopLeft, Rgba8::WHITE, UVs);          // Left
-        AddVertsForQuad3D(verts, indexes, frontBottomRight, backBottomLeft, frontTopRight, backTopLeft, Rgba8::WHITE, UVs);          // Right
+        MapChunk& chunk = m_chunks[chunkIndex];
+        MapGeometryBuilder::GetChunkRegion(m_dimensions, chunkIndex, chunk.m_tileMins, chunk.m_tileMaxs);
+        chunk.m_bounds = AABB3(Vec3(static_cast<float>(chunk.m_tileMins.x), static_cast<float>(chunk.m_tileMins.y), 0.f),
+                               Vec3(static_cast<float>(chunk.m_tileMaxs.x), static_cast<float>(chunk.m_tileMaxs.y), 1.f));
     }
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::AddGeometryForFloor(VertexList_PCUTBN& verts,
-                              IndexList&         indexes,
-                              AABB3 const&       bounds,
-                              AABB2 const&       UVs) const
+// A compiled map carries every chunk's vertexes and indexes, which are uploaded straight from its mapping;
+// otherwise each chunk is built here.
+void Map::CreateGeometry()
 {
-    Vec3 const frontBottomLeft  = Vec3(bounds.m_maxs.x, bounds.m_maxs.y - 1.f, bounds.m_maxs.z - 1.f);
-    Vec3 const frontBottomRight = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_maxs.z - 1.f);
-    Vec3 const backBottomLeft   = Vec3(bounds.m_mins.x, bounds.m_mins.y + 1.f, 0.f);
-    Vec3 const backBottomRight  = bounds.m_mins;
+    CompiledMap const* compiledMap = m_mapDefinition->m_compiledMap;
 
-    IntVec2 const currentTileCoords = IntVec2(bounds.m_mins.x, bounds.m_mins.y);
-    Tile const*   currentTile       = GetTile(currentTileCoords.x, currentTileCoords.y);
-
-    if (currentTile->m_name == "StoneFloor")
+    if (compiledMap != nullptr)
     {
-        AddVertsForQuad3D(verts, indexes, backBottomLeft, backBottomRight, frontBottomRight, frontBottomLeft, Rgba8::WHITE, UVs);
+        for (int chunkIndex = 0; chunkIndex < static_cast<int>(m_chunks.size()); ++chunkIndex)
+        {
+            CompiledMapChunk const& compiledChunk = compiledMap->GetChunk(chunkIndex);
+
+            CreateChunkBuffers(m_chunks[chunkIndex],
+                               compiledMap->GetVertexes() + compiledChunk.m_firstVertex, compiledChunk.m_vertexCount,
+                               compiledMap->GetIndexes() + compiledChunk.m_firstIndex, compiledChunk.m_indexCount);
+        }
+
+        return;
     }
-}
 
-//----------------------------------------------------------------------------------------------------
-void Map::AddGeometryForCeiling(VertexList_PCUTBN& verts,
-                                IndexList&         indexes,
-                                AABB3 const&       bounds,
-                                AABB2 const&       UVs) const
-{
-    Vec3 const frontTopLeft  = Vec3(bounds.m_maxs.x, bounds.m_maxs.y - 1.f, bounds.m_maxs.z);
-    Vec3 const frontTopRight = bounds.m_maxs;
-    Vec3 const backTopLeft   = Vec3(bounds.m_mins.x, bounds.m_mins.y + 1.f, 1.f);
-    Vec3 const backTopRight  = Vec3(bounds.m_mins.x, bounds.m_mins.y, 1.f);
+    std::vector<AABB2> spriteUVs;
+    MapGeometryBuilder::GetSpriteSheetUVs(m_mapDefinition->m_spriteSheetCellCount, spriteUVs);
 
-    IntVec2 const currentTileCoords = IntVec2(bounds.m_mins.x, bounds.m_mins.y);
-    Tile const*   currentTile       = GetTile(currentTileCoords.x, currentTileCoords.y);
+    MapGeometryBuilder const builder = MapGeometryBuilder(m_dimensions, m_tileData, m_mapDefinition->m_spriteSheetCellCount, spriteUVs);
+    VertexList_PCUTBN        verts;
+    IndexList                indexes;
 
-    if (currentTile->m_name == "StoneFloor")
+    for (MapChunk& chunk : m_chunks)
     {
-        AddVertsForQuad3D(verts, indexes, backTopRight, backTopLeft, frontTopLeft, frontTopRight, Rgba8::WHITE, UVs);
+        verts.clear();
+        indexes.clear();
+        builder.Build(verts, indexes, chunk.m_tileMins, chunk.m_tileMaxs);
+
+        CreateChunkBuffers(chunk, verts.data(), verts.size(), indexes.data(), indexes.size());
     }
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::CreateBuffers()
+STATIC void Map::CreateChunkBuffers(MapChunk&            chunk,
+                                    Vertex_PCUTBN const* verts,
+                                    size_t const         vertexCount,
+                                    unsigned int const*  indexes,
+                                    size_t const         indexCount)
 {
-    m_vertexBuffer = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
-    m_indexBuffer  = g_theRenderer->CreateIndexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
+    chunk.m_indexCount = static_cast<unsigned int>(indexCount);
+
+    if (chunk.m_indexCount == 0) return;
+
+    unsigned int const vertexBytes = static_cast<unsigned int>(vertexCount * sizeof(Vertex_PCUTBN));
+    unsigned int const indexBytes  = static_cast<unsigned int>(indexCount * sizeof(unsigned int));
+
+    chunk.m_vertexBuffer = g_theRenderer->CreateVertexBuffer(vertexBytes, sizeof(Vertex_PCUTBN));
+    chunk.m_indexBuffer  = g_theRenderer->CreateIndexBuffer(indexBytes, sizeof(unsigned int));
+    g_theRenderer->CopyCPUToGPU(verts, vertexBytes, chunk.m_vertexBuffer);
+    g_theRenderer->CopyCPUToGPU(indexes, indexBytes, chunk.m_indexBuffer);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -240,7 +255,20 @@ bool Map::IsTileCoordsOutOfBounds(int const x,
 //----------------------------------------------------------------------------------------------------
 bool Map::IsTileSolid(IntVec2 const& tileCoords) const
 {
-    return GetTile(tileCoords.x, tileCoords.y)->m_isSolid;
+    return IsTileSolid(tileCoords.x, tileCoords.y);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Branch-free bitset lookup. Coordinates are clamped into the padding ring around the map,
+// and the padding is never solid, so any tile outside of the map reads as open.
+bool Map::IsTileSolid(int const x,
+                      int const y) const
+{
+    int const paddedX  = std::clamp(x, -1, m_dimensions.x) + 1;
+    int const paddedY  = std::clamp(y, -1, m_dimensions.y) + 1;
+    int const bitIndex = paddedX + paddedY * m_solidTileBitsWidth;
+
+    return ((m_solidTileBitsData[bitIndex >> 6] >> (bitIndex & 63)) & 1) != 0;
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -253,15 +281,23 @@ IntVec2 const Map::GetTileCoordsFromWorldPos(Vec3 const& worldPosition) const
 }
 
 //----------------------------------------------------------------------------------------------------
+IntVec2 Map::GetDimensions() const
+{
+    return m_dimensions;
+}
+
+//----------------------------------------------------------------------------------------------------
+MapDefinition const* Map::GetMapDefinition() const
+{
+    return m_mapDefinition;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The caller is responsible for the coordinates being inside of the map (see IsTileCoordsOutOfBounds).
 Tile const* Map::GetTile(int const x,
                          int const y) const
 {
-    if (IsTileCoordsOutOfBounds(x, y))
-    {
-        ERROR_AND_DIE("tileCoords is out of bound!")
-    }
-
-    return &m_tiles[y + x * m_dimensions.y];
+    return &m_tileData[x + y * m_dimensions.x];
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -271,12 +307,49 @@ Tile const* Map::GetTile(IntVec2 const& tileCoords) const
 }
 
 //----------------------------------------------------------------------------------------------------
+int Map::GetChunkCount() const
+{
+    return static_cast<int>(m_chunks.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+AABB3 Map::GetChunkBounds(int const chunkIndex) const
+{
+    return m_chunks[chunkIndex].m_bounds;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Zero when the map was created without a renderer.
+unsigned int Map::GetChunkIndexCount(int const chunkIndex) const
+{
+    return m_chunks[chunkIndex].m_indexCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Needs no renderer, so the number of chunks each view would draw can be checked headless.
+int Map::GetVisibleChunks(ViewFrustum const& frustum,
+                          std::vector<int>&  out_chunkIndexes) const
+{
+    out_chunkIndexes.clear();
+
+    for (int chunkIndex = 0; chunkIndex < static_cast<int>(m_chunks.size()); ++chunkIndex)
+    {
+        if (!frustum.IsAABB3Outside(m_chunks[chunkIndex].m_bounds))
+        {
+            out_chunkIndexes.push_back(chunkIndex);
+        }
+    }
+
+    return static_cast<int>(out_chunkIndexes.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+// One fixed simulation tick; Game::Update runs as many per frame as the game clock calls for.
+// Keyboard input is read once per frame instead, see UpdateFromKeyboard.
 void Map::Update(float const deltaSeconds)
 {
-    UpdateFromKeyboard();
+    m_pathfinder.Update();
     UpdateAllActors(deltaSeconds);
-    CollideActors();
-    CollideActorsWithMap();
     DeleteDestroyedActor();
     for (PlayerController* controller : g_theGame->m_localPlayerControllerList)
     {
@@ -288,6 +361,17 @@ void Map::Update(float const deltaSeconds)
             controller->Possess(playerActor->m_handle);
         }
     }
+
+    // The only rebuild of the tick: the actors are done moving, spawning and being deleted, and it is the collision
+    // broadphase. Collision only pushes them a little, so the projectiles and the queries asked until the next tick see
+    // them where they are from a refresh.
+    RebuildActorQueryGrid();
+    CollideActors();
+    CollideActorsWithMap();
+    RefreshActorQueryGrid();
+
+    m_projectilePool.Update(deltaSeconds, *this, m_actorQueryGrid);
+    m_particleSystem.Update(deltaSeconds);
     // if (!m_game->GetPlayerController()->GetActor())
     // {
     //     Actor const* playerActor = SpawnPlayer(m_game->GetPlayerController());
@@ -299,6 +383,8 @@ void Map::Update(float const deltaSeconds)
 //----------------------------------------------------------------------------------------------------
 void Map::UpdateFromKeyboard()
 {
+    if (g_theInput == nullptr) return;
+
     if (g_theInput->WasKeyJustPressed(KEYCODE_I))
     {
         DebugAddMessage(Stringf("Sun Direction: (%.2f, %.2f, %.2f)", m_sunDirection.x, m_sunDirection.y, m_sunDirection.z), 5.f);
@@ -358,30 +444,204 @@ void Map::UpdateFromKeyboard()
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::UpdateAllActors(float const deltaSeconds) const
+// Updates the actors in phases: lifetime and the AI schedule on this thread, then think and physics each spread over g_theWorkerPool.
+// During the parallel phases an actor only writes to itself and queues anything else it does as commands,
+// which are applied at the end in actor order, and the AI schedule sizes its time budget from a configured cost per
+// agent rather than the measured one, so the result does not depend on the thread count or the machine.
+// The spatial queries asked while thinking are resolved in between, and handed back at the start of the physics phase.
+// Actors spawned by the commands are updated from the next frame on.
+void Map::UpdateAllActors(float const deltaSeconds)
 {
-    for (int i = 0; i < static_cast<int>(m_actors.size()); i++)
+    int const actorCount = static_cast<int>(m_actors.size());
+
+    for (int i = 0; i < actorCount; i++)
+    {
+        m_actors[i]->SaveTransformForInterpolation();
+        m_actors[i]->UpdateLifetime(deltaSeconds);
+    }
+
+    // Nothing moves until the physics phase, so the queries of the phases before it see the actors where the last tick
+    // left them; the grid only needs rebuilding for actors spawned or deleted since, e.g. by the debug keys.
+    if (m_isActorQueryGridStale)
+    {
+        RebuildActorQueryGrid();
+    }
+
+    m_aiScheduler.Schedule(m_actors, deltaSeconds);
+    m_aiPerception.Update(*this, m_actors);
+    m_flowFieldSystem.Update(*this, m_actors);
+    UpdateAIPaths();
+
+    double const thinkStartSeconds = GetCurrentTimeSeconds();
+
+    ForEachActorInParallel(actorCount, [this, deltaSeconds](int const begin, int const end)
     {
-        if (m_actors[i] != nullptr)
+        for (int i = begin; i < end; i++)
         {
-            m_actors[i]->Update(deltaSeconds);
+            m_actors[i]->Think(deltaSeconds);
         }
+    });
+
+    m_aiScheduler.RecordThinkMilliseconds(static_cast<float>((GetCurrentTimeSeconds() - thinkStartSeconds) * 1000.0));
+    m_spatialQueryService.Resolve(*this, m_actors, actorCount);
+
+    // Each batch integrates its actors in place in the physics store.
+    ForEachActorInParallel(actorCount, [this, deltaSeconds](int const begin, int const end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            m_spatialQueryService.Deliver(*m_actors[i]);
+        }
+
+        IntegrateActors(deltaSeconds, begin, end);
+    });
+
+    ApplyActorCommands(actorCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Asks the pathfinder for the paths of the AIs chasing far targets and hands them the ones it has finished, in actor
+// order, the same AIs as FlowFieldSystem::Update. Requests are solved by m_pathfinder.Update at the start of a tick.
+void Map::UpdateAIPaths()
+{
+    for (Actor const* actor : m_actors)
+    {
+        if (actor->m_isDead || actor->m_aiController == nullptr || actor->m_controller != actor->m_aiController) continue;
+        if (actor->m_aiController->m_isDormant) continue;
+
+        actor->m_aiController->UpdatePath(m_pathfinder);
     }
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::CollideActors()
+// The physics phase of actors [begin, end), the same as Actor::UpdatePhysics one at a time.
+// The kernel writes the collision cylinders in the same pass; dead actors are carried along without being integrated.
+void Map::IntegrateActors(float const deltaSeconds,
+                          int const   begin,
+                          int const   end)
 {
-    for (int i = 0; i < static_cast<int>(m_actors.size()); ++i)
+    for (int i = begin; i < end; i++)
     {
-        if (m_actors[i] == nullptr || !m_actors[i]->m_handle.IsValid()) continue;
+        Actor* actor = m_actors[i];
 
-        for (int j = i + 1; j < static_cast<int>(m_actors.size()); ++j)
+        m_physicsStore.SetSimulated(i, !actor->m_isDead);
+
+        if (!actor->m_isDead)
         {
-            if (m_actors[j] == nullptr || !m_actors[j]->m_handle.IsValid()) continue;
+            actor->AddForce(actor->m_heldMoveForce);
+        }
+    }
 
-            CollideActors(m_actors[i], m_actors[j]);
+    m_physicsStore.Integrate(deltaSeconds, begin, end);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Carries out the commands queued by the first actorCount actors, in actor order and then in the order they were queued.
+// This is the only place the parallel phases' random rolls, damage, spawns and sounds happen.
+void Map::ApplyActorCommands(int const actorCount)
+{
+    for (int i = 0; i < actorCount; i++)
+    {
+        std::vector<ActorCommand>& commands = m_actors[i]->m_commands;
+
+        for (ActorCommand const& command : commands)
+        {
+            switch (command.m_type)
+            {
+            case eActorCommandType::DAMAGE:
+                {
+                    Actor* target = GetActorByHandle(command.m_target);
+                    if (target == nullptr) break;
+
+                    float damage = command.m_damage.m_min;
+
+                    if (command.m_damage.m_max != command.m_damage.m_min)
+                    {
+                        damage = g_theRNG->RollRandomFloatInRange(command.m_damage.m_min, command.m_damage.m_max);
+                    }
+
+                    target->Damage((int)damage, command.m_source);
+                    break;
+                }
+            case eActorCommandType::IMPULSE:
+                {
+                    Actor* target = GetActorByHandle(command.m_target);
+                    if (target == nullptr) break;
+
+                    target->AddImpulse(command.m_vector);
+                    break;
+                }
+            case eActorCommandType::SPAWN:
+                {
+                    SpawnActor(command.m_spawnInfo);
+                    break;
+                }
+            case eActorCommandType::SPAWN_PROJECTILE:
+                {
+                    Vec3      forward, left, up;
+                    SpawnInfo spawnInfo     = command.m_spawnInfo;
+                    spawnInfo.m_orientation = Weapon::GetRandomDirectionInCone(spawnInfo.m_orientation, command.m_coneDegrees);
+                    spawnInfo.m_orientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
+                    spawnInfo.m_velocity = forward * command.m_speed;
+
+                    int const definitionIndex = ActorDefinition::GetDefIndexByNameID(spawnInfo.GetNameID());
+
+                    if (definitionIndex >= 0 && ActorDefinition::s_actorDefinitions[definitionIndex]->m_isPooledProjectile)
+                    {
+                        m_projectilePool.Spawn(definitionIndex, spawnInfo.m_position, spawnInfo.m_velocity, command.m_source);
+                        break;
+                    }
+
+                    Actor* projectile = SpawnActor(spawnInfo);
+                    if (projectile == nullptr) break;
+
+                    projectile->m_owner = GetActorByHandle(command.m_source);
+                    break;
+                }
+            case eActorCommandType::SPAWN_EFFECT:
+                {
+                    m_particleSystem.SpawnEffect(command.m_effectIndex, command.m_vector);
+                    break;
+                }
+            case eActorCommandType::PLAY_SOUND:
+                {
+                    m_aiScheduler.AddNoise(command.m_vector);
+
+                    if (g_theAudio == nullptr) break;
+
+                    g_theAudio->StartSoundAt(command.m_soundID, command.m_vector);
+                    break;
+                }
+            }
         }
+
+        commands.clear();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs job over [0, actorCount) on g_theWorkerPool, or inline without one.
+void Map::ForEachActorInParallel(int const                                      actorCount,
+                                 std::function<void(int begin, int end)> const& job) const
+{
+    if (g_theWorkerPool == nullptr)
+    {
+        job(0, actorCount);
+        return;
+    }
+
+    g_theWorkerPool->ParallelFor(actorCount, ACTOR_BATCH_SIZE, job);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Candidate pairs come from the query grid, which must have been rebuilt since the actors last moved or were deleted.
+void Map::CollideActors()
+{
+    m_actorQueryGrid.GetCandidatePairs(m_actorPairs);
+
+    for (ActorPair const& pair : m_actorPairs)
+    {
+        CollideActors(m_actors[pair.m_first], m_actors[pair.m_second]);
     }
 }
 
@@ -390,8 +650,8 @@ void Map::CollideActors(Actor* actorA,
                         Actor* actorB)
 {
     // 2. Get actors' MinMaxZ range.
-    FloatRange const actorAMinMaxZ = actorA->m_collisionCylinder.GetFloatRange();
-    FloatRange const actorBMinMaxZ = actorB->m_collisionCylinder.GetFloatRange();
+    FloatRange const actorAMinMaxZ = m_physicsStore.GetCylinderRangeZ(actorA->m_physicsIndex);
+    FloatRange const actorBMinMaxZ = m_physicsStore.GetCylinderRangeZ(actorB->m_physicsIndex);
 
     // 3. If actors are not overlapping on their MinMaxZ range, there will be no collision, so return.
     if (!actorAMinMaxZ.IsOverlappingWith(actorBMinMaxZ)) { return; }
@@ -400,21 +660,25 @@ void Map::CollideActors(Actor* actorA,
 }
 
 //----------------------------------------------------------------------------------------------------
+// Each actor is only pushed out of the tiles around it, so actors are collided with the map in parallel.
 void Map::CollideActorsWithMap() const
 {
-    for (int actorIndex = 0; actorIndex < static_cast<int>(m_actors.size()); ++actorIndex)
+    ForEachActorInParallel(static_cast<int>(m_actors.size()), [this](int const begin, int const end)
     {
-        if (m_actors[actorIndex] != nullptr)
+        for (int actorIndex = begin; actorIndex < end; ++actorIndex)
         {
-            CollideActorWithMap(m_actors[actorIndex]);
+            if (m_actors[actorIndex]->m_definition->m_collidesWithWorld)
+            {
+                CollideActorWithMap(m_actors[actorIndex]);
+            }
         }
-    }
+    });
 }
 
 //----------------------------------------------------------------------------------------------------
 void Map::CollideActorWithMap(Actor* actor) const
 {
-    IntVec2 const actorTileCoords = GetTileCoordsFromWorldPos(actor->m_position);
+    IntVec2 const actorTileCoords = GetTileCoordsFromWorldPos(actor->GetPosition());
 
     // Push out of cardinal neighbors (NSEW) first
     PushActorOutOfTileIfSolid(actor, actorTileCoords + IntVec2(1, 0));
@@ -428,7 +692,7 @@ void Map::CollideActorWithMap(Actor* actor) const
     PushActorOutOfTileIfSolid(actor, actorTileCoords + IntVec2(-1, -1));
     PushActorOutOfTileIfSolid(actor, actorTileCoords + IntVec2(1, -1));
 
-    actor->OnCollisionEnterWithMap(GetTile(actorTileCoords)->m_bounds);
+    actor->OnCollisionEnterWithMap(Tile::GetBounds(actorTileCoords));
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -448,23 +712,29 @@ void Map::PushActorOutOfTileIfSolid(Actor*         actor,
 void Map::Render(PlayerController const* toPlayer) const
 {
     RenderAllActors(toPlayer);
-    RenderMap();
+    RenderMap(toPlayer);
 }
 
 //----------------------------------------------------------------------------------------------------
+// Every actor sprite goes through m_spriteBatcher, one draw per material.
 void Map::RenderAllActors(PlayerController const* toPlayer) const
 {
-    for (int i = 0; i < static_cast<int>(m_actors.size()); i++)
+    m_spriteBatcher.Begin();
+
+    for (Actor const* actor : m_actors)
     {
-        if (m_actors[i] != nullptr)
-        {
-            m_actors[i]->Render(toPlayer);
-        }
+        actor->Render(toPlayer, m_spriteBatcher);
     }
+
+    m_spriteBatcher.End();
+
+    m_projectilePool.Render(toPlayer);
+    m_particleSystem.Render(toPlayer);
 }
 
 //----------------------------------------------------------------------------------------------------
-void Map::RenderMap() const
+// Only chunks that overlap the player's view frustum are submitted.
+void Map::RenderMap(PlayerController const* toPlayer) const
 {
     g_theRenderer->SetModelConstants();
     // g_theRenderer->SetLightConstants(m_sunDirection, m_sunIntensity, m_ambientIntensity);
@@ -475,7 +745,16 @@ void Map::RenderMap() const
     g_theRenderer->BindTexture(m_texture);
     g_theRenderer->BindShader(m_shader);
 
-    g_theRenderer->DrawVertexArray(m_vertexes, m_indexes);
+    GetVisibleChunks(toPlayer->GetWorldCameraFrustum(), m_visibleChunkIndexes);
+
+    for (int const chunkIndex : m_visibleChunkIndexes)
+    {
+        MapChunk const& chunk = m_chunks[chunkIndex];
+
+        if (chunk.m_indexCount == 0) continue;
+
+        g_theRenderer->DrawIndexedVertexBuffer(chunk.m_vertexBuffer, chunk.m_indexBuffer, chunk.m_indexCount);
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -490,11 +769,10 @@ RaycastResult3D Map::RaycastAll(Vec3 const& startPosition,
 
     if (!IsTileCoordsOutOfBounds(startTileCoords))
     {
-        Tile const* startTile       = GetTile(startTileCoords);
-        AABB3 const startTileBounds = startTile->m_bounds;
+        AABB3 const startTileBounds = Tile::GetBounds(startTileCoords);
 
         if (startTileBounds.IsPointInside(startPosition) &&
-            startTile->m_isSolid)
+            IsTileSolid(startTileCoords))
         {
             closestResult.m_didImpact      = false;
             closestResult.m_impactPosition = startPosition;
@@ -554,11 +832,10 @@ RaycastResult3D Map::RaycastAll(Actor const* attackerActor,
 
     if (!IsTileCoordsOutOfBounds(startTileCoords))
     {
-        Tile const* startTile       = GetTile(startTileCoords);
-        AABB3 const startTileBounds = startTile->m_bounds;
+        AABB3 const startTileBounds = Tile::GetBounds(startTileCoords);
 
         if (startTileBounds.IsPointInside(startPosition) &&
-            startTile->m_isSolid)
+            IsTileSolid(startTileCoords))
         {
             closestResult.m_didImpact      = false;
             closestResult.m_impactPosition = startPosition;
@@ -599,62 +876,89 @@ RaycastResult3D Map::RaycastAll(Actor const* attackerActor,
 }
 
 //----------------------------------------------------------------------------------------------------
+// Amanatides-Woo grid traversal: every tile the ray crosses is visited exactly once, in order.
+// A solid tile is hit where the ray enters it, as long as the entry point is between floor and ceiling.
+// The tile the ray starts in never counts as a hit, so rays fired from inside a wall pass out of it.
 RaycastResult3D Map::RaycastWorldXY(Vec3 const& startPosition,
                                     Vec3 const& forwardNormal,
                                     float const maxLength) const
 {
-    // 1. Initialize raycastResult3D.
+    // 1. Initialize raycastResult3D as a miss.
     RaycastResult3D result;
+    result.m_didImpact        = false;
+    result.m_impactPosition   = startPosition;
+    result.m_impactNormal     = -forwardNormal;
+    result.m_impactLength     = 0.f;
     result.m_rayStartPosition = startPosition;
     result.m_rayForwardNormal = forwardNormal;
     result.m_rayMaxLength     = maxLength;
 
-    // 2. Calculate information for the ray's stepping while-loop.
-    Vec3             currentPosition   = startPosition;
-    float            currentLength     = 0.f;
-    float constexpr  stepSize          = 0.01f;
-    Vec3 const       rayMoveStep       = forwardNormal * stepSize;
-    float const      rayMoveStepLength = rayMoveStep.GetLength();
-    FloatRange const rangeWorldZ       = FloatRange(0.f, 1.f);
+    // 2. A ray with no XY movement never leaves its starting tile.
+    if (forwardNormal.x == 0.f && forwardNormal.y == 0.f) { return result; }
 
-    // 3. While the ray is still stepping forward,
-    while (currentLength < maxLength)
-    {
-        // 4. Step the ray forward.
-        currentPosition += rayMoveStep;
-        currentLength += rayMoveStepLength;
+    // 3. Calculate the step direction, the ray length between two x (or y) crossings,
+    // and the ray length to the first x (or y) crossing.
+    IntVec2 currentTileCoords = GetTileCoordsFromWorldPos(startPosition);
 
-        // 5. If the current tile is not in the map, continue the loop.
-        IntVec2 currentTileCoords = GetTileCoordsFromWorldPos(currentPosition);
+    int const   stepX      = forwardNormal.x > 0.f ? 1 : -1;
+    int const   stepY      = forwardNormal.y > 0.f ? 1 : -1;
+    float const lengthPerX = forwardNormal.x != 0.f ? fabsf(1.f / forwardNormal.x) : FLOAT_MAX;
+    float const lengthPerY = forwardNormal.y != 0.f ? fabsf(1.f / forwardNormal.y) : FLOAT_MAX;
 
-        if (IsTileCoordsOutOfBounds(currentTileCoords)) { continue; }
+    float const firstCrossingX = stepX > 0 ? static_cast<float>(currentTileCoords.x + 1) - startPosition.x : startPosition.x - static_cast<float>(currentTileCoords.x);
+    float const firstCrossingY = stepY > 0 ? static_cast<float>(currentTileCoords.y + 1) - startPosition.y : startPosition.y - static_cast<float>(currentTileCoords.y);
+    float       nextLengthX    = forwardNormal.x != 0.f ? firstCrossingX * lengthPerX : FLOAT_MAX;
+    float       nextLengthY    = forwardNormal.y != 0.f ? firstCrossingY * lengthPerY : FLOAT_MAX;
 
-        Tile const* currentTile         = GetTile(currentTileCoords);
-        AABB3 const currentTileBounds3D = currentTile->m_bounds;
-        AABB2 const currentTileBounds2D = AABB2(Vec2(currentTileBounds3D.m_mins.x, currentTileBounds3D.m_mins.y), Vec2(currentTileBounds3D.m_maxs.x, currentTileBounds3D.m_maxs.y));
-        Vec3 const  previousPosition    = currentPosition - forwardNormal * rayMoveStepLength;
-        Vec2 const  previousPositionXY  = Vec2(previousPosition.x, previousPosition.y);
+    // 4. Step into the next tile on whichever axis crosses first, until the ray runs out.
+    while (true)
+    {
+        float impactLength;
+        Vec3  impactNormal;
 
-        if (IsTileSolid(currentTileCoords) &&
-            rangeWorldZ.IsOnRange(currentPosition.z) &&
-            !currentTileBounds2D.IsPointInside(previousPositionXY))
+        if (nextLengthX < nextLengthY)
         {
-            result.m_didImpact         = true;
-            result.m_impactPosition    = currentPosition;
-            IntVec2 const impactNormal = GetTileCoordsFromWorldPos(previousPosition) - GetTileCoordsFromWorldPos(currentPosition);
-            result.m_impactNormal      = Vec3(impactNormal.x, impactNormal.y, 0);
-            result.m_impactLength      = currentLength;
+            impactLength = nextLengthX;
+            impactNormal = Vec3(static_cast<float>(-stepX), 0.f, 0.f);
+            currentTileCoords.x += stepX;
+            nextLengthX += lengthPerX;
+        }
+        else
+        {
+            impactLength = nextLengthY;
+            impactNormal = Vec3(0.f, static_cast<float>(-stepY), 0.f);
+            currentTileCoords.y += stepY;
+            nextLengthY += lengthPerY;
+        }
 
-            return result;
+        if (impactLength >= maxLength) { return result; }
+
+        // 5. Outside of the map nothing is solid. Once the ray is outside and still moving away, it can never come back.
+        if (IsTileCoordsOutOfBounds(currentTileCoords))
+        {
+            bool const isLeavingX = (currentTileCoords.x < 0 && stepX < 0) || (currentTileCoords.x >= m_dimensions.x && stepX > 0);
+            bool const isLeavingY = (currentTileCoords.y < 0 && stepY < 0) || (currentTileCoords.y >= m_dimensions.y && stepY > 0);
+
+            if (isLeavingX || isLeavingY) { return result; }
+
+            continue;
         }
-    }
 
-    result.m_didImpact      = false;
-    result.m_impactPosition = startPosition;
-    result.m_impactNormal   = -forwardNormal;
-    result.m_impactLength   = 0.f;
+        if (!IsTileSolid(currentTileCoords)) { continue; }
 
-    return result;
+        // 6. Walls only span from floor to ceiling.
+        Vec3 const impactPosition = startPosition + forwardNormal * impactLength;
+
+        if (impactPosition.z < 0.f || impactPosition.z > 1.f) { continue; }
+
+        // RAY HIT
+        result.m_didImpact      = true;
+        result.m_impactPosition = impactPosition;
+        result.m_impactNormal   = impactNormal;
+        result.m_impactLength   = impactLength;
+
+        return result;
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -718,10 +1022,9 @@ RaycastResult3D Map::RaycastWorldActors(Actor const* attackerActor,
 
     for (int i = 0; i < static_cast<int>(m_actors.size()); i++)
     {
-        if (m_actors[i] == nullptr) continue;
         if (attackerActor == m_actors[i]) continue;
 
-        Cylinder3             cylinder3 = m_actors[i]->m_collisionCylinder;
+        Cylinder3 const       cylinder3 = m_physicsStore.GetCollisionCylinder(i);
         RaycastResult3D const result    = RaycastVsCylinderZ3D(startPosition,
                                                                forwardNormal, maxLength,
                                                                cylinder3.GetCenterPositionXY(),
@@ -752,7 +1055,7 @@ RaycastResult3D Map::RaycastWorldActors(Vec3 const& startPosition,
 
     for (int i = 0; i < static_cast<int>(m_actors.size()); i++)
     {
-        Cylinder3             cylinder3 = m_actors[i]->m_collisionCylinder;
+        Cylinder3 const       cylinder3 = m_physicsStore.GetCollisionCylinder(i);
         RaycastResult3D const result    = RaycastVsCylinderZ3D(startPosition,
                                                                forwardNormal, maxLength,
                                                                cylinder3.GetCenterPositionXY(),
@@ -770,113 +1073,243 @@ RaycastResult3D Map::RaycastWorldActors(Vec3 const& startPosition,
     return closestResult;
 }
 
+//----------------------------------------------------------------------------------------------------
+// Many rays at once, as RaycastAll ignoring ignoredActor, in SIMD packets; see RayPacket.
+void Map::RaycastBatch(Actor const*                 ignoredActor,
+                       std::vector<BatchRay> const& rays,
+                       std::vector<BatchRayResult>& out_results) const
+{
+    out_results.resize(rays.size());
+    RayPacket::Cast(*this, ignoredActor, rays.data(), static_cast<int>(rays.size()), out_results.data());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Rays sharing an origin and a length, such as a spread of pellets or the sight lines of one observer.
+void Map::RaycastBatch(Actor const*                 ignoredActor,
+                       Vec3 const&                  startPosition,
+                       std::vector<Vec3> const&     forwardNormals,
+                       float const                  maxLength,
+                       std::vector<BatchRayResult>& out_results) const
+{
+    std::vector<BatchRay> rays(forwardNormals.size());
+
+    for (size_t i = 0; i < forwardNormals.size(); ++i)
+    {
+        rays[i].m_startPosition = startPosition;
+        rays[i].m_forwardNormal = forwardNormals[i];
+        rays[i].m_maxLength     = maxLength;
+    }
+
+    RaycastBatch(ignoredActor, rays, out_results);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Actors whose center, or disc if the filter says so, is within radius of center.
+void Map::QueryActorsInDisc(Vec2 const&                 center,
+                            float const                 radius,
+                            ActorQueryFilter const&     filter,
+                            std::vector<ActorQueryHit>& out_hits) const
+{
+    m_actorQueryGrid.QueryDisc(center, radius, filter, out_hits);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Actors within range of origin and within halfAngleDegrees of forwardNormal, such as a melee swing or a sight cone.
+void Map::QueryActorsInSector(Vec2 const&                 origin,
+                              Vec2 const&                 forwardNormal,
+                              float const                 halfAngleDegrees,
+                              float const                 range,
+                              ActorQueryFilter const&     filter,
+                              std::vector<ActorQueryHit>& out_hits) const
+{
+    m_actorQueryGrid.QuerySector(origin, forwardNormal, halfAngleDegrees, range, filter, out_hits);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Up to count actors within maxDistance of center, closest first.
+void Map::QueryNearestActors(Vec2 const&                 center,
+                             int const                   count,
+                             float const                 maxDistance,
+                             ActorQueryFilter const&     filter,
+                             std::vector<ActorQueryHit>& out_hits) const
+{
+    m_actorQueryGrid.QueryNearest(center, count, maxDistance, filter, out_hits);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Actors within halfWidth of the segment, in the order the segment passes them.
+void Map::QueryActorsAlongSegment(Vec2 const&                 start,
+                                  Vec2 const&                 end,
+                                  float const                 halfWidth,
+                                  ActorQueryFilter const&     filter,
+                                  std::vector<ActorQueryHit>& out_hits) const
+{
+    m_actorQueryGrid.QuerySegment(start, end, halfWidth, filter, out_hits);
+}
+
 //----------------------------------------------------------------------------------------------------
 // Spawn a specified actor according to the provided spawn info.
-// Should find or add a slot in our actor list, increment our next uid, generate a handle, and construct and return the actor.
+// Reuses the most recently freed slot if there is one, otherwise adds a new slot. The handle carries the slot's current generation.
 Actor* Map::SpawnActor(SpawnInfo const& spawnInfo)
 {
-    if (m_nextActorUID >= MAX_ACTOR_UID)
+    unsigned int slotIndex;
+
+    if (!m_freeActorSlots.empty())
     {
-        return nullptr;
+        slotIndex = m_freeActorSlots.back();
+        m_freeActorSlots.pop_back();
+    }
+    else
+    {
+        if (m_actorSlots.size() >= MAX_ACTOR_SLOTS)
+        {
+            return nullptr;
+        }
+
+        slotIndex = static_cast<unsigned int>(m_actorSlots.size());
+        m_actorSlots.emplace_back();
     }
 
-    unsigned int const newIndex = static_cast<unsigned int>(m_actors.size());
-    Actor*             newActor = new Actor(spawnInfo);
+    ActorSlot& slot     = m_actorSlots[slotIndex];
+    Actor*     newActor = new Actor(spawnInfo);
 
-    ActorHandle const handle = ActorHandle(m_nextActorUID, newIndex);
+    ActorHandle const handle = ActorHandle(slot.m_generation, slotIndex);
     newActor->m_handle       = handle;
     newActor->m_map          = this;
+    slot.m_actor             = newActor;
 
     newActor->m_aiController = new AIController(this);
     newActor->m_controller   = newActor->m_aiController;
     newActor->m_aiController->Possess(newActor->m_handle);
 
+    // The physics row and the actor are appended together, so the store's indices stay the same as m_actors'.
+    ActorDefinition const* definition = newActor->m_definition;
 
     m_actors.push_back(newActor);
-    m_nextActorUID++;
+    newActor->m_physicsStore = &m_physicsStore;
+    newActor->m_physicsIndex = m_physicsStore.AddActor(spawnInfo.m_position, spawnInfo.m_velocity,
+                                                       definition->m_radius, definition->m_height, definition->m_drag, definition->m_flying);
+    GUARANTEE_OR_DIE(newActor->m_physicsIndex == static_cast<int>(m_actors.size()) - 1, "The actor physics store is out of step with Map::m_actors")
+
+    m_definitionActors[ActorDefinition::GetDefIndexByNameID(newActor->m_definition->m_nameID)].push_back(newActor);
+    m_factionActors[newActor->m_definition->m_factionIndex].push_back(newActor);
+    m_isActorQueryGridStale = true;
 
     return newActor;
 }
 
 //----------------------------------------------------------------------------------------------------
-// Dereference an actor handle and return an actor pointer.
-// Get the index from the actor handle.
-// If that slot in our list of actors is null, return null.
-// If that slot in our list of actors contains an actor, check if that actor’s handle matches the input actor handle.
-// If they do not match, return null.
-// Otherwise, return the actor pointer at that index.
+// Dereference an actor handle and return an actor pointer in O(1).
+// Returns null if the handle's slot is empty or has been reused since, i.e. its generation no longer matches.
 Actor* Map::GetActorByHandle(ActorHandle const handle) const
 {
     if (!handle.IsValid()) { return nullptr; }
 
     unsigned int const handleIndex = handle.GetIndex();
 
-    if (handleIndex >= m_actors.size())
+    if (handleIndex >= m_actorSlots.size())
     {
         return nullptr;
     }
 
-    Actor* storedActor = m_actors[handleIndex];
+    ActorSlot const& slot = m_actorSlots[handleIndex];
 
-    if (storedActor == nullptr)
+    if (slot.m_actor == nullptr ||
+        slot.m_generation != handle.GetGeneration())
     {
         return nullptr;
     }
 
-    if (storedActor->m_handle != handle)
-    {
-        return nullptr;
-    }
+    return slot.m_actor;
+}
 
-    return storedActor;
+//----------------------------------------------------------------------------------------------------
+unsigned int Map::GetActorSlotCount() const
+{
+    return static_cast<unsigned int>(m_actorSlots.size());
 }
 
+//----------------------------------------------------------------------------------------------------
+// The first actor of that definition still alive, in spawn order.
 Actor const* Map::GetActorByName(String const& name) const
 {
-    for (Actor const* actor : m_actors)
-    {
-        if (actor != nullptr &&
-            actor->m_handle.IsValid())
-        {
-            if (actor->m_definition->m_name == name)
-            {
-                return actor;
-            }
-        }
-    }
+    std::vector<Actor*> const& actors = GetActorsByName(name);
 
-    return nullptr;
+    return actors.empty() ? nullptr : actors.front();
 }
 
-void Map::GetActorsByName(std::vector<Actor*>& out_ActorList, String const& name) const
+//----------------------------------------------------------------------------------------------------
+// Delete any actors marked as destroyed.
+// The dense list is compacted in place so the survivors keep their spawn order, and each freed slot bumps its generation.
+// The query grid still holds the deleted actors until RebuildActorQueryGrid, which Update calls right after.
+void Map::DeleteDestroyedActor()
 {
-    for (Actor* actor : m_actors)
+    m_garbageActors.clear();
+    m_dirtyDefinitionIndexes.clear();
+    m_dirtyFactionIndexes.clear();
+
+    int liveCount = 0;
+
+    for (int i = 0; i < static_cast<int>(m_actors.size()); i++)
     {
-        if (actor != nullptr &&
-            actor->m_handle.IsValid())
+        Actor* actor = m_actors[i];
+
+        if (!actor->m_isGarbage)
         {
-            if (actor->m_definition->m_name == name)
+            // The physics store moves down with the list, so each actor's index stays its place in it.
+            if (liveCount != i)
             {
-                out_ActorList.push_back(actor);
+                m_physicsStore.MoveActor(i, liveCount);
+                actor->m_physicsIndex = liveCount;
             }
+
+            m_actors[liveCount] = actor;
+            ++liveCount;
+            continue;
+        }
+
+        unsigned int const slotIndex = actor->m_handle.GetIndex();
+        ActorSlot&         slot      = m_actorSlots[slotIndex];
+        slot.m_actor                 = nullptr;
+        ++slot.m_generation;
+
+        if (slot.m_generation < MAX_ACTOR_GENERATION)
+        {
+            m_freeActorSlots.push_back(slotIndex);
         }
+
+        m_garbageActors.push_back(actor);
+        m_dirtyDefinitionIndexes.push_back(ActorDefinition::GetDefIndexByNameID(actor->m_definition->m_nameID));
+        m_dirtyFactionIndexes.push_back(actor->m_definition->m_factionIndex);
     }
-}
 
-//----------------------------------------------------------------------------------------------------
-// Delete any actors marked as destroyed.
-void Map::DeleteDestroyedActor()
-{
-    for (int i = 0; i < static_cast<int>(m_actors.size()); i++)
+    if (m_garbageActors.empty()) return;
+
+    m_actors.resize(liveCount);
+    m_physicsStore.Resize(liveCount);
+
+    // Only the definition and faction lists that lost actors are compacted, the same way, before the garbage is deleted.
+    auto const CompactLists = [](std::vector<std::vector<Actor*>>& lists, std::vector<int>& dirtyIndexes)
     {
-        if (m_actors[i] == nullptr) continue;
-        if (!m_actors[i]->m_handle.IsValid()) continue;
-        if (!m_actors[i]->m_isGarbage) continue;
+        std::sort(dirtyIndexes.begin(), dirtyIndexes.end());
+        dirtyIndexes.erase(std::unique(dirtyIndexes.begin(), dirtyIndexes.end()), dirtyIndexes.end());
+
+        for (int const listIndex : dirtyIndexes)
+        {
+            std::vector<Actor*>& actors = lists[listIndex];
+            actors.erase(std::remove_if(actors.begin(), actors.end(), [](Actor const* actor) { return actor->m_isGarbage; }), actors.end());
+        }
+    };
+
+    CompactLists(m_definitionActors, m_dirtyDefinitionIndexes);
+    CompactLists(m_factionActors, m_dirtyFactionIndexes);
 
-        unsigned int const index = m_actors[i]->m_handle.GetIndex();
-        delete m_actors[i];
-        m_actors[index] = nullptr;
+    for (Actor const* actor : m_garbageActors)
+    {
+        delete actor;
     }
+
+    m_isActorQueryGridStale = true;
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -884,82 +1317,53 @@ void Map::DeleteDestroyedActor()
 Actor* Map::SpawnPlayer(PlayerController* playerController)
 {
     SpawnInfo spawnInfo;
-    spawnInfo.m_name = "Marine";
-    std::vector<Actor*> out_actorLists;
-    GetActorsByName(out_actorLists, "SpawnPoint");
-    Actor const* spawnPoint = out_actorLists[g_theRNG->RollRandomIntInRange(0, (int)out_actorLists.size() - 1)];
-    spawnInfo.m_position    = spawnPoint->m_position;
+    spawnInfo.m_name   = "Marine";
+    spawnInfo.m_nameID = NameTable::MARINE;
+    std::vector<Actor*> const& spawnPoints = GetActorsByNameID(NameTable::SPAWN_POINT);
+    Actor const* spawnPoint = spawnPoints[g_theRNG->RollRandomIntInRange(0, (int)spawnPoints.size() - 1)];
+    spawnInfo.m_position    = spawnPoint->GetPosition();
     spawnInfo.m_orientation = spawnPoint->m_orientation;
-    spawnInfo.m_velocity    = spawnPoint->m_velocity;
+    spawnInfo.m_velocity    = spawnPoint->GetVelocity();
     Actor* playerActor      = SpawnActor(spawnInfo);
     playerController->m_map = this;
     return playerActor;
 }
 
 //----------------------------------------------------------------------------------------------------
-// Search the actor list to find actors meeting the provided criteria.
-Actor const* Map::GetClosestVisibleEnemy(Actor const* owner) const
+// Whether actor's faction attacks other's faction. Hostility need not be mutual.
+bool Map::IsHostile(Actor const* actor,
+                    Actor const* other) const
 {
-    float        closestDistanceSquared = FLOAT_MAX;
-    Actor const* closestEnemy           = nullptr;
-
-    for (Actor const* actor : m_actors)
-    {
-        if (actor == nullptr || actor == owner) continue;
-
-        // Skip same faction or neutral
-        if (actor->m_definition->m_faction == owner->m_definition->m_faction) continue;
-        if (actor->m_definition->m_faction == "NEUTRAL"
-            || owner->m_definition->m_faction == "NEUTRAL")
-        {
-            continue;
-        }
-
-        // Check distance
-        Vec2 actorPositionXY      = Vec2(actor->m_position.x, actor->m_position.y);
-        Vec2 instigatorPositionXY = Vec2(owner->m_position.x, owner->m_position.y);
-
-        float const distanceSquared = GetDistanceSquared2D(actorPositionXY, instigatorPositionXY);
-        float const radiusSquared   = owner->m_definition->m_sightRadius * owner->m_definition->m_sightRadius;
-
-        if (distanceSquared > radiusSquared)
-        {
-            continue; // too far
-        }
-
-        // Check angle
-        Vec3 forward, left, up;
-        owner->m_orientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
-
-        Vec3 direction3D = actor->GetActorEyePosition() - owner->GetActorEyePosition();
-
-        Vec2 fwd2D(forward.x, forward.y);
-        Vec2 dirToActor = (actorPositionXY - instigatorPositionXY).GetNormalized();
+    return FactionDefinition::IsHostile(actor->m_definition->m_factionIndex, other->m_definition->m_factionIndex);
+}
 
-        // The angle between forward vector and direction to the actor
-        float const angleBetween = GetAngleDegreesBetweenVectors2D(fwd2D, dirToActor);
+//----------------------------------------------------------------------------------------------------
+std::vector<Actor*> const& Map::GetActorsByName(String const& name) const
+{
+    return GetActorsByNameID(NameTable::Find(name));
+}
 
-        if (angleBetween > owner->m_definition->m_sightAngle * 0.5f)
-        {
-            continue; // out of FOV cone
-        }
+//----------------------------------------------------------------------------------------------------
+// Live actors of the definition named nameID in spawn order, or an empty list if no actor definition has that name.
+std::vector<Actor*> const& Map::GetActorsByNameID(NameID const nameID) const
+{
+    static std::vector<Actor*> const s_noActors;
 
-        /// Line of Sight check: make sure no walls blocking
-        ActorHandle           out_impactedActorHandle;
-        RaycastResult3D const result = RaycastAll(owner, out_impactedActorHandle, owner->GetActorEyePosition(), direction3D.GetNormalized(), distanceSquared);
+    int const definitionIndex = ActorDefinition::GetDefIndexByNameID(nameID);
 
-        if (!result.m_didImpact) continue;
-        if (!IsPointInsideDisc2D(Vec2(result.m_impactPosition.x, result.m_impactPosition.y), Vec2(actor->m_position.x, actor->m_position.y), actor->m_radius + 0.1f)) continue;
-        /// End of Line of Sight check
+    return definitionIndex >= 0 ? m_definitionActors[definitionIndex] : s_noActors;
+}
 
-        if (distanceSquared < closestDistanceSquared)
-        {
-            closestDistanceSquared = distanceSquared;
-            closestEnemy           = actor;
-        }
-    }
+//----------------------------------------------------------------------------------------------------
+std::vector<Actor*> const& Map::GetDefinitionActors(int const definitionIndex) const
+{
+    return m_definitionActors[definitionIndex];
+}
 
-    return closestEnemy;
+//----------------------------------------------------------------------------------------------------
+std::vector<Actor*> const& Map::GetFactionActors(int const factionIndex) const
+{
+    return m_factionActors[factionIndex];
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -975,7 +1379,8 @@ void Map::DebugPossessNext() const
 
 	if (playerControlledActor != nullptr)
 	{
-		startIndex = playerControlledActor->m_handle.GetIndex() + 1;
+		auto const found = std::find(m_actors.begin(), m_actors.end(), playerControlledActor);
+		startIndex = static_cast<unsigned int>(found - m_actors.begin()) + 1;
 	}
 
 	unsigned int const actorCount = static_cast<unsigned int>(m_actors.size());
@@ -987,12 +1392,119 @@ void Map::DebugPossessNext() const
 		unsigned int const desiredIndex = (startIndex + i) % actorCount;
 		Actor const* potentialActor = m_actors[desiredIndex];
 
-		if (potentialActor &&
-			potentialActor->m_handle.IsValid() &&
-			potentialActor->m_definition->m_canBePossessed)
+		if (potentialActor->m_definition->m_canBePossessed)
 		{
 			playerController->Possess(potentialActor->m_handle);
 			return;
 		}
 	}
 }
+
+//----------------------------------------------------------------------------------------------------
+ProjectilePool& Map::GetProjectilePool()
+{
+    return m_projectilePool;
+}
+
+//----------------------------------------------------------------------------------------------------
+ProjectilePool const& Map::GetProjectilePool() const
+{
+    return m_projectilePool;
+}
+
+//----------------------------------------------------------------------------------------------------
+ParticleSystem& Map::GetParticleSystem()
+{
+    return m_particleSystem;
+}
+
+//----------------------------------------------------------------------------------------------------
+ParticleSystem const& Map::GetParticleSystem() const
+{
+    return m_particleSystem;
+}
+
+//----------------------------------------------------------------------------------------------------
+SpriteBatcher const& Map::GetSpriteBatcher() const
+{
+    return m_spriteBatcher;
+}
+
+//----------------------------------------------------------------------------------------------------
+AIPerception& Map::GetAIPerception()
+{
+    return m_aiPerception;
+}
+
+//----------------------------------------------------------------------------------------------------
+AIPerception const& Map::GetAIPerception() const
+{
+    return m_aiPerception;
+}
+
+//----------------------------------------------------------------------------------------------------
+void Map::RebuildActorQueryGrid()
+{
+    m_actorQueryGrid.Rebuild(m_actors);
+    m_isActorQueryGridStale = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+void Map::RefreshActorQueryGrid()
+{
+    m_actorQueryGrid.RefreshPositions();
+}
+
+//----------------------------------------------------------------------------------------------------
+ActorQueryGrid const& Map::GetActorQueryGrid() const
+{
+    return m_actorQueryGrid;
+}
+
+//----------------------------------------------------------------------------------------------------
+AIScheduler& Map::GetAIScheduler()
+{
+    return m_aiScheduler;
+}
+
+//----------------------------------------------------------------------------------------------------
+AIScheduler const& Map::GetAIScheduler() const
+{
+    return m_aiScheduler;
+}
+
+//----------------------------------------------------------------------------------------------------
+SpatialQueryService const& Map::GetSpatialQueryService() const
+{
+    return m_spatialQueryService;
+}
+
+//----------------------------------------------------------------------------------------------------
+FlowFieldSystem& Map::GetFlowFieldSystem()
+{
+    return m_flowFieldSystem;
+}
+
+//----------------------------------------------------------------------------------------------------
+FlowFieldSystem const& Map::GetFlowFieldSystem() const
+{
+    return m_flowFieldSystem;
+}
+
+//----------------------------------------------------------------------------------------------------
+HierarchicalPathfinder& Map::GetPathfinder()
+{
+    return m_pathfinder;
+}
+
+//----------------------------------------------------------------------------------------------------
+ActorPhysicsStore& Map::GetPhysicsStore()
+{
+    return m_physicsStore;
+}
+
+//----------------------------------------------------------------------------------------------------
+ActorPhysicsStore const& Map::GetPhysicsStore() const
+{
+    return m_physicsStore;
+}
@@ -4,13 +4,29 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <cstdint>
+#include <functional>
 
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/RaycastUtils.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
+#include "Game/Framework/NameTable.hpp"
+#include "Game/Framework/SpriteBatcher.hpp"
+#include "Game/Gameplay/AIPerception.hpp"
+#include "Game/Gameplay/AIScheduler.hpp"
+#include "Game/Gameplay/ActorPhysicsStore.hpp"
+#include "Game/Gameplay/ActorQueryGrid.hpp"
+#include "Game/Gameplay/FlowFieldSystem.hpp"
+#include "Game/Gameplay/HierarchicalPathfinder.hpp"
+#include "Game/Gameplay/MapGeometryBuilder.hpp"
+#include "Game/Gameplay/ParticleSystem.hpp"
+#include "Game/Gameplay/ProjectilePool.hpp"
+#include "Game/Gameplay/RayPacket.hpp"
+#include "Game/Gameplay/SpatialQueryService.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class Actor;
@@ -20,6 +36,7 @@ class IndexBuffer;
 class Shader;
 class Texture;
 struct ActorHandle;
+struct ViewFrustum;
 struct MapDefinition;
 struct SpawnInfo;
 struct Tile;
@@ -32,32 +49,43 @@ public:
     ~Map();
 
     void CreateTiles();
+    void CreateChunks();
     void CreateGeometry();
-    void AddGeometryForWall(VertexList_PCUTBN& verts, IndexList& indexes, AABB3 const& bounds, AABB2 const& UVs) const;
-    void AddGeometryForFloor(VertexList_PCUTBN& verts, IndexList& indexes, AABB3 const& bounds, AABB2 const& UVs) const;
-    void AddGeometryForCeiling(VertexList_PCUTBN& verts, IndexList& indexes, AABB3 const& bounds, AABB2 const& UVs) const;
-    void CreateBuffers();
-
-    bool          IsPositionInBounds(Vec3 const& position, float tolerance = 0.f) const;
-    bool          IsTileCoordsOutOfBounds(IntVec2 const& tileCoords) const;
-    bool          IsTileCoordsOutOfBounds(int x, int y) const;
-    bool          IsTileSolid(IntVec2 const& tileCoords) const;
-    IntVec2 const GetTileCoordsFromWorldPos(Vec3 const& worldPosition) const;
-    Tile const*   GetTile(int x, int y) const;
-    Tile const*   GetTile(IntVec2 const& tileCoords) const;
+
+    bool                 IsPositionInBounds(Vec3 const& position, float tolerance = 0.f) const;
+    bool                 IsTileCoordsOutOfBounds(IntVec2 const& tileCoords) const;
+    bool                 IsTileCoordsOutOfBounds(int x, int y) const;
+    bool                 IsTileSolid(IntVec2 const& tileCoords) const;
+    bool                 IsTileSolid(int x, int y) const;
+    IntVec2 const        GetTileCoordsFromWorldPos(Vec3 const& worldPosition) const;
+    IntVec2              GetDimensions() const;
+    MapDefinition const* GetMapDefinition() const;
+    Tile const*          GetTile(int x, int y) const;
+    Tile const*          GetTile(IntVec2 const& tileCoords) const;
+
+    static constexpr int CHUNK_SIZE = MapGeometryBuilder::CHUNK_SIZE;
+
+    int          GetChunkCount() const;
+    AABB3        GetChunkBounds(int chunkIndex) const;
+    unsigned int GetChunkIndexCount(int chunkIndex) const;
+    int          GetVisibleChunks(ViewFrustum const& frustum, std::vector<int>& out_chunkIndexes) const;
 
     void Update(float deltaSeconds);
     void UpdateFromKeyboard();
-    void UpdateAllActors(float deltaSeconds) const;
+    void UpdateAllActors(float deltaSeconds);
+    void UpdateAIPaths();
+    void IntegrateActors(float deltaSeconds, int begin, int end);
+    void ApplyActorCommands(int actorCount);
 
     void CollideActors();
     void CollideActors(Actor* actorA, Actor* actorB);
     void CollideActorsWithMap() const;
     void CollideActorWithMap(Actor* actor) const;
 
+    void ForEachActorInParallel(int actorCount, std::function<void(int begin, int end)> const& job) const;
     void PushActorOutOfTileIfSolid(Actor* actor, IntVec2 const& tileCoords) const;
     void RenderAllActors(PlayerController const* toPlayer) const;
-    void RenderMap() const;
+    void RenderMap(PlayerController const* toPlayer) const;
 
     void Render(PlayerController const* toPlayer) const;
 
@@ -67,18 +95,50 @@ public:
     RaycastResult3D RaycastWorldZ(Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength) const;
     RaycastResult3D RaycastWorldActors(Actor const* attackerActor, ActorHandle& out_impactedActorHandle, Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength) const;
     RaycastResult3D RaycastWorldActors(Vec3 const& startPosition, Vec3 const& forwardNormal, float maxLength) const;
+    void            RaycastBatch(Actor const* ignoredActor, std::vector<BatchRay> const& rays, std::vector<BatchRayResult>& out_results) const;
+    void            RaycastBatch(Actor const* ignoredActor, Vec3 const& startPosition, std::vector<Vec3> const& forwardNormals, float maxLength, std::vector<BatchRayResult>& out_results) const;
+
+    // Living actors in a shape on the XY plane; see ActorQueryGrid.
+    void QueryActorsInDisc(Vec2 const& center, float radius, ActorQueryFilter const& filter, std::vector<ActorQueryHit>& out_hits) const;
+    void QueryActorsInSector(Vec2 const& origin, Vec2 const& forwardNormal, float halfAngleDegrees, float range, ActorQueryFilter const& filter, std::vector<ActorQueryHit>& out_hits) const;
+    void QueryNearestActors(Vec2 const& center, int count, float maxDistance, ActorQueryFilter const& filter, std::vector<ActorQueryHit>& out_hits) const;
+    void QueryActorsAlongSegment(Vec2 const& start, Vec2 const& end, float halfWidth, ActorQueryFilter const& filter, std::vector<ActorQueryHit>& out_hits) const;
 
     Actor*       SpawnActor(SpawnInfo const& spawnInfo);
     Actor*       GetActorByHandle(ActorHandle handle) const;
+    unsigned int GetActorSlotCount() const;
     Actor const* GetActorByName(String const& name) const;
-    void         GetActorsByName(std::vector<Actor*>& out_ActorList, String const& name) const;
     void         DeleteDestroyedActor();
+    void         RebuildActorQueryGrid();     // For actors spawned, moved or deleted outside of Update, which the queries see from then on.
+    void         RefreshActorQueryGrid();     // For actors that were only pushed a little since the last rebuild, and none deleted.
     Actor*       SpawnPlayer(PlayerController* playerController);
-    Actor const* GetClosestVisibleEnemy(Actor const* owner) const;
+    bool         IsHostile(Actor const* actor, Actor const* other) const;
+
+    std::vector<Actor*> const& GetActorsByName(String const& name) const;
+    std::vector<Actor*> const& GetActorsByNameID(NameID nameID) const;
+    std::vector<Actor*> const& GetDefinitionActors(int definitionIndex) const;
+    std::vector<Actor*> const& GetFactionActors(int factionIndex) const;
     void         DebugPossessNext() const;
 
+    ProjectilePool&         GetProjectilePool();
+    ProjectilePool const&   GetProjectilePool() const;
+    ParticleSystem&         GetParticleSystem();
+    ParticleSystem const&   GetParticleSystem() const;
+    SpriteBatcher const&    GetSpriteBatcher() const;
+    AIPerception&           GetAIPerception();
+    AIPerception const&     GetAIPerception() const;
+    AIScheduler&            GetAIScheduler();
+    AIScheduler const&      GetAIScheduler() const;
+    SpatialQueryService const& GetSpatialQueryService() const;
+    ActorQueryGrid const&   GetActorQueryGrid() const;
+    FlowFieldSystem&        GetFlowFieldSystem();
+    FlowFieldSystem const&  GetFlowFieldSystem() const;
+    HierarchicalPathfinder& GetPathfinder();
+    ActorPhysicsStore&      GetPhysicsStore();
+    ActorPhysicsStore const& GetPhysicsStore() const;
+
     Game*               m_game = nullptr;
-    std::vector<Actor*> m_actors;
+    std::vector<Actor*> m_actors;       // Dense list of live actors in spawn order, never contains nullptr.
 
     Vec3  m_sunDirection     = Vec3(2.f, 1.f, -1.f).GetNormalized();
     float m_sunIntensity     = 0.85f;
@@ -86,22 +146,62 @@ public:
 
 protected:
     // Map
-    MapDefinition const* m_mapDefinition = nullptr;
-    std::vector<Tile>    m_tiles;
-    IntVec2              m_dimensions;
+    MapDefinition const*  m_mapDefinition = nullptr;
+    std::vector<Tile>     m_tiles;                             // Row major, x + y * m_dimensions.x. Empty when the map is compiled.
+    std::vector<uint64_t> m_solidTileBits;                     // One bit per tile, with a ring of non-solid padding around the map.
+    Tile const*           m_tileData           = nullptr;      // m_tiles, or the tiles inside of the compiled map's mapping.
+    uint64_t const*       m_solidTileBitsData  = nullptr;      // m_solidTileBits, or the bits inside of the compiled map's mapping.
+    int                   m_solidTileBitsWidth = 0;            // m_dimensions.x plus the padding on both sides.
+    IntVec2               m_dimensions;
 
     // Rendering
-    VertexList_PCUTBN m_vertexes;
-    IndexList         m_indexes;
-    Texture const*    m_texture      = nullptr;
-    Shader*           m_shader       = nullptr;
-    VertexBuffer*     m_vertexBuffer = nullptr;
-    IndexBuffer*      m_indexBuffer  = nullptr;
-
-
+    struct MapChunk
+    {
+        IntVec2       m_tileMins;                // Inclusive.
+        IntVec2       m_tileMaxs;                // Exclusive.
+        AABB3         m_bounds;
+        VertexBuffer* m_vertexBuffer = nullptr;
+        IndexBuffer*  m_indexBuffer  = nullptr;
+        unsigned int  m_indexCount   = 0;
+    };
+
+    static void CreateChunkBuffers(MapChunk& chunk, Vertex_PCUTBN const* verts, size_t vertexCount, unsigned int const* indexes, size_t indexCount);
+
+    std::vector<MapChunk>    m_chunks;                   // Row major over the chunk grid; bounds exist even without a renderer.
+    mutable std::vector<int> m_visibleChunkIndexes;      // Reused by RenderMap for every view.
+    mutable SpriteBatcher    m_spriteBatcher;            // Reused by RenderAllActors for every view.
+    Texture const*           m_texture = nullptr;
+    Shader*                  m_shader  = nullptr;
 
     // Actor
-    static constexpr unsigned int MAX_ACTOR_UID      = 0x0000fffeu;
-    unsigned int                  m_nextActorUID     = 0;
+    struct ActorSlot
+    {
+        Actor*       m_actor      = nullptr;
+        unsigned int m_generation = 0;
+    };
+
+    static constexpr unsigned int MAX_ACTOR_SLOTS      = 0xfffffffeu;   // Index 0xffffffff is reserved for ActorHandle::INVALID.
+    static constexpr unsigned int MAX_ACTOR_GENERATION = 0xfffffffeu;   // A slot whose generation reaches this is retired instead of reused.
+    static constexpr int          ACTOR_BATCH_SIZE     = 64;            // Actors per ParallelFor batch in the update and collision phases.
+    std::vector<ActorSlot>        m_actorSlots;                          // Indexed by ActorHandle::GetIndex().
+    std::vector<unsigned int>     m_freeActorSlots;                      // Slots ready to be reused, most recently freed last.
+    ActorQueryGrid                m_actorQueryGrid;                      // Every actor, for the gameplay queries and the collision broadphase.
+    bool                          m_isActorQueryGridStale = false;       // Actors were spawned or deleted since the last rebuild.
+    ActorPhysicsStore             m_physicsStore;                        // Physics state of every actor, in m_actors order.
+    std::vector<ActorPair>        m_actorPairs;
+    ProjectilePool                m_projectilePool;                      // Projectiles of pooled definitions, never in m_actors.
+    ParticleSystem                m_particleSystem;                      // Cosmetic effects, never in m_actors.
+    AIScheduler                   m_aiScheduler;                         // Which AIs think on each tick.
+    AIPerception                  m_aiPerception;
+    FlowFieldSystem               m_flowFieldSystem;                     // Steering toward the targets AIs chase.
+    HierarchicalPathfinder        m_pathfinder;                          // Point to point paths for long-range goals.
+    SpatialQueryService           m_spatialQueryService;                 // Answers the queries actors ask while thinking.
     PlayerController*             m_playerController = nullptr;
+
+    // Definition and faction
+    std::vector<std::vector<Actor*>> m_definitionActors;  // Live actors of each definition in spawn order, indexed by definition index.
+    std::vector<std::vector<Actor*>> m_factionActors;     // Live actors of each faction in spawn order, indexed by faction index.
+    std::vector<Actor*>              m_garbageActors;     // Scratch for DeleteDestroyedActor.
+    std::vector<int>                 m_dirtyDefinitionIndexes;
+    std::vector<int>                 m_dirtyFactionIndexes;
 };
@@ -0,0 +1,284 @@
+//----------------------------------------------------------------------------------------------------
+// MapGeometryBuilder.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/MapGeometryBuilder.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Definition/TileDefinition.hpp"
+#include "Game/Gameplay/Tile.hpp"
+
+//----------------------------------------------------------------------------------------------------
+MapGeometryBuilder::MapGeometryBuilder(IntVec2 const&            dimensions,
+                                       Tile const*               tiles,
+                                       IntVec2 const&            spriteSheetCellCount,
+                                       std::vector<AABB2> const& spriteUVs)
+    : m_dimensions(dimensions),
+      m_tiles(tiles),
+      m_spriteSheetCellCount(spriteSheetCellCount),
+      m_spriteUVs(&spriteUVs)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC int MapGeometryBuilder::GetChunkCount(IntVec2 const& dimensions)
+{
+    return ((dimensions.x + CHUNK_SIZE - 1) / CHUNK_SIZE) * ((dimensions.y + CHUNK_SIZE - 1) / CHUNK_SIZE);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Chunks are row major over the chunk grid; the last row and column may be smaller than CHUNK_SIZE.
+STATIC void MapGeometryBuilder::GetChunkRegion(IntVec2 const& dimensions,
+                                               int const      chunkIndex,
+                                               IntVec2&       out_tileMins,
+                                               IntVec2&       out_tileMaxs)
+{
+    int const chunkCountX = (dimensions.x + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    out_tileMins = IntVec2((chunkIndex % chunkCountX) * CHUNK_SIZE, (chunkIndex / chunkCountX) * CHUNK_SIZE);
+    out_tileMaxs = IntVec2(std::min(out_tileMins.x + CHUNK_SIZE, dimensions.x), std::min(out_tileMins.y + CHUNK_SIZE, dimensions.y));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same layout as SpriteSheet: sprite 0 is the top left cell and uvs grow up from the bottom left of the texture.
+// Used where there is no texture to build a SpriteSheet from, such as the map compiler.
+STATIC void MapGeometryBuilder::GetSpriteSheetUVs(IntVec2 const&      spriteSheetCellCount,
+                                                  std::vector<AABB2>& out_spriteUVs)
+{
+    out_spriteUVs.clear();
+
+    for (int spriteIndex = 0; spriteIndex < spriteSheetCellCount.x * spriteSheetCellCount.y; ++spriteIndex)
+    {
+        float const column = static_cast<float>(spriteIndex % spriteSheetCellCount.x);
+        float const row    = static_cast<float>(spriteIndex / spriteSheetCellCount.x);
+        float const width  = 1.f / static_cast<float>(spriteSheetCellCount.x);
+        float const height = 1.f / static_cast<float>(spriteSheetCellCount.y);
+
+        out_spriteUVs.emplace_back(Vec2(column * width, 1.f - (row + 1.f) * height), Vec2((column + 1.f) * width, 1.f - row * height));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void MapGeometryBuilder::Build(VertexList_PCUTBN& verts,
+                               IndexList&         indexes) const
+{
+    Build(verts, indexes, IntVec2(0, 0), m_dimensions);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Builds the tiles in [regionMins, regionMaxs). Neighbors outside of the region still hide faces,
+// but quads are never merged across the region's edges.
+void MapGeometryBuilder::Build(VertexList_PCUTBN& verts,
+                               IndexList&         indexes,
+                               IntVec2 const&     regionMins,
+                               IntVec2 const&     regionMaxs) const
+{
+    AddVertsForFloorsOrCeilings(verts, indexes, regionMins, regionMaxs, eMapSurface::FLOOR);
+    AddVertsForFloorsOrCeilings(verts, indexes, regionMins, regionMaxs, eMapSurface::CEILING);
+    AddVertsForWalls(verts, indexes, regionMins, regionMaxs, IntVec2(1, 0));
+    AddVertsForWalls(verts, indexes, regionMins, regionMaxs, IntVec2(-1, 0));
+    AddVertsForWalls(verts, indexes, regionMins, regionMaxs, IntVec2(0, -1));
+    AddVertsForWalls(verts, indexes, regionMins, regionMaxs, IntVec2(0, 1));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same corners and winding as AddVertsForQuad3D. The uvs run from (0, 0) to tileCount,
+// and the sprite's atlas bounds ride along in the tangent (mins) and bitangent (size).
+STATIC void MapGeometryBuilder::AddVertsForTiledQuad3D(VertexList_PCUTBN& verts,
+                                                       IndexList&         indexes,
+                                                       Vec3 const&        bottomLeft,
+                                                       Vec3 const&        bottomRight,
+                                                       Vec3 const&        topLeft,
+                                                       Vec3 const&        topRight,
+                                                       Vec2 const&        tileCount,
+                                                       AABB2 const&       spriteUVs)
+{
+    unsigned int const startIndex = static_cast<unsigned int>(verts.size());
+    Vec3 const         normal     = CrossProduct3D(bottomRight - bottomLeft, topLeft - bottomLeft).GetNormalized();
+    Vec3 const         uvMins     = Vec3(spriteUVs.m_mins.x, spriteUVs.m_mins.y, 0.f);
+    Vec3 const         uvSize     = Vec3(spriteUVs.m_maxs.x - spriteUVs.m_mins.x, spriteUVs.m_maxs.y - spriteUVs.m_mins.y, 0.f);
+
+    verts.emplace_back(bottomLeft, Rgba8::WHITE, Vec2(0.f, 0.f), uvMins, uvSize, normal);
+    verts.emplace_back(bottomRight, Rgba8::WHITE, Vec2(tileCount.x, 0.f), uvMins, uvSize, normal);
+    verts.emplace_back(topRight, Rgba8::WHITE, Vec2(tileCount.x, tileCount.y), uvMins, uvSize, normal);
+    verts.emplace_back(topLeft, Rgba8::WHITE, Vec2(0.f, tileCount.y), uvMins, uvSize, normal);
+
+    indexes.push_back(startIndex);
+    indexes.push_back(startIndex + 1);
+    indexes.push_back(startIndex + 2);
+    indexes.push_back(startIndex);
+    indexes.push_back(startIndex + 2);
+    indexes.push_back(startIndex + 3);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Anything outside of the map is open, like Map::IsTileSolid, so the outer faces of border walls are kept.
+bool MapGeometryBuilder::IsTileSolid(int const x,
+                                     int const y) const
+{
+    if (x < 0 || y < 0 || x >= m_dimensions.x || y >= m_dimensions.y) return false;
+
+    return m_tiles[x + y * m_dimensions.x].IsSolid();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns -1 when the tile has no face of that kind: solid tiles only have walls, open tiles only floors and ceilings.
+int MapGeometryBuilder::GetSpriteIndex(int const         x,
+                                       int const         y,
+                                       eMapSurface const surface) const
+{
+    TileDefinition const* tileDef = m_tiles[x + y * m_dimensions.x].GetDefinition();
+
+    if (tileDef == nullptr) return -1;
+    if (tileDef->m_isSolid != (surface == eMapSurface::WALL)) return -1;
+
+    IntVec2 const spriteCoords = surface == eMapSurface::FLOOR   ? tileDef->m_floorSpriteCoords :
+                                 surface == eMapSurface::CEILING ? tileDef->m_ceilingSpriteCoords :
+                                                                   tileDef->m_wallSpriteCoords;
+
+    return spriteCoords.x + spriteCoords.y * m_spriteSheetCellCount.x;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Greedy rectangles: grow each uncovered tile as wide as the row allows, then as tall as every row below it matches.
+void MapGeometryBuilder::AddVertsForFloorsOrCeilings(VertexList_PCUTBN& verts,
+                                                     IndexList&         indexes,
+                                                     IntVec2 const&     regionMins,
+                                                     IntVec2 const&     regionMaxs,
+                                                     eMapSurface const  surface) const
+{
+    int const         regionWidth = regionMaxs.x - regionMins.x;
+    std::vector<bool> isCovered(static_cast<size_t>(regionWidth * (regionMaxs.y - regionMins.y)), false);
+
+    auto const IsMergeable = [&](int const x, int const y, int const spriteIndex)
+    {
+        return
+            !isCovered[(x - regionMins.x) + (y - regionMins.y) * regionWidth] &&
+            GetSpriteIndex(x, y, surface) == spriteIndex;
+    };
+
+    for (int y = regionMins.y; y < regionMaxs.y; ++y)
+    {
+        for (int x = regionMins.x; x < regionMaxs.x; ++x)
+        {
+            if (isCovered[(x - regionMins.x) + (y - regionMins.y) * regionWidth]) continue;
+
+            int const spriteIndex = GetSpriteIndex(x, y, surface);
+
+            if (spriteIndex < 0) continue;
+
+            int width  = 1;
+            int height = 1;
+
+            if (m_mergeFaces)
+            {
+                while (x + width < regionMaxs.x && IsMergeable(x + width, y, spriteIndex))
+                {
+                    ++width;
+                }
+
+                while (y + height < regionMaxs.y)
+                {
+                    bool isRowMergeable = true;
+
+                    for (int offsetX = 0; offsetX < width && isRowMergeable; ++offsetX)
+                    {
+                        isRowMergeable = IsMergeable(x + offsetX, y + height, spriteIndex);
+                    }
+
+                    if (!isRowMergeable) break;
+
+                    ++height;
+                }
+            }
+
+            for (int coveredY = y; coveredY < y + height; ++coveredY)
+            {
+                for (int coveredX = x; coveredX < x + width; ++coveredX)
+                {
+                    isCovered[(coveredX - regionMins.x) + (coveredY - regionMins.y) * regionWidth] = true;
+                }
+            }
+
+            float const minX      = static_cast<float>(x);
+            float const maxX      = static_cast<float>(x + width);
+            float const minY      = static_cast<float>(y);
+            float const maxY      = static_cast<float>(y + height);
+            Vec2 const  tileCount = Vec2(static_cast<float>(height), static_cast<float>(width));
+            AABB2 const uvs       = (*m_spriteUVs)[spriteIndex];
+
+            if (surface == eMapSurface::FLOOR)
+            {
+                AddVertsForTiledQuad3D(verts, indexes, Vec3(minX, maxY, 0.f), Vec3(minX, minY, 0.f), Vec3(maxX, maxY, 0.f), Vec3(maxX, minY, 0.f), tileCount, uvs);
+            }
+            else
+            {
+                AddVertsForTiledQuad3D(verts, indexes, Vec3(minX, minY, 1.f), Vec3(minX, maxY, 1.f), Vec3(maxX, minY, 1.f), Vec3(maxX, maxY, 1.f), tileCount, uvs);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walls are one tile tall, so merging is one dimensional: every row (or column) of faces pointing in faceDirection
+// is split into runs of visible faces with the same sprite.
+void MapGeometryBuilder::AddVertsForWalls(VertexList_PCUTBN& verts,
+                                          IndexList&         indexes,
+                                          IntVec2 const&     regionMins,
+                                          IntVec2 const&     regionMaxs,
+                                          IntVec2 const&     faceDirection) const
+{
+    bool const isRunAlongY = faceDirection.x != 0;
+    bool const isReversed  = faceDirection.x < 0 || faceDirection.y > 0;      // Keeps "right" of the face consistent with the per-tile quads.
+    int const  lineMin     = isRunAlongY ? regionMins.x : regionMins.y;
+    int const  lineMax     = isRunAlongY ? regionMaxs.x : regionMaxs.y;
+    int const  runMin      = isRunAlongY ? regionMins.y : regionMins.x;
+    int const  runMax      = isRunAlongY ? regionMaxs.y : regionMaxs.x;
+
+    for (int line = lineMin; line < lineMax; ++line)
+    {
+        auto const GetVisibleSpriteIndex = [&](int const run)
+        {
+            IntVec2 const tileCoords = isRunAlongY ? IntVec2(line, run) : IntVec2(run, line);
+
+            if (!IsTileSolid(tileCoords.x, tileCoords.y)) return -1;
+            if (m_cullHiddenFaces && IsTileSolid(tileCoords.x + faceDirection.x, tileCoords.y + faceDirection.y)) return -1;
+
+            return GetSpriteIndex(tileCoords.x, tileCoords.y, eMapSurface::WALL);
+        };
+
+        for (int run = runMin; run < runMax;)
+        {
+            int const spriteIndex = GetVisibleSpriteIndex(run);
+
+            if (spriteIndex < 0)
+            {
+                ++run;
+                continue;
+            }
+
+            int runEnd = run + 1;
+
+            while (m_mergeFaces && runEnd < runMax && GetVisibleSpriteIndex(runEnd) == spriteIndex)
+            {
+                ++runEnd;
+            }
+
+            float const facePlane   = static_cast<float>(faceDirection.x + faceDirection.y > 0 ? line + 1 : line);
+            float const runFrom     = static_cast<float>(isReversed ? runEnd : run);
+            float const runTo       = static_cast<float>(isReversed ? run : runEnd);
+            Vec3 const  bottomLeft  = isRunAlongY ? Vec3(facePlane, runFrom, 0.f) : Vec3(runFrom, facePlane, 0.f);
+            Vec3 const  bottomRight = isRunAlongY ? Vec3(facePlane, runTo, 0.f) : Vec3(runTo, facePlane, 0.f);
+            Vec3 const  up          = Vec3(0.f, 0.f, 1.f);
+
+            AddVertsForTiledQuad3D(verts, indexes, bottomLeft, bottomRight, bottomLeft + up, bottomRight + up, Vec2(static_cast<float>(runEnd - run), 1.f), (*m_spriteUVs)[spriteIndex]);
+
+            run = runEnd;
+        }
+    }
+}
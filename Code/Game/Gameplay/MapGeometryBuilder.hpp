@@ -0,0 +1,62 @@
+//----------------------------------------------------------------------------------------------------
+// MapGeometryBuilder.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct Tile;
+
+//----------------------------------------------------------------------------------------------------
+enum class eMapSurface : int8_t
+{
+    FLOOR,
+    CEILING,
+    WALL
+};
+
+//----------------------------------------------------------------------------------------------------
+// Builds the static geometry of a tile grid.
+// Wall faces shared with a solid neighbor are never visible and are skipped, and coplanar faces that show the same
+// sprite are merged greedily into one quad: runs along a row or column for walls, rectangles for floors and ceilings.
+// A merged quad has uvs in tile units, so the sprite repeats once per tile; since an atlas cell cannot be repeated
+// by the sampler, every vertex also carries its cell's uv mins in the tangent and uv size in the bitangent,
+// and Data/Shaders/Map wraps the uv into the cell.
+class MapGeometryBuilder
+{
+public:
+    MapGeometryBuilder(IntVec2 const& dimensions, Tile const* tiles, IntVec2 const& spriteSheetCellCount, std::vector<AABB2> const& spriteUVs);
+
+    static constexpr int CHUNK_SIZE = 16;        // Tiles along each side of a map chunk.
+
+    static int  GetChunkCount(IntVec2 const& dimensions);
+    static void GetChunkRegion(IntVec2 const& dimensions, int chunkIndex, IntVec2& out_tileMins, IntVec2& out_tileMaxs);
+    static void GetSpriteSheetUVs(IntVec2 const& spriteSheetCellCount, std::vector<AABB2>& out_spriteUVs);
+
+    void Build(VertexList_PCUTBN& verts, IndexList& indexes) const;
+    void Build(VertexList_PCUTBN& verts, IndexList& indexes, IntVec2 const& regionMins, IntVec2 const& regionMaxs) const;
+
+    static void AddVertsForTiledQuad3D(VertexList_PCUTBN& verts, IndexList& indexes, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topLeft, Vec3 const& topRight, Vec2 const& tileCount, AABB2 const& spriteUVs);
+
+    bool m_cullHiddenFaces = true;      // Skip wall faces that touch another solid tile.
+    bool m_mergeFaces      = true;      // Merge neighboring faces with the same sprite into one quad.
+
+private:
+    bool IsTileSolid(int x, int y) const;
+    int  GetSpriteIndex(int x, int y, eMapSurface surface) const;
+    void AddVertsForFloorsOrCeilings(VertexList_PCUTBN& verts, IndexList& indexes, IntVec2 const& regionMins, IntVec2 const& regionMaxs, eMapSurface surface) const;
+    void AddVertsForWalls(VertexList_PCUTBN& verts, IndexList& indexes, IntVec2 const& regionMins, IntVec2 const& regionMaxs, IntVec2 const& faceDirection) const;
+
+    IntVec2                   m_dimensions;
+    Tile const*               m_tiles = nullptr;
+    IntVec2                   m_spriteSheetCellCount;
+    std::vector<AABB2> const* m_spriteUVs = nullptr;     // Indexed by sprite index, x + y * m_spriteSheetCellCount.x.
+};
@@ -0,0 +1,212 @@
+//----------------------------------------------------------------------------------------------------
+// ParticleSystem.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/ParticleSystem.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/SpriteSheet.hpp"
+#include "Game/Definition/EffectDefinition.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/PlayerController.hpp"
+#include "Game/Gameplay/Game.hpp"
+
+//----------------------------------------------------------------------------------------------------
+ParticleSystem::ParticleSystem(int const capacity)
+    : m_capacity(std::max(capacity, 1))
+{
+    m_positionX.resize(m_capacity);
+    m_positionY.resize(m_capacity);
+    m_positionZ.resize(m_capacity);
+    m_velocityX.resize(m_capacity);
+    m_velocityY.resize(m_capacity);
+    m_velocityZ.resize(m_capacity);
+    m_gravities.resize(m_capacity);
+    m_ageSeconds.resize(m_capacity);
+    m_lifetimes.resize(m_capacity);
+    m_effectIndexes.resize(m_capacity);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Each particle flies off in a random direction at a roll of the effect's speed.
+void ParticleSystem::SpawnEffect(int const   effectIndex,
+                                 Vec3 const& position)
+{
+    if (effectIndex < 0 || effectIndex >= static_cast<int>(EffectDefinition::s_effectDefinitions.size())) return;
+
+    EffectDefinition const* definition = EffectDefinition::s_effectDefinitions[effectIndex];
+
+    for (int i = 0; i < definition->m_particleCount; ++i)
+    {
+        if (m_count == m_capacity)
+        {
+            m_oldest = (m_oldest + 1) % m_capacity;
+            --m_count;
+        }
+
+        int const   slot         = GetSlot(m_count);
+        float const yawDegrees   = g_theRNG->RollRandomFloatInRange(0.f, 360.f);
+        float const pitchDegrees = g_theRNG->RollRandomFloatInRange(-90.f, 90.f);
+        float const speed        = g_theRNG->RollRandomFloatInRange(definition->m_speed.m_min, definition->m_speed.m_max);
+
+        m_positionX[slot]     = position.x;
+        m_positionY[slot]     = position.y;
+        m_positionZ[slot]     = position.z;
+        m_velocityX[slot]     = CosDegrees(pitchDegrees) * CosDegrees(yawDegrees) * speed;
+        m_velocityY[slot]     = CosDegrees(pitchDegrees) * SinDegrees(yawDegrees) * speed;
+        m_velocityZ[slot]     = SinDegrees(pitchDegrees) * speed;
+        m_gravities[slot]     = definition->m_gravity;
+        m_ageSeconds[slot]    = 0.f;
+        m_lifetimes[slot]     = definition->m_lifetime;
+        m_effectIndexes[slot] = effectIndex;
+
+        ++m_count;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Particles are retired from the oldest end only, so one that outlives younger ones keeps them in the ring
+// a little longer; Render skips every particle past its lifetime.
+void ParticleSystem::Update(float const deltaSeconds)
+{
+    int const firstEnd = std::min(m_oldest + m_count, m_capacity);
+
+    UpdateSpan(m_oldest, firstEnd, deltaSeconds);
+    UpdateSpan(0, m_count - (firstEnd - m_oldest), deltaSeconds);
+
+    while (m_count > 0 && m_ageSeconds[m_oldest] >= m_lifetimes[m_oldest])
+    {
+        m_oldest = (m_oldest + 1) % m_capacity;
+        --m_count;
+    }
+
+    if (m_count == 0)
+    {
+        m_oldest = 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Each particle is drawn where it was partway through the last tick, like actors are.
+void ParticleSystem::Render(PlayerController const* toPlayer) const
+{
+    if (m_count == 0) return;
+
+    Mat44 const cameraToWorld = toPlayer->m_worldCamera->GetCameraToWorldTransform();
+    float const rewindSeconds = (1.f - g_theGame->GetSimulationAlpha()) * g_theGame->GetFixedDeltaSeconds();
+
+    m_batchVertexes.resize(EffectDefinition::s_batchDefinitions.size());
+
+    for (VertexList_PCU& vertexes : m_batchVertexes)
+    {
+        vertexes.clear();
+    }
+
+    for (int particleIndex = 0; particleIndex < m_count; ++particleIndex)
+    {
+        int const slot = GetSlot(particleIndex);
+
+        if (m_ageSeconds[slot] >= m_lifetimes[slot]) continue;
+
+        EffectDefinition const* definition = EffectDefinition::s_effectDefinitions[m_effectIndexes[slot]];
+        int const               frame      = std::min(definition->m_startFrame + static_cast<int>(m_ageSeconds[slot] / definition->m_secondsPerFrame), definition->m_endFrame);
+        AABB2 const             uvs        = definition->m_spriteSheet->GetSpriteDef(frame).GetUVs();
+        Vec3 const              position   = Vec3(m_positionX[slot] - m_velocityX[slot] * rewindSeconds,
+                                                  m_positionY[slot] - m_velocityY[slot] * rewindSeconds,
+                                                  m_positionZ[slot] - m_velocityZ[slot] * rewindSeconds);
+        Mat44 const             billboard  = GetBillboardMatrix(definition->m_billboardType, cameraToWorld, position);
+        Vec2 const              halfSize   = definition->m_size * 0.5f;
+
+        AddVertsForQuad3D(m_batchVertexes[definition->m_batchIndex],
+                          billboard.TransformPosition3D(Vec3(0.f, -halfSize.x, -halfSize.y)),
+                          billboard.TransformPosition3D(Vec3(0.f, halfSize.x, -halfSize.y)),
+                          billboard.TransformPosition3D(Vec3(0.f, -halfSize.x, halfSize.y)),
+                          billboard.TransformPosition3D(Vec3(0.f, halfSize.x, halfSize.y)),
+                          Rgba8::WHITE, uvs);
+    }
+
+    g_theRenderer->SetModelConstants();
+    g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
+    g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
+    g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_NONE);
+    g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
+
+    for (int batchIndex = 0; batchIndex < static_cast<int>(m_batchVertexes.size()); ++batchIndex)
+    {
+        if (m_batchVertexes[batchIndex].empty()) continue;
+
+        EffectDefinition const* definition = EffectDefinition::s_batchDefinitions[batchIndex];
+
+        g_theRenderer->BindShader(definition->m_shader);
+        g_theRenderer->BindTexture(&definition->m_spriteSheet->GetTexture());
+        g_theRenderer->DrawVertexArray(m_batchVertexes[batchIndex]);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ParticleSystem::Clear()
+{
+    m_oldest = 0;
+    m_count  = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ParticleSystem::GetCount() const
+{
+    return m_count;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ParticleSystem::GetCapacity() const
+{
+    return m_capacity;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Particles stop at the floor; nothing else in the map affects them.
+// The arrays never alias, which lets the compiler vectorize the loop.
+void ParticleSystem::UpdateSpan(int const   begin,
+                                int const   end,
+                                float const deltaSeconds)
+{
+    float* __restrict positionX  = m_positionX.data();
+    float* __restrict positionY  = m_positionY.data();
+    float* __restrict positionZ  = m_positionZ.data();
+    float* __restrict velocityX  = m_velocityX.data();
+    float* __restrict velocityY  = m_velocityY.data();
+    float* __restrict velocityZ  = m_velocityZ.data();
+    float const* __restrict gravities = m_gravities.data();
+    float* __restrict ageSeconds = m_ageSeconds.data();
+
+    for (int i = begin; i < end; ++i)
+    {
+        velocityZ[i] -= gravities[i] * deltaSeconds;
+        positionX[i] += velocityX[i] * deltaSeconds;
+        positionY[i] += velocityY[i] * deltaSeconds;
+        float const z = positionZ[i] + velocityZ[i] * deltaSeconds;
+
+        // On the floor the particle stops, so it neither slides along the floor forever nor has Render rewind it along
+        // a velocity it never moved by.
+        bool const isOnFloor = z <= 0.f;
+        positionZ[i] = std::max(z, 0.f);
+        velocityX[i] = isOnFloor ? 0.f : velocityX[i];
+        velocityY[i] = isOnFloor ? 0.f : velocityY[i];
+        velocityZ[i] = isOnFloor ? 0.f : velocityZ[i];
+        ageSeconds[i] += deltaSeconds;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int ParticleSystem::GetSlot(int const particleIndex) const
+{
+    int const slot = m_oldest + particleIndex;
+
+    return slot < m_capacity ? slot : slot - m_capacity;
+}
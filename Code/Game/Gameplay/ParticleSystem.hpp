@@ -0,0 +1,54 @@
+//----------------------------------------------------------------------------------------------------
+// ParticleSystem.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class PlayerController;
+
+//----------------------------------------------------------------------------------------------------
+// Cosmetic particles of EffectDefinitions, which never touch the actor list, its handles or collision.
+// Particles live in a ring buffer of per-component arrays allocated once to the capacity; spawning past it
+// overwrites the oldest particles. The live particles are one or two contiguous spans of the ring, which Update
+// walks with branch-free loops the compiler can vectorize. Render buckets every particle into one vertex batch
+// per sprite sheet, see EffectDefinition::m_batchIndex.
+class ParticleSystem
+{
+public:
+    explicit ParticleSystem(int capacity);
+
+    void SpawnEffect(int effectIndex, Vec3 const& position);
+    void Update(float deltaSeconds);
+    void Render(PlayerController const* toPlayer) const;
+    void Clear();
+
+    int GetCount() const;
+    int GetCapacity() const;
+
+private:
+    void UpdateSpan(int begin, int end, float deltaSeconds);
+    int  GetSlot(int particleIndex) const;
+
+    int                m_capacity = 0;
+    int                m_oldest   = 0;      // Slot of the oldest live particle.
+    int                m_count    = 0;
+    std::vector<float> m_positionX;
+    std::vector<float> m_positionY;
+    std::vector<float> m_positionZ;
+    std::vector<float> m_velocityX;
+    std::vector<float> m_velocityY;
+    std::vector<float> m_velocityZ;
+    std::vector<float> m_gravities;
+    std::vector<float> m_ageSeconds;
+    std::vector<float> m_lifetimes;
+    std::vector<int>   m_effectIndexes;    // Into EffectDefinition::s_effectDefinitions.
+
+    mutable std::vector<VertexList_PCU> m_batchVertexes;   // Reused by Render, indexed by batch.
+};
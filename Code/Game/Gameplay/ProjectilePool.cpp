@@ -0,0 +1,305 @@
+//----------------------------------------------------------------------------------------------------
+// ProjectilePool.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/ProjectilePool.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Framework/AnimationGroup.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/PlayerController.hpp"
+#include "Game/Gameplay/Actor.hpp"
+#include "Game/Gameplay/ActorQueryGrid.hpp"
+#include "Game/Gameplay/Game.hpp"
+#include "Game/Gameplay/Map.hpp"
+
+//----------------------------------------------------------------------------------------------------
+ProjectilePool::ProjectilePool(int const capacity)
+    : m_capacity(std::max(capacity, 0))
+{
+    m_positions.reserve(m_capacity);
+    m_velocities.reserve(m_capacity);
+    m_owners.reserve(m_capacity);
+    m_definitionIndexes.reserve(m_capacity);
+    m_secondsLeft.reserve(m_capacity);
+    m_ageSeconds.reserve(m_capacity);
+    m_isDying.reserve(m_capacity);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns false, dropping the shot, when the pool is full or the definition is not a pooled projectile.
+bool ProjectilePool::Spawn(int const          definitionIndex,
+                           Vec3 const&        position,
+                           Vec3 const&        velocity,
+                           ActorHandle const& owner)
+{
+    if (GetCount() >= m_capacity) return false;
+    if (definitionIndex < 0 || definitionIndex >= static_cast<int>(ActorDefinition::s_actorDefinitions.size())) return false;
+
+    ActorDefinition const* definition = ActorDefinition::s_actorDefinitions[definitionIndex];
+
+    if (!definition->m_isPooledProjectile) return false;
+
+    m_positions.push_back(position);
+    m_velocities.push_back(velocity);
+    m_owners.push_back(owner);
+    m_definitionIndexes.push_back(definitionIndex);
+    m_secondsLeft.push_back(definition->m_projectileLifetime);
+    m_ageSeconds.push_back(0.f);
+    m_isDying.push_back(0);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs after the actors have moved and collided, once actorQueryGrid holds where they ended up.
+void ProjectilePool::Update(float const           deltaSeconds,
+                            Map const&            map,
+                            ActorQueryGrid const& actorQueryGrid)
+{
+    Move(deltaSeconds);
+
+    for (int projectileIndex = 0; projectileIndex < GetCount();)
+    {
+        if (m_secondsLeft[projectileIndex] <= 0.f)
+        {
+            Remove(projectileIndex);
+            continue;
+        }
+
+        ++projectileIndex;
+    }
+
+    Collide(map, actorQueryGrid);
+}
+
+//----------------------------------------------------------------------------------------------------
+// One batch per definition. Each projectile is drawn where it was partway through the last tick, like actors are,
+// which needs no extra state since it moves in a straight line.
+void ProjectilePool::Render(PlayerController const* toPlayer) const
+{
+    if (GetCount() == 0) return;
+
+    Mat44 const cameraToWorld = toPlayer->m_worldCamera->GetCameraToWorldTransform();
+    float const rewindSeconds = (1.f - g_theGame->GetSimulationAlpha()) * g_theGame->GetFixedDeltaSeconds();
+
+    for (int definitionIndex = 0; definitionIndex < static_cast<int>(ActorDefinition::s_actorDefinitions.size()); ++definitionIndex)
+    {
+        ActorDefinition* definition = ActorDefinition::s_actorDefinitions[definitionIndex];
+
+        if (!definition->m_isPooledProjectile || !definition->m_isVisible) continue;
+        if (definition->m_animationGroup.empty()) continue;
+
+        AnimationGroup const* flyingGroup = definition->GetAnimationGroupByNameID(NameTable::WALK);
+        AnimationGroup const* dyingGroup  = definition->GetAnimationGroupByNameID(NameTable::DEATH);
+        if (flyingGroup == nullptr) flyingGroup = &definition->m_animationGroup[0];
+        if (dyingGroup == nullptr) dyingGroup = flyingGroup;
+
+        Vec2 const spriteOffSet = -definition->m_size * definition->m_pivot;
+        Vec3 const bottomLeft   = Vec3(0.f, spriteOffSet.x, spriteOffSet.y);
+        Vec3 const bottomRight  = bottomLeft + Vec3(0.f, definition->m_size.x, 0.f);
+        Vec3 const topLeft      = bottomLeft + Vec3(0.f, 0.f, definition->m_size.y);
+        Vec3 const topRight     = bottomRight + Vec3(0.f, 0.f, definition->m_size.y);
+
+        Texture const* texture = nullptr;
+        m_vertexes.clear();
+
+        for (int projectileIndex = 0; projectileIndex < GetCount(); ++projectileIndex)
+        {
+            if (m_definitionIndexes[projectileIndex] != definitionIndex) continue;
+
+            AnimationGroup const* group          = m_isDying[projectileIndex] ? dyingGroup : flyingGroup;
+            AABB2 const&          uvs            = group->GetSpriteUVs(Vec3::X_BASIS, m_ageSeconds[projectileIndex]);
+            Vec3 const            renderPosition = m_positions[projectileIndex] - m_velocities[projectileIndex] * rewindSeconds;
+            Mat44                 localToWorld   = Mat44::MakeTranslation3D(renderPosition);
+
+            if (definition->m_billboardType != eBillboardType::NONE)
+            {
+                localToWorld = GetBillboardMatrix(definition->m_billboardType, cameraToWorld, renderPosition);
+            }
+
+            AddVertsForQuad3D(m_vertexes,
+                              localToWorld.TransformPosition3D(bottomLeft),
+                              localToWorld.TransformPosition3D(bottomRight),
+                              localToWorld.TransformPosition3D(topLeft),
+                              localToWorld.TransformPosition3D(topRight),
+                              Rgba8::WHITE, uvs);
+
+            texture = group->GetTexture();
+        }
+
+        if (m_vertexes.empty()) continue;
+
+        g_theRenderer->SetModelConstants();
+        g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
+        g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
+        g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_NONE);
+        g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
+        g_theRenderer->BindShader(definition->m_shader);
+        g_theRenderer->BindTexture(texture);
+        g_theRenderer->DrawVertexArray(m_vertexes);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ProjectilePool::Clear()
+{
+    m_positions.clear();
+    m_velocities.clear();
+    m_owners.clear();
+    m_definitionIndexes.clear();
+    m_secondsLeft.clear();
+    m_ageSeconds.clear();
+    m_isDying.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+int ProjectilePool::GetCount() const
+{
+    return static_cast<int>(m_positions.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int ProjectilePool::GetCapacity() const
+{
+    return m_capacity;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ProjectilePool::IsDying(int const projectileIndex) const
+{
+    return m_isDying[projectileIndex] != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 ProjectilePool::GetPosition(int const projectileIndex) const
+{
+    return m_positions[projectileIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+// No drag and no forces, so every array is walked once in a straight loop.
+void ProjectilePool::Move(float const deltaSeconds)
+{
+    int const count = GetCount();
+
+    for (int i = 0; i < count; ++i)
+    {
+        m_positions[i] += m_velocities[i] * deltaSeconds;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        m_secondsLeft[i] -= deltaSeconds;
+        m_ageSeconds[i] += deltaSeconds;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// The world test samples the tile under the projectile's leading edge, which is enough as long as a projectile
+// moves less than its radius per tick. Against actors, the lowest actor index wins when several are touched;
+// dead actors and projectile actors are passed through, as in Actor::OnCollisionEnterWithActor.
+void ProjectilePool::Collide(Map const&            map,
+                             ActorQueryGrid const& actorQueryGrid)
+{
+    int const count = GetCount();
+
+    for (int projectileIndex = 0; projectileIndex < count; ++projectileIndex)
+    {
+        if (m_isDying[projectileIndex]) continue;
+
+        ActorDefinition const* definition = ActorDefinition::s_actorDefinitions[m_definitionIndexes[projectileIndex]];
+        Vec3 const&            position   = m_positions[projectileIndex];
+        Vec3 const&            velocity   = m_velocities[projectileIndex];
+        float const            radius     = definition->m_radius;
+
+        if (definition->m_collidesWithWorld)
+        {
+            Vec3 const leadingEdge = Vec3(position.x + (velocity.x < 0.f ? -radius : radius),
+                                          position.y + (velocity.y < 0.f ? -radius : radius),
+                                          position.z);
+
+            if (!map.IsPositionInBounds(position) ||
+                position.z < 0.f || position.z + definition->m_height > 1.f ||
+                map.IsTileSolid(map.GetTileCoordsFromWorldPos(leadingEdge)))
+            {
+                Kill(projectileIndex);
+                continue;
+            }
+        }
+
+        if (!definition->m_collidesWithActors) continue;
+
+        actorQueryGrid.QueryBounds(Vec2(position.x - radius, position.y - radius), Vec2(position.x + radius, position.y + radius), m_candidateActors);
+
+        Actor* hitActor = nullptr;
+
+        for (Actor* actor : m_candidateActors)
+        {
+            if (!ActorQueryGrid::IsCollidableWithActors(actor) || actor->m_owner != nullptr) continue;
+            if (actor->m_handle == m_owners[projectileIndex]) continue;
+            if (hitActor != nullptr && actor->m_physicsIndex > hitActor->m_physicsIndex) continue;
+
+            Vec3 const actorPosition = actor->GetPosition();
+
+            if (position.z > actorPosition.z + actor->GetHeight() || position.z + definition->m_height < actorPosition.z) continue;
+            if (!DoDiscsOverlap2D(Vec2(position.x, position.y), radius, Vec2(actorPosition.x, actorPosition.y), actor->GetRadius())) continue;
+
+            hitActor = actor;
+        }
+
+        if (hitActor == nullptr) continue;
+
+        int const damage   = static_cast<int>(g_theRNG->RollRandomFloatInRange(definition->m_damageOnCollide.m_min, definition->m_damageOnCollide.m_max));
+        hitActor->Damage(damage, m_owners[projectileIndex]);
+        hitActor->AddImpulse(definition->m_impulseOnCollide * velocity.GetNormalized());
+
+        Kill(projectileIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Stops the projectile where it is and plays out its death animation for the definition's corpse lifetime.
+void ProjectilePool::Kill(int const projectileIndex)
+{
+    ActorDefinition const* definition = ActorDefinition::s_actorDefinitions[m_definitionIndexes[projectileIndex]];
+
+    m_velocities[projectileIndex]  = Vec3::ZERO;
+    m_secondsLeft[projectileIndex] = definition->m_corpseLifetime;
+    m_ageSeconds[projectileIndex]  = 0.f;
+    m_isDying[projectileIndex]     = 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ProjectilePool::Remove(int const projectileIndex)
+{
+    int const lastIndex = GetCount() - 1;
+
+    if (projectileIndex != lastIndex)
+    {
+        m_positions[projectileIndex]         = m_positions[lastIndex];
+        m_velocities[projectileIndex]        = m_velocities[lastIndex];
+        m_owners[projectileIndex]            = m_owners[lastIndex];
+        m_definitionIndexes[projectileIndex] = m_definitionIndexes[lastIndex];
+        m_secondsLeft[projectileIndex]       = m_secondsLeft[lastIndex];
+        m_ageSeconds[projectileIndex]        = m_ageSeconds[lastIndex];
+        m_isDying[projectileIndex]           = m_isDying[lastIndex];
+    }
+
+    m_positions.pop_back();
+    m_velocities.pop_back();
+    m_owners.pop_back();
+    m_definitionIndexes.pop_back();
+    m_secondsLeft.pop_back();
+    m_ageSeconds.pop_back();
+    m_isDying.pop_back();
+}
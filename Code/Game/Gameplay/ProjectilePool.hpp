@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------------------------------------
+// ProjectilePool.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Game/Framework/ActorHandle.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+class ActorQueryGrid;
+class Map;
+class PlayerController;
+
+//----------------------------------------------------------------------------------------------------
+// Projectiles of actor definitions with a <Projectile> element, kept out of the actor list.
+// A projectile only flies straight, hits the first tile or actor it touches and plays its death animation,
+// so it is a row in a set of parallel arrays instead of an Actor with its controller, timers and weapons.
+// Every array is reserved to the capacity up front, so spawning never allocates; a full pool drops the shot.
+// Removal swaps the last projectile into the hole, so the arrays stay dense for the update loop.
+class ProjectilePool
+{
+public:
+    explicit ProjectilePool(int capacity);
+
+    bool Spawn(int definitionIndex, Vec3 const& position, Vec3 const& velocity, ActorHandle const& owner);
+    void Update(float deltaSeconds, Map const& map, ActorQueryGrid const& actorQueryGrid);
+    void Render(PlayerController const* toPlayer) const;
+    void Clear();
+
+    int  GetCount() const;
+    int  GetCapacity() const;
+    bool IsDying(int projectileIndex) const;
+    Vec3 GetPosition(int projectileIndex) const;
+
+private:
+    void Move(float deltaSeconds);
+    void Collide(Map const& map, ActorQueryGrid const& actorQueryGrid);
+    void Kill(int projectileIndex);
+    void Remove(int projectileIndex);
+
+    int                      m_capacity = 0;
+    std::vector<Vec3>        m_positions;
+    std::vector<Vec3>        m_velocities;
+    std::vector<ActorHandle> m_owners;                  // Never hit by their own projectiles.
+    std::vector<int>         m_definitionIndexes;       // Into ActorDefinition::s_actorDefinitions.
+    std::vector<float>       m_secondsLeft;             // Flight time left, or the rest of the death animation once dying.
+    std::vector<float>       m_ageSeconds;              // Since spawning, or since dying; drives the sprite animation.
+    std::vector<uint8_t>     m_isDying;                 // Stopped after a hit, only playing the "Death" animation.
+    std::vector<Actor*>      m_candidateActors;         // Scratch for the broadphase query.
+    mutable VertexList_PCU   m_vertexes;                // Reused by Render, one batch per definition.
+};
@@ -0,0 +1,298 @@
+//----------------------------------------------------------------------------------------------------
+// RayPacket.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/RayPacket.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <emmintrin.h>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include "Game/Gameplay/Actor.hpp"
+#include "Game/Gameplay/ActorQueryGrid.hpp"
+#include "Game/Gameplay/Map.hpp"
+#include "Game/Gameplay/Tile.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Actor cylinders near the current packet, one array per component so a cylinder's values broadcast straight into lanes.
+// Per thread, since the AI casts from every worker at once.
+struct PacketCylinders
+{
+    std::vector<float>        m_centerX;
+    std::vector<float>        m_centerY;
+    std::vector<float>        m_radius;
+    std::vector<float>        m_minZ;
+    std::vector<float>        m_maxZ;
+    std::vector<Actor const*> m_actors;
+    std::vector<Actor*>       m_candidates;     // Scratch for the grid query.
+
+    void Clear()
+    {
+        m_centerX.clear();
+        m_centerY.clear();
+        m_radius.clear();
+        m_minZ.clear();
+        m_maxZ.clear();
+        m_actors.clear();
+    }
+};
+
+static thread_local PacketCylinders s_cylinders;
+
+//----------------------------------------------------------------------------------------------------
+STATIC void RayPacket::Cast(Map const&      map,
+                            Actor const*    ignoredActor,
+                            BatchRay const* rays,
+                            int const       rayCount,
+                            BatchRayResult* out_results)
+{
+    for (int packetStart = 0; packetStart < rayCount; packetStart += LANE_COUNT)
+    {
+        int const laneCount = std::min(LANE_COUNT, rayCount - packetStart);
+        float     closestLengths[LANE_COUNT];
+        int       cylinderIndexes[LANE_COUNT];
+        Vec2      boundsMins = Vec2(FLT_MAX, FLT_MAX);
+        Vec2      boundsMaxs = Vec2(-FLT_MAX, -FLT_MAX);
+
+        // 1. Clip every ray to the world, and bound what is left of them.
+        for (int lane = 0; lane < laneCount; ++lane)
+        {
+            BatchRay const& ray = rays[packetStart + lane];
+            CastWorld(map, ray, out_results[packetStart + lane], closestLengths[lane]);
+
+            if (closestLengths[lane] < 0.f) continue;
+
+            Vec3 const endPosition = ray.m_startPosition + ray.m_forwardNormal * closestLengths[lane];
+            boundsMins.x           = std::min(boundsMins.x, std::min(ray.m_startPosition.x, endPosition.x));
+            boundsMins.y           = std::min(boundsMins.y, std::min(ray.m_startPosition.y, endPosition.y));
+            boundsMaxs.x           = std::max(boundsMaxs.x, std::max(ray.m_startPosition.x, endPosition.x));
+            boundsMaxs.y           = std::max(boundsMaxs.y, std::max(ray.m_startPosition.y, endPosition.y));
+        }
+
+        if (boundsMins.x > boundsMaxs.x) continue;
+
+        // 2. Find each ray's closest cylinder closer than its world hit.
+        GatherCylinders(map, ignoredActor, boundsMins, boundsMaxs);
+
+        if (s_cylinders.m_actors.empty()) continue;
+
+        FindClosestCylinders(rays + packetStart, laneCount, closestLengths, cylinderIndexes);
+
+        // 3. Fill in the impact details of the rays that hit an actor.
+        for (int lane = 0; lane < laneCount; ++lane)
+        {
+            if (cylinderIndexes[lane] < 0) continue;
+
+            BatchRay const&       ray         = rays[packetStart + lane];
+            Actor const*          actor       = s_cylinders.m_actors[cylinderIndexes[lane]];
+            Cylinder3 const       cylinder3   = map.GetPhysicsStore().GetCollisionCylinder(actor->m_physicsIndex);
+            RaycastResult3D const actorResult = RaycastVsCylinderZ3D(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength,
+                                                                     cylinder3.GetCenterPositionXY(), cylinder3.GetFloatRange(), cylinder3.m_radius);
+
+            if (!actorResult.m_didImpact) continue;
+
+            out_results[packetStart + lane].m_result              = actorResult;
+            out_results[packetStart + lane].m_impactedActorHandle = actor->m_handle;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// As the world half of Map::RaycastAll. out_closestLength is how far an actor may be hit, or -1 when the ray starts inside
+// of a wall and must not hit anything.
+STATIC void RayPacket::CastWorld(Map const&      map,
+                                 BatchRay const& ray,
+                                 BatchRayResult& out_result,
+                                 float&          out_closestLength)
+{
+    RaycastResult3D& result = out_result.m_result;
+    result.m_didImpact        = false;
+    result.m_impactPosition   = ray.m_startPosition;
+    result.m_impactNormal     = -ray.m_forwardNormal;
+    result.m_impactLength     = ray.m_maxLength;
+    result.m_rayStartPosition = ray.m_startPosition;
+    result.m_rayForwardNormal = ray.m_forwardNormal;
+    result.m_rayMaxLength     = ray.m_maxLength;
+    out_result.m_impactedActorHandle = ActorHandle::INVALID;
+    out_closestLength                = ray.m_maxLength;
+
+    IntVec2 const startTileCoords = map.GetTileCoordsFromWorldPos(ray.m_startPosition);
+
+    if (!map.IsTileCoordsOutOfBounds(startTileCoords) &&
+        map.IsTileSolid(startTileCoords) &&
+        Tile::GetBounds(startTileCoords).IsPointInside(ray.m_startPosition))
+    {
+        out_closestLength = -1.f;
+        return;
+    }
+
+    RaycastResult3D const xyResult = map.RaycastWorldXY(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength);
+
+    if (xyResult.m_didImpact &&
+        xyResult.m_impactLength < out_closestLength)
+    {
+        result            = xyResult;
+        out_closestLength = xyResult.m_impactLength;
+    }
+
+    RaycastResult3D const zResult = map.RaycastWorldZ(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength);
+
+    if (zResult.m_didImpact &&
+        zResult.m_impactLength < out_closestLength)
+    {
+        result            = zResult;
+        out_closestLength = zResult.m_impactLength;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// The grid's candidates are checked again against their current cylinders. Actors spawned since the grid was rebuilt
+// are not in it yet, and are checked one by one at the end of the actor list.
+STATIC void RayPacket::GatherCylinders(Map const&   map,
+                                       Actor const* ignoredActor,
+                                       Vec2 const&  boundsMins,
+                                       Vec2 const&  boundsMaxs)
+{
+    s_cylinders.Clear();
+
+    ActorQueryGrid const&      grid         = map.GetActorQueryGrid();
+    ActorPhysicsStore const&   physicsStore = map.GetPhysicsStore();
+    std::vector<Actor*>&       candidates   = s_cylinders.m_candidates;
+    std::vector<Actor*> const& actors       = map.m_actors;
+
+    grid.QueryBounds(boundsMins, boundsMaxs, candidates);
+    candidates.insert(candidates.end(), actors.begin() + std::min(grid.GetActorCount(), static_cast<int>(actors.size())), actors.end());
+
+    for (Actor const* actor : candidates)
+    {
+        if (actor == ignoredActor) continue;
+
+        Vec3 const  position = physicsStore.GetPosition(actor->m_physicsIndex);
+        Vec2 const  center   = Vec2(position.x, position.y);
+        float const radius   = physicsStore.GetRadius(actor->m_physicsIndex);
+
+        if (center.x + radius < boundsMins.x || center.x - radius > boundsMaxs.x) continue;
+        if (center.y + radius < boundsMins.y || center.y - radius > boundsMaxs.y) continue;
+
+        FloatRange const rangeZ = physicsStore.GetCylinderRangeZ(actor->m_physicsIndex);
+        s_cylinders.m_centerX.push_back(center.x);
+        s_cylinders.m_centerY.push_back(center.y);
+        s_cylinders.m_radius.push_back(radius);
+        s_cylinders.m_minZ.push_back(rangeZ.m_min);
+        s_cylinders.m_maxZ.push_back(rangeZ.m_max);
+        s_cylinders.m_actors.push_back(actor);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// A lane hits a cylinder where it starts inside of it, enters its side between its bottom and top, or enters its top or
+// bottom cap inside of its radius, and keeps the cylinder when that is strictly closer than anything it hit before.
+// Unused lanes start at a closest length of -1, which nothing is closer than.
+STATIC void RayPacket::FindClosestCylinders(BatchRay const* rays,
+                                            int const       laneCount,
+                                            float*          inout_closestLengths,
+                                            int*            out_cylinderIndexes)
+{
+    alignas(16) float startX[LANE_COUNT];
+    alignas(16) float startY[LANE_COUNT];
+    alignas(16) float startZ[LANE_COUNT];
+    alignas(16) float forwardX[LANE_COUNT];
+    alignas(16) float forwardY[LANE_COUNT];
+    alignas(16) float forwardZ[LANE_COUNT];
+    alignas(16) float closestLengths[LANE_COUNT];
+
+    for (int lane = 0; lane < LANE_COUNT; ++lane)
+    {
+        BatchRay const& ray = rays[lane < laneCount ? lane : 0];
+        startX[lane]         = ray.m_startPosition.x;
+        startY[lane]         = ray.m_startPosition.y;
+        startZ[lane]         = ray.m_startPosition.z;
+        forwardX[lane]       = ray.m_forwardNormal.x;
+        forwardY[lane]       = ray.m_forwardNormal.y;
+        forwardZ[lane]       = ray.m_forwardNormal.z;
+        closestLengths[lane] = lane < laneCount ? inout_closestLengths[lane] : -1.f;
+    }
+
+    __m128 const zero     = _mm_setzero_ps();
+    __m128 const infinity = _mm_set1_ps(FLT_MAX);
+    __m128 const sx       = _mm_load_ps(startX);
+    __m128 const sy       = _mm_load_ps(startY);
+    __m128 const sz       = _mm_load_ps(startZ);
+    __m128 const fx       = _mm_load_ps(forwardX);
+    __m128 const fy       = _mm_load_ps(forwardY);
+    __m128 const fz       = _mm_load_ps(forwardZ);
+
+    // Per lane terms that do not depend on the cylinder; divisors of lanes that cannot use them are replaced by 1.
+    __m128 const a              = _mm_add_ps(_mm_mul_ps(fx, fx), _mm_mul_ps(fy, fy));
+    __m128 const isMovingXY     = _mm_cmpgt_ps(a, _mm_set1_ps(1.0e-12f));
+    __m128 const safeA          = _mm_or_ps(_mm_and_ps(isMovingXY, a), _mm_andnot_ps(isMovingXY, _mm_set1_ps(1.f)));
+    __m128 const isMovingUp     = _mm_cmpgt_ps(fz, zero);
+    __m128 const isMovingDown   = _mm_cmplt_ps(fz, zero);
+    __m128 const isMovingZ      = _mm_or_ps(isMovingUp, isMovingDown);
+    __m128 const safeFz         = _mm_or_ps(_mm_and_ps(isMovingZ, fz), _mm_andnot_ps(isMovingZ, _mm_set1_ps(1.f)));
+    __m128 const oneOverFz      = _mm_and_ps(isMovingZ, _mm_div_ps(_mm_set1_ps(1.f), safeFz));
+    __m128       closest        = _mm_load_ps(closestLengths);
+    __m128i      closestIndexes = _mm_set1_epi32(-1);
+
+    int const cylinderCount = static_cast<int>(s_cylinders.m_actors.size());
+
+    for (int cylinderIndex = 0; cylinderIndex < cylinderCount; ++cylinderIndex)
+    {
+        __m128 const cx     = _mm_set1_ps(s_cylinders.m_centerX[cylinderIndex]);
+        __m128 const cy     = _mm_set1_ps(s_cylinders.m_centerY[cylinderIndex]);
+        __m128 const radius = _mm_set1_ps(s_cylinders.m_radius[cylinderIndex]);
+        __m128 const minZ   = _mm_set1_ps(s_cylinders.m_minZ[cylinderIndex]);
+        __m128 const maxZ   = _mm_set1_ps(s_cylinders.m_maxZ[cylinderIndex]);
+
+        __m128 const dx            = _mm_sub_ps(sx, cx);
+        __m128 const dy            = _mm_sub_ps(sy, cy);
+        __m128 const radiusSquared = _mm_mul_ps(radius, radius);
+        __m128 const c             = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), radiusSquared);
+        __m128 const isAbove       = _mm_cmpgt_ps(sz, maxZ);
+        __m128 const isBelow       = _mm_cmplt_ps(sz, minZ);
+        __m128 const isInside      = _mm_andnot_ps(_mm_or_ps(isAbove, isBelow), _mm_cmple_ps(c, zero));
+
+        // Starting inside.
+        __m128 length = _mm_andnot_ps(isInside, infinity);
+
+        // Side: the first root of |d + t * f|^2 = r^2 in XY, from outside of the radius.
+        __m128 const halfB        = _mm_add_ps(_mm_mul_ps(dx, fx), _mm_mul_ps(dy, fy));
+        __m128 const discriminant = _mm_sub_ps(_mm_mul_ps(halfB, halfB), _mm_mul_ps(a, c));
+        __m128 const sideLength   = _mm_div_ps(_mm_sub_ps(_mm_sub_ps(zero, halfB), _mm_sqrt_ps(_mm_max_ps(discriminant, zero))), safeA);
+        __m128 const sideZ        = _mm_add_ps(sz, _mm_mul_ps(fz, sideLength));
+        __m128       isSideHit    = _mm_and_ps(isMovingXY, _mm_cmpge_ps(discriminant, zero));
+        isSideHit                 = _mm_and_ps(isSideHit, _mm_cmpgt_ps(c, zero));
+        isSideHit                 = _mm_and_ps(isSideHit, _mm_cmpge_ps(sideLength, zero));
+        isSideHit                 = _mm_and_ps(isSideHit, _mm_and_ps(_mm_cmpge_ps(sideZ, minZ), _mm_cmple_ps(sideZ, maxZ)));
+        length                    = _mm_min_ps(length, _mm_or_ps(_mm_and_ps(isSideHit, sideLength), _mm_andnot_ps(isSideHit, infinity)));
+
+        // Caps: the top from above moving down, or the bottom from below moving up, inside of the radius.
+        __m128 const capZ      = _mm_or_ps(_mm_and_ps(isAbove, maxZ), _mm_andnot_ps(isAbove, minZ));
+        __m128 const capLength = _mm_mul_ps(_mm_sub_ps(capZ, sz), oneOverFz);
+        __m128 const capX      = _mm_add_ps(dx, _mm_mul_ps(fx, capLength));
+        __m128 const capY      = _mm_add_ps(dy, _mm_mul_ps(fy, capLength));
+        __m128       isCapHit  = _mm_or_ps(_mm_and_ps(isAbove, isMovingDown), _mm_and_ps(isBelow, isMovingUp));
+        isCapHit               = _mm_and_ps(isCapHit, _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(capX, capX), _mm_mul_ps(capY, capY)), radiusSquared));
+        length                 = _mm_min_ps(length, _mm_or_ps(_mm_and_ps(isCapHit, capLength), _mm_andnot_ps(isCapHit, infinity)));
+
+        // Keep the closer hits.
+        __m128 const  isCloser    = _mm_cmplt_ps(length, closest);
+        __m128i const isCloserInt = _mm_castps_si128(isCloser);
+        closest                   = _mm_or_ps(_mm_and_ps(isCloser, length), _mm_andnot_ps(isCloser, closest));
+        closestIndexes            = _mm_or_si128(_mm_and_si128(isCloserInt, _mm_set1_epi32(cylinderIndex)), _mm_andnot_si128(isCloserInt, closestIndexes));
+    }
+
+    alignas(16) int cylinderIndexes[LANE_COUNT];
+    _mm_store_ps(closestLengths, closest);
+    _mm_store_si128(reinterpret_cast<__m128i*>(cylinderIndexes), closestIndexes);
+
+    for (int lane = 0; lane < laneCount; ++lane)
+    {
+        inout_closestLengths[lane] = closestLengths[lane];
+        out_cylinderIndexes[lane]  = cylinderIndexes[lane];
+    }
+}
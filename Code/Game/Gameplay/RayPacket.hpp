@@ -0,0 +1,50 @@
+//----------------------------------------------------------------------------------------------------
+// RayPacket.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Math/RaycastUtils.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Game/Framework/ActorHandle.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+class Map;
+
+//----------------------------------------------------------------------------------------------------
+struct BatchRay
+{
+    Vec3  m_startPosition;
+    Vec3  m_forwardNormal;
+    float m_maxLength = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+// The same result as Map::RaycastAll, except that the impacted actor is only set when the actor is what the ray hit first.
+struct BatchRayResult
+{
+    RaycastResult3D m_result;
+    ActorHandle     m_impactedActorHandle;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Map::RaycastBatch, in packets of LANE_COUNT rays. Each ray walks the tile grid on its own, which clips it to the first
+// wall, floor or ceiling it hits; the packet then gathers the actors within its rays' bounds from the map's ActorQueryGrid
+// and tests their cylinders with SSE, one cylinder against all of its rays at a time. Only the closest cylinder of each ray is raycast again in full for the impact details.
+// Thread-safe, so the AI can cast from the parallel think phase.
+class RayPacket
+{
+public:
+    static constexpr int LANE_COUNT = 4;
+
+    static void Cast(Map const& map, Actor const* ignoredActor, BatchRay const* rays, int rayCount, BatchRayResult* out_results);
+
+private:
+    static void CastWorld(Map const& map, BatchRay const& ray, BatchRayResult& out_result, float& out_closestLength);
+    static void GatherCylinders(Map const& map, Actor const* ignoredActor, Vec2 const& boundsMins, Vec2 const& boundsMaxs);
+    static void FindClosestCylinders(BatchRay const* rays, int laneCount, float* inout_closestLengths, int* out_cylinderIndexes);
+};
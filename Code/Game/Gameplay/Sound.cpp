@@ -11,8 +11,13 @@
 Sound::Sound(XmlElement const& element)
 {
     m_name     = ParseXmlAttribute(element, "sound", m_name);
+    m_nameID   = NameTable::Intern(m_name);
     m_filePath = ParseXmlAttribute(element, "name", m_filePath);
-    m_id       = g_theAudio->CreateOrGetSound(m_filePath, eAudioSystemSoundDimension::Sound3D);
+
+    if (g_theAudio != nullptr)
+    {
+        m_id = g_theAudio->CreateOrGetSound(m_filePath, eAudioSystemSoundDimension::Sound3D);
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 
 #include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Core/XmlUtils.hpp"
+#include "Game/Framework/NameTable.hpp"
 
 ///
 /// Different from FMod::Sound, this class Encapsulate sound name, file path and SoundID from
@@ -20,6 +21,7 @@ public:
     SoundID  GetSoundID() const;
 
     String  m_name     = "DEFAULT";     // Name of a specific sound to be played by this weapon. Possible values: Fire, played every time the weapon is fired.
+    NameID  m_nameID   = NameTable::INVALID;
     String  m_filePath = "DEFAULT";     // Audio file for this sound.
-    SoundID m_id       ;
+    SoundID m_id       = MISSING_SOUND_ID;     // Stays missing when there is no audio system (headless).
 };
@@ -0,0 +1,54 @@
+//----------------------------------------------------------------------------------------------------
+// SpatialQuery.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Game/Framework/ActorHandle.hpp"
+#include "Game/Gameplay/RayPacket.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+
+//----------------------------------------------------------------------------------------------------
+enum class eSpatialQueryType : int8_t
+{
+    RAY,        // m_ray, as Map::RaycastAll ignoring the querying actor.
+    SPHERE,     // Actors whose collision cylinder is within m_radius of m_center.
+    SECTOR      // Actors whose center is within m_radius of m_center in XY and within m_halfAngleDegrees of m_direction.
+};
+
+//----------------------------------------------------------------------------------------------------
+struct SpatialQueryResult
+{
+    BatchRayResult           m_rayResult;         // RAY.
+    std::vector<ActorHandle> m_actorHandles;      // SPHERE and SECTOR, living actors other than the querying one.
+};
+
+//----------------------------------------------------------------------------------------------------
+// Called on the querying actor once its query is resolved. Like Think, it runs in parallel with other actors' callbacks,
+// so it only writes to that actor and queues everything else in its m_commands.
+typedef std::function<void(Actor& actor, SpatialQueryResult const& result)> SpatialQueryCallback;
+
+//----------------------------------------------------------------------------------------------------
+// A question about the map that an actor asks during the think phase and gets answered before the physics phase.
+// Queries are queued on the asking actor, as its commands are, and resolved together by Map's SpatialQueryService.
+// The answer goes to m_resultSlot, which must stay alive until then, and/or to m_callback.
+struct SpatialQuery
+{
+    eSpatialQueryType    m_type = eSpatialQueryType::RAY;
+    BatchRay             m_ray;
+    Vec3                 m_center;
+    float                m_radius           = 0.f;
+    Vec2                 m_direction;                   // SECTOR, normalized.
+    float                m_halfAngleDegrees = 180.f;    // SECTOR.
+    SpatialQueryResult*  m_resultSlot       = nullptr;
+    SpatialQueryCallback m_callback;
+    SpatialQueryResult   m_result;                      // Filled in by SpatialQueryService::Resolve.
+};
@@ -0,0 +1,207 @@
+//----------------------------------------------------------------------------------------------------
+// SpatialQueryService.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/SpatialQueryService.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/WorkerPool.hpp"
+#include "Game/Gameplay/Actor.hpp"
+#include "Game/Gameplay/Map.hpp"
+#include "Game/Gameplay/SpatialQuery.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Only the first actorCount actors thought this tick; queries of actors spawned since wait for the next Resolve.
+void SpatialQueryService::Resolve(Map const&                 map,
+                                  std::vector<Actor*> const& actors,
+                                  int const                  actorCount)
+{
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    m_queryingActorIndexes.clear();
+    m_queryCount    = 0;
+    m_rayQueryCount = 0;
+
+    for (int actorIndex = 0; actorIndex < actorCount; ++actorIndex)
+    {
+        std::vector<SpatialQuery> const& queries = actors[actorIndex]->m_queries;
+
+        if (queries.empty()) continue;
+
+        m_queryingActorIndexes.push_back(actorIndex);
+        m_queryCount += static_cast<int>(queries.size());
+
+        for (SpatialQuery const& query : queries)
+        {
+            if (query.m_type == eSpatialQueryType::RAY) ++m_rayQueryCount;
+        }
+    }
+
+    int const queryingActorCount = static_cast<int>(m_queryingActorIndexes.size());
+
+    auto const ResolveBatch = [this, &map, &actors](int const begin, int const end)
+    {
+        std::vector<BatchRay>       scratchRays;
+        std::vector<BatchRayResult> scratchResults;
+        std::vector<ActorQueryHit>  scratchHits;
+
+        for (int i = begin; i < end; ++i)
+        {
+            ResolveActorQueries(map, *actors[m_queryingActorIndexes[i]], scratchRays, scratchResults, scratchHits);
+        }
+    };
+
+    if (g_theWorkerPool == nullptr)
+    {
+        ResolveBatch(0, queryingActorCount);
+    }
+    else if (queryingActorCount > 0)
+    {
+        g_theWorkerPool->ParallelFor(queryingActorCount, ACTOR_BATCH_SIZE, ResolveBatch);
+    }
+
+    m_resolveMilliseconds = static_cast<float>((GetCurrentTimeSeconds() - startSeconds) * 1000.0);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Hands the actor its answers in the order it asked, and clears its queries. Queries a callback asks are kept for the next tick.
+void SpatialQueryService::Deliver(Actor& actor) const
+{
+    if (actor.m_queries.empty()) return;
+
+    std::vector<SpatialQuery> queries;
+    queries.swap(actor.m_queries);
+
+    for (SpatialQuery const& query : queries)
+    {
+        if (query.m_resultSlot != nullptr)
+        {
+            *query.m_resultSlot = query.m_result;
+        }
+
+        if (query.m_callback)
+        {
+            query.m_callback(actor, query.m_result);
+        }
+    }
+
+    // Keep the capacity for the next tick.
+    if (actor.m_queries.empty())
+    {
+        queries.clear();
+        actor.m_queries.swap(queries);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int SpatialQueryService::GetQueryCount() const
+{
+    return m_queryCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int SpatialQueryService::GetRayQueryCount() const
+{
+    return m_rayQueryCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+float SpatialQueryService::GetResolveMilliseconds() const
+{
+    return m_resolveMilliseconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void SpatialQueryService::ResolveActorQueries(Map const&                   map,
+                                                     Actor&                       actor,
+                                                     std::vector<BatchRay>&       scratchRays,
+                                                     std::vector<BatchRayResult>& scratchResults,
+                                                     std::vector<ActorQueryHit>&  scratchHits)
+{
+    scratchRays.clear();
+
+    for (SpatialQuery& query : actor.m_queries)
+    {
+        switch (query.m_type)
+        {
+        case eSpatialQueryType::RAY:
+            scratchRays.push_back(query.m_ray);
+            break;
+        case eSpatialQueryType::SPHERE:
+            ResolveSphere(map, actor, query, scratchHits);
+            break;
+        case eSpatialQueryType::SECTOR:
+            ResolveSector(map, actor, query, scratchHits);
+            break;
+        }
+    }
+
+    if (scratchRays.empty()) return;
+
+    map.RaycastBatch(&actor, scratchRays, scratchResults);
+
+    int rayIndex = 0;
+
+    for (SpatialQuery& query : actor.m_queries)
+    {
+        if (query.m_type != eSpatialQueryType::RAY) continue;
+
+        query.m_result.m_rayResult = scratchResults[rayIndex];
+        ++rayIndex;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Distance from the center to the closest point of each cylinder, so tall and wide actors are found by any part of them.
+// The map's disc query measures it on the XY plane, and the height is checked here.
+STATIC void SpatialQueryService::ResolveSphere(Map const&                  map,
+                                               Actor const&                actor,
+                                               SpatialQuery&               query,
+                                               std::vector<ActorQueryHit>& scratchHits)
+{
+    ActorQueryFilter filter;
+    filter.m_ignoredActor        = &actor;
+    filter.m_isMeasuredToSurface = true;
+
+    map.QueryActorsInDisc(Vec2(query.m_center.x, query.m_center.y), query.m_radius, filter, scratchHits);
+
+    float const radiusSquared = query.m_radius * query.m_radius;
+
+    query.m_result.m_actorHandles.clear();
+
+    for (ActorQueryHit const& hit : scratchHits)
+    {
+        FloatRange const rangeZ          = map.GetPhysicsStore().GetCylinderRangeZ(hit.m_actor->m_physicsIndex);
+        float const      distanceZ       = std::max(std::max(rangeZ.m_min - query.m_center.z, query.m_center.z - rangeZ.m_max), 0.f);
+        float const      distanceSquared = hit.m_distance * hit.m_distance + distanceZ * distanceZ;
+
+        if (distanceSquared > radiusSquared) continue;
+
+        query.m_result.m_actorHandles.push_back(hit.m_actor->m_handle);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void SpatialQueryService::ResolveSector(Map const&                  map,
+                                               Actor const&                actor,
+                                               SpatialQuery&               query,
+                                               std::vector<ActorQueryHit>& scratchHits)
+{
+    ActorQueryFilter filter;
+    filter.m_ignoredActor = &actor;
+
+    map.QueryActorsInSector(Vec2(query.m_center.x, query.m_center.y), query.m_direction, query.m_halfAngleDegrees, query.m_radius, filter, scratchHits);
+
+    query.m_result.m_actorHandles.clear();
+
+    for (ActorQueryHit const& hit : scratchHits)
+    {
+        query.m_result.m_actorHandles.push_back(hit.m_actor->m_handle);
+    }
+}
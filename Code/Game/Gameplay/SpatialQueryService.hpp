@@ -0,0 +1,44 @@
+//----------------------------------------------------------------------------------------------------
+// SpatialQueryService.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Game/Gameplay/ActorQueryGrid.hpp"
+#include "Game/Gameplay/RayPacket.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+class Map;
+struct SpatialQuery;
+
+//----------------------------------------------------------------------------------------------------
+// Answers the SpatialQuery every actor queued in its m_queries during the think phase, all at one sync point between
+// the think and physics phases, when nothing moves: Resolve spreads the actors with queries over g_theWorkerPool and
+// answers each actor's queries against the map as it stands, its rays as one RaycastBatch. Deliver then hands the
+// answers over from the physics phase, so a query asked in one tick's think phase is answered in that same tick.
+class SpatialQueryService
+{
+public:
+    void Resolve(Map const& map, std::vector<Actor*> const& actors, int actorCount);
+    void Deliver(Actor& actor) const;
+
+    // Counts of the last Resolve.
+    int   GetQueryCount() const;
+    int   GetRayQueryCount() const;
+    float GetResolveMilliseconds() const;
+
+private:
+    static void ResolveActorQueries(Map const& map, Actor& actor, std::vector<BatchRay>& scratchRays, std::vector<BatchRayResult>& scratchResults, std::vector<ActorQueryHit>& scratchHits);
+    static void ResolveSphere(Map const& map, Actor const& actor, SpatialQuery& query, std::vector<ActorQueryHit>& scratchHits);
+    static void ResolveSector(Map const& map, Actor const& actor, SpatialQuery& query, std::vector<ActorQueryHit>& scratchHits);
+
+    static constexpr int ACTOR_BATCH_SIZE = 16;     // Querying actors per ParallelFor batch.
+
+    std::vector<int> m_queryingActorIndexes;            // Reused by every Resolve.
+    int              m_queryCount          = 0;
+    int              m_rayQueryCount       = 0;
+    float            m_resolveMilliseconds = 0.f;
+};
@@ -3,4 +3,61 @@
 //----------------------------------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------------------------------
-#include "Game/Gameplay/Tile.hpp"
\ No newline at end of file
+#include "Game/Gameplay/Tile.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Game/Definition/TileDefinition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+TileDefinition const* Tile::GetDefinition() const
+{
+    if (m_tileDefIndex == INVALID_DEF_INDEX) return nullptr;
+
+    return TileDefinition::s_tileDefinitions[m_tileDefIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+bool Tile::IsSolid() const
+{
+    TileDefinition const* tileDef = GetDefinition();
+
+    return tileDef != nullptr && tileDef->m_isSolid;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC AABB3 Tile::GetBounds(IntVec2 const& tileCoords)
+{
+    Vec3 const mins = Vec3(static_cast<float>(tileCoords.x), static_cast<float>(tileCoords.y), 0.f);
+
+    return AABB3(mins, mins + Vec3(1.f, 1.f, 1.f));
+}
+
+//----------------------------------------------------------------------------------------------------
+// The solidity bitset has a one tile ring of non-solid padding around the map, see Map::IsTileSolid.
+STATIC int Tile::GetSolidTileBitsWidth(IntVec2 const& dimensions)
+{
+    return dimensions.x + 2;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void Tile::CreateSolidTileBits(IntVec2 const&         dimensions,
+                                      Tile const*            tiles,
+                                      std::vector<uint64_t>& out_solidTileBits)
+{
+    int const bitsWidth       = GetSolidTileBitsWidth(dimensions);
+    int const paddedTileCount = bitsWidth * (dimensions.y + 2);
+
+    out_solidTileBits.assign(static_cast<size_t>((paddedTileCount + 63) / 64), 0);
+
+    for (int y = 0; y < dimensions.y; ++y)
+    {
+        for (int x = 0; x < dimensions.x; ++x)
+        {
+            if (!tiles[x + y * dimensions.x].IsSolid()) continue;
+
+            int const bitIndex = (x + 1) + (y + 1) * bitsWidth;
+            out_solidTileBits[bitIndex >> 6] |= uint64_t{1} << (bitIndex & 63);
+        }
+    }
+}
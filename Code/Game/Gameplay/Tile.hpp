@@ -4,14 +4,27 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
-#include "Engine/Core/StringUtils.hpp"
+#include <cstdint>
+#include <vector>
+
 #include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct TileDefinition;
 
 //----------------------------------------------------------------------------------------------------
+// A tile is just its definition index; its bounds follow from its coordinates.
+// Hot paths should ask Map::IsTileSolid, which reads a bitset instead of the definition.
 struct Tile
 {
-    // IntVec2 m_coords = IntVec2::NEGATIVE_ONE;
-    AABB3  m_bounds  = AABB3::NEG_ONE;   // Tile bounds are the world space bounds of the tile.
-    String m_name    = "Unnamed";
-    bool   m_isSolid = false;
+    static constexpr uint8_t INVALID_DEF_INDEX = 0xff;
+
+    TileDefinition const* GetDefinition() const;
+    bool                  IsSolid() const;
+    static AABB3          GetBounds(IntVec2 const& tileCoords);
+    static int            GetSolidTileBitsWidth(IntVec2 const& dimensions);
+    static void           CreateSolidTileBits(IntVec2 const& dimensions, Tile const* tiles, std::vector<uint64_t>& out_solidTileBits);
+
+    uint8_t m_tileDefIndex = INVALID_DEF_INDEX;     // Index into TileDefinition::s_tileDefinitions, INVALID_DEF_INDEX if the map color matched no definition.
 };
@@ -17,6 +17,8 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Game/Gameplay/Actor.hpp"
 #include "Game/Definition/ActorDefinition.hpp"
+#include "Game/Definition/EffectDefinition.hpp"
+#include "Game/Definition/FactionDefinition.hpp"
 #include "Game/Framework/Animation.hpp"
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Framework/GameCommon.hpp"
@@ -50,6 +52,8 @@ Weapon::Weapon(Actor*            owner,
 //----------------------------------------------------------------------------------------------------
 Weapon::~Weapon()
 {
+    GAME_SAFE_RELEASE(m_timer);
+    GAME_SAFE_RELEASE(m_animationTimer);
     m_owner = nullptr;
 }
 
@@ -184,6 +188,8 @@ void Weapon::RenderWeaponAnim() const
 // Checks if the weapon is ready to fire.
 // If so, fires each of the ray casts, projectiles, and melee attacks defined in the definition.
 // Needs to pass along its owning actor to be ignored in all raycast and collision checks.
+// The AI fires from Actor::Think on a worker thread, so the weapon only reads the map; rays are queued on the owner as
+// spatial queries, and sounds, damage, impulses and spawns as commands carried out by Map::ApplyActorCommands.
 void Weapon::Fire()
 {
     int rayCount        = m_definition->m_rayCount;
@@ -197,8 +203,16 @@ void Weapon::Fire()
         if (m_timeSinceLastFire > m_definition->m_refireTime)
         {
             // m_owner->m_controller->m_state = "Attack";
-            SoundID weaponFireSound = m_definition->GetSoundByName("Fire")->GetSoundID();
-            g_theAudio->StartSoundAt(weaponFireSound, m_owner->m_position);
+            Sound const* fireSound = m_definition->GetSoundByNameID(NameTable::FIRE);
+
+            if (g_theAudio != nullptr && fireSound != nullptr)
+            {
+                ActorCommand soundCommand;
+                soundCommand.m_type    = eActorCommandType::PLAY_SOUND;
+                soundCommand.m_soundID = fireSound->GetSoundID();
+                soundCommand.m_vector  = m_owner->GetPosition();
+                m_owner->m_commands.push_back(soundCommand);
+            }
             if (m_definition->m_hud)
             {
                 PlayAnimationByName("Attack");
@@ -207,72 +221,51 @@ void Weapon::Fire()
             PlayerController* player = dynamic_cast<PlayerController*>(m_owner->m_controller);
             if (player)
             {
-                player->GetActor()->PlayAnimationByName("Attack");
+                player->GetActor()->PlayAnimationByNameID(NameTable::ATTACK);
             }
 
             m_timer->DecrementPeriodIfElapsed();
             m_lastFireTime = m_currentFireTime;
             // if (m_owner == nullptr) return;
-            while (rayCount > 0)
+            if (rayCount > 0)
             {
-                //float             rayRange = m_definition->m_rayRange;
-                Vec3              forward, left, up;
-                Vec3 const        firePosition    = m_owner->m_position;
-                Vec3 const        fireEyePosition = firePosition + Vec3(0.f, 0.f, m_owner->m_definition->m_eyeHeight);
-                EulerAngles const fireOrientation = m_owner->m_orientation;
-                fireOrientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
-                ActorHandle           impactedActorHandle;
-                RaycastResult3D const result        = m_owner->m_map->RaycastAll(m_owner, impactedActorHandle, fireEyePosition, forward, 10.f);
-                Actor*                impactedActor = m_owner->m_map->GetActorByHandle(impactedActorHandle);
-
-                if (result.m_didImpact)
-                {
-                    // DebugAddWorldPoint(result.m_impactPosition, 0.06f, 10.f);
-                    // DebugAddWorldCylinder(fireEyePosition - Vec3::Z_BASIS * 0.05f, result.m_impactPosition, 0.01f, 10.f, false, Rgba8::BLUE, Rgba8::BLUE, DebugRenderMode::X_RAY);
-                    // DebugAddWorldCylinder(fireEyePosition - Vec3::Z_BASIS * 0.05f, result.m_impactPosition, 0.01f, 10.f, false, Rgba8::BLUE, Rgba8::BLUE, DebugRenderMode::USE_DEPTH);
-                    SpawnInfo particleSpawnInfo;
-                    particleSpawnInfo.m_position   = result.m_impactPosition;
-                    particleSpawnInfo.m_position.x = GetClamped(particleSpawnInfo.m_position.x, 0.f, 31.f);
-                    particleSpawnInfo.m_position.y = GetClamped(particleSpawnInfo.m_position.y, 0.f, 31.f);
-                    particleSpawnInfo.m_name       = "BulletHit";
-                    g_theGame->m_currentMap->SpawnActor(particleSpawnInfo);
-                }
-                else
-                {
-                    // DebugAddWorldCylinder(fireEyePosition - Vec3::Z_BASIS * 0.05f, result.m_rayStartPosition + result.m_rayForwardNormal * rayRange, 0.01f, 10.f, false, Rgba8::BLUE, Rgba8::BLUE, DebugRenderMode::USE_DEPTH);
-                }
-
-                if (impactedActor != nullptr && impactedActor != m_owner)
+                // The rays are asked of the map's query service and hit at the end of the think phase, all in one batch.
+                // A shot of several rays spreads them over the cone in a fixed pattern, since the random number generator
+                // may not be rolled from the think phase.
+                Vec3 const              fireEyePosition = m_owner->GetPosition() + Vec3(0.f, 0.f, m_owner->m_definition->m_eyeHeight);
+                WeaponDefinition const* definition      = m_definition;
+                std::vector<Vec3>       forwardNormals;
+                GetRayDirectionsInCone(m_owner->m_orientation, m_definition->m_rayCone, rayCount, forwardNormals);
+
+                for (Vec3 const& forwardNormal : forwardNormals)
                 {
-                    impactedActor->Damage((int)m_definition->m_rayDamage.m_min, m_owner->m_handle);
-                    impactedActor->AddImpulse(m_definition->m_rayImpulse * forward);
-
-                    //float damage = g_theRNG->RollRandomFloatInRange(m_definition->m_rayDamage.m_min, m_definition->m_rayDamage.m_max);
-
-                    SpawnInfo particleSpawnInfo;
-                    particleSpawnInfo.m_position = result.m_impactPosition;
-                    particleSpawnInfo.m_name     = "BloodSplatter";
-                    g_theGame->m_currentMap->SpawnActor(particleSpawnInfo);
+                    SpatialQuery query;
+                    query.m_type                = eSpatialQueryType::RAY;
+                    query.m_ray.m_startPosition = fireEyePosition;
+                    query.m_ray.m_forwardNormal = forwardNormal;
+                    query.m_ray.m_maxLength     = 10.f;
+                    query.m_callback            = [definition, forwardNormal](Actor& owner, SpatialQueryResult const& result)
+                    {
+                        QueueRayHitCommands(owner, *definition, forwardNormal, result.m_rayResult);
+                    };
+                    m_owner->m_queries.push_back(query);
                 }
-                rayCount--;
             }
 
             while (projectileCount > 0)
             {
-                Vec3 startPos = m_owner->m_position + Vec3(0.f, 0.f, m_owner->m_definition->m_eyeHeight);
-                Vec3 forward, left, up;
-
-                EulerAngles randomDirection = GetRandomDirectionInCone(m_owner->m_orientation, m_definition->m_projectileCone);
-                randomDirection.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
-                Vec3      projectileSpeed = forward * m_definition->m_projectileSpeed;
-                SpawnInfo spawnInfo;
-                spawnInfo.m_name        = m_definition->m_projectileActor;
-                spawnInfo.m_faction     = m_owner->m_definition->m_faction;
-                spawnInfo.m_position    = startPos;
-                spawnInfo.m_orientation = randomDirection;
-                spawnInfo.m_velocity    = projectileSpeed;
-                Actor* projectile       = m_owner->m_map->SpawnActor(spawnInfo);
-                projectile->m_owner     = m_owner;
+                // The direction within the cone is rolled when the command is applied, see Map::ApplyActorCommands.
+                ActorCommand projectileCommand;
+                projectileCommand.m_type                    = eActorCommandType::SPAWN_PROJECTILE;
+                projectileCommand.m_source                  = m_owner->m_handle;
+                projectileCommand.m_spawnInfo.m_name        = m_definition->m_projectileActor;
+                projectileCommand.m_spawnInfo.m_nameID      = m_definition->m_projectileActorID;
+                projectileCommand.m_spawnInfo.m_faction     = m_owner->m_definition->m_faction;
+                projectileCommand.m_spawnInfo.m_position    = m_owner->GetPosition() + Vec3(0.f, 0.f, m_owner->m_definition->m_eyeHeight);
+                projectileCommand.m_spawnInfo.m_orientation = m_owner->m_orientation;
+                projectileCommand.m_coneDegrees             = m_definition->m_projectileCone;
+                projectileCommand.m_speed                   = m_definition->m_projectileSpeed;
+                m_owner->m_commands.push_back(projectileCommand);
                 projectileCount--;
             }
 
@@ -285,39 +278,46 @@ void Weapon::Fire()
                 Vec3 fwd, left, up;
                 m_owner->m_orientation.GetAsVectors_IFwd_JLeft_KUp(fwd, left, up);
 
-                Vec2  ownerPos2D = Vec2(m_owner->m_position.x, m_owner->m_position.y);
-                Vec2  forward2D  = Vec2(fwd.x, fwd.y);
-                float halfArc    = m_definition->m_meleeArc * 0.5f;
+                // The closest living hostile in the swing's arc.
+                ActorQueryFilter filter;
+                filter.m_ignoredActor = m_owner;
+                filter.m_factionMask  = FactionDefinition::GetHostileMask(m_owner->m_definition->m_factionIndex);
 
-                Actor* bestTarget   = nullptr;
-                float  bestDistSq   = FLT_MAX;
-                float  meleeRangeSq = m_definition->m_meleeRange * m_definition->m_meleeRange;
+                Vec3 const                 ownerPosition = m_owner->GetPosition();
+                std::vector<ActorQueryHit> hits;
+                m_owner->m_map->QueryActorsInSector(Vec2(ownerPosition.x, ownerPosition.y),
+                                                    Vec2(fwd.x, fwd.y).GetNormalized(),
+                                                    m_definition->m_meleeArc * 0.5f,
+                                                    m_definition->m_meleeRange,
+                                                    filter,
+                                                    hits);
 
-                for (Actor* testActor : m_owner->m_map->m_actors)
+                Actor const* bestTarget   = nullptr;
+                float        bestDistance = FLT_MAX;
+
+                for (ActorQueryHit const& hit : hits)
                 {
-                    if (!testActor || testActor == m_owner) continue;
-                    if (testActor->m_isDead) continue;
-                    if (testActor->m_definition->m_faction == m_owner->m_definition->m_faction) continue;
-                    if (testActor->m_definition->m_faction == "NEUTRAL" || m_owner->m_definition->m_faction == "NEUTRAL") continue;
-
-                    Vec2  testPos2D   = Vec2(testActor->m_position.x, testActor->m_position.y);
-                    float distSquared = GetDistanceSquared2D(ownerPos2D, testPos2D);
-                    if (distSquared > meleeRangeSq) continue;
-                    Vec2  toTarget2D = (testPos2D - ownerPos2D).GetNormalized();
-                    float angle      = GetAngleDegreesBetweenVectors2D(forward2D, toTarget2D);
-                    if (angle > halfArc) continue;
-
-                    if (distSquared < bestDistSq)
+                    if (hit.m_distance < bestDistance)
                     {
-                        bestDistSq = distSquared;
-                        bestTarget = testActor;
+                        bestDistance = hit.m_distance;
+                        bestTarget   = hit.m_actor;
                     }
                 }
+
                 if (bestTarget)
                 {
-                    float damage = g_theRNG->RollRandomFloatInRange(m_definition->m_meleeDamage.m_min, m_definition->m_meleeDamage.m_max);
-                    bestTarget->Damage((int)damage, m_owner->m_handle);
-                    bestTarget->AddImpulse(m_definition->m_meleeImpulse * fwd);
+                    ActorCommand damageCommand;
+                    damageCommand.m_type   = eActorCommandType::DAMAGE;
+                    damageCommand.m_target = bestTarget->m_handle;
+                    damageCommand.m_source = m_owner->m_handle;
+                    damageCommand.m_damage = m_definition->m_meleeDamage;
+                    m_owner->m_commands.push_back(damageCommand);
+
+                    ActorCommand impulseCommand;
+                    impulseCommand.m_type   = eActorCommandType::IMPULSE;
+                    impulseCommand.m_target = bestTarget->m_handle;
+                    impulseCommand.m_vector = m_definition->m_meleeImpulse * fwd;
+                    m_owner->m_commands.push_back(impulseCommand);
                 }
             }
         }
@@ -368,9 +368,76 @@ Animation* Weapon::PlayAnimationByName(std::string animationName, bool force)
     return nullptr;
 }
 
+//----------------------------------------------------------------------------------------------------
+// Queues the effects of one of the owner's rays on whatever it hit, once the query service has cast it.
+STATIC void Weapon::QueueRayHitCommands(Actor&                  owner,
+                                        WeaponDefinition const& definition,
+                                        Vec3 const&             forwardNormal,
+                                        BatchRayResult const&   rayResult)
+{
+    RaycastResult3D const& result = rayResult.m_result;
+
+    if (result.m_didImpact)
+    {
+        // DebugAddWorldPoint(result.m_impactPosition, 0.06f, 10.f);
+        // DebugAddWorldCylinder(result.m_rayStartPosition - Vec3::Z_BASIS * 0.05f, result.m_impactPosition, 0.01f, 10.f, false, Rgba8::BLUE, Rgba8::BLUE, DebugRenderMode::X_RAY);
+        ActorCommand effectCommand;
+        effectCommand.m_type        = eActorCommandType::SPAWN_EFFECT;
+        effectCommand.m_effectIndex = EffectDefinition::GetDefIndexByNameID(NameTable::BULLET_HIT);
+        effectCommand.m_vector      = result.m_impactPosition;
+        owner.m_commands.push_back(effectCommand);
+    }
+
+    if (!rayResult.m_impactedActorHandle.IsValid()) return;
+
+    ActorCommand damageCommand;
+    damageCommand.m_type   = eActorCommandType::DAMAGE;
+    damageCommand.m_target = rayResult.m_impactedActorHandle;
+    damageCommand.m_source = owner.m_handle;
+    damageCommand.m_damage = FloatRange(definition.m_rayDamage.m_min, definition.m_rayDamage.m_min);
+    owner.m_commands.push_back(damageCommand);
+
+    ActorCommand impulseCommand;
+    impulseCommand.m_type   = eActorCommandType::IMPULSE;
+    impulseCommand.m_target = rayResult.m_impactedActorHandle;
+    impulseCommand.m_vector = definition.m_rayImpulse * forwardNormal;
+    owner.m_commands.push_back(impulseCommand);
+
+    ActorCommand effectCommand;
+    effectCommand.m_type        = eActorCommandType::SPAWN_EFFECT;
+    effectCommand.m_effectIndex = EffectDefinition::GetDefIndexByNameID(NameTable::BLOOD_SPLATTER);
+    effectCommand.m_vector      = result.m_impactPosition;
+    owner.m_commands.push_back(effectCommand);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The first ray goes straight ahead and the rest spiral out to the edge of the cone at golden angle steps, so any number
+// of rays covers the cone evenly and the same way on every shot.
+STATIC void Weapon::GetRayDirectionsInCone(EulerAngles const& weaponOrientation,
+                                           float const        coneDegrees,
+                                           int const          rayCount,
+                                           std::vector<Vec3>& out_forwardNormals)
+{
+    out_forwardNormals.resize(rayCount);
+
+    for (int rayIndex = 0; rayIndex < rayCount; ++rayIndex)
+    {
+        float const fraction       = rayCount > 1 ? sqrtf(static_cast<float>(rayIndex) / static_cast<float>(rayCount - 1)) : 0.f;
+        float const spiralDegrees  = 137.5f * static_cast<float>(rayIndex);
+        float const offsetDegrees  = coneDegrees * fraction;
+        EulerAngles rayOrientation = weaponOrientation;
+        rayOrientation.m_yawDegrees += offsetDegrees * CosDegrees(spiralDegrees);
+        rayOrientation.m_pitchDegrees += offsetDegrees * SinDegrees(spiralDegrees);
+
+        Vec3 left, up;
+        rayOrientation.GetAsVectors_IFwd_JLeft_KUp(out_forwardNormals[rayIndex], left, up);
+    }
+}
+
 //----------------------------------------------------------------------------------------------------
 // This, and other utility methods, will be helpful for randomizing weapons with a cone.
-EulerAngles Weapon::GetRandomDirectionInCone(EulerAngles weaponOrientation, float degreeOfVariation)
+// Rolls g_theRNG, so only call it from the main thread.
+STATIC EulerAngles Weapon::GetRandomDirectionInCone(EulerAngles weaponOrientation, float degreeOfVariation)
 {
     float const       randomYaw       = g_theRNG->RollRandomFloatInRange(-degreeOfVariation, degreeOfVariation);
     float const       randomPitch     = g_theRNG->RollRandomFloatInRange(-degreeOfVariation, degreeOfVariation);
@@ -5,14 +5,18 @@
 //----------------------------------------------------------------------------------------------------
 #pragma once
 
+#include <vector>
+
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Vec3.hpp"
 #include "Game/Framework/Animation.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class Actor;
 class Timer;
+struct BatchRayResult;
 struct WeaponDefinition;
 
 //----------------------------------------------------------------------------------------------------
@@ -30,7 +34,9 @@ public:
     void        RenderWeaponHudText() const;
     void        RenderWeaponAnim() const;
     void        Fire();
-    EulerAngles GetRandomDirectionInCone(EulerAngles weaponOrientation, float degreeOfVariation);
+    static EulerAngles GetRandomDirectionInCone(EulerAngles weaponOrientation, float degreeOfVariation);
+    static void        GetRayDirectionsInCone(EulerAngles const& weaponOrientation, float coneDegrees, int rayCount, std::vector<Vec3>& out_forwardNormals);
+    static void        QueueRayHitCommands(Actor& owner, WeaponDefinition const& definition, Vec3 const& forwardNormal, BatchRayResult const& rayResult);
     Animation*  PlayAnimationByName(String animationName, bool force = false);
 
     Actor*            m_owner        = nullptr;
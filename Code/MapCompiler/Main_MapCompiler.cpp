@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------------------------------
+// Main_MapCompiler.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+// MapCompiler [mapName ...]
+// Run from the Run folder. Compiles every map definition in Data/Definitions/MapDefinitions.xml that sets
+// compiledMap (or only the ones named) from its image into that .dmap, see CompiledMap.
+// A .dmap carries the tile definitions and sprite sheet layout it was compiled against, and the game falls back to
+// the image when those no longer match, but edits to a map image or its spawn infos need this to be rerun;
+// the project's post-build step does so on every build.
+#include <cstdio>
+#include <cstring>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Game/Definition/MapDefinition.hpp"
+#include "Game/Definition/TileDefinition.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Gameplay/CompiledMap.hpp"
+#include "Game/Gameplay/Tile.hpp"
+
+//----------------------------------------------------------------------------------------------------
+Renderer* g_theRenderer = nullptr;       // Never created, so the definitions load without touching the GPU.
+
+//----------------------------------------------------------------------------------------------------
+static bool IsMapNamed(MapDefinition const& mapDef,
+                       int const            argc,
+                       char**               argv)
+{
+    if (argc <= 1) return true;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (mapDef.m_name == argv[i]) return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool CompileMap(MapDefinition& mapDef)
+{
+    // Unmap any .dmap the definition opened, so it can be overwritten.
+    delete mapDef.m_compiledMap;
+    mapDef.m_compiledMap = nullptr;
+
+    Image const       image      = Image(mapDef.m_imageFilePath.c_str());
+    IntVec2 const     dimensions = image.GetDimensions();
+    std::vector<Tile> tiles(static_cast<size_t>(dimensions.x * dimensions.y));
+
+    for (int y = 0; y < dimensions.y; ++y)
+    {
+        for (int x = 0; x < dimensions.x; ++x)
+        {
+            tiles[x + y * dimensions.x].m_tileDefIndex = TileDefinition::GetDefIndexByMapImagePixelColor(image.GetTexelColor(IntVec2(x, y)));
+        }
+    }
+
+    if (!CompiledMap::Write(mapDef.m_compiledMapFilePath.c_str(), dimensions, tiles.data(), mapDef.m_spriteSheetCellCount, mapDef.m_spawnInfos))
+    {
+        printf("MapCompiler: failed to write %s for %s\n", mapDef.m_compiledMapFilePath.c_str(), mapDef.m_name.c_str());
+        return false;
+    }
+
+    CompiledMap compiledMap;
+
+    if (!compiledMap.Open(mapDef.m_compiledMapFilePath.c_str(), mapDef.m_spriteSheetCellCount))
+    {
+        printf("MapCompiler: %s does not read back for %s\n", mapDef.m_compiledMapFilePath.c_str(), mapDef.m_name.c_str());
+        return false;
+    }
+
+    printf("MapCompiler: %s %dx%d -> %s (%d chunks, %.2f MB)\n",
+           mapDef.m_name.c_str(), dimensions.x, dimensions.y, mapDef.m_compiledMapFilePath.c_str(),
+           compiledMap.GetChunkCount(), static_cast<double>(compiledMap.GetFileSize()) / (1024.0 * 1024.0));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+int main(int const argc,
+         char**    argv)
+{
+    TileDefinition::InitializeTileDefs("Data/Definitions/TileDefinitions.xml");
+    MapDefinition::InitializeMapDefs("Data/Definitions/MapDefinitions.xml");
+
+    int failedCount = 0;
+
+    for (MapDefinition* mapDef : MapDefinition::s_mapDefinitions)
+    {
+        if (mapDef->m_compiledMapFilePath.empty() || !IsMapNamed(*mapDef, argc, argv)) continue;
+
+        if (!CompileMap(*mapDef)) ++failedCount;
+    }
+
+    return failedCount == 0 ? 0 : 1;
+}
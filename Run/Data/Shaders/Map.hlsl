@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------------------------------
+// Map geometry shader. Merged map quads span several tiles, so their uv is in tile units and repeats once per tile,
+// and the atlas cell to repeat is carried in the tangent (cell uv mins) and bitangent (cell uv size) of every vertex.
+//----------------------------------------------------------------------------------------------------
+struct vs_input_t
+{
+	float3 modelPosition : VERTEX_POSITION;
+	float4 color : VERTEX_COLOR;
+	float2 uv : VERTEX_UVTEXCOORDS;
+	float3 modelTangent : VERTEX_TANGENT;
+	float3 modelBitangent : VERTEX_BITANGENT;
+	float3 modelNormal : VERTEX_NORMAL;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct v2p_t
+{
+	float4 clipPosition : SV_Position;
+	float4 color : COLOR;
+	float2 uv : TEXCOORD;
+	float4 worldTangent : TANGENT;
+	float4 worldBitangent : BITANGENT;
+	float4 worldNormal : NORMAL;
+	float4 spriteBounds : SPRITEBOUNDS;
+};
+
+//----------------------------------------------------------------------------------------------------
+cbuffer LightConstants : register(b2)
+{
+	float3 SunDirection;
+	float SunIntensity;
+	float AmbientIntensity;
+};
+
+//----------------------------------------------------------------------------------------------------
+cbuffer CameraConstants : register(b3)
+{
+	float4x4 WorldToCameraTransform;	// View transform
+	float4x4 CameraToRenderTransform;	// Non-standard transform from game to DirectX conventions
+	float4x4 RenderToClipTransform;		// Projection transform
+};
+
+//----------------------------------------------------------------------------------------------------
+cbuffer ModelConstants : register(b4)
+{
+	float4x4 ModelToWorldTransform;		// Model transform
+	float4 ModelColor;
+};
+
+//----------------------------------------------------------------------------------------------------
+Texture2D diffuseTexture : register(t0);
+
+//----------------------------------------------------------------------------------------------------
+SamplerState samplerState : register(s0);
+
+//----------------------------------------------------------------------------------------------------
+v2p_t VertexMain(vs_input_t input)
+{
+	float4 modelPosition = float4(input.modelPosition, 1);
+	float4 worldPosition = mul(ModelToWorldTransform, modelPosition);
+	float4 cameraPosition = mul(WorldToCameraTransform, worldPosition);
+	float4 renderPosition = mul(CameraToRenderTransform, cameraPosition);
+	float4 clipPosition = mul(RenderToClipTransform, renderPosition);
+
+	float4 worldTangent = mul(ModelToWorldTransform, float4(input.modelNormal, 0.0f));
+	float4 worldBitangent = mul(ModelToWorldTransform, float4(input.modelNormal, 0.0f));
+	float4 worldNormal = mul(ModelToWorldTransform, float4(input.modelNormal, 0.0f));
+
+	v2p_t v2p;
+	v2p.clipPosition = clipPosition;
+	v2p.color = input.color;
+	v2p.uv = input.uv;
+	v2p.worldTangent = worldTangent;
+	v2p.worldBitangent = worldBitangent;
+	v2p.worldNormal = worldNormal;
+	v2p.spriteBounds = float4(input.modelTangent.xy, input.modelBitangent.xy);
+	return v2p;
+}
+
+//----------------------------------------------------------------------------------------------------
+float4 PixelMain(v2p_t input) : SV_Target0
+{
+	float ambient = AmbientIntensity;
+	float directional = SunIntensity * saturate(dot(normalize(input.worldNormal.xyz), -SunDirection));
+	float4 lightColor = float4((ambient + directional).xxx, 1);
+	float2 spriteUV = input.spriteBounds.xy + frac(input.uv) * input.spriteBounds.zw;
+	float4 textureColor = diffuseTexture.Sample(samplerState, spriteUV);
+	float4 vertexColor = input.color;
+	float4 modelColor = ModelColor;
+	//float4 color = lightColor * textureColor * vertexColor * modelColor;
+float4 color = textureColor * vertexColor * modelColor;
+	clip(color.a - 0.01f);
+	return color;
+}